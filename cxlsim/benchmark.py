@@ -0,0 +1,79 @@
+import sys
+import os
+import re
+import time
+import subprocess
+
+# Simulator throughput benchmark
+# Runs cxlsim on every synthetic trace pattern and reports simulated requests and ticks per wall clock second. With a
+# cxlsim built with PROFILE=true it also reports the updates per second of every kind of component
+# Usage: python benchmark.py <number of accesses> <base directory> [baseline csv]
+# The results are written to <base directory>/benchmark.csv. Pass the csv of an earlier run as baseline to get the speedup
+
+PATTERNS = [
+    ("stream", []),
+    ("strided", ["stride=256"]),
+    ("random", []),
+    ("zipf", ["alpha=0.99"]),
+    ("chase", []),
+    ("mix", ["writes=0.3"]),
+]
+
+COMPONENTS = ["links", "switch", "devices", "hosts", "DAMs"]
+
+
+def run_pattern(pattern, args, num_accesses, base_dir):
+    trace = f"{base_dir}/bench_{pattern}.trace"
+    subprocess.run(["./cxlsim-gen", pattern, str(num_accesses), f"out={trace}"] + args, check=True)
+    start = time.time()
+    p = subprocess.run(["./cxlsim", trace, "bench", base_dir], stdout=subprocess.PIPE, stderr=subprocess.STDOUT, text=True)
+    wall = time.time() - start
+    if p.returncode != 0:
+        print(p.stdout[-2000:])
+        sys.exit(f"cxlsim failed on {pattern}")
+    ticks = int(re.search(r"Simulation Finished at (\d+)", p.stdout).group(1))
+    result = {"pattern": pattern, "requests": num_accesses, "ticks": ticks, "wall_s": wall,
+              "requests_per_s": num_accesses / wall, "ticks_per_s": ticks / wall}
+    # Updates per second of every kind of component, only printed by a PROFILE build
+    for name, updates, seconds, rate in re.findall(r"Profile, (\w+), (\d+), ([\d.e+-]+), ([\d.e+-]+)", p.stdout):
+        if name in COMPONENTS:
+            result[f"{name}_updates_per_s"] = float(rate)
+    os.remove(trace)
+    return result
+
+
+def read_baseline(filename):
+    baseline = {}
+    with open(filename) as f:
+        header = f.readline().strip().split(",")
+        for line in f:
+            row = dict(zip(header, line.strip().split(",")))
+            baseline[row["pattern"]] = float(row["requests_per_s"])
+    return baseline
+
+
+if __name__ == '__main__':
+    num_accesses = int(sys.argv[1])
+    base_dir = sys.argv[2]
+    baseline = read_baseline(sys.argv[3]) if len(sys.argv) > 3 else {}
+    os.makedirs(f"{base_dir}/bench", exist_ok=True)
+
+    results = [run_pattern(pattern, args, num_accesses, base_dir) for pattern, args in PATTERNS]
+
+    columns = ["pattern", "requests", "ticks", "wall_s", "requests_per_s", "ticks_per_s"] + \
+              [f"{c}_updates_per_s" for c in COMPONENTS if any(f"{c}_updates_per_s" in r for r in results)]
+    with open(f"{base_dir}/benchmark.csv", "w") as f:
+        f.write(",".join(columns) + "\n")
+        for r in results:
+            f.write(",".join(str(r.get(c, "")) for c in columns) + "\n")
+
+    print(f"{'pattern':<10}{'ticks':>12}{'wall s':>10}{'req/s':>12}{'ticks/s':>14}" + ("  speedup" if baseline else ""))
+    for r in results:
+        line = f"{r['pattern']:<10}{r['ticks']:>12}{r['wall_s']:>10.2f}{r['requests_per_s']:>12.0f}{r['ticks_per_s']:>14.0f}"
+        if r["pattern"] in baseline:
+            line += f"  {r['requests_per_s'] / baseline[r['pattern']]:.2f}x"
+        print(line)
+    for c in COMPONENTS:
+        if f"{c}_updates_per_s" in results[0]:
+            print(f"{c} updates/s: " + ", ".join(f"{r['pattern']} {r[f'{c}_updates_per_s']:.0f}" for r in results))
+    print(f"Results written to {base_dir}/benchmark.csv")
@@ -6,11 +6,25 @@ import os
 simulator_binary_dir = "/data1/sumanthu/cxlsim" 
 
 if __name__ == '__main__':
-    trace_file = sys.argv[1] # trace file dir
+    trace_file = sys.argv[1] # trace file dir, or ring:<path> to stream the trace from the pintool
     num_workers = int(sys.argv[2]) # num of partitions
     query = sys.argv[3]
     trace_dir = sys.argv[4] # trace target dir
 
+    if trace_file.startswith("ring:"):
+        # Live streaming, every worker is a shard reading its own ring. Nothing to split, but all shards have to run
+        # at the same time, the pintool fills their rings in turn
+        ring = trace_file[len("ring:"):]
+        if not os.path.exists(f"{trace_dir}/q_{query}"):
+            os.makedirs(f"{trace_dir}/q_{query}")
+        with open(f"{trace_dir}/run_{query}.sh", 'w') as file:
+            for shard in range(num_workers):
+                shard_ring = ring if num_workers == 1 else f"{ring}.{shard}"
+                command = f"cd {simulator_binary_dir} && time ./cxlsim ring:{shard_ring} q_{query} {trace_dir} > {trace_dir}/q_{query}/shard_{shard}.log\n"
+                file.write(command)
+        print(f"Start the shards with parallel -j {num_workers} < {trace_dir}/run_{query}.sh, then run the pintool with -ring {ring} -shards {num_workers}")
+        sys.exit(0)
+
     # First get the number of lines in the pinfile
     result = subprocess.run(f"cat {trace_file} | wc -l", shell=True, capture_output=True)
     num_lines = int(result.stdout.splitlines()[0])
@@ -0,0 +1,106 @@
+#ifndef __CXL_ANALYTICAL_H
+#define __CXL_ANALYTICAL_H
+
+#include <array>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+#include "message.h"
+
+namespace CXL
+{
+    //! Memory an access goes to
+    enum memory_tier
+    {
+        dam_tier = 0,
+        cxl_tier = 1,
+        NUM_TIERS = 2
+    };
+
+    //! Access counts of one table in one tier
+    typedef struct
+    {
+        uint64_t reads;
+        uint64_t writes;
+        uint64_t row_hits; /*!< Accesses to the row last opened in their bank*/
+    } table_stats;
+
+    /*!
+    Aggregated statistics of a window of the trace, all the analytical model needs to know about it
+    */
+    class TraceWindowStats
+    {
+    public:
+        TraceWindowStats();
+        void add(const message &m, uint64_t gap, memory_tier tier, int core);
+        uint64_t issue_ticks() const; /*!< Ticks the slowest core needs to execute the instructions of the window*/
+        table_stats tier_totals(memory_tier tier) const;
+
+        uint64_t accesses;
+        std::map<uint64_t, table_stats> tables[NUM_TIERS]; /*!< Keyed by table id, the same id the per table AMAT uses*/
+
+    private:
+        std::vector<uint64_t> core_instructions;     /*!< Instructions executed by every core in the window*/
+        std::array<std::array<uint64_t, 64>, NUM_TIERS> open_row; /*!< Most recently accessed row of every bank*/
+    };
+
+    //! What the analytical model predicts for a window
+    typedef struct
+    {
+        double amat[NUM_TIERS];                              /*!< Average access latency in ticks*/
+        std::map<uint64_t, double> table_amat[NUM_TIERS];    /*!< Average access latency of every table in ticks*/
+        double dram_latency[NUM_TIERS];                      /*!< Average time in the DRAM in ticks*/
+        double link_utilization[2];                          /*!< Utilization of the links towards the device and towards the host*/
+        double dram_utilization[NUM_TIERS];                  /*!< Utilization of the DRAM channels*/
+        int64_t ticks;                                       /*!< Duration of the window*/
+        bool saturated;                                      /*!< True if the link or the DRAM cannot keep up with the issue rate*/
+    } analytical_estimate;
+
+    /*!
+    Queueing network model of the path of an access: host VCs and packer, the host link, the switch, the device link and
+    the DRAM of the device or the direct attached DRAM.
+    Fixed delays come from CXLParams. Every link direction is an M/D/1 queue whose service time is the flit time times
+    the flits an access needs. At low load the packer sends flits that are mostly empty, the fill grows with the number
+    of slots that arrive while the packer waits for more. The DRAM is an M/D/1 queue per channel with a service
+    time set by the row buffer hit rate of the window. What the model does not capture (arbitration, credit stalls, DRAM
+    refresh and bank conflicts) is absorbed by a per tier correction that is calibrated against windows simulated in
+    detail. Every calibration window is first predicted with the correction of the earlier windows, the relative errors
+    of these predictions give the error bound
+    */
+    class CXLAnalytical
+    {
+    public:
+        CXLAnalytical();
+        analytical_estimate estimate(const TraceWindowStats &w) const;
+        /*!
+        \brief Calibrate the model against a window simulated in detail
+        \param measured_amat average latency of both tiers in ticks, only used for tiers that had accesses
+        */
+        void calibrate(const TraceWindowStats &w, const double *measured_amat);
+        double relative_error_bound(memory_tier tier) const; /*!< 95% bound of the relative AMAT error, from the calibration windows after the first, -1 if there are fewer than two*/
+        double mean_relative_error(memory_tier tier) const;
+        int calibration_windows(memory_tier tier) const { return errors[tier].size(); }
+        bool load(const std::string &filename);
+        void save(const std::string &filename) const;
+        void print() const;
+
+    private:
+        double dram_service(const table_stats &s) const; /*!< Mean DRAM access time of the accesses of s without queueing*/
+        double mm_wait(double utilization, double service) const; /*!< M/D/1 waiting time*/
+        double packing_efficiency(double slots_per_tick) const;   /*!< Fraction of the slots of a flit that are filled*/
+
+        double fixed_latency[NUM_TIERS]; /*!< Delays of the path without the DRAM and without queueing*/
+        double flit_ticks;               /*!< Time one flit takes on a link*/
+        double packer_wait_ticks;        /*!< Time the packer waits to fill a flit*/
+        double row_hit_ticks;
+        double row_miss_ticks;
+        double burst_ticks;              /*!< Time a 64B burst occupies a DRAM channel*/
+        int dram_channels;
+        double correction[NUM_TIERS];    /*!< Calibrated additive correction of the AMAT in ticks*/
+        std::vector<double> errors[NUM_TIERS]; /*!< Relative error of the prediction of every calibration window, including those of loaded calibrations*/
+        int run_windows[NUM_TIERS];      /*!< Calibration windows of this run, the correction is their mean residual*/
+    };
+}
+
+#endif
@@ -18,7 +18,7 @@ namespace CXL
     template <typename T>
     class CXLBuf
     {
-    private:
+    protected:
         int size_;
         std::deque<T> q_;
 
@@ -39,11 +39,27 @@ namespace CXL
         //typename std::vector<T>::iterator get_it();
     };
 
+    /*! Link layer replay buffer. Holds every transmitted protocol flit in sequence order until the receiver acknowledges it*/
     class CXLRETRYBuf : public CXLBuf<flit>
     {
-        // public:
-        //     int find_flit(int flit_id);
-        //     std::vector<flit> resend_flits(int flit_id);
+    public:
+        CXLRETRYBuf() : CXLBuf<flit>() {}
+        CXLRETRYBuf(int size) : CXLBuf<flit>(size) {}
+        //! Free the n oldest flits once the receiver has acknowledged them
+        void release(int n)
+        {
+            CXL_ASSERT(n <= buf_occupancy() && "Acknowledging more flits than were sent");
+            q_.erase(q_.begin(), q_.begin() + n);
+        }
+        //! All flits from sequence number seq onwards, in the order they have to be replayed
+        std::vector<flit> resend_flits(uint64_t seq)
+        {
+            std::vector<flit> flits;
+            for (const flit &f : q_)
+                if (f.header.seq >= seq)
+                    flits.push_back(f);
+            return flits;
+        }
     };
 
     template <typename T>
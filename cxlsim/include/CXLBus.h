@@ -3,10 +3,12 @@
 
 #include "flit.h"
 #include "CXLBuf.h"
+#include "CXLSampler.h"
 #include <memory>
 #include <string>
 #include <map>
 #include <deque>
+#include <random>
 // #include "CXLNode.h"
 
 namespace CXL
@@ -41,6 +43,20 @@ namespace CXL
         uint num_empty;
     } bus_timings;
 
+    //! Link layer retry counters for the flits carried by one bus
+    typedef struct
+    {
+        uint64_t flits_sent;          /*!< Protocol flits put on the bus, including replays*/
+        uint64_t flits_accepted;      /*!< Protocol flits that passed CRC in sequence and were handed to the receiver*/
+        uint64_t crc_errors;          /*!< Flits that failed CRC*/
+        uint64_t flits_discarded;     /*!< Out of sequence flits dropped by the receiver while it waits for a replay*/
+        uint64_t flits_replayed;      /*!< Flits sent again from the retry buffer*/
+        uint64_t retry_requests;      /*!< RETRY control flits sent back to the transmitter*/
+        uint64_t acks_piggybacked;    /*!< Acks returned in the header of a flit going the other way*/
+        uint64_t control_flits;       /*!< ACK and RETRY control flits carried by this bus*/
+        uint64_t retry_buf_full_ticks; /*!< Ticks the transmitter was held back by a full retry buffer*/
+    } llr_stats;
+
     class CXLBus
     {
     private:
@@ -54,13 +70,36 @@ namespace CXL
         uint to_node_id;   /*!< Node id of the CXL Node which will receive flits from the bus*/
         direction dir;
         std::map<uint64_t, bus_timings> timing_tracker; /*!< To store metrics on flits passing through the bus*/
+
+        // Link layer retry, only active when params.link_ber is non zero
+        bool llr_enabled;
+        CXLBus *reverse;              /*!< Bus going the other way on the same link. Carries the ACKs and RETRY requests for the flits on this bus*/
+        CXLRETRYBuf retry_buf;        /*!< Transmitted flits waiting to be acknowledged*/
+        std::deque<flit> replay_queue; /*!< Flits from the retry buffer waiting to be sent again*/
+        std::deque<flit> control_queue; /*!< Control flits waiting to be sent, they go ahead of replays and regular flits*/
+        uint64_t next_seq;            /*!< Sequence number of the next new flit the transmitter sends*/
+        uint64_t expected_seq;        /*!< Sequence number the receiver accepts next*/
+        int unacked;                  /*!< Flits accepted by the receiver that have not been acknowledged yet*/
+        int64_t oldest_unacked_tick;  /*!< Tick at which the oldest unacknowledged flit was accepted*/
+        int64_t time_of_last_add;     /*!< Tick at which a flit was last put on the bus*/
+        double flit_error_rate;       /*!< Probability that a flit fails CRC, derived from the bit error rate*/
+        std::mt19937_64 rng;
+        void put_on_bus(flit &f);
+        bool link_has_room();
+        bool link_layer_accept(const flit &f);
+        void llr_update();
+        void queue_control(llr_control ctrl, uint64_t value);
+        void receive_control(const flit &f);
+        void release_acked(int n);
+        void replay_from(uint64_t seq);
+
     public:
         int64_t time_of_last_dequeue; /*!< Tick at which last dequeue occured*/
 
         bus_terminals bus_type;
 
         // Constructor and destructor
-        CXLBus(){};
+        CXLBus() : llr_enabled(false), reverse(NULL){};
         CXLBus(int size, uint node_id, direction d);
 
         // Connect nodes
@@ -98,6 +137,11 @@ namespace CXL
         uint node_id; /*!< Unique ID assigned to every single instantiated object in the main loop*/
 
         void dump_data();
+
+        llr_stats llr;
+        void set_reverse(CXLBus *reverse);
+        void print_link_stats();
+        void sample(CXLSampler &s);
     };
 }
 #endif
\ No newline at end of file
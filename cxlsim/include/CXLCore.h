@@ -0,0 +1,65 @@
+#ifndef __CXL_CORE_H
+#define __CXL_CORE_H
+
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include "message.h"
+#include "CXLBuf.h"
+#include "TraceRing.h"
+
+namespace CXL
+{
+    /*!
+    Front end of one core of a host.
+    Every core reads the trace of one thread from a file or a trace ring and keeps its own instruction clock, and with
+    the core model its own ROB window and MSHRs. The cores of a host share its VCs, credits, prefetcher and DAM
+    */
+    class CXLCore
+    {
+    public:
+        CXLCore();
+        void set_trace_file(const std::string &filename);
+        bool set_trace_ring(const std::string &filename, uint64_t capacity);
+        bool read_trace_entry(uint64_t &gap, message &m); /*!< Next access of the trace file or ring, false at its end*/
+        bool refill();                                    /*!< Read the next access into the buffer if there is space, false once the trace has ended*/
+        bool take_entry(uint64_t &gap, message &m);       /*!< Take the next access out of the buffer or the trace without issuing it, false at the end of the trace*/
+        bool is_done() { return is_trace_finished && text_to_trace_buf.is_buf_empty(); }
+
+        int64_t ticks_since_issue() const; /*!< Ticks the core executed since its most recent access was issued, without the ticks it stalled*/
+        int64_t ticks_to_next_issue();     /*!< Ticks until the access at the head of the buffer is due, 0 if it is due or the buffer is empty*/
+        bool is_due();                     /*!< True if the gap of the access at the head of the buffer has passed*/
+        void start_issue();                /*!< Restart the instruction clock, called whenever the head is taken out*/
+        void resume();                     /*!< Restart the instruction clock after the host skipped a part of the trace*/
+
+        // Core model
+        bool core_stalled();
+        void core_dispatch(const message &m, uint64_t gap);
+        void core_issued(const message &m, uint64_t gap);
+        bool core_retire(uint64_t msg_id); /*!< Remove a completed demand load from the window, false if it is not one of this core's*/
+
+        CXLBuf<std::pair<uint64_t, message>> text_to_trace_buf; /*!< Accesses read from the trace with the number of cpu instructions executed before each of them*/
+        std::unique_ptr<TraceRing> trace_ring;                  /*!< Shared memory ring the trace is streamed through, nullptr when reading trace_in*/
+        uint64_t trace_entries_read;                            /*!< Number of trace lines or ring records read so far*/
+
+        // Core model
+        uint64_t core_instructions;    /*!< Instruction index of the most recently issued access, counting non memory instructions only*/
+        uint64_t core_accesses;        /*!< Number of accesses issued*/
+        int64_t core_stall_ticks[3];   /*!< Stall ticks because of a full ROB, no free MSHR and a load to use dependency*/
+
+    private:
+        std::ifstream trace_in;
+        bool is_trace_finished;
+        int64_t last_text_to_trace_buf_dequeue; /*!< Tick at which the most recent access left the buffer*/
+        std::map<uint64_t, uint64_t> core_window;       /*!< Outstanding demand loads, instruction index (memory and non memory) to msg id. The oldest one holds back the ROB*/
+        std::map<uint64_t, uint64_t> core_window_index; /*!< Outstanding demand loads, msg id to instruction index*/
+        uint64_t core_last_load;                        /*!< msg id of the most recently issued demand load*/
+        int64_t core_stall_since_issue;                 /*!< Ticks the core stalled since the most recent access was issued, they do not count towards the next gap*/
+        int64_t core_last_tick;                         /*!< Tick of the last stall check*/
+    };
+}
+
+#endif
@@ -0,0 +1,43 @@
+#ifndef __CXL_HYBRID_H
+#define __CXL_HYBRID_H
+
+#include <cstdint>
+#include "CXLNode.h"
+#include "CXLAnalytical.h"
+
+namespace CXL
+{
+    /*!
+    Hybrid simulation of a host: out of every period accesses of the trace, the first window accesses are simulated in
+    detail and the rest is estimated by the analytical model. Every detailed window calibrates the model before the
+    following accesses are estimated, so the model follows the phases of the trace
+    */
+    class CXLHybrid
+    {
+    public:
+        CXLHybrid(CXLHost &host, CXLAnalytical &model, uint64_t window, uint64_t period);
+        void update(); /*!< Call after every tick, switches to the analytical model once a detailed window has drained*/
+        void print();
+
+    private:
+        void begin_window();
+        void end_window();
+        void fast_forward();
+
+        CXLHost &host;
+        CXLAnalytical &model;
+        uint64_t window;
+        uint64_t period;
+        TraceWindowStats stats;           /*!< Accesses issued in the current detailed window*/
+        double count_before[NUM_TIERS];   /*!< Completed accesses of every tier when the window started*/
+        double sum_before[NUM_TIERS];     /*!< Sum of their latencies*/
+        uint64_t detailed_accesses;
+        uint64_t analytical_accesses[NUM_TIERS];
+        double analytical_latency[NUM_TIERS]; /*!< Sum of the estimated latencies of the analytical accesses*/
+        int64_t analytical_ticks;
+        int windows;
+        bool saturated;                   /*!< True if the model saw a saturated queue in any of the estimated parts*/
+    };
+}
+
+#endif
@@ -14,12 +14,22 @@
 #include "CXLBus.h"
 #include "CXLBuf.h"
 #include "RamDevice.h"
+#include "CXLPrefetcher.h"
+#include "CXLQoS.h"
+#include "CXLSampler.h"
+#include "CXLTimeline.h"
+#include "CXLWriteBuffer.h"
+#include "CXLSnoopFilter.h"
+#include "CXLCore.h"
+#include "CXLAnalytical.h"
 #include <utility>
 #include <map>
 #include <list>
 #include <algorithm>
 #include <fstream>
 #include <sstream>
+#include <memory>
+#include <random>
 
 // class RamDevice;
 
@@ -94,7 +104,6 @@ namespace CXL
         */
         virtual bool CRC(flit f) = 0;
         int packer_cur_vc;
-        CXLRETRYBuf resend_buf; /*!<Buffer storing flits for resending*/
         CXLBus *tx_bus;         /*!< tx bus pointer, set by the connect function */
         CXLBus *rx_bus;         /*!< rx bus pointer, set by the connect function */
         int64_t counter;        /*!< counter to keep track of the correspondence of message */
@@ -121,7 +130,8 @@ namespace CXL
         void connect_rx(CXLBus *bus);
         std::map<int, credits> *get_cred();
         bool text_to_trace();
-        void set_trace_file(std::string filename);
+        void set_trace_file(std::string filename, int core = 0);
+        bool set_trace_ring(std::string filename, uint64_t capacity, int core = 0); /*!< Read the trace from a shared memory ring fed by the pintool instead of a file*/
         std::map<uint64_t, message> messages_sent_to_device; /*!< Map with a list of all messages sent to the devices with msg_id as key*/
         std::map<uint64_t, msg_timing> timing_tracker;       /*!< To store the timing parameters of all the completed memory accesses*/
         std::vector<uint64_t> latency_data;
@@ -156,6 +166,33 @@ namespace CXL
         std::map<uint64_t, std::pair<uint64_t,double>> amat_per_table_dam;
         std::map<uint64_t, double[3]> amat_per_table_cxl;
 
+        prefetch_stats pf_stats;     /*!< Prefetch accounting, only updated if a prefetcher is configured*/
+        void print_prefetch_stats();
+        bool has_buffered_writes() const { return write_buffer != nullptr && !write_buffer->is_empty(); } /*!< Posted writes that have not gone to the device yet*/
+        void print_write_buffer_stats();
+
+        uint64_t qos_throttle_reject_ctr;      /*!< Packer checks that found the head of a VC held back by throttling*/
+        double amat_per_tc[NUM_TC][2];         /*!< Completed accesses and average latency of every traffic class*/
+        void print_qos_stats();
+        void print_trace_ring_stats();
+        void print_core_stats(std::ofstream &out);
+        void core_retire(uint64_t msg_id); /*!< Remove a completed demand load from the window of the core that issued it*/
+        bool trace_finished() const { return is_trace_finished; } /*!< True once the traces of all cores have been read and issued*/
+        uint64_t trace_entries() const;                           /*!< Number of trace lines or ring records read so far by all cores*/
+        int num_cores() const { return cores.size(); }
+
+        // Fast mode
+        void set_issue_budget(int64_t accesses) { issue_budget = accesses; } /*!< The cores stop issuing after this many more accesses*/
+        int64_t issue_budget_left() const { return issue_budget; }
+        void set_issue_stats(TraceWindowStats *stats) { issue_stats = stats; } /*!< Add every issued access to stats, nullptr stops it*/
+        uint64_t fast_forward(uint64_t accesses, TraceWindowStats &w);         /*!< Take accesses out of the traces without simulating them, returns how many there were*/
+        void account_estimate(const TraceWindowStats &w, const analytical_estimate &e); /*!< Count accesses skipped by fast_forward as completed with their estimated latency*/
+        void tier_latency(double *count, double *sum);                       /*!< Completed accesses and the sum of their latencies per memory tier*/
+
+        std::map<uint64_t, uint64_t> latency_histogram; /*!< Latency of completed CXL accesses, bucketed to about 1% precision*/
+        void print_latency_tail();
+        void sample(CXLSampler &s);
+
     protected:
         std::map<uint64_t, std::pair<uint64_t, uint64_t>> address_intervals; /*!< Stores the address mapping for different devices*/
         int64_t latency_counter;                                             /*!< increment after every tick*/
@@ -180,6 +217,31 @@ namespace CXL
         // bool get_next_message_to_transmit(std::vector<message>::iterator &it, bool &nothing_more_to_send);
         void get_msg_from_vcs(CXLBuf<message> *&vc, bool &valid);
         void add_flit_to_buf(flit &f);
+        void retire_demand(message &m);
+        bool issue_from_core(int c);
+        memory_tier tier_of(uint64_t addr) { return DAM != nullptr && addr >= DAM_addr.first && addr < DAM_addr.second ? dam_tier : cxl_tier; }
+        bool is_cxl_address(uint64_t addr);
+
+        // Prefetcher
+        bool prefetch_lookup(message &m);
+        void train_prefetcher(uint64_t addr, int traffic_class);
+        bool issue_prefetch();
+        void prefetch_arrived(message &m);
+        bool make_room_in_prefetch_table();
+        void erase_from_prefetch_table(std::map<uint64_t, prefetch_entry>::iterator entry);
+
+        // Write buffer
+        bool write_drain_due();
+        bool drain_write_buffer();
+
+        // Back invalidation
+        bool pack_birsp(int i);
+
+        // QoS
+        int select_vc(const message &m, int cur_vc);
+        bool is_throttled(const message &m, uint dest);
+
+        void update_throttle(const message &m);
 
     private:
         std::vector<ramulator::RamDevice*> device_memories;
@@ -189,6 +251,7 @@ namespace CXL
         int cur_RWD_vc;
         CXLBuf<message> S2M_NDR; /*!<S2M NDR virtual channel, connect to tx*/
         CXLBuf<message> S2M_DRS; /*!<S2M_DRS virtual channel, connect to tx*/
+        CXLBuf<message> S2M_BISnp; /*!<Received BISnp messages, each is answered with a BIRsp once the host has invalidated the line*/
         round_robin_state packer_state;
         int unpacker_rollover;
         int packer_rollover;
@@ -198,12 +261,14 @@ namespace CXL
         flit tmp_unfilled_flit;                                 // tmp flit
         int64_t last_transmitted_at;                            // Tick at which last tx_buf->bus transaction happened
         bool trace_line_pending;                                // True if a line was read from trace file last tick but not put on the VCs yet
-        ifstream trace_in;                                      // ifstream buffer pointed to the trace file
+        std::vector<CXLCore> cores;                             // Front ends of the cores, each one reads the trace of one thread
+        size_t next_core;                                       // Core that gets to issue first in the next tick
+        int64_t issue_budget;                                   // Accesses the cores may still issue, see set_issue_budget
+        TraceWindowStats *issue_stats;                          // Statistics of the issued accesses for the analytical model, nullptr if not needed
         round_robin_state rcvd_rsp_state;                       // Round robin state for processing received responses
         message last_drs_hdr;                                   // Termporary variable to store the most recent drs_hdr
         message last_rwd_hdr;                                   // Termporary variable to store the most recent rwd_hdr
-        bool is_trace_finished;                                 // True means all requests in trace file have been converted into messages and put onto the VCs
-        CXLBuf<std::pair<uint64_t, message>> text_to_trace_buf; /*!< Buffer to keep all newly formed messages before they are put on the virtual channels. It also keeps the numer of cpu instructions executed before this access*/
+        bool is_trace_finished;                                 // True means all requests in the trace files of all cores have been converted into messages and put onto the VCs
 
         // Packer2
         bool is_packer_waiting;
@@ -214,7 +279,17 @@ namespace CXL
         // int num_read_ports;
         round_robin_state pkr2_state;
         uint device_under_consideration;       /*!< Node id of the device we are packing stuff to*/
-        int64_t last_text_to_trace_buf_dequeue; /*!< Counter which gatekeeps when a message from text_to_trace_buf reaches VC. It keeps track of tick at which the most recent message moved from text_to_trace_buf to the VC*/
+
+        // Prefetcher
+        std::unique_ptr<CXLPrefetcher> prefetcher;                     /*!< Host prefetcher, nullptr if prefetching is disabled*/
+        CXLBuf<message> prefetch_queue;                                /*!< Prefetches waiting for space in the M2S Req VCs*/
+        std::map<uint64_t, prefetch_entry> prefetch_table;             /*!< Prefetched lines that are in flight or have arrived but not been used yet*/
+        std::list<uint64_t> prefetch_table_order;                      /*!< Lines in the order they were added to the prefetch table, used for replacement*/
+        std::map<uint64_t, std::vector<message>> merged_demands;       /*!< Demand reads waiting on an in flight prefetch to the same line*/
+
+        std::unique_ptr<CXLWriteBuffer> write_buffer;                  /*!< Write combining buffer for posted writes, nullptr if writes go straight to the VCs*/
+
+        std::map<uint, qos_throttle_state> throttle;                   /*!< Throttling state per device, driven by the DevLoad of its responses*/
     };
 
     //! Struct to keep track of reqs that have been sent to ramulator and are yet to be completed
@@ -224,6 +299,14 @@ namespace CXL
         int counter;
     } req_sent_to_ramulator;
 
+    //! Request in a device M2S VC that has to wait for back invalidations before it can go to the DRAM
+    typedef struct
+    {
+        int64_t since;                /*!< Tick the request reached the head of its VC and had to wait, -1 before*/
+        int64_t peer_snoop_done;      /*!< Tick the back invalidations of peer hosts complete*/
+        std::vector<uint64_t> lines;  /*!< Lines whose BISnp the host has to answer first*/
+    } coherence_wait;
+
     /*!
     CXL Device class
     */
@@ -262,6 +345,14 @@ namespace CXL
         int ndr_ctr, drs_ctr;
         // int num_read_ports;
         round_robin_state pkr2_state;
+        WeightedArbiter packer_arb; /*!< Arbitrates between the traffic classes of the packable S2M VC heads*/
+
+        // Back invalidation
+        std::unique_ptr<CXLSnoopFilter> snoop_filter;           /*!< Snoop filter, nullptr if coherence is not modeled*/
+        CXLBuf<message> S2M_BISnp;                              /*!< BISnp messages waiting to be packed*/
+        std::map<uint64_t, int> lines_being_invalidated;        /*!< Lines with BISnp messages the host has not answered yet*/
+        std::map<uint64_t, coherence_wait> coherence_waits;     /*!< Requests waiting for back invalidations, by message id*/
+        std::mt19937_64 bi_rng;                                 /*!< Draws which new lines peer hosts cache*/
 
     public:
         bool check_connection();
@@ -286,6 +377,9 @@ namespace CXL
         uint64_t empty_cycle_transmit;
         uint64_t skippable_cycle;
         uint64_t num_reqs;
+        uint64_t dev_load_reported[4]; /*!< Number of responses sent with every DevLoad value*/
+        void sample(CXLSampler &s);
+        void print_coherence_stats();
 
     protected:
         // bool check_send() override { return 0; };
@@ -323,6 +417,10 @@ namespace CXL
         CXLBuf<ram_msg> ram_device_buf; /*!<buffer from ram 2 device */
         std::vector<uint64_t> connected_hosts;
         bool check_rx_vc(CXLBuf<message> &);
+        void coherence_lookup(const message &m);
+        bool coherence_ready(const message &m);
+        bool pack_bisnp(int i);
+        void birsp_received(const message &m);
         type_packed free_allocation(slot &s);
         credits get_Device_credits();
         bool check_vcs_for_packing(std::array<CXLBuf<message>, NUM_VC> &vcs, CXLBuf<message> *&vc);
@@ -331,6 +429,8 @@ namespace CXL
         void credit_sanity_check();
         credits get_device_credits();
         uint destination_device(uint64_t addr);
+        int current_dev_load();
+        void report_dev_load(message &m);
     };
 }
 
@@ -3,6 +3,8 @@
 
 #include <cstdint>
 
+#define NUM_TC 4 /*!< Number of traffic classes arbitrated by the switch and device packers. Class 0 has the highest priority*/
+
 namespace CXL
 {
     class CXLParams
@@ -27,6 +29,60 @@ namespace CXL
         int64_t delay_cxl_port_switch_ns;
         float ramulator_update_delay_ns;
 
+        // Host prefetcher
+        int prefetcher;               /*!< Type of host prefetcher, see prefetcher_type. 0 disables prefetching*/
+        int prefetch_degree;          /*!< Number of prefetches generated per trigger*/
+        int prefetch_distance;        /*!< Number of lines ahead of the demand stream the first prefetch is*/
+        int prefetch_queue_size;      /*!< Prefetches waiting for space in the M2S Req VCs*/
+        uint64_t prefetch_table_size; /*!< Number of prefetched lines the host can track (in flight and arrived)*/
+
+        // QoS
+        int tc_weights[NUM_TC];   /*!< Arbitration weight of every traffic class in the switch and device packers*/
+        int devload_optimal;      /*!< Device queue occupancy at which the device starts reporting optimal load*/
+        int devload_moderate;     /*!< Device queue occupancy at which the device starts reporting moderate overload*/
+        int devload_severe;       /*!< Device queue occupancy at which the device starts reporting severe overload*/
+        int qos_throttle;         /*!< 1 enables host side throttling driven by the DevLoad field of responses*/
+        int qos_throttle_min_tc;  /*!< Only traffic classes >= this are throttled, lower classes are never held back*/
+        int qos_window_min;       /*!< Minimum number of outstanding throttled requests per device*/
+        int qos_window_max;       /*!< Maximum (and initial) number of outstanding throttled requests per device*/
+
+        // Link layer retry
+        double link_ber;            /*!< Bit error rate of every link. 0 disables CRC error injection and the link layer retry model*/
+        int llr_buf_size;           /*!< Number of unacknowledged flits a transmitter can hold in its retry buffer*/
+        int llr_ack_margin;         /*!< Free retry buffer entries of the transmitter below which received flits get an explicit ACK*/
+        int64_t llr_ack_timeout_ns; /*!< Max time received flits wait for reverse traffic to piggyback their ack on before an explicit ACK is sent*/
+        uint64_t llr_seed;          /*!< Seed for the error injection, every bus adds its node id*/
+
+        // Core model
+        int core_model; /*!< 1 makes the host issue the trace through a ROB window and a limited number of MSHRs instead of purely by instruction gaps*/
+        int rob_size;   /*!< Instructions in flight behind the oldest outstanding demand load before the core stops issuing*/
+        int num_mshrs;  /*!< Outstanding demand loads (line fill buffers) the core can have*/
+
+        // Time series sampling
+        int64_t sample_interval; /*!< Ticks between two samples of credits and buffer depths. 0 disables sampling*/
+        int sample_buffer_rows;  /*!< Samples kept in memory before they are written out*/
+
+        // Write buffer
+        int write_buffer_size;  /*!< Lines in the host write combining buffer. 0 sends writes straight to the VCs and completes them on the NDR*/
+        int write_buffer_high;  /*!< Buffered lines at which the watermark policy starts draining*/
+        int write_buffer_low;   /*!< Buffered lines at which it stops*/
+        int write_drain_policy; /*!< See write_drain_policy*/
+        float dram_write_high;  /*!< Fraction of the write queue at which the DRAM controllers switch to writes*/
+        float dram_write_low;   /*!< Fraction at which they switch back to reads*/
+
+        // Message timeline
+        uint64_t timeline_sample; /*!< Record the lifecycle of one out of this many messages. 0 disables the timeline*/
+        int64_t timeline_start;   /*!< Only record messages created in [timeline_start, timeline_end)*/
+        int64_t timeline_end;
+
+        // Back invalidation
+        int bi_snoop_filter;        /*!< Lines tracked by the snoop filter of every device. 0 disables coherence*/
+        int bi_snoop_filter_ways;   /*!< Associativity of the snoop filter*/
+        double bi_peer_share;       /*!< Probability that a line entering the snoop filter is already cached by a peer host*/
+        int64_t bi_host_snoop_ns;   /*!< Time the host takes to invalidate a line before it sends the BIRsp*/
+        int64_t bi_peer_snoop_ns;   /*!< Round trip of a back invalidation of a peer host, including its snoop*/
+        uint64_t bi_seed;           /*!< Seed for the peer sharing draws, every device adds its node id*/
+
 
         int bus_size;
         int64_t cxl_bus_total_latency;     /*!< Time taken to in ns to travel the bus*/
@@ -40,6 +96,9 @@ namespace CXL
         int64_t delay_vc_to_retire;
         int64_t delay_cxl_port_switch;
         int64_t delay_cxl_noc_switch;
+        int64_t llr_ack_timeout;
+        int64_t bi_host_snoop;
+        int64_t bi_peer_snoop;
 
 
 
@@ -0,0 +1,117 @@
+#ifndef __CXL_PREFETCHER_H
+#define __CXL_PREFETCHER_H
+
+#include <cstdint>
+#include <vector>
+#include <deque>
+#include <list>
+#include <map>
+#include <string>
+
+namespace CXL
+{
+    //! Types of host side hardware prefetchers that can sit in front of the M2S Req VCs
+    enum prefetcher_type
+    {
+        no_prefetcher = 0,
+        next_line = 1,
+        stride = 2,
+        region = 3
+    };
+
+    //! State of a prefetched cacheline in the prefetch table
+    enum prefetch_state
+    {
+        in_flight,
+        arrived
+    };
+
+    //! Entry of the prefetch table. order points at the line in the replacement order, so both can be updated together
+    typedef struct
+    {
+        prefetch_state state;
+        std::list<uint64_t>::iterator order;
+    } prefetch_entry;
+
+    //! Counters used for late/useless prefetch accounting
+    typedef struct
+    {
+        uint64_t triggers;      /*!< Number of demand accesses the prefetcher was trained on*/
+        uint64_t generated;     /*!< Number of candidate addresses generated by the prefetcher*/
+        uint64_t filtered;      /*!< Candidates dropped because they were already tracked or outside the CXL address range*/
+        uint64_t dropped;       /*!< Candidates dropped because the prefetch queue or prefetch table was full*/
+        uint64_t issued;        /*!< Prefetches put on the M2S Req VCs*/
+        uint64_t useful;        /*!< Demand reads that found their line already prefetched*/
+        uint64_t late;          /*!< Demand reads that found their line still in flight*/
+        uint64_t useless;       /*!< Prefetched lines evicted from the prefetch table without being used*/
+        uint64_t demand_misses; /*!< Demand reads that had to go to the device*/
+    } prefetch_stats;
+
+    /*!
+    Abstract host prefetcher. It is trained on the demand address stream and returns the cacheline addresses to prefetch
+    */
+    class CXLPrefetcher
+    {
+    public:
+        CXLPrefetcher(int degree, int distance) : degree(degree), distance(distance) {}
+        virtual ~CXLPrefetcher() {}
+        /*!
+        \brief Train on a demand access and append the addresses to prefetch to candidates
+        \param addr cacheline aligned demand address
+        \param candidates vector to which prefetch addresses are appended
+        */
+        virtual void train(uint64_t addr, std::vector<uint64_t> &candidates) = 0;
+        virtual std::string name() = 0;
+
+    protected:
+        int degree;   /*!< Number of prefetches generated per trigger*/
+        int distance; /*!< How many lines ahead of the demand stream the first prefetch is*/
+    };
+
+    //! Prefetches the lines following the demand access
+    class NextLinePrefetcher : public CXLPrefetcher
+    {
+    public:
+        NextLinePrefetcher(int degree, int distance) : CXLPrefetcher(degree, distance) {}
+        void train(uint64_t addr, std::vector<uint64_t> &candidates) override;
+        std::string name() override { return "next-line"; }
+    };
+
+    //! IP-less stream prefetcher. Tracks strides per page and prefetches once a stride is seen twice in a row
+    class StridePrefetcher : public CXLPrefetcher
+    {
+    public:
+        StridePrefetcher(int degree, int distance, size_t num_streams) : CXLPrefetcher(degree, distance), num_streams(num_streams) {}
+        void train(uint64_t addr, std::vector<uint64_t> &candidates) override;
+        std::string name() override { return "stride"; }
+
+    private:
+        typedef struct
+        {
+            uint64_t last_addr;
+            int64_t stride;
+            int confidence;
+        } stream_entry;
+        size_t num_streams;                         /*!< Max number of pages tracked at the same time*/
+        std::map<uint64_t, stream_entry> streams;   /*!< Stream table with the page number as key*/
+        std::deque<uint64_t> lru;                   /*!< Page numbers in order of allocation, used to replace streams*/
+    };
+
+    //! Spatial region prefetcher. On the first access to a region it prefetches the rest of the region
+    class RegionPrefetcher : public CXLPrefetcher
+    {
+    public:
+        RegionPrefetcher(int degree, int distance, int region_size, size_t num_regions) : CXLPrefetcher(degree, distance), region_size(region_size), num_regions(num_regions) {}
+        void train(uint64_t addr, std::vector<uint64_t> &candidates) override;
+        std::string name() override { return "region"; }
+
+    private:
+        int region_size;                  /*!< Size of a region in bytes*/
+        size_t num_regions;               /*!< Number of recently triggered regions remembered to avoid retriggering*/
+        std::deque<uint64_t> recent;      /*!< Recently triggered region numbers*/
+    };
+
+    CXLPrefetcher *make_prefetcher(int type, int degree, int distance);
+}
+
+#endif
@@ -0,0 +1,50 @@
+#ifndef __CXL_QOS_H
+#define __CXL_QOS_H
+
+#include <cstdint>
+#include <vector>
+#include "CXLParams.h"
+
+namespace CXL
+{
+    //! DevLoad values a device reports in its responses, as defined by the CXL.mem QoS telemetry
+    enum dev_load_type
+    {
+        light_load = 0,
+        optimal_load = 1,
+        moderate_overload = 2,
+        severe_overload = 3
+    };
+
+    //! Host side throttling state kept per device
+    typedef struct
+    {
+        int window;         /*!< Max number of outstanding requests of throttled traffic classes*/
+        int outstanding;    /*!< Requests of throttled traffic classes packed but not yet responded to*/
+        int since_decrease; /*!< Responses received since the window was last closed*/
+    } qos_throttle_state;
+
+    /*!
+    Smooth weighted round robin arbiter over NUM_TC traffic classes.
+    Every pick each ready class earns its weight, the richest class wins and pays back the total weight of the ready classes.
+    This interleaves the classes in proportion to their weights instead of serving them in bursts
+    */
+    class WeightedArbiter
+    {
+    public:
+        WeightedArbiter();
+        WeightedArbiter(const int *weights);
+        /*!
+        \brief Pick one of the ready traffic classes
+        \param ready ready[tc] is true if class tc has something to send
+        \return the chosen traffic class, -1 if no class is ready
+        */
+        int pick(const std::vector<bool> &ready);
+
+    private:
+        std::vector<int> weights;
+        std::vector<int64_t> current; /*!< Accumulated weight of every class*/
+    };
+}
+
+#endif
@@ -0,0 +1,55 @@
+#ifndef __CXL_SAMPLER_H
+#define __CXL_SAMPLER_H
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace CXL
+{
+    /*!
+    Time series sampler for credits, buffer depths and stall counters.
+    Every params.sample_interval ticks each component adds its columns to a row. Rows go into a fixed size ring buffer
+    that is written out as one CSV column per metric whenever it fills up, so sampling never touches the file system
+    */
+    class CXLSampler
+    {
+    public:
+        CXLSampler();
+        /*!
+        \brief Start sampling into the given file
+        \param filename output csv
+        \param interval number of ticks between samples
+        \param rows number of rows buffered before they are written out
+        */
+        void open(const std::string &filename, int64_t interval, int rows);
+        void close();
+        bool is_due(); /*!< True if sampling is enabled and a sample is due this tick*/
+        void begin_row();
+        void set_prefix(const std::string &prefix); /*!< Prefix for the column names added next, e.g. the component name*/
+        void add(const char *name, int64_t value);
+        void end_row();
+        int num_columns() const { return num_cols; }
+        const std::string &column_name(int i) const { return names[i]; }
+        int64_t last_value(int i) const; /*!< Value of column i in the row that was taken last*/
+
+    private:
+        void flush();
+        bool enabled;
+        std::ofstream out;
+        int64_t interval;
+        int64_t last_sample_tick;
+        std::string prefix;
+        std::vector<std::string> names; /*!< Column names, collected while the first row is built*/
+        bool header_written;
+        int num_cols;
+        int col;                        /*!< Column being filled in the current row*/
+        std::vector<int64_t> ring;      /*!< rows x num_cols values, row major*/
+        int capacity;                   /*!< Number of rows the ring can hold*/
+        int head;                       /*!< Oldest row not written out yet*/
+        int count;                      /*!< Number of rows not written out yet*/
+    };
+}
+
+#endif
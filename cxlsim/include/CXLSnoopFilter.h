@@ -0,0 +1,73 @@
+#ifndef __CXL_SNOOP_FILTER_H
+#define __CXL_SNOOP_FILTER_H
+
+#include <cstdint>
+#include <vector>
+
+namespace CXL
+{
+    //! Sharer bit of the host connected through the switch. Higher bits stand for the peer hosts that are not simulated
+    const uint64_t HOST_SHARER = 1;
+    const uint64_t PEER_SHARERS = ~HOST_SHARER;
+
+    //! Line that had to leave the snoop filter, its sharers have to be back invalidated
+    typedef struct
+    {
+        uint64_t line;
+        uint64_t sharers;
+    } snoop_filter_victim;
+
+    //! Snoop filter and back invalidation accounting
+    typedef struct
+    {
+        uint64_t lookups;        /*!< Requests that looked up the filter*/
+        uint64_t hits;           /*!< Lookups that found the line tracked already*/
+        uint64_t evictions;      /*!< Tracked lines that were replaced to make room*/
+        uint64_t bisnp;          /*!< BISnp messages sent to the host*/
+        uint64_t birsp;          /*!< BIRsp messages received from the host*/
+        uint64_t peer_snoops;    /*!< Back invalidations of peer hosts*/
+        uint64_t blocked;        /*!< Requests that waited for a back invalidation before going to the DRAM*/
+        uint64_t blocked_ticks;  /*!< Ticks these requests waited in total*/
+    } snoop_filter_stats;
+
+    /*!
+    Inclusive device snoop filter for CXL.mem back invalidation (HDM-DB).
+    Set associative with LRU replacement. Every tracked line keeps a bit mask of the hosts that may cache it. Replacing
+    a line that still has sharers forces the device to back invalidate them before the new line can be granted
+    */
+    class CXLSnoopFilter
+    {
+    public:
+        CXLSnoopFilter(int entries, int ways);
+        bool lookup(uint64_t line);                                           /*!< True if the line is tracked, counts the lookup*/
+        uint64_t sharers(uint64_t line) const;                                /*!< Sharers of a tracked line, 0 if it is not tracked*/
+        /*!
+        \brief Add sharers to a line, allocating it if needed
+        \param victim set to the line that was replaced, if any
+        \return true if a line with sharers was replaced
+        */
+        bool add_sharers(uint64_t line, uint64_t sharers, snoop_filter_victim &victim);
+        void remove_sharers(uint64_t line, uint64_t sharers);                 /*!< Lines without sharers stop being tracked*/
+        int capacity() const { return sets * ways; }
+
+        snoop_filter_stats stats;
+
+    private:
+        typedef struct
+        {
+            uint64_t line;
+            uint64_t sharers;  /*!< 0 means the way is free*/
+            uint64_t last_use; /*!< For LRU*/
+        } snoop_filter_entry;
+
+        snoop_filter_entry *find(uint64_t line);
+        const snoop_filter_entry *find(uint64_t line) const;
+
+        int sets;
+        int ways;
+        uint64_t use_counter;
+        std::vector<snoop_filter_entry> entries; /*!< sets x ways, the ways of a set are next to each other*/
+    };
+}
+
+#endif
@@ -10,10 +10,19 @@
 #include <iostream>
 #include "CXLBuf.h"
 #include "CXLBus.h"
+#include "CXLQoS.h"
 #include <map>
+#include <array>
 
 namespace CXL
 {
+    //! Keeps the data flits of an RwD/DRS in the same traffic class queue as their header and stops the arbiter from interleaving other classes in between
+    typedef struct
+    {
+        int rollover; /*!< Data slots still expected for the last header*/
+        int tc;       /*!< Traffic class the header was classified into*/
+    } tc_lock;
+
     /*! One host version switch */
     class CXLSwitch
     {
@@ -32,6 +41,7 @@ namespace CXL
         uint node_id;
         bool check_transmission(uint64_t l_t, CXLBus *);
         void dump_latency();
+        void sample(CXLSampler &s);
 
     private:
         uint64_t previous_destination;
@@ -46,8 +56,14 @@ namespace CXL
         CXLBus *bus_from_host;
         uint64_t num_devices;
         // uint8_t RR_state; // round robin not implement, need further consideration
-        CXLBuf<flit> ARB_NOC_h2d;
-        CXLBuf<flit> ARB_NOC_d2h;
+        std::array<CXLBuf<flit>, NUM_TC> ARB_NOC_h2d; /*!< One arbitration queue per traffic class*/
+        std::array<CXLBuf<flit>, NUM_TC> ARB_NOC_d2h;
+        WeightedArbiter h2d_arb;
+        WeightedArbiter d2h_arb;
+        tc_lock h2d_in, h2d_out, d2h_in, d2h_out;
+        int classify(tc_lock &lock, const flit &f);
+        int arbitrate(std::array<CXLBuf<flit>, NUM_TC> &queues, WeightedArbiter &arb, tc_lock &lock, bool &flag);
+        void update_tc_lock(tc_lock &lock, const flit &f, int tc);
         std::map<uint64_t, std::pair<uint64_t, uint64_t>> address_intervals;
         // device statemachine module
         uint64_t last_port;
@@ -3,9 +3,29 @@
 
 #include "CXLNode.h"
 #include "CXLSwitch.h"
+#include "CXLSampler.h"
+#include <array>
 
 namespace CXL
 {
+    //! Kinds of components whose update time is profiled
+    enum profile_component
+    {
+        PROFILE_LINK,
+        PROFILE_SWITCH,
+        PROFILE_DEVICE,
+        PROFILE_HOST,
+        PROFILE_DAM,
+        NUM_PROFILE_COMPONENTS
+    };
+
+    //! Number of updates and wall clock time spent in them for one kind of component, only collected with PROFILE
+    typedef struct
+    {
+        uint64_t updates;
+        double seconds;
+    } update_profile;
+
     class CXLSystem
     {
         public:
@@ -19,6 +39,10 @@ namespace CXL
             std::vector<std::pair<CXLBus, CXLBus>> interconnects;
             std::vector<int> last_DAM_update;
             CXLSwitch switch_;
+            CXLSampler sampler; /*!< Only samples once it is opened*/
+            void sample();
+            std::array<update_profile, NUM_PROFILE_COMPONENTS> profile{}; /*!< Stays zero unless compiled with PROFILE*/
+            void print_profile(double wall_seconds, uint64_t requests);    /*!< Print the simulation speed overall and per kind of component*/
 
     };
 }
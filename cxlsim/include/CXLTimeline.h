@@ -0,0 +1,77 @@
+#ifndef __CXL_TIMELINE_H
+#define __CXL_TIMELINE_H
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "message.h"
+
+namespace CXL
+{
+    class CXLSampler;
+
+    //! Components that get their own track group in the timeline
+    enum timeline_track
+    {
+        TRACK_HOST,
+        TRACK_HOST_LINK,
+        TRACK_SWITCH,
+        TRACK_DEVICE_LINK,
+        TRACK_DEVICE,
+        TRACK_DRAM,
+        TRACK_DAM,
+        NUM_TRACKS
+    };
+
+    /*!
+    Lifecycle timeline of sampled messages in the Chrome trace event format, open it in ui.perfetto.dev or
+    chrome://tracing.
+    Once a sampled access completes, every stage between two consecutive timestamps of its msg_timing becomes a span on
+    the track of the component it spent that time in: VCs and buffers of the host and the device, the flits carrying it
+    over the links and through the switch, and the DRAM. Spans that overlap go to separate lanes of the track. Every
+    sample of the sampler adds counter tracks with the occupancy of every component
+    */
+    class CXLTimeline
+    {
+    public:
+        CXLTimeline();
+        /*!
+        \brief Start writing the timeline into the given file
+        \param filename output json
+        \param sample_every record one out of this many messages, by message id
+        \param start_tick only record messages created from this tick on
+        \param end_tick only record messages created before this tick
+        */
+        void open(const std::string &filename, uint64_t sample_every, int64_t start_tick, int64_t end_tick);
+        void close();
+        bool is_open() const { return enabled; }
+        bool is_sampled(uint64_t msg_id, int64_t tick_created) const
+        {
+            return enabled && msg_id % sample_every == 0 && tick_created >= start_tick && tick_created < end_tick;
+        }
+        void add_message(const message &m);  /*!< Add the lifecycle of a CXL access, m is the response that completed it*/
+        void add_dam_access(uint64_t msg_id, uint64_t address, int64_t tick_created, int64_t tick_complete);
+        void add_counters(const CXLSampler &s); /*!< Add the row the sampler has just taken*/
+
+    private:
+        void add_span(timeline_track track, const char *name, const char *category, int64_t start, int64_t end, uint64_t msg_id, uint64_t address);
+        double to_us(int64_t tick) const;
+        void begin_event();
+
+        bool enabled;
+        std::ofstream out;
+        std::vector<char> out_buffer;     /*!< Large stream buffer, so the file is only written in big chunks*/
+        bool first_event;
+        uint64_t sample_every;
+        int64_t start_tick;
+        int64_t end_tick;
+        double ticks_per_us;
+        std::vector<int64_t> lane_end[NUM_TRACKS]; /*!< Tick at which the last span of every lane of a track ends*/
+        std::vector<std::string> counter_groups;   /*!< Component of every sampler column, empty for the tick column*/
+        std::vector<std::string> counter_names;    /*!< Sampler column names without the component*/
+        uint64_t spans;
+    };
+}
+
+#endif
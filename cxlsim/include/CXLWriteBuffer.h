@@ -0,0 +1,69 @@
+#ifndef __CXL_WRITE_BUFFER_H
+#define __CXL_WRITE_BUFFER_H
+
+#include <cstdint>
+#include <list>
+#include <map>
+#include "message.h"
+
+namespace CXL
+{
+    //! When the host moves buffered writes to the M2S RwD VCs
+    enum write_drain_policy
+    {
+        drain_eager = 0,     /*!< As soon as there is VC space, writes only coalesce while the VCs are full*/
+        drain_watermark = 1, /*!< In batches, from the high watermark down to the low watermark*/
+        drain_idle = 2       /*!< Whenever no read is waiting in the M2S Req VCs, or above the high watermark*/
+    };
+
+    //! Write buffer accounting
+    typedef struct
+    {
+        uint64_t posted;     /*!< Writes from the trace that entered the buffer and completed*/
+        uint64_t coalesced;  /*!< Writes that hit a line already in the buffer*/
+        uint64_t forwarded;  /*!< Reads serviced with the data of a buffered line*/
+        uint64_t drained;    /*!< Lines written to the device*/
+        uint64_t full;       /*!< Writes that found the buffer full, counted once however many ticks they wait*/
+        uint64_t peak;       /*!< Highest number of buffered lines*/
+        double residency;    /*!< Average ticks a line stayed in the buffer*/
+    } write_buffer_stats;
+
+    /*!
+    Host write combining buffer for posted CXL writes.
+    A write completes for the core once it is in the buffer. Writes to a line that is already buffered are merged into
+    it, reads to a buffered line get its data without going to the device. Lines leave oldest first, when the drain
+    policy asks for it
+    */
+    class CXLWriteBuffer
+    {
+    public:
+        CXLWriteBuffer(int entries, int high_watermark, int low_watermark, write_drain_policy policy);
+        bool post(const message &m);           /*!< Add a write, false if the buffer is full and the line is not in it*/
+        bool forward(uint64_t address);        /*!< True if the line of a read is in the buffer*/
+        /*!
+        \brief True if the oldest line should go to the VCs now
+        \param reads_waiting true if reads are waiting in the M2S Req VCs
+        \param flush true once no more writes can arrive, drains whatever the policy
+        */
+        bool wants_drain(bool reads_waiting, bool flush) const;
+        const message &oldest() const { return lines.front().second; }
+        void pop();                            /*!< Remove the oldest line once it is on a VC*/
+        size_t occupancy() const { return lines.size(); }
+        bool is_empty() const { return lines.empty(); }
+        const char *policy_name() const;
+
+        write_buffer_stats stats;
+
+    private:
+        int entries;
+        int high_watermark;
+        int low_watermark;
+        write_drain_policy policy;
+        bool draining;                                                   /*!< Between reaching the high and the low watermark*/
+        bool stalled;                                                    /*!< The last write found the buffer full and is retried*/
+        std::list<std::pair<int64_t, message>> lines;                    /*!< Buffered lines with the tick they entered, oldest first*/
+        std::map<uint64_t, std::list<std::pair<int64_t, message>>::iterator> line_index; /*!< Line address to its entry*/
+    };
+}
+
+#endif
@@ -0,0 +1,251 @@
+#ifndef __TRACE_RING_H
+#define __TRACE_RING_H
+
+#include <atomic>
+#include <cstdint>
+#include <new>
+#include <string>
+#include <fcntl.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+// This header is shared with the pintool (pin/source/tools/Memory/dcache_hyrise.cpp), so it is header only and
+// sticks to what the Pin CRT offers: no threads library, no shm_open. The ring lives in a file that both sides mmap,
+// put it on a tmpfs (/dev/shm) so that it never hits the disk
+
+namespace CXL
+{
+    const uint32_t TRACE_RING_MAGIC = 0x43584c52; // "CXLR"
+    const uint32_t TRACE_RING_VERSION = 1;
+
+    /*!
+    Binary form of a text trace line `addr R|W gap [tc]`
+    */
+    struct TraceRecord
+    {
+        uint64_t address;
+        uint32_t gap;          /*!< Number of instructions executed by the CPU before this access*/
+        uint8_t is_write;
+        uint8_t traffic_class;
+        uint8_t flags;         /*!< TRACE_FLAG_* bits*/
+        uint8_t reserved;
+    };
+
+    const uint8_t TRACE_FLAG_DEPENDS_ON_LOAD = 1; /*!< The access needs the data of the previous load, see message::depends_on_load*/
+
+    struct TraceRingSlot
+    {
+        std::atomic<uint64_t> seq; /*!< Position of the slot while it is free, position + 1 once its record is written*/
+        TraceRecord record;
+        uint64_t pad;
+    };
+
+    /*!
+    Header at the start of the shared file, followed by capacity slots
+    */
+    struct TraceRingHeader
+    {
+        std::atomic<uint32_t> magic;            /*!< Written last by the consumer, producers wait for it before using the ring*/
+        uint32_t version;
+        uint64_t capacity;                      /*!< Number of slots, a power of two*/
+        uint32_t slot_size;
+        std::atomic<uint32_t> producers;        /*!< Number of attached producers*/
+        std::atomic<uint32_t> closed;           /*!< Set when the last producer detaches, the stream ends once the ring is drained*/
+        std::atomic<uint64_t> producer_stalls;  /*!< Number of pushes that found their slot still occupied*/
+        alignas(64) std::atomic<uint64_t> tail; /*!< Next position a producer reserves*/
+        alignas(64) std::atomic<uint64_t> head; /*!< Next position the consumer reads*/
+    };
+
+    /*!
+    Bounded multi producer single consumer ring of TraceRecords in shared memory.
+    The consumer (cxlsim) creates the ring, producers (pintool threads) attach to it. Every slot carries a sequence
+    number, so producers reserve positions with one fetch_add and then publish their record independently of each
+    other. A producer that finds its slot still occupied waits for the consumer (backpressure), and the consumer
+    waits for the producers when the ring is empty, so the simulated time never depends on which side is faster.
+    With a single producer thread this degenerates to a plain SPSC ring
+    */
+    class TraceRing
+    {
+    public:
+        TraceRing() : header(nullptr), slots(nullptr), map_size(0), mask(0), owner(false), attached(false) {}
+        ~TraceRing()
+        {
+            if (attached)
+                detach();
+            if (header != nullptr)
+                munmap(header, map_size);
+            if (owner)
+                unlink(path.c_str());
+        }
+        TraceRing(const TraceRing &) = delete;
+        TraceRing &operator=(const TraceRing &) = delete;
+
+        //! Path of a shard, shards are numbered from 0 and a single shard uses the base path
+        static std::string shard_path(const std::string &base, int shard, int num_shards)
+        {
+            return num_shards == 1 ? base : base + "." + std::to_string(shard);
+        }
+
+        /*!
+        \brief Create the ring as its consumer, the file is removed again when the ring is destroyed
+        \param capacity number of records, rounded up to a power of two
+        */
+        bool create(const std::string &filename, uint64_t capacity)
+        {
+            uint64_t slots_count = 1;
+            while (slots_count < capacity)
+                slots_count <<= 1;
+            int fd = open(filename.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+            if (fd < 0)
+                return false;
+            size_t size = sizeof(TraceRingHeader) + slots_count * sizeof(TraceRingSlot);
+            if (ftruncate(fd, size) != 0 || !map(fd, size))
+            {
+                close(fd);
+                unlink(filename.c_str());
+                return false;
+            }
+            close(fd);
+            path = filename;
+            owner = true;
+            new (header) TraceRingHeader();
+            header->version = TRACE_RING_VERSION;
+            header->capacity = slots_count;
+            header->slot_size = sizeof(TraceRingSlot);
+            for (uint64_t i = 0; i < slots_count; i++)
+                new (&slots[i]) TraceRingSlot{{i}, {}, 0};
+            mask = slots_count - 1;
+            header->magic.store(TRACE_RING_MAGIC, std::memory_order_release);
+            return true;
+        }
+
+        /*!
+        \brief Attach to a ring as a producer, waiting for the consumer to create it
+        \param timeout_ms how long to wait for the ring to show up
+        */
+        bool attach(const std::string &filename, int64_t timeout_ms)
+        {
+            for (int64_t waited_ms = 0; waited_ms <= timeout_ms; waited_ms++)
+            {
+                if (try_attach(filename))
+                    return true;
+                sleep_us(1000);
+            }
+            return false;
+        }
+
+        //! Detach a producer, the last one to detach closes the stream
+        void detach()
+        {
+            attached = false;
+            if (header->producers.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                header->closed.store(1, std::memory_order_release);
+        }
+
+        //! Append a record, blocks while the ring is full
+        void push(const TraceRecord &record)
+        {
+            uint64_t pos = header->tail.fetch_add(1, std::memory_order_relaxed);
+            TraceRingSlot &slot = slots[pos & mask];
+            uint32_t spins = 0;
+            if (slot.seq.load(std::memory_order_acquire) != pos)
+            {
+                header->producer_stalls.fetch_add(1, std::memory_order_relaxed);
+                while (slot.seq.load(std::memory_order_acquire) != pos)
+                    backoff(spins);
+            }
+            slot.record = record;
+            slot.seq.store(pos + 1, std::memory_order_release);
+        }
+
+        //! Take the next record, blocks while the ring is empty. Returns false once the stream is closed and drained
+        bool pop(TraceRecord &record)
+        {
+            uint64_t pos = header->head.load(std::memory_order_relaxed);
+            TraceRingSlot &slot = slots[pos & mask];
+            uint32_t spins = 0;
+            while (slot.seq.load(std::memory_order_acquire) != pos + 1)
+            {
+                // Producers publish all their records before they detach, so check the slot once more after closing
+                if (header->closed.load(std::memory_order_acquire) && slot.seq.load(std::memory_order_acquire) != pos + 1)
+                    return false;
+                backoff(spins);
+            }
+            record = slot.record;
+            slot.seq.store(pos + mask + 1, std::memory_order_release);
+            header->head.store(pos + 1, std::memory_order_relaxed);
+            return true;
+        }
+
+        uint64_t producer_stalls() const { return header->producer_stalls.load(std::memory_order_relaxed); }
+        uint64_t records_read() const { return header->head.load(std::memory_order_relaxed); }
+
+    private:
+        bool map(int fd, size_t size)
+        {
+            void *p = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            if (p == MAP_FAILED)
+                return false;
+            header = static_cast<TraceRingHeader *>(p);
+            slots = reinterpret_cast<TraceRingSlot *>(header + 1);
+            map_size = size;
+            return true;
+        }
+
+        bool try_attach(const std::string &filename)
+        {
+            int fd = open(filename.c_str(), O_RDWR);
+            if (fd < 0)
+                return false;
+            struct stat st;
+            if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(TraceRingHeader) || !map(fd, st.st_size))
+            {
+                close(fd);
+                return false;
+            }
+            close(fd);
+            if (header->magic.load(std::memory_order_acquire) != TRACE_RING_MAGIC || header->version != TRACE_RING_VERSION ||
+                header->slot_size != sizeof(TraceRingSlot) ||
+                sizeof(TraceRingHeader) + header->capacity * sizeof(TraceRingSlot) != map_size)
+            {
+                munmap(header, map_size);
+                header = nullptr;
+                return false;
+            }
+            mask = header->capacity - 1;
+            path = filename;
+            header->producers.fetch_add(1, std::memory_order_acq_rel);
+            attached = true;
+            return true;
+        }
+
+        static void sleep_us(long us)
+        {
+            struct timespec ts = {0, us * 1000};
+            nanosleep(&ts, nullptr);
+        }
+
+        //! Spin first, then yield, then sleep, so a stalled side does not burn a core for long
+        static void backoff(uint32_t &spins)
+        {
+            spins++;
+            if (spins > 128)
+                sleep_us(50);
+            else if (spins > 64)
+                sched_yield();
+        }
+
+        TraceRingHeader *header;
+        TraceRingSlot *slots;
+        size_t map_size;
+        uint64_t mask;
+        std::string path;
+        bool owner;    /*!< True for the consumer that created the file*/
+        bool attached; /*!< True for an attached producer*/
+    };
+}
+
+#endif
@@ -22,7 +22,9 @@ namespace CXL
 		s2m_ndr = 2,
 		s2m_drs_hdr = 3,
 		data = 4,
-		empty = 5
+		empty = 5,
+		s2m_bisnp = 6, /*!< Header slot of a back invalidate snoop, no data*/
+		m2s_birsp = 7  /*!< Header slot of a back invalidate response, no data*/
 	};
 	//!  Description of slot in terms of messages
 	/*!
@@ -52,6 +54,13 @@ namespace CXL
 		protocol
 	};
 
+	//! Kind of link layer control flit
+	enum llr_control
+	{
+		llcrd_ack, /*!< Explicit acknowledgement, sent when there is no reverse traffic to piggyback the ack on*/
+		retry_req  /*!< Sent by the receiver on a CRC error, asks for a replay starting at header.seq*/
+	};
+
 	//!  Description of flit in terms of slots
 	/*!
 	  Basically a vector of slots
@@ -60,9 +69,12 @@ namespace CXL
 	{
 	public:
 		flit_type type;	  /*!< Type of flit, either control or protocol*/
-		bool ack;		  /*!< Acknowledgment of 8 successful flit transfers. For RETRY and CONTROL flits*/
+		bool ack;		  /*!< A protocol flit piggybacks the acknowledgment of header.acks flits received on the other direction*/
 		bool byte_enable; /*!< Need to check what this does. Used in control flits*/
 		bool size;		  /*!< Need to check what this does. Used in control flits*/
+		uint64_t seq;	  /*!< Link layer sequence number of a protocol flit. For a RETRY control flit, the sequence number to replay from*/
+		llr_control ctrl; /*!< Kind of control flit*/
+		int acks;		  /*!< Number of flits acknowledged by an ACK control flit or a piggybacked ack*/
 
 		// Credits
 		credits credit;
@@ -92,7 +104,7 @@ namespace CXL
 		flit();
 		void copy(const flit &);
 		void print();
-		std::string sprint();
+		std::string sprint() const;
 		uint64_t flit_id; /*!< Unique id given to each flit*/
 		static uint64_t flit_counter;
 
@@ -102,6 +114,7 @@ namespace CXL
 		bool are_all_slots_after_this_empty(int i);
 		void set_time(int64_t msg_timing::*member, int64_t value);
 		uint64_t get_first_address() const;
+		int traffic_class() const;
 	};
 }
 
@@ -47,7 +47,9 @@ namespace CXL
 		Req,
 		RwD,
 		NDR,
-		DRS
+		DRS,
+		BISnp, /*!< Back invalidate snoop, S2M from the device to a host caching the line*/
+		BIRsp  /*!< Response of the host once it has invalidated the line, M2S*/
 	};
 
 	class message
@@ -58,7 +60,7 @@ namespace CXL
 		opcode opCode;	   /*!< Opcode for particular transaction, can be made into enum later*/
 		int meta_field;	   /*!< Not sure what this is supposed to be*/
 		int meta_value;	   /*!< Not sure what this is supposed to be*/
-		int snoop_type;	   /*!< Not used in cxl.mem, keeping here for later upgrade to cxl.mem*/
+		int snoop_type;	   /*!< Not used, back invalidation has its own BISnp and BIRsp opcodes*/
 		int tag;		   /*!< Looks similar in use to the tag in 470 memory subsystem, need to confirm*/
 		uint64_t address;  /*!< Address to access 46+5 bits for 68B flit, 46 for 256B and PBR flits*/
 		int ld_id;		   /*!< Used to address LD-ID inside MLD. Not applicable to PBR flits*/
@@ -77,6 +79,10 @@ namespace CXL
 
 		uint64_t msg_id; /*!< Unique id for every message*/
 
+		bool is_prefetch = false; /*!< Set for Req messages generated by the host prefetcher instead of the trace*/
+		bool is_posted = false;	  /*!< Set for RwD messages drained from the host write buffer, the write completed for the core when it was buffered*/
+		bool depends_on_load = false; /*!< Load to use hint from the trace, the access needs the data of the previous demand load*/
+
 		msg_timing time;
 		// ramulator_timing dram_time; /*!< Keeps track of time taken by ramulator to service this particular message if it is Req or RwD*/
 
@@ -3,6 +3,7 @@
 
 #include <string>
 #include <fstream>
+#include <iostream>
 #include "flit.h"
 #include "CXLInterface.h"
 #include <cstdlib>
@@ -24,11 +24,21 @@ if __name__ == '__main__':
     cxl_accesses = 0
     dam_accesses = 0
 
+    # Core model rows, the shards simulate consecutive parts of the trace so their execution times add up
+    instructions = 0
+    execution_ticks = 0
+    stall_ticks = [0, 0, 0]
+
     for file in filtered_files:
         print(file)
         with open(os.path.join(path,file)) as file:
             reader = csv.reader(file)
             for row in reader:
+                if row[0] == "2":
+                    instructions += int(row[1])
+                    execution_ticks += int(row[2])
+                    stall_ticks = [s + int(t) for s, t in zip(stall_ticks, row[3:6])]
+                    continue
                 num_accesses = int(float(row[2]))
                 if row[0] == "1":
                     cxl_accesses += num_accesses
@@ -42,3 +52,7 @@ if __name__ == '__main__':
     print(f"DAM Accesses : {dam_accesses}")
     print(f"Num Accesses : {total_accesses}")
     print(f"Final AMAT : {final_avg}")
+    if instructions > 0:
+        print(f"Instructions : {instructions}")
+        print(f"Execution ticks : {execution_ticks}")
+        print(f"Stall ticks (ROB, MSHR, load to use) : {stall_ticks}")
@@ -6,6 +6,8 @@
 namespace CXL
 {
     extern CXLLog log;
+    extern CXLParams params;
+    extern CXLTimeline timeline;
     extern uint64_t num_reqs_completed;
     extern uint64_t num_dam_reqs;
 }
@@ -108,6 +110,9 @@ void DirectAttached::ramulator_init()
         ctrls.push_back(ctrl);
     }
     memory = new Memory<T, Controller>(*configs, ctrls);
+    // The controllers switch to draining writes at the high watermark of their write queue and back to reads at the low one
+    memory->set_high_writeq_watermark(CXL::params.dram_write_high);
+    memory->set_low_writeq_watermark(CXL::params.dram_write_low);
 
     // Uncomment only for testing ramulator standalone
     // initialize_buffer();
@@ -240,11 +245,14 @@ void ramulator::direct_attached_req_complete(Request &r)
     auto& avg = entry.second;
     ++count;
     avg = avg + (CXL::curr_tick - r.req_host->reqs_in_dam[r.req_id] - avg) / count;
+    if (CXL::timeline.is_sampled(r.req_id, r.req_host->reqs_in_dam[r.req_id]))
+        CXL::timeline.add_dam_access(r.req_id, r.addr, r.req_host->reqs_in_dam[r.req_id], CXL::curr_tick);
 #ifdef TRACK_LATENCY
     // Dump the latency onto file
     r.req_host->print_direct_attached_latency(r.req_id);
 #endif
     r.req_host->reqs_in_dam.erase(r.req_id);
+    r.req_host->core_retire(r.req_id);
 #ifdef DUMP
     // Set the tick of completion
     r.req_host->DAM->timing_tracker[r.req_id].end = r.req_host->DAM->state.clks;
@@ -6,6 +6,7 @@
 namespace CXL
 {
     extern CXLLog log;
+    extern CXLParams params;
 }
 
 using namespace ramulator;
@@ -97,6 +98,9 @@ void RamDevice::ramulator_init()
         ctrls.push_back(ctrl);
     }
     memory = new Memory<T, Controller>(*configs, ctrls);
+    // The controllers switch to draining writes at the high watermark of their write queue and back to reads at the low one
+    memory->set_high_writeq_watermark(CXL::params.dram_write_high);
+    memory->set_low_writeq_watermark(CXL::params.dram_write_low);
 
     // Uncomment only for testing ramulator standalone
     // initialize_buffer();
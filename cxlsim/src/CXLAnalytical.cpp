@@ -0,0 +1,246 @@
+#include "CXLAnalytical.h"
+#include "CXLParams.h"
+#include "utils.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+using namespace CXL;
+
+namespace CXL
+{
+    extern CXLParams params;
+}
+
+// DDR4-3200 as configured in ramulator/configs/DDR4-config.cfg
+const double DDR_TCK_NS = 0.625;
+const int DDR_CL = 22, DDR_RCD = 22, DDR_RP = 22, DDR_BURST = 4;
+const int DDR_CHANNELS = 4;
+const int ROW_BITS = 13; // 8KB rows
+const double MAX_UTILIZATION = 0.95;
+
+TraceWindowStats::TraceWindowStats() : accesses(0), core_instructions(1, 0)
+{
+    for (auto &banks : open_row)
+        banks.fill(UINT64_MAX);
+}
+
+void TraceWindowStats::add(const message &m, uint64_t gap, memory_tier tier, int core)
+{
+    if ((int)core_instructions.size() <= core)
+        core_instructions.resize(core + 1, 0);
+    core_instructions[core] += gap;
+    accesses++;
+    table_stats &t = tables[tier][(m.address >> 48) & 0xFFF];
+    if (m.opCode == opcode::RwD)
+        t.writes++;
+    else
+        t.reads++;
+    uint64_t row = m.address >> ROW_BITS;
+    uint64_t &open = open_row[tier][row % open_row[tier].size()];
+    if (open == row)
+        t.row_hits++;
+    open = row;
+}
+
+uint64_t TraceWindowStats::issue_ticks() const
+{
+    return *std::max_element(core_instructions.begin(), core_instructions.end()) * params.ticks_per_ins;
+}
+
+table_stats TraceWindowStats::tier_totals(memory_tier tier) const
+{
+    table_stats total = {0, 0, 0};
+    for (auto &iter : tables[tier])
+    {
+        total.reads += iter.second.reads;
+        total.writes += iter.second.writes;
+        total.row_hits += iter.second.row_hits;
+    }
+    return total;
+}
+
+CXLAnalytical::CXLAnalytical()
+{
+    // Host VC to packer, tx buffer, bus and rx buffer of every hop, twice through the switch and the device queues
+    double hop = params.delay_vc_to_pack + params.delay_tx_buf_to_bus + params.cxl_bus_total_latency + params.delay_rx_buf_to_unpack;
+    fixed_latency[dam_tier] = 0;
+    fixed_latency[cxl_tier] = 4 * hop + 2 * (params.delay_cxl_noc_switch + params.delay_cxl_port_switch) + params.delay_vc_to_ramulator + params.delay_vc_to_retire;
+    flit_ticks = params.cxl_bus_ticks_per_dequeue;
+    packer_wait_ticks = params.ticks_per_ns; // packer_wait_time of CXLHost
+    row_hit_ticks = DDR_CL * DDR_TCK_NS * params.ticks_per_ns;
+    row_miss_ticks = (DDR_RP + DDR_RCD + DDR_CL) * DDR_TCK_NS * params.ticks_per_ns;
+    burst_ticks = DDR_BURST * DDR_TCK_NS * params.ticks_per_ns;
+    dram_channels = DDR_CHANNELS;
+    for (int tier = 0; tier < NUM_TIERS; tier++) {
+        correction[tier] = 0;
+        run_windows[tier] = 0;
+    }
+}
+
+double CXLAnalytical::mm_wait(double utilization, double service) const
+{
+    utilization = std::min(utilization, MAX_UTILIZATION);
+    return utilization * service / (2 * (1 - utilization));
+}
+
+double CXLAnalytical::packing_efficiency(double slots_per_tick) const
+{
+    return std::min(1.0, (1 + slots_per_tick * packer_wait_ticks) / params.slots_per_flit);
+}
+
+double CXLAnalytical::dram_service(const table_stats &s) const
+{
+    uint64_t n = s.reads + s.writes;
+    if (n == 0)
+        return 0;
+    double hit_rate = (double)s.row_hits / n;
+    return hit_rate * row_hit_ticks + (1 - hit_rate) * row_miss_ticks + burst_ticks;
+}
+
+analytical_estimate CXLAnalytical::estimate(const TraceWindowStats &w) const
+{
+    analytical_estimate e;
+    e.saturated = false;
+    table_stats cxl = w.tier_totals(cxl_tier);
+    // Slots every CXL access needs towards the device (Req or RwD header and data) and towards the host (DRS header and
+    // data or NDR)
+    double slots[2] = {(double)cxl.reads + 5.0 * cxl.writes, 5.0 * cxl.reads + (double)cxl.writes};
+    double ticks = std::max((double)w.issue_ticks(), 1.0);
+    double link_busy[2], dram_busy[NUM_TIERS];
+    for (int dir = 0; dir < 2; dir++)
+        link_busy[dir] = slots[dir] / params.slots_per_flit / packing_efficiency(slots[dir] / ticks) * flit_ticks;
+    for (int tier = 0; tier < NUM_TIERS; tier++)
+    {
+        table_stats t = w.tier_totals((memory_tier)tier);
+        dram_busy[tier] = (t.reads + t.writes) * burst_ticks / dram_channels;
+    }
+    // If a queue cannot keep up, the VCs fill up and the window takes as long as that queue needs
+    double busiest = std::max({link_busy[0], link_busy[1], dram_busy[dam_tier], dram_busy[cxl_tier]});
+    if (busiest > ticks * MAX_UTILIZATION)
+    {
+        e.saturated = true;
+        ticks = busiest / MAX_UTILIZATION;
+    }
+    e.ticks = ticks;
+
+    // Every access crosses the host link and the device link in both directions
+    double link_wait = 0;
+    for (int dir = 0; dir < 2; dir++)
+    {
+        e.link_utilization[dir] = link_busy[dir] / ticks;
+        double accesses = cxl.reads + cxl.writes;
+        if (accesses > 0)
+            link_wait += 2 * mm_wait(e.link_utilization[dir], link_busy[dir] / accesses);
+    }
+    for (int tier = 0; tier < NUM_TIERS; tier++)
+    {
+        e.dram_utilization[tier] = dram_busy[tier] / ticks;
+        double dram_wait = mm_wait(e.dram_utilization[tier], burst_ticks);
+        double sum = 0, sum_dram = 0;
+        uint64_t n = 0;
+        for (auto &iter : w.tables[tier])
+        {
+            uint64_t count = iter.second.reads + iter.second.writes;
+            double dram = dram_service(iter.second) + dram_wait;
+            double amat = fixed_latency[tier] + (tier == cxl_tier ? link_wait : 0) + dram + correction[tier];
+            e.table_amat[tier][iter.first] = amat;
+            sum += amat * count;
+            sum_dram += dram * count;
+            n += count;
+        }
+        e.amat[tier] = n > 0 ? sum / n : 0;
+        e.dram_latency[tier] = n > 0 ? sum_dram / n : 0;
+    }
+    return e;
+}
+
+void CXLAnalytical::calibrate(const TraceWindowStats &w, const double *measured_amat)
+{
+    analytical_estimate e = estimate(w);
+    for (int tier = 0; tier < NUM_TIERS; tier++)
+    {
+        table_stats t = w.tier_totals((memory_tier)tier);
+        if (t.reads + t.writes == 0 || measured_amat[tier] <= 0)
+            continue;
+        errors[tier].push_back((e.amat[tier] - measured_amat[tier]) / measured_amat[tier]);
+        // The correction is the mean residual of the uncorrected model over the calibration windows of this run, errors
+        // loaded from earlier runs only add to the error bound
+        double residual = measured_amat[tier] - (e.amat[tier] - correction[tier]);
+        run_windows[tier]++;
+        correction[tier] += (residual - correction[tier]) / run_windows[tier];
+    }
+}
+
+double CXLAnalytical::mean_relative_error(memory_tier tier) const
+{
+    // The first window is predicted without any correction, so it is in-sample and left out
+    if (errors[tier].size() < 2)
+        return 0;
+    double sum = 0;
+    for (size_t i = 1; i < errors[tier].size(); i++)
+        sum += errors[tier][i];
+    return sum / (errors[tier].size() - 1);
+}
+
+double CXLAnalytical::relative_error_bound(memory_tier tier) const
+{
+    // Only the out-of-sample errors of the windows after the first one give the bound
+    if (errors[tier].size() < 2)
+        return -1;
+    double sum_sq = 0;
+    for (size_t i = 1; i < errors[tier].size(); i++)
+        sum_sq += errors[tier][i] * errors[tier][i];
+    return 1.96 * std::sqrt(sum_sq / (errors[tier].size() - 1));
+}
+
+//! Read a calibration written by save(), returns false if there is none
+bool CXLAnalytical::load(const std::string &filename)
+{
+    std::ifstream in(filename);
+    if (!in.is_open())
+        return false;
+    std::string line;
+    while (std::getline(in, line))
+    {
+        std::stringstream ss(line);
+        std::string key;
+        int tier;
+        double value;
+        char comma;
+        if (!std::getline(ss, key, ',') || !(ss >> tier >> comma >> value) || tier < 0 || tier >= NUM_TIERS)
+            continue;
+        if (key == "correction")
+            correction[tier] = value;
+        else if (key == "error")
+            errors[tier].push_back(value);
+    }
+    return true;
+}
+
+void CXLAnalytical::save(const std::string &filename) const
+{
+    std::ofstream out(filename);
+    for (int tier = 0; tier < NUM_TIERS; tier++)
+    {
+        out << "correction, " << tier << ", " << correction[tier] << "\n";
+        for (double err : errors[tier])
+            out << "error, " << tier << ", " << err << "\n";
+    }
+}
+
+void CXLAnalytical::print() const
+{
+    const char *names[NUM_TIERS] = {"DAM", "CXL"};
+    std::cout << "Analytical model: fixed latency DAM " << fixed_latency[dam_tier] << " CXL " << fixed_latency[cxl_tier]
+              << " flit " << flit_ticks << " row hit " << row_hit_ticks << " row miss " << row_miss_ticks << " ticks\n";
+    for (int tier = 0; tier < NUM_TIERS; tier++)
+    {
+        std::cout << names[tier] << " correction " << correction[tier] << " ticks from " << errors[tier].size() << " windows";
+        if (relative_error_bound((memory_tier)tier) >= 0)
+            std::cout << ", mean error " << 100 * mean_relative_error((memory_tier)tier) << "% 95% bound +-" << 100 * relative_error_bound((memory_tier)tier) << "%";
+        std::cout << "\n";
+    }
+}
@@ -2,6 +2,7 @@
 #include <iostream>
 #include "utils.h"
 #include "CXLNode.h"
+#include <cmath>
 
 using namespace CXL;
 
@@ -23,6 +24,25 @@ CXLBus::CXLBus(int size, uint node_id, direction d)
     this->node_id = node_id;
     this->time_of_last_dequeue = 0;
     set_dir(d);
+    // Link layer retry
+    this->llr_enabled = params.link_ber > 0;
+    this->reverse = NULL;
+    this->retry_buf = CXLRETRYBuf(params.llr_buf_size);
+    this->next_seq = 0;
+    this->expected_seq = 0;
+    this->unacked = 0;
+    this->oldest_unacked_tick = 0;
+    this->time_of_last_add = -params.cxl_bus_ticks_per_dequeue;
+    // A flit is corrupted if any of its bits is flipped
+    this->flit_error_rate = -std::expm1(params.bytes_per_flit * 8 * std::log1p(-params.link_ber));
+    this->rng.seed(params.llr_seed + node_id);
+    this->llr = {0, 0, 0, 0, 0, 0, 0, 0, 0};
+}
+
+//! Pair the bus with the bus going the other way on the same link. Needed for ACKs and RETRY requests
+void CXLBus::set_reverse(CXLBus *reverse)
+{
+    this->reverse = reverse;
 }
 
 // //! Constructor specifying direction
@@ -78,6 +98,9 @@ void CXLBus::update()
     // Check if flit is stagnant
     CXL_ASSERT(!is_flit_stagnant() && "Stagnant flit in bus");
 
+    if (llr_enabled)
+        llr_update();
+
     // Every once in params.cxl_bus_ticks_per_dequeue ticks try to dequeue from the bus
     // This will model the bandwidth
     if (curr_tick - time_of_last_dequeue >= params.cxl_bus_ticks_per_dequeue && !is_empty())
@@ -91,6 +114,9 @@ bool CXLBus::is_full()
 {
     if (flit_slots.size() == size)
         return true;
+    // With link layer retry the transmitter also waits for space in the retry buffer, and control flits and replays go first
+    if (llr_enabled)
+        return retry_buf.is_buf_full() || !control_queue.empty() || !replay_queue.empty() || curr_tick - time_of_last_add < params.cxl_bus_ticks_per_dequeue;
     return false;
 }
 
@@ -107,24 +133,44 @@ void CXLBus::add_to_bus(flit f)
 {
     CXL_ASSERT(!is_full() && "Addding to bus when it is full");
 
+    if (llr_enabled)
+    {
+        f.header.type = flit_type::protocol;
+        f.header.seq = next_seq++;
+        // Piggyback an ack for all flits received on the other direction of the link so far
+        f.header.ack = reverse->unacked > 0;
+        f.header.acks = reverse->unacked;
+        if (f.header.ack)
+        {
+            reverse->unacked = 0;
+            reverse->oldest_unacked_tick = curr_tick;
+            llr.acks_piggybacked++;
+        }
+        retry_buf.enqueue(f);
+        llr.flits_sent++;
+    }
+    put_on_bus(f);
+}
+
+//! Put a flit in the bus and start tracking it
+void CXLBus::put_on_bus(flit &f)
+{
     // If bus is empty, then reset the dequeue counter
     if (is_empty())
         time_of_last_dequeue = curr_tick;
+    time_of_last_add = curr_tick;
 
-    if (!is_full())
-    {
-        flit_slots.push_back(f);
-        // Add to timing tracker
-        bus_timings time;
-        time.num_data = f.slot_count_in_flit(slot_type::data);
-        time.num_empty = f.slot_count_in_flit(slot_type::empty);
-        time.tick_added_to_bus = curr_tick;
-        time.tick_removed_from_bus = 0;
+    flit_slots.push_back(f);
+    // Add to timing tracker
+    bus_timings time;
+    time.num_data = f.slot_count_in_flit(slot_type::data);
+    time.num_empty = f.slot_count_in_flit(slot_type::empty);
+    time.tick_added_to_bus = curr_tick;
+    time.tick_removed_from_bus = 0;
 #ifdef DUMP
-        timing_tracker.insert({f.flit_id, time});
+    timing_tracker.insert({f.flit_id, time});
 #endif
-        // std::cout << "Pkt added to bus @" << curr_tick << "\n";
-    }
+    // std::cout << "Pkt added to bus @" << curr_tick << "\n";
 }
 
 //! Dequeue head of bus and add to rx buf of receivng end
@@ -136,6 +182,13 @@ void CXLBus::send_to_node()
         flit f;
         f.copy(flit_slots.front());
         f.time.time_of_receipt = curr_tick;
+        // Flits that fail CRC or arrive out of sequence never reach the receiver. Neither do the credits they carry, those are only returned once the replayed flit is accepted
+        if (llr_enabled && !link_layer_accept(f))
+        {
+            flit_slots.pop_front();
+            time_of_last_dequeue = curr_tick;
+            return;
+        }
         // set the messages' ticks at which it is received at either switch or device or host based on the terminals of the switch
         switch (bus_type)
         {
@@ -227,4 +280,157 @@ void CXLBus::dump_data()
              << it->second.num_empty << "\n";
     }
     dump.close();
-}
\ No newline at end of file
+}
+
+//! Returns true if there is a free slot on the bus for a control flit or replay
+bool CXLBus::link_has_room()
+{
+    return flit_slots.size() < (size_t)size && curr_tick - time_of_last_add >= params.cxl_bus_ticks_per_dequeue;
+}
+
+//! Receiver side of the link layer. Returns true if the flit should be handed to the receiving node
+bool CXLBus::link_layer_accept(const flit &f)
+{
+    // Control flits on this bus are about the flits going the other way
+    if (f.header.type == flit_type::control)
+    {
+        reverse->receive_control(f);
+        return false;
+    }
+    // Go-back-N: after a CRC error everything up to the replayed flit is dropped
+    if (f.header.seq != expected_seq)
+    {
+        llr.flits_discarded++;
+        return false;
+    }
+    if (std::uniform_real_distribution<double>(0.0, 1.0)(rng) < flit_error_rate)
+    {
+        llr.crc_errors++;
+        llr.retry_requests++;
+        reverse->queue_control(llr_control::retry_req, expected_seq);
+#ifdef EVENTLOG
+        log.CXLEventLog("CRC error, requesting replay " + f.sprint() + "\n", this->node_id, to_node_id);
+#endif
+        return false;
+    }
+    expected_seq++;
+    llr.flits_accepted++;
+    if (unacked == 0)
+        oldest_unacked_tick = curr_tick;
+    unacked++;
+    // The ack is only trusted once the flit carrying it passes CRC
+    if (f.header.ack)
+        reverse->release_acked(f.header.acks);
+    return true;
+}
+
+//! Per tick link layer work: explicit ACKs when there is no reverse traffic to piggyback on, then control flits and replays
+void CXLBus::llr_update()
+{
+    if (retry_buf.is_buf_full())
+        llr.retry_buf_full_ticks++;
+    // Every reverse flit piggybacks the pending acks, so they only wait this long if the reverse direction is idle.
+    // The transmitter must not stall on its retry buffer meanwhile
+    bool reverse_idle = curr_tick - oldest_unacked_tick >= params.llr_ack_timeout;
+    bool retry_buf_nearly_full = retry_buf.buf_occupancy() >= params.llr_buf_size - params.llr_ack_margin;
+    if (unacked > 0 && (reverse_idle || retry_buf_nearly_full))
+    {
+        reverse->queue_control(llr_control::llcrd_ack, unacked);
+        unacked = 0;
+    }
+    if (!link_has_room())
+        return;
+    flit f;
+    if (!control_queue.empty())
+    {
+        f.copy(control_queue.front());
+        control_queue.pop_front();
+        llr.control_flits++;
+    }
+    else if (!replay_queue.empty())
+    {
+        f.copy(replay_queue.front());
+        replay_queue.pop_front();
+        llr.flits_replayed++;
+        llr.flits_sent++;
+    }
+    else
+        return;
+    f.time.time_of_transmission = curr_tick;
+    put_on_bus(f);
+}
+
+//! Queue an ACK (value is the number of flits acknowledged) or a RETRY (value is the sequence number to replay from)
+void CXLBus::queue_control(llr_control ctrl, uint64_t value)
+{
+    flit f;
+    f.header.type = flit_type::control;
+    f.header.ctrl = ctrl;
+    if (ctrl == llr_control::llcrd_ack)
+        f.header.acks = (int)value;
+    else
+        f.header.seq = value;
+    control_queue.push_back(f);
+}
+
+//! Transmitter side of the link layer. Handle an ACK or RETRY sent back by the receiver
+void CXLBus::receive_control(const flit &f)
+{
+    switch (f.header.ctrl)
+    {
+    case llr_control::llcrd_ack:
+        release_acked(f.header.acks);
+        break;
+    case llr_control::retry_req:
+        replay_from(f.header.seq);
+        break;
+    default:
+        CXL_ASSERT(false && "Illegal control flit");
+    }
+}
+
+//! Free acknowledged flits from the retry buffer
+void CXLBus::release_acked(int n)
+{
+    retry_buf.release(n);
+}
+
+//! Resend every unacknowledged flit starting at seq. Copies of these flits already on the bus will be dropped by the receiver
+void CXLBus::replay_from(uint64_t seq)
+{
+    std::vector<flit> flits = retry_buf.resend_flits(seq);
+    replay_queue.assign(flits.begin(), flits.end());
+#ifdef EVENTLOG
+    log.CXLEventLog("Replaying " + std::to_string(flits.size()) + " flits from sequence number " + std::to_string(seq) + "\n", this->node_id);
+#endif
+}
+
+//! Print the link layer retry statistics of this bus
+void CXLBus::print_link_stats()
+{
+    if (!llr_enabled)
+        return;
+    double elapsed_ns = (double)curr_tick / params.ticks_per_ns;
+    double effective_bw = elapsed_ns > 0 ? llr.flits_accepted * params.bytes_per_flit / elapsed_ns : 0; // Bytes/ns = GB/s
+    uint64_t total = llr.flits_sent + llr.control_flits;
+    std::cout << "Bus " << node_id << " (" << from_node_id << "->" << to_node_id << ")"
+              << " sent " << llr.flits_sent << " accepted " << llr.flits_accepted
+              << " crc_errors " << llr.crc_errors << " discarded " << llr.flits_discarded
+              << " replayed " << llr.flits_replayed << " retries " << llr.retry_requests
+              << " acks_piggybacked " << llr.acks_piggybacked << " control " << llr.control_flits
+              << " retry_buf_full_ticks " << llr.retry_buf_full_ticks << "\n";
+    std::cout << "    effective bandwidth " << effective_bw << " GB/s of " << (double)params.link_bandwidth_s / 1e9
+              << " GB/s, link efficiency " << (total > 0 ? (double)llr.flits_accepted / total : 1.0) << "\n";
+}
+
+//! Add the bus occupancy, and the retry state if link layer retry is on, to the current sample
+void CXLBus::sample(CXLSampler &s)
+{
+    s.set_prefix("bus" + std::to_string(node_id) + "_");
+    s.add("occupancy", bus_occupancy());
+    if (llr_enabled)
+    {
+        s.add("retry_buf", retry_buf.buf_occupancy());
+        s.add("replay_queue", replay_queue.size());
+    }
+}
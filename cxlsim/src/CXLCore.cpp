@@ -0,0 +1,235 @@
+#include "CXLCore.h"
+#include "CXLParams.h"
+#include "utils.h"
+#include <sstream>
+#include <vector>
+
+using namespace CXL;
+
+namespace CXL
+{
+    extern int64_t curr_tick;
+    extern CXLParams params;
+}
+
+static std::vector<std::string> split(const std::string &s, char delim)
+{
+    std::vector<std::string> result;
+    std::stringstream ss(s);
+    std::string item;
+
+    while (getline(ss, item, delim))
+    {
+        result.push_back(item);
+    }
+
+    return result;
+}
+
+CXLCore::CXLCore() : text_to_trace_buf(20)
+{
+    trace_entries_read = 0;
+    core_instructions = 0;
+    core_accesses = 0;
+    core_stall_ticks[0] = core_stall_ticks[1] = core_stall_ticks[2] = 0;
+    is_trace_finished = false;
+    last_text_to_trace_buf_dequeue = 0;
+    core_last_load = UINT64_MAX;
+    core_stall_since_issue = 0;
+    core_last_tick = 0;
+}
+
+void CXLCore::set_trace_file(const std::string &filename)
+{
+    trace_in.open(filename);
+}
+
+bool CXLCore::set_trace_ring(const std::string &filename, uint64_t capacity)
+{
+    trace_ring.reset(new TraceRing());
+    if (trace_ring->create(filename, capacity))
+        return true;
+    trace_ring.reset();
+    return false;
+}
+
+//! Create the message for the next access from a line of the trace file or a record of the trace ring
+bool CXLCore::read_trace_entry(uint64_t &gap, message &m)
+{
+    opcode opCode;
+    uint64_t addr;
+    if (trace_ring != nullptr)
+    {
+        // Blocks until the pintool produced the record, so the simulation does not depend on how fast it traces
+        TraceRecord r;
+        if (!trace_ring->pop(r))
+            return false;
+        opCode = r.is_write ? opcode::RwD : opcode::Req;
+        addr = r.address;
+        gap = r.gap;
+        m = message(opCode, addr);
+        m.traffic_class = r.traffic_class;
+        m.depends_on_load = r.flags & TRACE_FLAG_DEPENDS_ON_LOAD;
+        CXL_ASSERT(m.traffic_class < NUM_TC && "Illegal traffic class in trace");
+        trace_entries_read++;
+        return true;
+    }
+
+    std::string s;
+    // Create message from a line of text in the trace file
+    if (!std::getline(trace_in, s))
+        return false;
+
+    // Process the line
+    // Split string at the spaces
+    std::vector<std::string> words = split(s, ' ');
+    CXL_ASSERT(words.size() >= 3 && words.size() <= 5 && "Incorrect string splitting");
+    // Make the first word the address and the second word the type
+    addr = (uint64_t)stoul(words[0], NULL, 0);
+    if (words[1].compare("R") == 0)
+        opCode = opcode::Req;
+    else if (words[1].compare("W") == 0)
+        opCode = opcode::RwD;
+    else
+        CXL_ASSERT(false && "Illegal opcode");
+    // The third word is the number of instructions executed by CPU before this access
+    gap = (uint64_t)stoul(words[2], NULL, 0);
+
+    // Create the message to be put on the buffer and then later onto the virtual channels
+    m = message(opCode, addr);
+    // The optional fourth word is the traffic class of the access
+    if (words.size() >= 4)
+    {
+        m.traffic_class = (int)stoul(words[3], NULL, 0);
+        CXL_ASSERT(m.traffic_class < NUM_TC && "Illegal traffic class in trace");
+    }
+    // The optional fifth word is the load to use hint, 1 if the access needs the data of the previous load
+    if (words.size() == 5)
+        m.depends_on_load = stoul(words[4], NULL, 0) != 0;
+    trace_entries_read++;
+    return true;
+}
+
+bool CXLCore::refill()
+{
+    if (is_trace_finished)
+        return false;
+    // If the buffer is full, skip creating new messages, but return true to show that file has not ended yet
+    if (text_to_trace_buf.is_buf_full())
+        return true;
+    uint64_t clk_interval;
+    message m;
+    if (!read_trace_entry(clk_interval, m))
+    {
+        is_trace_finished = true;
+        return false;
+    }
+    text_to_trace_buf.enqueue(std::pair<uint64_t, message>(clk_interval, m));
+    return true;
+}
+
+bool CXLCore::take_entry(uint64_t &gap, message &m)
+{
+    if (!text_to_trace_buf.is_buf_empty())
+    {
+        gap = text_to_trace_buf.get_head().first;
+        m = text_to_trace_buf.get_head().second;
+        text_to_trace_buf.dequeue();
+        return true;
+    }
+    if (is_trace_finished)
+        return false;
+    if (read_trace_entry(gap, m))
+        return true;
+    is_trace_finished = true;
+    return false;
+}
+
+int64_t CXLCore::ticks_since_issue() const
+{
+    return curr_tick - last_text_to_trace_buf_dequeue - core_stall_since_issue;
+}
+
+int64_t CXLCore::ticks_to_next_issue()
+{
+    if (text_to_trace_buf.is_buf_empty())
+        return 0;
+    return std::max((int64_t)0, (int64_t)text_to_trace_buf.get_head().first * params.ticks_per_ins - ticks_since_issue());
+}
+
+bool CXLCore::is_due()
+{
+    return !text_to_trace_buf.is_buf_empty() && ticks_since_issue() >= (int64_t)text_to_trace_buf.get_head().first * params.ticks_per_ins;
+}
+
+void CXLCore::start_issue()
+{
+    last_text_to_trace_buf_dequeue = curr_tick;
+    core_stall_since_issue = 0;
+}
+
+void CXLCore::resume()
+{
+    start_issue();
+    core_last_tick = curr_tick;
+}
+
+//! Interval core model: check whether the instruction stream can make progress this tick. Stalled ticks do not count
+//! towards the gap of the next access, so memory latency that the window cannot hide becomes execution time
+bool CXLCore::core_stalled()
+{
+    if (text_to_trace_buf.is_buf_empty())
+        return false;
+    const std::pair<uint64_t, message> next = text_to_trace_buf.get_head();
+    int64_t elapsed = curr_tick - core_last_tick;
+    core_last_tick = curr_tick;
+    int reason = -1;
+    // Instructions retire in order, so at most rob_size instructions can be in flight behind the oldest outstanding load
+    uint64_t current = core_instructions + core_accesses + ticks_since_issue() / params.ticks_per_ins;
+    if (!core_window.empty() && current >= core_window.begin()->first + params.rob_size)
+        reason = 0;
+    // A load that is due needs a free MSHR and, if it is dependent, the data of the previous load. Loads already in the
+    // window are only waiting for VC space
+    else if (next.second.opCode == opcode::Req && core_window_index.count(next.second.msg_id) == 0 && is_due())
+    {
+        if ((int)core_window.size() >= params.num_mshrs)
+            reason = 1;
+        else if (next.second.depends_on_load && core_window_index.count(core_last_load) == 1)
+            reason = 2;
+    }
+    if (reason < 0)
+        return false;
+    core_stall_since_issue += elapsed;
+    core_stall_ticks[reason] += elapsed;
+    return true;
+}
+
+//! Add a demand load to the core window
+void CXLCore::core_dispatch(const message &m, uint64_t gap)
+{
+    if (m.opCode != opcode::Req)
+        return;
+    uint64_t index = core_instructions + core_accesses + gap;
+    core_window[index] = m.msg_id;
+    core_window_index[m.msg_id] = index;
+}
+
+//! Advance the instruction stream past an access that left the text to trace buffer
+void CXLCore::core_issued(const message &m, uint64_t gap)
+{
+    // Accesses issue without taking time of their own, like in the gap only model
+    core_instructions += gap;
+    core_accesses++;
+    if (m.opCode == opcode::Req)
+        core_last_load = m.msg_id;
+}
+
+bool CXLCore::core_retire(uint64_t msg_id)
+{
+    auto it = core_window_index.find(msg_id);
+    if (it == core_window_index.end())
+        return false;
+    core_window.erase(it->second);
+    core_window_index.erase(it);
+    return true;
+}
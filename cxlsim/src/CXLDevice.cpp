@@ -82,6 +82,17 @@ CXLDevice::CXLDevice(int vc_size, int buf_size, uint node_id) : CXLNode(vc_size,
     empty_cycle_transmit = 0;
     empty_cycle_unpacker = 0;
     num_reqs = 0;
+    packer_arb = WeightedArbiter(params.tc_weights);
+    for (int i = 0; i < 4; i++)
+        dev_load_reported[i] = 0;
+    // Create the snoop filter, stays nullptr if coherence is not modeled
+    if (params.bi_snoop_filter > 0)
+    {
+        snoop_filter.reset(new CXLSnoopFilter(params.bi_snoop_filter, params.bi_snoop_filter_ways));
+        // Every request in the M2S VCs replaces at most one line of the host, so the BISnp VC never fills
+        S2M_BISnp = CXLBuf<message>(2 * vc_size);
+        bi_rng.seed(params.bi_seed + node_id);
+    }
     printf("Device, %d,%d,%d,%d\n", S2M_DRS[0].size() * S2M_DRS.size(), tx_buffer.size(), M2S_Req.size(), rx_buffer.size());
 }
 
@@ -264,6 +275,7 @@ bool CXLDevice::FLIT_unpacker()
     int m2s_req_ctr = 0;
     int m2s_rwd_ctr = 0;
     int m2s_data_ctr = 0;
+    int m2s_birsp_ctr = 0;
 
     // Packing rule checks
     // For 68B flit, data rollover cannot be more than 4 TODO: take care of packing rules for other flit types
@@ -312,6 +324,8 @@ bool CXLDevice::FLIT_unpacker()
                 // Set unpacking time for message
                 last_rwd_hdr.time.tick_unpacked = curr_tick;
                 M2S_RWD.enqueue(last_rwd_hdr); // Assume that m2s_rwd_hdr is accompanied by its data in the M2S_RWD queue
+                if (snoop_filter != nullptr)
+                    coherence_lookup(last_rwd_hdr);
                 break;
             }
         }
@@ -330,6 +344,8 @@ bool CXLDevice::FLIT_unpacker()
             // Set the tick unpacked
             s.msg.time.tick_unpacked = curr_tick;
             M2S_Req.enqueue(s.msg);
+            if (snoop_filter != nullptr)
+                coherence_lookup(s.msg);
             m2s_req_ctr++;
             // std::cout << "Unpacked Req with id " << s.msg.msg_id << "\n";
             break;
@@ -350,10 +366,19 @@ bool CXLDevice::FLIT_unpacker()
                 // Set the tick unpacked
                 last_rwd_hdr.time.tick_unpacked = curr_tick;
                 M2S_RWD.enqueue(last_rwd_hdr); // Assume that m2s_rwd_hdr is accompanied by its data in the M2S_RWD queue
+                if (snoop_filter != nullptr)
+                    coherence_lookup(last_rwd_hdr);
                 // std::cout << "Unpacked RWD with id " << last_rwd_hdr.msg_id << "\n";
             }
             m2s_data_ctr++;
             break;
+        case m2s_birsp:
+#ifdef EVENTLOG
+            log.CXLEventLog("Unpacked message on device " + s.msg.sprint() + "\n", this->node_id);
+#endif
+            birsp_received(s.msg);
+            m2s_birsp_ctr++;
+            break;
         case empty: // Do nothing
             break;
         default:
@@ -370,6 +395,8 @@ bool CXLDevice::FLIT_unpacker()
     flag = m2s_rwd_ctr <= 1 ? flag : false;
     // Max number of m2s_data is 4
     flag = m2s_data_ctr <= 4 ? flag : false;
+    // Max number of m2s_birsp is 2
+    flag = m2s_birsp_ctr <= 2 ? flag : false;
     CXL_ASSERT(flag && "Packing rule violated");
 
     // Dequeue the flit
@@ -417,6 +444,9 @@ bool CXLDevice::check_rx_vc(CXLBuf<message> &vc)
         // log.CXLEventLog("Ramulator buffer full\n", this->node_id);
         return false;
     }
+    // With back invalidation the hosts may first have to give up lines
+    if (snoop_filter != nullptr && !coherence_ready(vc.get_head()))
+        return false;
     // Convert from message to ramulator requests
     CXL_IF::ramulator_req req = message2ramulator_req(vc.get_head());
     // Add requests to ramulator input buffer
@@ -445,6 +475,84 @@ bool CXLDevice::check_rx_vc(CXLBuf<message> &vc)
     return true;
 }
 
+/*!
+Track the host of a request in the snoop filter as it enters the device and start the back invalidations it needs, so
+that the BISnp messages of all queued requests are in flight at the same time. Only host 0 is connected through the
+switch, the other hosts sharing the memory are not simulated: a line entering the filter is cached by one of them with
+probability bi_peer_share, and invalidating it there takes the round trip bi_peer_snoop without any flits on our links
+*/
+void CXLDevice::coherence_lookup(const message &m)
+{
+    uint64_t line = m.address & ~(uint64_t)0x3f;
+    coherence_wait w = {-1, curr_tick, {}};
+    uint64_t sharers = HOST_SHARER;
+    if (!snoop_filter->lookup(line) && std::uniform_real_distribution<double>(0.0, 1.0)(bi_rng) < params.bi_peer_share)
+        sharers |= PEER_SHARERS;
+    snoop_filter_victim victim;
+    if (snoop_filter->add_sharers(line, sharers, victim))
+    {
+        if (victim.sharers & HOST_SHARER)
+        {
+            message snp(opcode::BISnp, victim.line, 0, node_id);
+            S2M_BISnp.enqueue(snp);
+            lines_being_invalidated[victim.line]++;
+            w.lines.push_back(victim.line);
+            snoop_filter->stats.bisnp++;
+        }
+        if (victim.sharers & PEER_SHARERS)
+        {
+            w.peer_snoop_done = curr_tick + params.bi_peer_snoop;
+            snoop_filter->stats.peer_snoops++;
+        }
+    }
+    // Peers caching the line give it up, a read needs their dirty data and a write their copies gone
+    if (snoop_filter->sharers(line) & PEER_SHARERS)
+    {
+        w.peer_snoop_done = curr_tick + params.bi_peer_snoop;
+        snoop_filter->remove_sharers(line, PEER_SHARERS);
+        snoop_filter->stats.peer_snoops++;
+    }
+    // A line the host is still giving up can only be granted again after its BIRsp
+    if (lines_being_invalidated.count(line) == 1 && std::find(w.lines.begin(), w.lines.end(), line) == w.lines.end())
+        w.lines.push_back(line);
+    if (!w.lines.empty() || w.peer_snoop_done > curr_tick)
+        coherence_waits.insert({m.msg_id, w});
+}
+
+//! Returns true once the back invalidations a request started are done and it can go to the DRAM
+bool CXLDevice::coherence_ready(const message &m)
+{
+    auto it = coherence_waits.find(m.msg_id);
+    if (it == coherence_waits.end())
+        return true;
+    coherence_wait &w = it->second;
+    bool done = w.peer_snoop_done <= curr_tick;
+    for (uint64_t line : w.lines)
+        done = done && lines_being_invalidated.count(line) == 0;
+    // Only the time the request waits at the head of its VC delays it
+    if (!done && w.since < 0)
+    {
+        w.since = curr_tick;
+        snoop_filter->stats.blocked++;
+    }
+    if (!done)
+        return false;
+    if (w.since >= 0)
+        snoop_filter->stats.blocked_ticks += curr_tick - w.since;
+    coherence_waits.erase(it);
+    return true;
+}
+
+//! The host has invalidated a line it was sent a BISnp for
+void CXLDevice::birsp_received(const message &m)
+{
+    auto it = lines_being_invalidated.find(m.address);
+    CXL_ASSERT(it != lines_being_invalidated.end() && "BIRsp for a line that was not snooped");
+    snoop_filter->stats.birsp++;
+    if (--it->second == 0)
+        lines_being_invalidated.erase(it);
+}
+
 /*!< Send requests from the Req and RwD queues to ramulator input buffer*/
 bool CXLDevice::send_to_ramulator()
 {
@@ -538,36 +646,43 @@ bool CXLDevice::transmit()
     return true; // True means successfully dequeued
 }
 
+//! Picks the VC to pack from. Among the packable VC heads the traffic class is chosen by weighted arbitration, within a class VCs are served round robin
 bool CXLDevice::check_vcs_for_packing(std::array<CXLBuf<message>, NUM_VC> &vcs, CXLBuf<message> *&vc)
 {
+    int candidate[NUM_TC];               /*!< First packable VC of every traffic class in round robin order*/
+    std::vector<bool> ready(NUM_TC, false);
+    bool any_ready = false;
     for (int i = packer_cur_vc; i < NUM_VC + packer_cur_vc; i++)
     {
         if (!vcs[i % NUM_VC].is_buf_empty() && curr_tick - vcs[i % NUM_VC].get_head().time.tick_ramulator_complete >= params.delay_vc_to_pack)
         {
+            bool can_pack = false;
             switch (vcs[i % NUM_VC].get_head().opCode)
             {
             case opcode::NDR:
-                if (ext_creds[0].rsp_credit != 0)
-                {
-                    vc = &vcs[i % NUM_VC]; // assign
-                    packer_cur_vc = packer_cur_vc == NUM_VC - 1 ? 0 : i % NUM_VC + 1;
-                    return true;
-                }
+                can_pack = ext_creds[0].rsp_credit != 0;
                 break;
             case opcode::DRS:
-                if (ext_creds[0].data_credit != 0 && packer_seq_length < seq_threshold)
-                {
-                    vc = &vcs[i % NUM_VC]; // assign vc
-                    packer_cur_vc = packer_cur_vc == NUM_VC - 1 ? 0 : i % NUM_VC + 1;
-                    return true;
-                }
+                can_pack = ext_creds[0].data_credit != 0 && packer_seq_length < seq_threshold;
                 break;
             default:
                 CXL_ASSERT(false && "Illegal message type");
             }
+            int tc = vcs[i % NUM_VC].get_head().traffic_class;
+            if (can_pack && !ready[tc])
+            {
+                candidate[tc] = i;
+                ready[tc] = true;
+                any_ready = true;
+            }
         }
     }
-    return false;
+    if (!any_ready)
+        return false;
+    int i = candidate[packer_arb.pick(ready)];
+    vc = &vcs[i % NUM_VC]; // assign vc
+    packer_cur_vc = packer_cur_vc == NUM_VC - 1 ? 0 : i % NUM_VC + 1;
+    return true;
 }
 
 void CXLDevice::get_msg_from_vcs(CXLBuf<message> *&vc, bool &valid)
@@ -688,6 +803,9 @@ bool CXLDevice::skip_packer_check()
     // If there are messages in tc VCs then we need to make sure that the first #read port number of messages do not satisfy latency constraints
     if (packer_rollover != 0 || is_packer_waiting)
         return false;
+    // A BISnp that satisfies the latency gets packed
+    if (snoop_filter != nullptr && !S2M_BISnp.is_buf_empty() && curr_tick - S2M_BISnp.get_head().time.tick_created >= params.delay_vc_to_pack)
+        return false;
     // If all tx virtual channels are empty we can skip cycle
     bool flag = true;
     for (int i = 0; i < NUM_VC; i++)
@@ -891,6 +1009,9 @@ bool CXLDevice::FLIT_packer()
             packer_rollover--;
             continue;
         }
+        // BISnp messages go ahead of the responses, requests wait in the device until the host answers them
+        if (pack_bisnp(i))
+            continue;
         // Try to get a message from the VCs
         get_msg_from_vcs(vc, valid);
         if (!valid)
@@ -906,6 +1027,7 @@ bool CXLDevice::FLIT_packer()
                     flit_to_pack.header.slots[i] = slot_type::s2m_ndr;
                     flit_to_pack.slots[i].type = slot_type::s2m_ndr;
                     flit_to_pack.slots[i].msg.copy(vc->get_head());
+                    report_dev_load(flit_to_pack.slots[i].msg);
                     // Free data credit when you pack an NDR. This means that we can accept one more write
                     int_cred.data_credit++;
                     // Decrement rsp credits
@@ -924,6 +1046,7 @@ bool CXLDevice::FLIT_packer()
                     flit_to_pack.slots[i].type = slot_type::s2m_drs_hdr;
                     last_drs_hdr.copy(vc->get_head());
                     flit_to_pack.slots[i].msg.copy(vc->get_head());
+                    report_dev_load(flit_to_pack.slots[i].msg);
                     packer_rollover = 4;
                     // Decrement data credits
                     ext_creds[0].data_credit--;
@@ -948,6 +1071,7 @@ bool CXLDevice::FLIT_packer()
     int drs_count = flit_to_pack.slot_count_in_flit(slot_type::s2m_drs_hdr);
     int ndr_count = flit_to_pack.slot_count_in_flit(slot_type::s2m_ndr);
     int data_count = flit_to_pack.slot_count_in_flit(slot_type::data);
+    int bisnp_count = flit_to_pack.slot_count_in_flit(slot_type::s2m_bisnp);
 
     // Packing rule check
     bool flag = false; // True means some error has occured;
@@ -957,12 +1081,29 @@ bool CXLDevice::FLIT_packer()
         flag = true;
     if (drs_count > 1 || drs_count < 0)
         flag = true;
-    if (drs_count + data_count + ndr_count > 4)
+    if (bisnp_count > 2 || bisnp_count < 0)
+        flag = true;
+    if (drs_count + data_count + ndr_count + bisnp_count > 4)
         flag = true;
     CXL_ASSERT(!flag && "Packing rule violated on packer side");
     return active_flag;
 }
 
+//! Put the oldest BISnp into slot i. BI channels have no credits in this model, the host always has room for a snoop
+bool CXLDevice::pack_bisnp(int i)
+{
+    if (snoop_filter == nullptr || S2M_BISnp.is_buf_empty() || curr_tick - S2M_BISnp.get_head().time.tick_created < params.delay_vc_to_pack)
+        return false;
+    // Same limit as for NDR, two BISnp per flit
+    if (flit_to_pack.slot_count_in_flit(slot_type::s2m_bisnp) > 1)
+        return false;
+    flit_to_pack.header.slots[i] = slot_type::s2m_bisnp;
+    flit_to_pack.slots[i].type = slot_type::s2m_bisnp;
+    flit_to_pack.slots[i].msg.copy(S2M_BISnp.get_head());
+    S2M_BISnp.dequeue();
+    return true;
+}
+
 // //! Returns node id of the destination CXL Device by looking at the address
 // uint CXLDevice::destination_device(uint64_t addr)
 // {
@@ -983,6 +1124,57 @@ bool CXLDevice::FLIT_packer()
 //     return dest;
 // }
 
+//! Classify the device load from the occupancy of the request queues and the requests inside ramulator
+int CXLDevice::current_dev_load()
+{
+    int occupancy = M2S_Req.buf_occupancy() + M2S_RWD.buf_occupancy() + messages_in_ramulator.size();
+    if (occupancy >= params.devload_severe)
+        return dev_load_type::severe_overload;
+    if (occupancy >= params.devload_moderate)
+        return dev_load_type::moderate_overload;
+    if (occupancy >= params.devload_optimal)
+        return dev_load_type::optimal_load;
+    return dev_load_type::light_load;
+}
+
+//! Put the current DevLoad into a response that is being packed
+void CXLDevice::report_dev_load(message &m)
+{
+    m.dev_load = current_dev_load();
+    dev_load_reported[m.dev_load]++;
+}
+
+//! Add the device's queue depths, DRAM backlog and credits to the current sample
+void CXLDevice::sample(CXLSampler &s)
+{
+    int ndr_vc = 0, drs_vc = 0;
+    for (int i = 0; i < NUM_VC; i++)
+    {
+        ndr_vc += S2M_NDR[i].buf_occupancy();
+        drs_vc += S2M_DRS[i].buf_occupancy();
+    }
+    s.set_prefix("dev" + std::to_string(node_id) + "_");
+    s.add("m2s_req_vc", M2S_Req.buf_occupancy());
+    s.add("m2s_rwd_vc", M2S_RWD.buf_occupancy());
+    s.add("s2m_ndr_vc", ndr_vc);
+    s.add("s2m_drs_vc", drs_vc);
+    s.add("tx_buf", tx_buffer.buf_occupancy());
+    s.add("rx_buf", rx_buffer.buf_occupancy());
+    s.add("in_dram", messages_in_ramulator.size());
+    s.add("dev_load", current_dev_load());
+    s.add("int_req_credit", int_cred.req_credit);
+    s.add("int_data_credit", int_cred.data_credit);
+    s.add("ext_rsp_credit", ext_creds[0].rsp_credit);
+    s.add("ext_data_credit", ext_creds[0].data_credit);
+    s.add("packer_rollover", packer_rollover);
+    if (snoop_filter != nullptr)
+    {
+        s.add("bisnp_vc", S2M_BISnp.buf_occupancy());
+        s.add("bi_lines", lines_being_invalidated.size());
+        s.add("bi_waiting", coherence_waits.size());
+    }
+}
+
 //! Print all the skipped cycles for each of the component functions within device update
 void CXLDevice::print_skipped_cycles()
 {
@@ -994,5 +1186,20 @@ void CXLDevice::print_skipped_cycles()
     std::cout << "Transmit " << empty_cycle_transmit << "\n";
     std::cout << "Send to ramulator " << empty_cycle_sent_to_ram << "\n";
     std::cout << "Skippable cycle " << skippable_cycle << "\n";
+    std::cout << "DevLoad reported (light/optimal/moderate/severe) " << dev_load_reported[0] << "/" << dev_load_reported[1] << "/" << dev_load_reported[2] << "/" << dev_load_reported[3] << "\n";
+    std::cout << "=====================================================\n";
+}
+
+//! Print the snoop filter and back invalidation statistics, nothing if coherence is not modeled
+void CXLDevice::print_coherence_stats()
+{
+    if (snoop_filter == nullptr)
+        return;
+    snoop_filter_stats &st = snoop_filter->stats;
     std::cout << "=====================================================\n";
-}
\ No newline at end of file
+    std::cout << "Back invalidation summary of device " << node_id << "\n";
+    std::cout << "Snoop filter " << snoop_filter->capacity() << " lines, " << params.bi_snoop_filter_ways << " ways, lookups " << st.lookups << " hits " << st.hits << " evictions " << st.evictions << "\n";
+    std::cout << "BISnp sent " << st.bisnp << " BIRsp received " << st.birsp << " peer snoops " << st.peer_snoops << "\n";
+    std::cout << "Requests blocked " << st.blocked << " for " << (st.blocked > 0 ? (double)st.blocked_ticks / st.blocked : 0) << " ticks on average\n";
+    std::cout << "=====================================================\n";
+}
@@ -12,13 +12,15 @@ namespace CXL
     extern int64_t curr_tick;
     extern CXLParams params;
     extern CXLLog log;
+    extern CXLTimeline timeline;
     extern uint64_t num_reqs_completed;
+    extern uint64_t num_dam_reqs;
     #ifdef TRACK_LATENCY
         extern std::string latency_file_prefix;
     #endif
 }
 
-CXLHost::CXLHost() : CXLNode(), text_to_trace_buf(20)
+CXLHost::CXLHost() : CXLNode()
 {
     this->node_id = 0;
     packer_rollover = 0;
@@ -28,6 +30,10 @@ CXLHost::CXLHost() : CXLNode(), text_to_trace_buf(20)
     Req_packed = 0;
     last_transmitted_at = 0;
     trace_line_pending = 0;
+    cores.resize(1);
+    next_core = 0;
+    issue_budget = INT64_MAX;
+    issue_stats = nullptr;
     rcvd_rsp_state = round_robin_state::R;
     is_trace_finished = false;
     started_packing_at = 0;
@@ -36,12 +42,16 @@ CXLHost::CXLHost() : CXLNode(), text_to_trace_buf(20)
     req_ctr = 0;
     rwd_ctr = 0;
     is_packer_waiting = false;
+    pf_stats = {0, 0, 0, 0, 0, 0, 0, 0, 0};
+    qos_throttle_reject_ctr = 0;
+    for (int tc = 0; tc < NUM_TC; tc++)
+        amat_per_tc[tc][0] = amat_per_tc[tc][1] = 0;
     // Initialize your own credits counter to the max size -1 of your available NDR and DRS VCs
     int_cred = {0, S2M_NDR.size() - S2M_NDR.buf_occupancy(), S2M_DRS.size() - S2M_DRS.buf_occupancy()};
     log.CXLEventLog("Internal Credit initialization [" + print_cred(int_cred) + "]\n", this->node_id);
 }
 
-CXLHost::CXLHost(int vc_size, int buf_size, uint node_id) : CXLNode(vc_size, buf_size), text_to_trace_buf(20), S2M_DRS(1024), S2M_NDR(1024)
+CXLHost::CXLHost(int vc_size, int buf_size, uint node_id) : CXLNode(vc_size, buf_size), S2M_DRS(1024), S2M_NDR(1024), S2M_BISnp(1024), prefetch_queue(params.prefetch_queue_size)
 {
     for (int i = 0; i < NUM_VC; i++)
     {
@@ -59,6 +69,10 @@ CXLHost::CXLHost(int vc_size, int buf_size, uint node_id) : CXLNode(vc_size, buf
     Req_packed = 0;
     last_transmitted_at = 0;
     trace_line_pending = 0;
+    cores.resize(1);
+    next_core = 0;
+    issue_budget = INT64_MAX;
+    issue_stats = nullptr;
     rcvd_rsp_state = round_robin_state::R;
     is_trace_finished = false;
     started_packing_at = 0;
@@ -84,19 +98,31 @@ CXLHost::CXLHost(int vc_size, int buf_size, uint node_id) : CXLNode(vc_size, buf
     ofstream temp2(latency_file_prefix+"_dam.csv");
     temp2.close();
 #endif
-    last_text_to_trace_buf_dequeue = 0;
     int_credit_reject_ctr = 0;
     ext_credit_reject_ctr = 0;
     total_credit_checks = 0;
+    // Create the prefetcher, stays nullptr if prefetching is disabled
+    prefetcher.reset(make_prefetcher(params.prefetcher, params.prefetch_degree, params.prefetch_distance));
+    pf_stats = {0, 0, 0, 0, 0, 0, 0, 0, 0};
+    // Create the write buffer, stays nullptr if writes go straight to the VCs
+    if (params.write_buffer_size > 0)
+        write_buffer.reset(new CXLWriteBuffer(params.write_buffer_size, params.write_buffer_high, params.write_buffer_low, (write_drain_policy)params.write_drain_policy));
+    qos_throttle_reject_ctr = 0;
+    for (int tc = 0; tc < NUM_TC; tc++)
+        amat_per_tc[tc][0] = amat_per_tc[tc][1] = 0;
     printf("Host, %d,%d,%d,%d\n", M2S_Req[0].size() * M2S_Req.size(), tx_buffer.size(), S2M_DRS.size(), rx_buffer.size());
 }
 
 void CXLHost::update()
 {
     // Get trace
-    if (!is_trace_finished || !text_to_trace_buf.is_buf_empty())
-        if (!text_to_trace()) // Get trace line by line. If all entries in trace file are done, set is_trace_finished to true
-            is_trace_finished = true;
+    if (!is_trace_finished)
+        is_trace_finished = !text_to_trace(); // Get trace line by line. False once the traces of all cores are done
+    // Buffered writes and prefetches go on the VCs after the demand accesses of this tick
+    if (write_buffer != nullptr)
+        drain_write_buffer();
+    if (prefetcher != nullptr)
+        issue_prefetch();
     // Check that no extra external credits are added
     CXL_ASSERT(ext_creds.size() == connected_devices.size() && "External credits for unknown device added");
 
@@ -165,6 +191,9 @@ bool CXLHost::no_active_transaction()
     //2. Host Rx buffers are empty
     //3. The messages_sent_to_device map is empty i.e, there are no CXL reqs that have been sent to device but yet to be fulfilled
     //4. The reqs_in_dam map is emmpty i.e., there are no DAM reqs sent to device but yet to be fulfilled
+    //5. There are no prefetches waiting to be put on the VCs
+    //6. The write buffer does not want to drain. Writes it holds back until a watermark do not change anything while skipping
+    //7. No BISnp from a device is waiting for its BIRsp
 
     //Return true if there is no active transaction
 
@@ -178,7 +207,8 @@ bool CXLHost::no_active_transaction()
         }
     }
     return tx_buf_empty && S2M_DRS.is_buf_empty() && S2M_NDR.is_buf_empty() && 
-           reqs_in_dam.empty() && messages_sent_to_device.empty();
+           reqs_in_dam.empty() && messages_sent_to_device.empty() && prefetch_queue.is_buf_empty() && !write_drain_due() &&
+           S2M_BISnp.is_buf_empty();
 }
 
 void CXLHost::register_device(uint64_t device_id, const std::pair<uint64_t, uint64_t> &addr_interval)
@@ -193,6 +223,9 @@ void CXLHost::register_device(uint64_t device_id, const std::pair<uint64_t, uint
     // Initialize credit counters
     credits crd = {1, 0, 1}; // Downstream CXLDevice will only have req and data credits not rsp credits
     ext_creds.insert({device_id, crd});
+    // Throttling starts fully open and closes once the device reports overload
+    qos_throttle_state thr = {params.qos_window_max, 0, 0};
+    throttle.insert({device_id, thr});
 }
 
 void CXLHost::register_DAM(ramulator::DirectAttached *dam, const std::pair<uint64_t, uint64_t> &addr_interval)
@@ -274,6 +307,7 @@ bool CXLHost::FLIT_unpacker()
     int s2m_ndr_ctr = f.slot_count_in_flit(slot_type::s2m_ndr);
     int s2m_drs_ctr = f.slot_count_in_flit(slot_type::s2m_drs_hdr);
     int s2m_data_ctr = f.slot_count_in_flit(slot_type::data);
+    int s2m_bisnp_ctr = f.slot_count_in_flit(slot_type::s2m_bisnp);
 
     // Packing rule checks
     // For 68B flit, data rollover cannot be more than 4 TODO: take care of packing rules for other flit types
@@ -308,6 +342,8 @@ bool CXLHost::FLIT_unpacker()
         flag = false;
     if (s2m_drs_ctr > 1 || s2m_drs_ctr < 0)
         flag = false;
+    if (s2m_bisnp_ctr > 2 || s2m_bisnp_ctr < 0)
+        flag = false;
     CXL_ASSERT(flag && "Packing rule violated");
 
     // TODO Add more packing rules
@@ -357,6 +393,14 @@ bool CXLHost::FLIT_unpacker()
             unpacker_rollover = 4; // TODO: May need to paramterize the 4 later
             last_drs_hdr.copy(s.msg);
             break;
+        case s2m_bisnp:
+#ifdef EVENTLOG
+            log.CXLEventLog("Unpacked message on host " + s.msg.sprint() + "\n", this->node_id);
+#endif
+            // The snoop of the host starts now, see pack_birsp
+            s.msg.time.tick_resp_unpacked = curr_tick;
+            S2M_BISnp.enqueue(s.msg);
+            break;
         case data:
             CXL_ASSERT(unpacker_rollover > 0 && "Data received when not expected!");
             unpacker_rollover--;
@@ -435,130 +479,165 @@ std::map<int, credits> *CXLHost::get_cred()
     return &ext_creds;
 }
 
-std::vector<std::string> split(const std::string &s, char delim)
+//! Convert traces from the text files into messages and put them on the VCs. Every core issues at most one access per
+//! tick, and the core that goes first changes every tick so that no core gets the shared VCs and DAM buffer to itself
+bool CXLHost::text_to_trace()
 {
-    std::vector<std::string> result;
-    std::stringstream ss(s);
-    std::string item;
-
-    while (getline(ss, item, delim))
+    // Check if the system is inactive, if so advance curr tick by the gap required to issue the next request of any core
+    if (no_active_transaction())
     {
-        result.push_back(item);
+        int64_t skip = INT64_MAX;
+        for (CXLCore &core : cores)
+        {
+            // A core that has not read its next access yet might need to issue right away
+            if (core.text_to_trace_buf.is_buf_empty() && !core.is_done())
+            {
+                skip = 0;
+                break;
+            }
+            if (!core.text_to_trace_buf.is_buf_empty())
+                skip = std::min(skip, core.ticks_to_next_issue());
+        }
+        if (skip != INT64_MAX && skip > 0)
+        {
+            int64_t curr_tick_before = curr_tick;
+            curr_tick += skip;
+            //While the host n device may be inactive, there might still be cycles in the ramulator itself. We need to continue these cycles. For this purpose, when we skip we update ramulator as many number of times as it would have without skipping
+            for(int64_t i=((curr_tick_before/6)+1)*6;i<=curr_tick;i+=6)
+            {
+                if(i!=curr_tick)
+                    DAM->update();
+                for(ramulator::RamDevice *ram_ptr: device_memories)
+                {
+                    ram_ptr->update();
+                }
+            }
+        }
     }
 
-    return result;
+    bool active = false;
+    for (size_t i = 0; i < cores.size(); i++)
+    {
+        int c = (next_core + i) % cores.size();
+        CXLCore &core = cores[c];
+        // With the core model, the instruction stream stops while the ROB is full or the next load cannot issue yet
+        bool stalled = params.core_model && core.core_stalled();
+        // A core whose access is waiting for space in a VC or the DAM buffer does not read the next one this tick
+        if (stalled || !core.is_due() || issue_budget == 0 || issue_from_core(c))
+            core.refill();
+        active |= !core.is_done();
+    }
+    next_core = (next_core + 1) % cores.size();
+    return active; // False means the traces of all cores have ended and all their accesses are issued
 }
 
-//! Convert traces from the text file into messages and put them on the VCs
-bool CXLHost::text_to_trace()
+//! Move the access at the head of the core's buffer to the VCs or the DAM buffer. Returns false if its VC is full
+bool CXLHost::issue_from_core(int c)
 {
+    CXLCore &core = cores[c];
+    uint64_t gap = core.text_to_trace_buf.get_head().first;
+    core.start_issue();
 
-    // Check if the system is inactive, if so advance curr tick by the gap required to issue next request
-    if (no_active_transaction() && !text_to_trace_buf.is_buf_empty())
+    // Check if message belongs to DAM
+    message t = core.text_to_trace_buf.get_head().second;
+    if (tier_of(t.address) == dam_tier)
     {
-        int64_t curr_tick_before=curr_tick;
-        curr_tick += (text_to_trace_buf.get_head().first * params.ticks_per_ins) - (curr_tick - last_text_to_trace_buf_dequeue);
-        //While the host n device may be inactive, there might still be cycles in the ramulator itself. We need to continue these cycles. For this purpose, when we skip we update ramulator as many number of times as it would have without skipping
-        for(int64_t i=((curr_tick_before/6)+1)*6;i<=curr_tick;i+=6)
+        if (DAM->inp_buf.isFull())
+            return true;
+        CXL_IF::ramulator_req req = message2ramulator_req(t);
+        // Send to the DAM
+        DAM->inp_buf.buf_add(req);
+        reqs_in_dam.insert({req.req_id, curr_tick});
+        if (params.core_model)
         {
-            if(i!=curr_tick)
-                DAM->update();
-            for(ramulator::RamDevice *ram_ptr: device_memories)
-            {
-                ram_ptr->update();
-            }
+            core.core_dispatch(t, gap);
+            core.core_issued(t, gap);
         }
+        // Dequeue buffer
+        core.text_to_trace_buf.dequeue();
+        issue_budget--;
+        if (issue_stats != nullptr)
+            issue_stats->add(t, gap, dam_tier, c);
+#ifdef EVENTLOG
+        log.CXLEventLog("Created message from trace " + t.sprint() + "\n", node_id);
+        log.CXLEventLog("Sent req to DAM " + t.sprint() + "\n", DAM->node_id);
+#endif
+        return true;
     }
 
-    // Move messages from the text to trace buf to the VCs or DAM buffer using round robin if buffer is not empty and we have waited for enough time between message generations
-    if (!text_to_trace_buf.is_buf_empty() && (curr_tick - last_text_to_trace_buf_dequeue >= text_to_trace_buf.get_head().first * params.ticks_per_ins))
+    message temp;
+    temp.copy(core.text_to_trace_buf.get_head().second);
+    temp.time.tick_created = curr_tick;
+    bool sent_to_vc = true; /*!< False if the demand was serviced by a prefetch and never goes on the link*/
+    switch (temp.opCode)
     {
-        last_text_to_trace_buf_dequeue = curr_tick;
-
-        // Check if message belongs to DAM
-        message t = text_to_trace_buf.get_head().second;
-        if (DAM != nullptr && t.address >= DAM_addr.first && t.address < DAM_addr.second)
+    case opcode::Req:
+        temp.time.read_write = false;
+        // The load enters the core window before the prefetch lookup, a timely prefetch retires it right away
+        if (params.core_model)
+            core.core_dispatch(temp, gap);
+        // Reads to lines that were prefetched are serviced without going on the link
+        if (prefetcher != nullptr && prefetch_lookup(temp))
         {
-            if (!DAM->inp_buf.isFull())
-            {
-                CXL_IF::ramulator_req req = message2ramulator_req(t);
-                // Send to the DAM
-                DAM->inp_buf.buf_add(req);
-                reqs_in_dam.insert({req.req_id, curr_tick});
-                // Dequeue buffer
-                text_to_trace_buf.dequeue();
-#ifdef EVENTLOG
-                log.CXLEventLog("Created message from trace " + t.sprint() + "\n", node_id);
-                log.CXLEventLog("Sent req to DAM " + t.sprint() + "\n", DAM->node_id);
-#endif
-            }
+            sent_to_vc = false;
+            break;
         }
-        else
+        // Reads to lines in the write buffer get the buffered data
+        if (write_buffer != nullptr && write_buffer->forward(temp.address))
         {
-            message temp;
-            temp.copy(text_to_trace_buf.get_head().second);
-            temp.time.tick_created = curr_tick;
-            // temp.copy(text_to_trace_buf.get_head());
-            switch (temp.opCode)
-            {
-            case opcode::Req:
-                if (M2S_Req[cur_Req_vc].is_buf_full())
-                    return true;
-                temp.time.read_write = false;
-                M2S_Req[cur_Req_vc].enqueue(temp);
-                cur_Req_vc = cur_Req_vc == NUM_VC - 1 ? 0 : cur_Req_vc + 1;
+            temp.time.tick_req_complete = curr_tick + params.delay_vc_to_retire;
+            retire_demand(temp);
+            sent_to_vc = false;
+            break;
+        }
+        if (M2S_Req[select_vc(temp, cur_Req_vc)].is_buf_full())
+            return false;
+        M2S_Req[select_vc(temp, cur_Req_vc)].enqueue(temp);
+        cur_Req_vc = cur_Req_vc == NUM_VC - 1 ? 0 : cur_Req_vc + 1;
+        if (prefetcher != nullptr)
+            pf_stats.demand_misses++;
 #ifdef EVENTLOG
-                log.CXLEventLog("Created message from trace " + temp.sprint() + "\n", this->node_id);
+        log.CXLEventLog("Created message from trace " + temp.sprint() + "\n", this->node_id);
 #endif
-                break;
-            case opcode::RwD:
-                if (M2S_RWD[cur_RWD_vc].is_buf_full())
-                    return true;
+        break;
+    case opcode::RwD:
+        temp.time.read_write = true;
+        // Posted write, it completes as soon as the write buffer takes it and goes to the device later
+        if (write_buffer != nullptr)
+        {
+            if (!write_buffer->post(temp))
+                return false;
 #ifdef EVENTLOG
-                log.CXLEventLog("Created message from trace " + temp.sprint() + "\n", this->node_id);
+            log.CXLEventLog("Posted write from trace " + temp.sprint() + "\n", this->node_id);
 #endif
-                temp.time.read_write = true;
-                M2S_RWD[cur_RWD_vc].enqueue(temp);
-                cur_RWD_vc = cur_RWD_vc == NUM_VC - 1 ? 0 : cur_RWD_vc + 1;
-                break;
-            default:
-                CXL_ASSERT(false && "Illegal message type");
-            }
-            text_to_trace_buf.dequeue();
-            // Add this message to the std map keeping track of all messages sent to the devices
-            messages_sent_to_device.insert({temp.msg_id, temp});
+            num_reqs_completed++;
+            sent_to_vc = false;
+            break;
         }
+        if (M2S_RWD[select_vc(temp, cur_RWD_vc)].is_buf_full())
+            return false;
+#ifdef EVENTLOG
+        log.CXLEventLog("Created message from trace " + temp.sprint() + "\n", this->node_id);
+#endif
+        M2S_RWD[select_vc(temp, cur_RWD_vc)].enqueue(temp);
+        cur_RWD_vc = cur_RWD_vc == NUM_VC - 1 ? 0 : cur_RWD_vc + 1;
+        break;
+    default:
+        CXL_ASSERT(false && "Illegal message type");
     }
-    // If the text_to_trace buf is full, skip creating new messages, but return true to show that file has not ended yet
-    if (text_to_trace_buf.is_buf_full())
-        return true;
-
-    // If the buffer is not full we can put stuff into it now
-    std::string s;
-    // Create message from a line of text in the trace file
-    if (!std::getline(trace_in, s))
-        return false; // False means file has ended
-
-    // Process the line
-    // Split string at the spaces
-    std::vector<std::string> words = split(s, ' ');
-    CXL_ASSERT(words.size() == 3 && "Incorrect string splitting");
-    // Make the first word the address and the second word the type
-    uint64_t addr = (uint64_t)stoul(words[0], NULL, 0);
-    opcode opCode;
-    if (words[1].compare("R") == 0)
-        opCode = opcode::Req;
-    else if (words[1].compare("W") == 0)
-        opCode = opcode::RwD;
-    else
-        CXL_ASSERT(false && "Illegal opcode");
-    // The third word is the number of instructions executed by CPU before this access
-    uint64_t clk_interval = (uint64_t)stoul(words[2], NULL, 0);
-
-    // Create the message to be put on the buffer and then later onto the virtual channels
-    message m = message(opCode, addr);
-    text_to_trace_buf.enqueue(std::pair<uint64_t, message>(clk_interval, m));
-    return true; // True means file has not ended
+    core.text_to_trace_buf.dequeue();
+    issue_budget--;
+    if (issue_stats != nullptr)
+        issue_stats->add(temp, gap, cxl_tier, c);
+    if (params.core_model)
+        core.core_issued(temp, gap);
+    // Add this message to the std map keeping track of all messages sent to the devices
+    if (sent_to_vc)
+        messages_sent_to_device.insert({temp.msg_id, temp});
+    // Train the prefetcher on the demand read stream
+    if (prefetcher != nullptr && temp.opCode == opcode::Req)
+        train_prefetcher(temp.address, temp.traffic_class);
+    return true;
 }
 
 // bool CXLHost::text_to_trace()
@@ -641,10 +720,19 @@ bool CXLHost::text_to_trace()
 //     return true;
 // }
 
-void CXLHost::set_trace_file(std::string filename)
+void CXLHost::set_trace_file(std::string filename, int core)
 {
     // Load trace file
-    trace_in.open(filename);
+    if ((int)cores.size() <= core)
+        cores.resize(core + 1);
+    cores[core].set_trace_file(filename);
+}
+
+bool CXLHost::set_trace_ring(std::string filename, uint64_t capacity, int core)
+{
+    if ((int)cores.size() <= core)
+        cores.resize(core + 1);
+    return cores[core].set_trace_ring(filename, capacity);
 }
 
 //! Function checks given VC to see if there is some request whose response is received
@@ -659,32 +747,24 @@ bool CXLHost::check_rx_vc(CXLBuf<message> &vc)
     message m = vc.get_head();
     // Set message completion time
     m.time.tick_req_complete = curr_tick;
+    if (timeline.is_sampled(m.msg_id, m.time.tick_created))
+        timeline.add_message(m);
     // Check if the message id of the VC head is present in the std map, or else raise an error
     CXL_ASSERT(messages_sent_to_device.count(m.msg_id) == 1 && "Response received is for an unknown request");
 #ifdef DUMP
     // Store the completed memory access' timing data
     timing_tracker.insert({m.msg_id, m.time});
 #endif
-    auto& entry = amat_per_table_cxl[(m.address >> 48) & 0xFFF];
-    auto& count = entry[0];
-    auto& avg = entry[1];
-    auto& avg_dram = entry[2];
-    ++count;
-    avg = avg + (m.time.tick_req_complete - m.time.tick_created - avg) / count;
-    avg_dram = avg_dram + (m.time.tick_ramulator_complete - m.time.tick_at_ramulator - avg_dram) / count;
-    
-#ifdef TRACK_LATENCY
-    // latency_data.push_back(m.time.tick_req_complete - m.time.tick_created);
-    // ram_latency_data.push_back(m.time.tick_ramulator_complete - m.time.tick_at_ramulator);
-    print_latency_verbose(m.time);
-#endif
+    // Every response carries the load of the device, use it to open or close the throttling window
+    update_throttle(m);
+    // Prefetch responses are not part of the trace, they only fill the prefetch table
+    if (m.is_prefetch)
+        prefetch_arrived(m);
+    else
+        retire_demand(m);
 
     // Remove message from the std map
     messages_sent_to_device.erase(m.msg_id);
-    if (num_reqs_completed % 100000 == 0)
-        std::cout << num_reqs_completed << " reqs completed!\n";
-    // Increment the num reqs completed counter
-    num_reqs_completed++;
     // Once requests are completed we can free internal credits to send to new devices
     switch (m.opCode)
     {
@@ -705,6 +785,43 @@ bool CXLHost::check_rx_vc(CXLBuf<message> &vc)
     return true;
 }
 
+//! Account for a completed demand access from the trace. Updates the per table AMAT and the completed request counter.
+//! Posted writes already completed when they were buffered, only the device latency of the drained line is accounted
+void CXLHost::retire_demand(message &m)
+{
+    if (!m.is_posted)
+        core_retire(m.msg_id);
+    auto& entry = amat_per_table_cxl[(m.address >> 48) & 0xFFF];
+    auto& count = entry[0];
+    auto& avg = entry[1];
+    auto& avg_dram = entry[2];
+    ++count;
+    avg = avg + (m.time.tick_req_complete - m.time.tick_created - avg) / count;
+    avg_dram = avg_dram + (m.time.tick_ramulator_complete - m.time.tick_at_ramulator - avg_dram) / count;
+    // Keep the 7 most significant bits of the latency so the histogram stays small
+    uint64_t latency = m.time.tick_req_complete - m.time.tick_created;
+    int shift = 0;
+    while ((latency >> shift) >= 128)
+        shift++;
+    latency_histogram[(latency >> shift) << shift]++;
+    auto &tc_entry = amat_per_tc[m.traffic_class];
+    ++tc_entry[0];
+    tc_entry[1] = tc_entry[1] + (m.time.tick_req_complete - m.time.tick_created - tc_entry[1]) / tc_entry[0];
+
+#ifdef TRACK_LATENCY
+    // latency_data.push_back(m.time.tick_req_complete - m.time.tick_created);
+    // ram_latency_data.push_back(m.time.tick_ramulator_complete - m.time.tick_at_ramulator);
+    print_latency_verbose(m.time);
+#endif
+    if (m.is_posted)
+        return;
+
+    if (num_reqs_completed % 100000 == 0)
+        std::cout << num_reqs_completed << " reqs completed!\n";
+    // Increment the num reqs completed counter
+    num_reqs_completed++;
+}
+
 //! Function checks if there is any message in the received VCs and ensures that the address corresponds to a sent request and removes that request from the map
 bool CXLHost::check_if_req_completed()
 {
@@ -925,6 +1042,11 @@ bool CXLHost::check_vcs_for_packing(std::array<CXLBuf<message>, NUM_VC> &vcs, CX
         if (!vcs[i % NUM_VC].is_buf_empty() && curr_tick - vcs[i % NUM_VC].get_head().time.tick_created >= params.delay_vc_to_pack)
         {
             int dest = destination_device(vcs[i % NUM_VC].get_head().address);
+            if (is_throttled(vcs[i % NUM_VC].get_head(), dest))
+            {
+                qos_throttle_reject_ctr++;
+                continue;
+            }
             if (device_under_consideration == 4096 || device_under_consideration == dest)
             {
                 switch (vcs[i % NUM_VC].get_head().opCode)
@@ -952,6 +1074,9 @@ bool CXLHost::check_vcs_for_packing(std::array<CXLBuf<message>, NUM_VC> &vcs, CX
                         return true;
                     }
                     break;
+                default:
+                    // BIRsp are packed straight from S2M_BISnp, only requests and writes wait in the M2S VCs
+                    CXL_ASSERT(false && "Illegal message type in M2S VC");
                 }
             }
         }
@@ -1019,6 +1144,9 @@ bool CXLHost::skip_packer_check()
     // If there are messages in tc VCs then we need to make sure that the first #read port number of messages do not satisfy latency constraints
     if (packer_rollover != 0 || is_packer_waiting)
         return false;
+    // A BISnp whose snoop is done gets its BIRsp packed
+    if (!S2M_BISnp.is_buf_empty() && curr_tick - S2M_BISnp.get_head().time.tick_resp_unpacked >= params.bi_host_snoop)
+        return false;
     // If all tx VCs are empty, we can skip cycle
     bool flag = true;
     for (int i = 0; i < NUM_VC; i++)
@@ -1216,6 +1344,9 @@ bool CXLHost::FLIT_packer()
             packer_rollover--;
             continue;
         }
+        // Back invalidate responses go first, the device holds a request back until it has them
+        if (pack_birsp(i))
+            continue;
         // Try to get a message from the VCs
         get_msg_from_vcs(vc, valid);
         if (!valid)
@@ -1241,6 +1372,8 @@ bool CXLHost::FLIT_packer()
                     log.CXLEventLog("Decrement req creds\n", this->node_id);
 #endif
                     ext_creds[destination_device(vc->get_head().address)].req_credit--;
+                    if (vc->get_head().traffic_class >= params.qos_throttle_min_tc)
+                        throttle[destination_device(vc->get_head().address)].outstanding++;
                     // Erase from VC
                     vc->dequeue();
                     // Decrement internal credits
@@ -1259,6 +1392,8 @@ bool CXLHost::FLIT_packer()
                     packer_rollover = 4;
                     // Decrement the data credits
                     ext_creds[destination_device(vc->get_head().address)].data_credit--;
+                    if (vc->get_head().traffic_class >= params.qos_throttle_min_tc)
+                        throttle[destination_device(vc->get_head().address)].outstanding++;
 #ifdef EVENTLOG
                     log.CXLEventLog("Decrement data creds\n", this->node_id);
 #endif
@@ -1285,6 +1420,7 @@ bool CXLHost::FLIT_packer()
     int req_count = flit_to_pack.slot_count_in_flit(slot_type::m2s_req);
     int rwd_count = flit_to_pack.slot_count_in_flit(slot_type::m2s_rwd_hdr);
     int data_count = flit_to_pack.slot_count_in_flit(slot_type::data);
+    int birsp_count = flit_to_pack.slot_count_in_flit(slot_type::m2s_birsp);
 
     // Packing rule check
     bool flag = false; // True means some error has occured;
@@ -1294,12 +1430,34 @@ bool CXLHost::FLIT_packer()
         flag = true;
     if (rwd_count > 1 || rwd_count < 0)
         flag = true;
-    if (rwd_count + data_count + req_count > 4)
+    if (birsp_count > 2 || birsp_count < 0)
+        flag = true;
+    if (rwd_count + data_count + req_count + birsp_count > 4)
         flag = true;
     CXL_ASSERT(!flag && "Packing rule violated on packer side");
     return active_flag;
 }
 
+//! Answer the oldest BISnp with a BIRsp in slot i once the host has had the time to invalidate the line. The host has no
+//! cache model, so the line is always clean and the BIRsp carries no data
+bool CXLHost::pack_birsp(int i)
+{
+    if (S2M_BISnp.is_buf_empty() || curr_tick - S2M_BISnp.get_head().time.tick_resp_unpacked < params.bi_host_snoop)
+        return false;
+    uint dest = destination_device(S2M_BISnp.get_head().address);
+    if (device_under_consideration != 4096 && device_under_consideration != dest)
+        return false;
+    // Same limit as for requests, two BIRsp per flit
+    if (flit_to_pack.slot_count_in_flit(slot_type::m2s_birsp) > 1)
+        return false;
+    device_under_consideration = dest;
+    flit_to_pack.slots[i].type = slot_type::m2s_birsp;
+    flit_to_pack.slots[i].msg.copy(S2M_BISnp.get_head());
+    flit_to_pack.slots[i].msg.opCode = opcode::BIRsp;
+    S2M_BISnp.dequeue();
+    return true;
+}
+
 //! Returns node id of the destination CXL Device by looking at the address
 uint CXLHost::destination_device(uint64_t addr)
 {
@@ -1320,6 +1478,478 @@ uint CXLHost::destination_device(uint64_t addr)
     return dest;
 }
 
+//! Returns true if the address belongs to one of the CXL devices connected to this host
+bool CXLHost::is_cxl_address(uint64_t addr)
+{
+    for (auto &iter : this->address_intervals)
+    {
+        if (addr < iter.second.second && addr >= iter.second.first)
+            return true;
+    }
+    return false;
+}
+
+//! Check if a demand read can be serviced by the prefetcher. Returns true if the demand does not need to go on the link
+bool CXLHost::prefetch_lookup(message &m)
+{
+    uint64_t line = m.address & ~(uint64_t)0x3f;
+    auto it = prefetch_table.find(line);
+    if (it == prefetch_table.end())
+        return false;
+    if (it->second.state == prefetch_state::arrived)
+    {
+        // Timely prefetch, the line is already on the host
+        pf_stats.useful++;
+        erase_from_prefetch_table(it);
+        m.time.tick_req_complete = curr_tick + params.delay_vc_to_retire;
+        retire_demand(m);
+    }
+    else
+    {
+        // Late prefetch, wait for the prefetch response instead of sending a second request
+        pf_stats.late++;
+        merged_demands[line].push_back(m);
+    }
+#ifdef EVENTLOG
+    log.CXLEventLog("Demand serviced by prefetch " + m.sprint() + "\n", this->node_id);
+#endif
+    return true;
+}
+
+//! Evict the oldest arrived but unused line from the prefetch table. Returns false if every tracked line is still in flight
+bool CXLHost::make_room_in_prefetch_table()
+{
+    if (prefetch_table.size() < params.prefetch_table_size)
+        return true;
+    for (uint64_t line : prefetch_table_order)
+    {
+        auto entry = prefetch_table.find(line);
+        if (entry->second.state == prefetch_state::arrived)
+        {
+            pf_stats.useless++;
+            erase_from_prefetch_table(entry);
+            return true;
+        }
+    }
+    return false;
+}
+
+//! Remove a line from the prefetch table and its replacement order
+void CXLHost::erase_from_prefetch_table(std::map<uint64_t, prefetch_entry>::iterator entry)
+{
+    prefetch_table_order.erase(entry->second.order);
+    prefetch_table.erase(entry);
+}
+
+//! Train the prefetcher on a demand read and queue up the generated prefetches
+void CXLHost::train_prefetcher(uint64_t addr, int traffic_class)
+{
+    std::vector<uint64_t> candidates;
+    uint64_t line = addr & ~(uint64_t)0x3f;
+    pf_stats.triggers++;
+    prefetcher->train(line, candidates);
+    for (uint64_t pf_addr : candidates)
+    {
+        pf_stats.generated++;
+        pf_addr &= ~(uint64_t)0x3f;
+        // Only prefetch lines that live on a CXL device and are not already tracked
+        if (pf_addr == line || !is_cxl_address(pf_addr) || prefetch_table.count(pf_addr) != 0)
+        {
+            pf_stats.filtered++;
+            continue;
+        }
+        if (prefetch_queue.is_buf_full() || !make_room_in_prefetch_table())
+        {
+            pf_stats.dropped++;
+            continue;
+        }
+        message m = message(opcode::Req, pf_addr);
+        m.is_prefetch = true;
+        m.traffic_class = traffic_class;
+        prefetch_queue.enqueue(m);
+        prefetch_table_order.push_back(pf_addr);
+        prefetch_table.insert({pf_addr, {prefetch_state::in_flight, std::prev(prefetch_table_order.end())}});
+    }
+}
+
+//! Move the head of the prefetch queue onto the M2S Req VCs, where it competes with demand reads for credits
+bool CXLHost::issue_prefetch()
+{
+    if (prefetch_queue.is_buf_empty() || M2S_Req[select_vc(prefetch_queue.get_head(), cur_Req_vc)].is_buf_full())
+        return false;
+    message m;
+    m.copy(prefetch_queue.get_head());
+    m.time.tick_created = curr_tick;
+    m.time.read_write = false;
+    M2S_Req[select_vc(m, cur_Req_vc)].enqueue(m);
+    cur_Req_vc = cur_Req_vc == NUM_VC - 1 ? 0 : cur_Req_vc + 1;
+    messages_sent_to_device.insert({m.msg_id, m});
+    prefetch_queue.dequeue();
+    pf_stats.issued++;
+#ifdef EVENTLOG
+    log.CXLEventLog("Created prefetch " + m.sprint() + "\n", this->node_id);
+#endif
+    return true;
+}
+
+//! A prefetch response came back. Complete any demand reads that merged with it, otherwise keep the line for later demands
+void CXLHost::prefetch_arrived(message &m)
+{
+    uint64_t line = m.address & ~(uint64_t)0x3f;
+    auto merged = merged_demands.find(line);
+    if (merged == merged_demands.end())
+    {
+        prefetch_table.at(line).state = prefetch_state::arrived;
+        return;
+    }
+    // The line is consumed by the waiting demands
+    for (message &d : merged->second)
+    {
+        message done;
+        done.copy(m);
+        done.msg_id = d.msg_id;
+        done.address = d.address;
+        done.is_prefetch = false;
+        done.time.tick_created = d.time.tick_created;
+        retire_demand(done);
+    }
+    merged_demands.erase(merged);
+    erase_from_prefetch_table(prefetch_table.find(line));
+}
+
+//! VC a new message goes to. Round robin by default. With throttling every traffic class gets its own VC so a throttled class cannot block the others at the head of a VC
+int CXLHost::select_vc(const message &m, int cur_vc)
+{
+    return params.qos_throttle ? m.traffic_class % NUM_VC : cur_vc;
+}
+
+//! True if the message belongs to a throttled traffic class and the device already has a full window of such requests outstanding
+bool CXLHost::is_throttled(const message &m, uint dest)
+{
+    if (!params.qos_throttle || m.traffic_class < params.qos_throttle_min_tc)
+        return false;
+    return throttle[dest].outstanding >= throttle[dest].window;
+}
+
+//! Adjust the throttling window of the responding device based on the DevLoad it reported.
+//! Light load opens the window by one request, overload closes it multiplicatively but at most once per window worth of responses so a burst of overloaded responses only counts once
+void CXLHost::update_throttle(const message &m)
+{
+    qos_throttle_state &thr = throttle[destination_device(m.address)];
+    if (m.traffic_class >= params.qos_throttle_min_tc)
+        thr.outstanding--;
+    thr.since_decrease++;
+    switch (m.dev_load)
+    {
+    case dev_load_type::light_load:
+        thr.window = std::min(thr.window + 1, params.qos_window_max);
+        break;
+    case dev_load_type::optimal_load:
+        break;
+    case dev_load_type::moderate_overload:
+        if (thr.since_decrease >= thr.window)
+        {
+            thr.window = std::max(thr.window - std::max(thr.window / 8, 1), params.qos_window_min);
+            thr.since_decrease = 0;
+        }
+        break;
+    case dev_load_type::severe_overload:
+        if (thr.since_decrease >= thr.window)
+        {
+            thr.window = std::max(thr.window / 2, params.qos_window_min);
+            thr.since_decrease = 0;
+        }
+        break;
+    default:
+        CXL_ASSERT(false && "Illegal DevLoad value");
+    }
+    CXL_ASSERT(thr.outstanding >= 0 && "More throttled responses than requests");
+}
+
+void CXLHost::core_retire(uint64_t msg_id)
+{
+    for (CXLCore &core : cores)
+        if (core.core_retire(msg_id))
+            return;
+}
+
+uint64_t CXLHost::fast_forward(uint64_t accesses, TraceWindowStats &w)
+{
+    CXL_ASSERT(no_active_transaction() && "Fast forward while accesses are in flight");
+    uint64_t taken = 0;
+    bool more = true;
+    // Take the accesses round robin from the cores, so that every core moves forward by about the same amount
+    while (taken < accesses && more)
+    {
+        more = false;
+        for (size_t c = 0; c < cores.size() && taken < accesses; c++)
+        {
+            uint64_t gap;
+            message m;
+            if (!cores[c].take_entry(gap, m))
+                continue;
+            w.add(m, gap, tier_of(m.address), c);
+            taken++;
+            more = true;
+        }
+    }
+    for (CXLCore &core : cores)
+        core.resume();
+    return taken;
+}
+
+void CXLHost::account_estimate(const TraceWindowStats &w, const analytical_estimate &e)
+{
+    for (auto &iter : w.tables[dam_tier])
+    {
+        uint64_t n = iter.second.reads + iter.second.writes;
+        auto &entry = amat_per_table_dam[iter.first];
+        entry.first += n;
+        entry.second += (e.table_amat[dam_tier].at(iter.first) - entry.second) * n / entry.first;
+        num_dam_reqs += n;
+    }
+    for (auto &iter : w.tables[cxl_tier])
+    {
+        double n = iter.second.reads + iter.second.writes;
+        auto &entry = amat_per_table_cxl[iter.first];
+        entry[0] += n;
+        entry[1] += (e.table_amat[cxl_tier].at(iter.first) - entry[1]) * n / entry[0];
+        entry[2] += (e.dram_latency[cxl_tier] - entry[2]) * n / entry[0];
+    }
+    num_reqs_completed += w.accesses;
+}
+
+void CXLHost::tier_latency(double *count, double *sum)
+{
+    count[dam_tier] = sum[dam_tier] = count[cxl_tier] = sum[cxl_tier] = 0;
+    for (auto &iter : amat_per_table_dam)
+    {
+        count[dam_tier] += iter.second.first;
+        sum[dam_tier] += iter.second.first * iter.second.second;
+    }
+    for (auto &iter : amat_per_table_cxl)
+    {
+        count[cxl_tier] += iter.second[0];
+        sum[cxl_tier] += iter.second[0] * iter.second[1];
+    }
+}
+
+uint64_t CXLHost::trace_entries() const
+{
+    uint64_t entries = 0;
+    for (const CXLCore &core : cores)
+        entries += core.trace_entries_read;
+    return entries;
+}
+
+//! Print the execution time predicted by the core model and add it to the latency csv. With several cores the
+//! instructions and stalls are summed up, the execution time is the time the slowest core took
+void CXLHost::print_core_stats(std::ofstream &out)
+{
+    if (!params.core_model)
+        return;
+    uint64_t instructions = 0;
+    int64_t ideal = 0;
+    int64_t stall_ticks[3] = {0, 0, 0};
+    for (CXLCore &core : cores)
+    {
+        instructions += core.core_instructions + core.core_accesses;
+        ideal = std::max(ideal, (int64_t)core.core_instructions * params.ticks_per_ins);
+        for (int i = 0; i < 3; i++)
+            stall_ticks[i] += core.core_stall_ticks[i];
+    }
+    std::cout << "=====================================================\n";
+    std::cout << "Core model summary (" << cores.size() << " cores, ROB " << params.rob_size << ", MSHRs " << params.num_mshrs << ")\n";
+    std::cout << "Instructions " << instructions << " execution ticks " << curr_tick << " without memory stalls " << ideal << "\n";
+    std::cout << "Stall ticks ROB full " << stall_ticks[0] << " MSHRs full " << stall_ticks[1] << " load to use " << stall_ticks[2] << "\n";
+    if (ideal > 0)
+        std::cout << "CPI " << (double)curr_tick / params.ticks_per_ins / instructions * cores.size() << " slowdown " << (double)curr_tick / ideal << "\n";
+    if (cores.size() > 1)
+        for (size_t i = 0; i < cores.size(); i++)
+            std::cout << "Core " << i << " instructions " << cores[i].core_instructions + cores[i].core_accesses << " stall ticks " << cores[i].core_stall_ticks[0] << ", " << cores[i].core_stall_ticks[1] << ", " << cores[i].core_stall_ticks[2] << "\n";
+    std::cout << "=====================================================\n";
+    out << std::dec << 2 << ", " << instructions << ", " << curr_tick << ", " << stall_ticks[0] << ", " << stall_ticks[1] << ", " << stall_ticks[2] << std::endl;
+}
+
+//! Print how many records the trace rings delivered and how often their producers stalled
+void CXLHost::print_trace_ring_stats()
+{
+    uint64_t producer_stalls = 0;
+    int rings = 0;
+    for (CXLCore &core : cores)
+    {
+        if (core.trace_ring == nullptr)
+            continue;
+        producer_stalls += core.trace_ring->producer_stalls();
+        rings++;
+    }
+    if (rings == 0)
+        return;
+    std::cout << "=====================================================\n";
+    std::cout << "Trace ring summary (" << rings << " rings)\n";
+    std::cout << "Records " << trace_entries() << " producer stalls " << producer_stalls << "\n";
+    std::cout << "=====================================================\n";
+}
+
+//! Print the per traffic class latency and the throttling state
+void CXLHost::print_qos_stats()
+{
+    std::cout << "=====================================================\n";
+    std::cout << "QoS summary\n";
+    for (int tc = 0; tc < NUM_TC; tc++)
+    {
+        if (amat_per_tc[tc][0] == 0)
+            continue;
+        std::cout << "TC " << tc << " (weight " << params.tc_weights[tc] << ") completed " << (uint64_t)amat_per_tc[tc][0] << " avg latency " << amat_per_tc[tc][1] << " ticks\n";
+    }
+    if (params.qos_throttle)
+    {
+        std::cout << "Throttle rejects " << qos_throttle_reject_ctr << "\n";
+        for (auto &iter : throttle)
+            std::cout << "Device " << iter.first << " final window " << iter.second.window << "\n";
+    }
+    std::cout << "=====================================================\n";
+}
+
+//! Add the host's VC and buffer depths, credits and cumulative stall counters to the current sample
+void CXLHost::sample(CXLSampler &s)
+{
+    int req_vc = 0, rwd_vc = 0;
+    for (int i = 0; i < NUM_VC; i++)
+    {
+        req_vc += M2S_Req[i].buf_occupancy();
+        rwd_vc += M2S_RWD[i].buf_occupancy();
+    }
+    s.set_prefix("host" + std::to_string(node_id) + "_");
+    s.add("m2s_req_vc", req_vc);
+    s.add("m2s_rwd_vc", rwd_vc);
+    s.add("s2m_ndr_vc", S2M_NDR.buf_occupancy());
+    s.add("s2m_drs_vc", S2M_DRS.buf_occupancy());
+    s.add("tx_buf", tx_buffer.buf_occupancy());
+    s.add("rx_buf", rx_buffer.buf_occupancy());
+    s.add("outstanding", messages_sent_to_device.size());
+    s.add("int_rsp_credit", int_cred.rsp_credit);
+    s.add("int_data_credit", int_cred.data_credit);
+    for (uint64_t dev : connected_devices)
+    {
+        s.set_prefix("host" + std::to_string(node_id) + "_dev" + std::to_string(dev) + "_");
+        s.add("req_credit", ext_creds[dev].req_credit);
+        s.add("data_credit", ext_creds[dev].data_credit);
+    }
+    s.set_prefix("host" + std::to_string(node_id) + "_");
+    s.add("packer_waiting", is_packer_waiting);
+    s.add("credit_checks", total_credit_checks);
+    s.add("int_credit_rejects", int_credit_reject_ctr);
+    s.add("ext_credit_rejects", ext_credit_reject_ctr);
+    s.add("throttle_rejects", qos_throttle_reject_ctr);
+}
+
+//! Print latency percentiles of the completed CXL accesses. Only with link layer retry, where replays show up in the tail
+void CXLHost::print_latency_tail()
+{
+    if (params.link_ber <= 0)
+        return;
+    uint64_t total = 0;
+    for (auto &iter : latency_histogram)
+        total += iter.second;
+    if (total == 0)
+        return;
+    const double percentiles[] = {0.5, 0.9, 0.99, 0.999};
+    int p = 0;
+    uint64_t seen = 0;
+    std::cout << "CXL access latency (ticks)";
+    for (auto &iter : latency_histogram)
+    {
+        seen += iter.second;
+        while (p < 4 && seen >= percentiles[p] * total)
+        {
+            std::cout << " p" << percentiles[p] * 100 << " " << iter.first;
+            p++;
+        }
+    }
+    std::cout << " max " << latency_histogram.rbegin()->first << "\n";
+}
+
+//! Print the prefetcher accounting
+void CXLHost::print_prefetch_stats()
+{
+    if (prefetcher == nullptr)
+        return;
+    uint64_t unused_at_end = 0;
+    for (auto &iter : prefetch_table)
+    {
+        if (iter.second.state == prefetch_state::arrived)
+            unused_at_end++;
+    }
+    uint64_t demand_reads = pf_stats.useful + pf_stats.late + pf_stats.demand_misses;
+    std::cout << "Summary of " << prefetcher->name() << " prefetcher (degree " << params.prefetch_degree << ", distance " << params.prefetch_distance << ")\n";
+    std::cout << "Triggers " << pf_stats.triggers << "\n";
+    std::cout << "Generated " << pf_stats.generated << "\n";
+    std::cout << "Filtered " << pf_stats.filtered << "\n";
+    std::cout << "Dropped " << pf_stats.dropped << "\n";
+    std::cout << "Issued " << pf_stats.issued << "\n";
+    std::cout << "Useful " << pf_stats.useful << "\n";
+    std::cout << "Late " << pf_stats.late << "\n";
+    std::cout << "Useless " << pf_stats.useless + unused_at_end << "\n";
+    std::cout << "Demand misses " << pf_stats.demand_misses << "\n";
+    if (demand_reads > 0)
+        std::cout << "Coverage " << (double)(pf_stats.useful + pf_stats.late) / demand_reads << "\n";
+    if (pf_stats.issued > 0)
+        std::cout << "Accuracy " << (double)(pf_stats.useful + pf_stats.late) / pf_stats.issued << "\n";
+}
+
+//! True if the drain policy wants the oldest buffered write on the VCs this tick
+bool CXLHost::write_drain_due()
+{
+    if (write_buffer == nullptr)
+        return false;
+    bool reads_waiting = !prefetch_queue.is_buf_empty();
+    for (auto &vc : M2S_Req)
+        reads_waiting |= !vc.is_buf_empty();
+    // Once the cores stop issuing nothing can coalesce any more, so everything drains
+    return write_buffer->wants_drain(reads_waiting, is_trace_finished || issue_budget == 0);
+}
+
+//! Move the oldest buffered write to the M2S RwD VCs. Returns true if a write was moved
+bool CXLHost::drain_write_buffer()
+{
+    if (!write_drain_due())
+        return false;
+    message m;
+    m.copy(write_buffer->oldest());
+    if (M2S_RWD[select_vc(m, cur_RWD_vc)].is_buf_full())
+        return false;
+    // The device latency of the write starts when it leaves the buffer
+    m.time.tick_created = curr_tick;
+    m.is_posted = true;
+    M2S_RWD[select_vc(m, cur_RWD_vc)].enqueue(m);
+    cur_RWD_vc = cur_RWD_vc == NUM_VC - 1 ? 0 : cur_RWD_vc + 1;
+    write_buffer->pop();
+    messages_sent_to_device.insert({m.msg_id, m});
+#ifdef EVENTLOG
+    log.CXLEventLog("Drained write from write buffer " + m.sprint() + "\n", this->node_id);
+#endif
+    return true;
+}
+
+void CXLHost::print_write_buffer_stats()
+{
+    if (write_buffer == nullptr)
+        return;
+    const write_buffer_stats &s = write_buffer->stats;
+    std::cout << "Summary of write buffer (" << params.write_buffer_size << " lines, " << write_buffer->policy_name() << " drain, watermarks "
+              << params.write_buffer_high << "/" << params.write_buffer_low << ")\n";
+    std::cout << "Posted " << s.posted << "\n";
+    std::cout << "Coalesced " << s.coalesced << "\n";
+    std::cout << "Forwarded reads " << s.forwarded << "\n";
+    std::cout << "Drained " << s.drained << "\n";
+    std::cout << "Full " << s.full << "\n";
+    std::cout << "Peak occupancy " << s.peak << "\n";
+    std::cout << "Average residency " << s.residency << " ticks\n";
+    if (s.posted > 0)
+        std::cout << "Device writes saved " << 1 - (double)s.drained / s.posted << "\n";
+}
+
 //! Dump all the message timing data gathered from completed memory accesses
 void CXLHost::dump_data()
 {
@@ -0,0 +1,103 @@
+#include "CXLHybrid.h"
+#include "utils.h"
+#include <iostream>
+
+using namespace CXL;
+
+namespace CXL
+{
+    extern int64_t curr_tick;
+}
+
+CXLHybrid::CXLHybrid(CXLHost &host, CXLAnalytical &model, uint64_t window, uint64_t period)
+    : host(host), model(model), window(window), period(period)
+{
+    CXL_ASSERT(window > 0 && period >= window && "The detailed window should be part of the period");
+    detailed_accesses = 0;
+    analytical_ticks = 0;
+    windows = 0;
+    saturated = false;
+    for (int tier = 0; tier < NUM_TIERS; tier++)
+    {
+        analytical_accesses[tier] = 0;
+        analytical_latency[tier] = 0;
+    }
+    begin_window();
+}
+
+void CXLHybrid::update()
+{
+    if (host.issue_budget_left() > 0 || !host.no_active_transaction())
+        return;
+    end_window();
+    fast_forward();
+    begin_window();
+}
+
+void CXLHybrid::begin_window()
+{
+    stats = TraceWindowStats();
+    host.tier_latency(count_before, sum_before);
+    host.set_issue_stats(&stats);
+    host.set_issue_budget(window);
+}
+
+//! Calibrate the model with the latencies the window measured
+void CXLHybrid::end_window()
+{
+    double count[NUM_TIERS], sum[NUM_TIERS], measured[NUM_TIERS];
+    host.tier_latency(count, sum);
+    for (int tier = 0; tier < NUM_TIERS; tier++)
+        measured[tier] = count[tier] > count_before[tier] ? (sum[tier] - sum_before[tier]) / (count[tier] - count_before[tier]) : 0;
+    model.calibrate(stats, measured);
+    host.set_issue_stats(nullptr);
+    detailed_accesses += stats.accesses;
+    windows++;
+}
+
+//! Estimate the rest of the period and move the clock past it
+void CXLHybrid::fast_forward()
+{
+    TraceWindowStats skipped;
+    if (host.fast_forward(period - window, skipped) == 0)
+        return;
+    analytical_estimate e = model.estimate(skipped);
+    curr_tick += e.ticks;
+    analytical_ticks += e.ticks;
+    saturated |= e.saturated;
+    host.account_estimate(skipped, e);
+    for (int tier = 0; tier < NUM_TIERS; tier++)
+    {
+        table_stats t = skipped.tier_totals((memory_tier)tier);
+        analytical_accesses[tier] += t.reads + t.writes;
+        analytical_latency[tier] += e.amat[tier] * (t.reads + t.writes);
+    }
+}
+
+void CXLHybrid::print()
+{
+    const char *names[NUM_TIERS] = {"DAM", "CXL"};
+    double count[NUM_TIERS], sum[NUM_TIERS];
+    host.tier_latency(count, sum);
+    std::cout << "=====================================================\n";
+    std::cout << "Hybrid summary\n";
+    std::cout << "Detailed windows " << windows << " accesses " << detailed_accesses << ", analytical accesses "
+              << analytical_accesses[dam_tier] + analytical_accesses[cxl_tier] << " ticks " << analytical_ticks << " of " << curr_tick << "\n";
+    model.print();
+    for (int tier = 0; tier < NUM_TIERS; tier++)
+    {
+        if (count[tier] == 0)
+            continue;
+        std::cout << names[tier] << " AMAT " << sum[tier] / count[tier];
+        // Only the estimated accesses carry the model error
+        double bound = model.relative_error_bound((memory_tier)tier);
+        if (bound >= 0)
+            std::cout << " +- " << bound * analytical_latency[tier] / count[tier] << " ticks (95%)";
+        else if (analytical_accesses[tier] > 0)
+            std::cout << ", no error bound, needs at least two detailed windows";
+        std::cout << "\n";
+    }
+    if (saturated)
+        std::cout << "The model saw saturated queues, the estimate of these parts is a lower bound\n";
+    std::cout << "=====================================================\n";
+}
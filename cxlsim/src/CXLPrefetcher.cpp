@@ -0,0 +1,104 @@
+#include "CXLPrefetcher.h"
+#include "utils.h"
+#include <algorithm>
+
+using namespace CXL;
+
+#define LINE_SIZE 64
+#define PAGE_SIZE 4096
+
+//! Prefetch the next degree lines starting distance lines after the demand. Stays within the 4KB page like real hardware
+void NextLinePrefetcher::train(uint64_t addr, std::vector<uint64_t> &candidates)
+{
+    uint64_t page = addr / PAGE_SIZE;
+    for (int i = 0; i < degree; i++)
+    {
+        uint64_t pf_addr = addr + (uint64_t)(distance + i) * LINE_SIZE;
+        if (pf_addr / PAGE_SIZE != page)
+            break;
+        candidates.push_back(pf_addr);
+    }
+}
+
+//! Look up the stream of the page, update its stride and confidence and prefetch along the stride once it is confirmed
+void StridePrefetcher::train(uint64_t addr, std::vector<uint64_t> &candidates)
+{
+    uint64_t page = addr / PAGE_SIZE;
+    auto it = streams.find(page);
+    // Allocate a new stream, replacing the oldest one if the table is full
+    if (it == streams.end())
+    {
+        if (streams.size() >= num_streams)
+        {
+            streams.erase(lru.front());
+            lru.pop_front();
+        }
+        streams[page] = {addr, 0, 0};
+        lru.push_back(page);
+        return;
+    }
+    stream_entry &s = it->second;
+    int64_t new_stride = (int64_t)addr - (int64_t)s.last_addr;
+    if (new_stride == 0)
+        return;
+    if (new_stride == s.stride)
+        s.confidence = std::min(s.confidence + 1, 3);
+    else
+    {
+        s.stride = new_stride;
+        s.confidence = 0;
+    }
+    s.last_addr = addr;
+    // Need to see the same stride at least twice before trusting it
+    if (s.confidence < 1)
+        return;
+    for (int i = 0; i < degree; i++)
+    {
+        uint64_t pf_addr = addr + s.stride * (distance + i);
+        if (pf_addr / PAGE_SIZE != page)
+            break;
+        candidates.push_back(pf_addr);
+    }
+}
+
+//! On the first access to a region prefetch up to degree lines of the region, starting distance lines after the demand and wrapping around to the start of the region
+void RegionPrefetcher::train(uint64_t addr, std::vector<uint64_t> &candidates)
+{
+    uint64_t region_id = addr / region_size;
+    if (std::find(recent.begin(), recent.end(), region_id) != recent.end())
+        return;
+    if (recent.size() >= num_regions)
+        recent.pop_front();
+    recent.push_back(region_id);
+
+    uint64_t base = region_id * region_size;
+    int lines = region_size / LINE_SIZE;
+    int offset = (addr - base) / LINE_SIZE;
+    for (int i = 0; i < std::min(degree, lines - 1); i++)
+    {
+        int line = (offset + distance + i) % lines;
+        if (line == offset)
+            continue;
+        candidates.push_back(base + (uint64_t)line * LINE_SIZE);
+    }
+}
+
+//! Create a prefetcher of the given type. Returns nullptr if prefetching is disabled
+CXLPrefetcher *CXL::make_prefetcher(int type, int degree, int distance)
+{
+    CXL_ASSERT(degree > 0 && distance > 0 && "Prefetch degree and distance should be positive");
+    switch (type)
+    {
+    case prefetcher_type::no_prefetcher:
+        return nullptr;
+    case prefetcher_type::next_line:
+        return new NextLinePrefetcher(degree, distance);
+    case prefetcher_type::stride:
+        return new StridePrefetcher(degree, distance, 16);
+    case prefetcher_type::region:
+        return new RegionPrefetcher(degree, distance, 2048, 32);
+    default:
+        CXL_ASSERT(false && "Unknown prefetcher type");
+    }
+    return nullptr;
+}
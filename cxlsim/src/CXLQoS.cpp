@@ -0,0 +1,30 @@
+#include "CXLQoS.h"
+#include "utils.h"
+
+using namespace CXL;
+
+WeightedArbiter::WeightedArbiter() : weights(NUM_TC, 1), current(NUM_TC, 0) {}
+
+WeightedArbiter::WeightedArbiter(const int *weights) : weights(weights, weights + NUM_TC), current(NUM_TC, 0)
+{
+    for (int w : this->weights)
+        CXL_ASSERT(w > 0 && "Traffic class weights should be positive");
+}
+
+int WeightedArbiter::pick(const std::vector<bool> &ready)
+{
+    int chosen = -1;
+    int64_t total = 0;
+    for (int tc = 0; tc < NUM_TC; tc++)
+    {
+        if (!ready[tc])
+            continue;
+        current[tc] += weights[tc];
+        total += weights[tc];
+        if (chosen == -1 || current[tc] > current[chosen])
+            chosen = tc;
+    }
+    if (chosen != -1)
+        current[chosen] -= total;
+    return chosen;
+}
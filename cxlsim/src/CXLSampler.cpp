@@ -0,0 +1,113 @@
+#include "CXLSampler.h"
+#include "utils.h"
+
+using namespace CXL;
+
+namespace CXL
+{
+    extern int64_t curr_tick;
+}
+
+CXLSampler::CXLSampler()
+{
+    enabled = false;
+    interval = 0;
+    last_sample_tick = 0;
+    header_written = false;
+    num_cols = 0;
+    col = 0;
+    capacity = 0;
+    head = 0;
+    count = 0;
+}
+
+void CXLSampler::open(const std::string &filename, int64_t interval, int rows)
+{
+    CXL_ASSERT(interval > 0 && rows > 0 && "Sampling interval and buffer size should be positive");
+    out.open(filename);
+    CXL_ASSERT(out.is_open() && "Could not open sample file");
+    this->interval = interval;
+    capacity = rows;
+    last_sample_tick = curr_tick - interval;
+    enabled = true;
+}
+
+bool CXLSampler::is_due()
+{
+    return enabled && curr_tick - last_sample_tick >= interval;
+}
+
+void CXLSampler::set_prefix(const std::string &prefix)
+{
+    this->prefix = prefix;
+}
+
+void CXLSampler::begin_row()
+{
+    last_sample_tick = curr_tick;
+    col = 0;
+    // The ring is sized once the first row has told us the number of columns
+    if (header_written && count == capacity)
+        flush();
+    prefix.clear();
+    add("tick", curr_tick);
+}
+
+void CXLSampler::add(const char *name, int64_t value)
+{
+    if (!header_written)
+    {
+        names.push_back(prefix + name);
+        ring.push_back(value);
+        col++;
+        return;
+    }
+    CXL_ASSERT(col < num_cols && "More columns than in the first sample");
+    ring[(size_t)((head + count) % capacity) * num_cols + col] = value;
+    col++;
+}
+
+void CXLSampler::end_row()
+{
+    if (!header_written)
+    {
+        // First row, write the header and set up the ring with this row in it
+        num_cols = col;
+        for (int i = 0; i < num_cols; i++)
+            out << names[i] << (i == num_cols - 1 ? "\n" : ",");
+        std::vector<int64_t> first(ring);
+        ring.assign((size_t)capacity * num_cols, 0);
+        std::copy(first.begin(), first.end(), ring.begin());
+        header_written = true;
+    }
+    CXL_ASSERT(col == num_cols && "Fewer columns than in the first sample");
+    count++;
+}
+
+int64_t CXLSampler::last_value(int i) const
+{
+    CXL_ASSERT(header_written && count > 0 && "No sample taken yet");
+    return ring[(size_t)((head + count - 1) % capacity) * num_cols + i];
+}
+
+//! Write out all buffered rows, oldest first
+void CXLSampler::flush()
+{
+    for (; count > 0; count--)
+    {
+        const int64_t *row = &ring[(size_t)head * num_cols];
+        for (int i = 0; i < num_cols; i++)
+            out << row[i] << (i == num_cols - 1 ? "\n" : ",");
+        head = (head + 1) % capacity;
+    }
+}
+
+void CXLSampler::close()
+{
+    if (!enabled)
+        return;
+    if (header_written)
+        flush();
+    out.close();
+    enabled = false;
+}
@@ -0,0 +1,81 @@
+#include "CXLSnoopFilter.h"
+#include "utils.h"
+
+using namespace CXL;
+
+CXLSnoopFilter::CXLSnoopFilter(int entries, int ways) : stats{}, ways(ways)
+{
+    CXL_ASSERT(ways > 0 && entries >= ways && entries % ways == 0 && "Snoop filter entries should be a multiple of its ways");
+    sets = entries / ways;
+    use_counter = 0;
+    this->entries.assign(entries, {0, 0, 0});
+}
+
+CXLSnoopFilter::snoop_filter_entry *CXLSnoopFilter::find(uint64_t line)
+{
+    snoop_filter_entry *set = &entries[((line >> 6) % sets) * ways];
+    for (int w = 0; w < ways; w++)
+        if (set[w].sharers != 0 && set[w].line == line)
+            return &set[w];
+    return nullptr;
+}
+
+const CXLSnoopFilter::snoop_filter_entry *CXLSnoopFilter::find(uint64_t line) const
+{
+    return const_cast<CXLSnoopFilter *>(this)->find(line);
+}
+
+bool CXLSnoopFilter::lookup(uint64_t line)
+{
+    stats.lookups++;
+    if (find(line) == nullptr)
+        return false;
+    stats.hits++;
+    return true;
+}
+
+uint64_t CXLSnoopFilter::sharers(uint64_t line) const
+{
+    const snoop_filter_entry *e = find(line);
+    return e == nullptr ? 0 : e->sharers;
+}
+
+bool CXLSnoopFilter::add_sharers(uint64_t line, uint64_t sharers, snoop_filter_victim &victim)
+{
+    CXL_ASSERT(sharers != 0 && "Adding a line without sharers");
+    snoop_filter_entry *e = find(line);
+    if (e != nullptr)
+    {
+        e->sharers |= sharers;
+        e->last_use = ++use_counter;
+        return false;
+    }
+    // Take a free way if there is one, otherwise the least recently used
+    snoop_filter_entry *set = &entries[((line >> 6) % sets) * ways];
+    snoop_filter_entry *slot = &set[0];
+    for (int w = 0; w < ways; w++)
+    {
+        if (set[w].sharers == 0)
+        {
+            slot = &set[w];
+            break;
+        }
+        if (set[w].last_use < slot->last_use)
+            slot = &set[w];
+    }
+    bool evicted = slot->sharers != 0;
+    if (evicted)
+    {
+        victim = {slot->line, slot->sharers};
+        stats.evictions++;
+    }
+    *slot = {line, sharers, ++use_counter};
+    return evicted;
+}
+
+void CXLSnoopFilter::remove_sharers(uint64_t line, uint64_t sharers)
+{
+    snoop_filter_entry *e = find(line);
+    if (e != nullptr)
+        e->sharers &= ~sharers;
+}
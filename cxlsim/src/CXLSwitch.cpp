@@ -13,8 +13,14 @@ CXLSwitch::CXLSwitch(uint64_t buf_size, uint node_id)
 {
     num_devices = 0;
     this->buf_size = buf_size;
-    ARB_NOC_d2h = CXLBuf<flit>(buf_size);
-    ARB_NOC_h2d = CXLBuf<flit>(buf_size);
+    for (int tc = 0; tc < NUM_TC; tc++)
+    {
+        ARB_NOC_d2h[tc] = CXLBuf<flit>(buf_size);
+        ARB_NOC_h2d[tc] = CXLBuf<flit>(buf_size);
+    }
+    h2d_arb = WeightedArbiter(params.tc_weights);
+    d2h_arb = WeightedArbiter(params.tc_weights);
+    h2d_in = h2d_out = d2h_in = d2h_out = {0, 0};
     previous_destination = 0;
     curr_port = 0;
     expected_rollover = 0;
@@ -117,14 +123,16 @@ void CXLSwitch::update()
         f.copy(upstream_buffer_rx.get_head());
         upstream_buffer_rx.dequeue();
         f.time.time_of_receipt = curr_tick;//set receipt not transmission for check_latency_flit
-        ARB_NOC_h2d.enqueue(f);
+        ARB_NOC_h2d[classify(h2d_in, f)].enqueue(f);
     }
-    if (check_buffer_condition(ARB_NOC_h2d, params.delay_cxl_noc_switch, flag))
+    int tc = arbitrate(ARB_NOC_h2d, h2d_arb, h2d_out, flag);
+    if (tc != -1)
     {
-        uint64_t destination_decode = ARB_NOC_h2d.get_head().slots[0].type == data ? previous_destination : destination_device(ARB_NOC_h2d.get_head().get_first_address());
+        uint64_t destination_decode = ARB_NOC_h2d[tc].get_head().slots[0].type == data ? previous_destination : destination_device(ARB_NOC_h2d[tc].get_head().get_first_address());
         previous_destination = destination_decode;
-        f.copy(ARB_NOC_h2d.get_head());
-        ARB_NOC_h2d.dequeue();
+        f.copy(ARB_NOC_h2d[tc].get_head());
+        ARB_NOC_h2d[tc].dequeue();
+        update_tc_lock(h2d_out, f, tc);
         f.time.time_of_receipt = curr_tick;//set receipt not transmission for check_latency_flit
         downstream_buffers_tx[destination_decode].enqueue(f);
     }
@@ -160,17 +168,19 @@ void CXLSwitch::update()
             downstream_buffers_rx[curr_port].dequeue();
             // cout << curr_port << "!!!!!" << endl;
             f.time.time_of_receipt = curr_tick;//set receipt not transmission for check_latency_flit
-            ARB_NOC_d2h.enqueue(f);
+            ARB_NOC_d2h[classify(d2h_in, f)].enqueue(f);
             update_rollover(f);
             update_port();
             break;
         }
         update_port();
     }
-    if (check_buffer_condition(ARB_NOC_d2h, params.delay_cxl_noc_switch, flag))
+    tc = arbitrate(ARB_NOC_d2h, d2h_arb, d2h_out, flag);
+    if (tc != -1)
     {
-        f.copy(ARB_NOC_d2h.get_head());
-        ARB_NOC_d2h.dequeue();
+        f.copy(ARB_NOC_d2h[tc].get_head());
+        ARB_NOC_d2h[tc].dequeue();
+        update_tc_lock(d2h_out, f, tc);
         f.time.time_of_receipt = curr_tick;//set receipt not transmission for check_latency_flit
         upstream_buffer_tx.enqueue(f);
     }
@@ -214,4 +224,64 @@ void CXLSwitch::update_rollover(const flit &f)
         }
         // cout << "curr_rollover: " << expected_rollover << endl;
     }
-}
\ No newline at end of file
+}
+//! Pick the traffic class queue an incoming flit goes to. Flits finishing the data of an earlier header follow that header
+int CXLSwitch::classify(tc_lock &lock, const flit &f)
+{
+    int tc = lock.rollover > 0 ? lock.tc : f.traffic_class();
+    CXL_ASSERT(tc >= 0 && tc < NUM_TC && "Illegal traffic class");
+    update_tc_lock(lock, f, tc);
+    return tc;
+}
+
+//! Choose which traffic class queue sends a flit this tick. Returns -1 if none can. While data of a header is still due, only that header's queue may send
+int CXLSwitch::arbitrate(std::array<CXLBuf<flit>, NUM_TC> &queues, WeightedArbiter &arb, tc_lock &lock, bool &flag)
+{
+    std::vector<bool> ready(NUM_TC);
+    bool any_ready = false;
+    for (int tc = 0; tc < NUM_TC; tc++)
+    {
+        ready[tc] = check_buffer_condition(queues[tc], params.delay_cxl_noc_switch, flag);
+        any_ready |= ready[tc];
+    }
+    if (lock.rollover > 0)
+        return ready[lock.tc] ? lock.tc : -1;
+    if (!any_ready)
+        return -1;
+    return arb.pick(ready);
+}
+
+void CXLSwitch::update_tc_lock(tc_lock &lock, const flit &f, int tc)
+{
+    lock.tc = tc;
+    for (int i = 0; i < 4; ++i)
+    {
+        if (f.slots[i].type == m2s_rwd_hdr || f.slots[i].type == s2m_drs_hdr)
+            lock.rollover += 4;
+        else if (f.slots[i].type == data)
+            lock.rollover -= 1;
+    }
+    CXL_ASSERT(lock.rollover >= 0 && "Data flit without a header");
+}
+
+//! Add the switch buffer depths to the current sample
+void CXLSwitch::sample(CXLSampler &s)
+{
+    int h2d = 0, d2h = 0;
+    for (int tc = 0; tc < NUM_TC; tc++)
+    {
+        h2d += ARB_NOC_h2d[tc].buf_occupancy();
+        d2h += ARB_NOC_d2h[tc].buf_occupancy();
+    }
+    s.set_prefix("switch_");
+    s.add("us_rx", upstream_buffer_rx.buf_occupancy());
+    s.add("us_tx", upstream_buffer_tx.buf_occupancy());
+    s.add("arb_h2d", h2d);
+    s.add("arb_d2h", d2h);
+    for (auto &iter : downstream_buffers_tx)
+    {
+        s.set_prefix("switch_ds" + std::to_string(iter.first) + "_");
+        s.add("tx", iter.second.buf_occupancy());
+        s.add("rx", downstream_buffers_rx[iter.first].buf_occupancy());
+    }
+}
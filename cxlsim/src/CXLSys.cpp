@@ -1,4 +1,6 @@
 #include "CXLSys.h"
+#include <chrono>
+#include <iostream>
 
 #ifndef HOST_VC_SIZE
     #define HOST_VC_SIZE 1024
@@ -15,6 +17,28 @@
 
 using namespace CXL;
 
+namespace CXL
+{
+    extern CXLTimeline timeline;
+}
+
+#ifdef PROFILE
+//! Adds the wall clock time of its scope to the profile of a kind of component
+class profile_scope
+{
+public:
+    profile_scope(update_profile &p, uint64_t updates) : p(p), start(std::chrono::steady_clock::now()) { p.updates += updates; }
+    ~profile_scope() { p.seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(); }
+
+private:
+    update_profile &p;
+    std::chrono::steady_clock::time_point start;
+};
+#define PROFILE_SCOPE(component, updates) profile_scope profile_scope_##component(profile[component], updates)
+#else
+#define PROFILE_SCOPE(component, updates)
+#endif
+
 CXLSystem::~CXLSystem()
 {
     for (ramulator::DirectAttached *dam : DAMs)
@@ -91,6 +115,9 @@ CXLSystem::CXLSystem(uint64_t num_host, uint64_t num_device, bool has_DAM, const
             devices[i - num_host].connect_rx(&interconnects[i].first);
             devices[i - num_host].check_connection();
         }
+        // The two buses of a link carry each other's link layer ACKs and RETRY requests
+        interconnects[i].first.set_reverse(&interconnects[i].second);
+        interconnects[i].second.set_reverse(&interconnects[i].first);
     }
     if (has_DAM)
     {
@@ -106,32 +133,83 @@ CXLSystem::CXLSystem(uint64_t num_host, uint64_t num_device, bool has_DAM, const
     }
 }
 
+//! Take one sample of every component
+void CXLSystem::sample()
+{
+    sampler.begin_row();
+    for (auto &host : hosts)
+        host.sample(sampler);
+    switch_.sample(sampler);
+    for (auto &device : devices)
+        device.sample(sampler);
+    for (auto &link : interconnects)
+    {
+        link.first.sample(sampler);
+        link.second.sample(sampler);
+    }
+    sampler.end_row();
+    if (timeline.is_open())
+        timeline.add_counters(sampler);
+}
+
 void CXLSystem::update()
 {
-    for (int i = 0; i < hosts.size(); ++i)
     {
-        interconnects[i].first.update();
-        interconnects[i].second.update();
+        PROFILE_SCOPE(PROFILE_LINK, 2 * hosts.size());
+        for (int i = 0; i < hosts.size(); ++i)
+        {
+            interconnects[i].first.update();
+            interconnects[i].second.update();
+        }
+    }
+    {
+        PROFILE_SCOPE(PROFILE_SWITCH, 1);
+        switch_.update();
     }
-    switch_.update();
-    for (int i = hosts.size(); i < interconnects.size(); ++i)
     {
-        interconnects[i].first.update();
-        interconnects[i].second.update();
+        PROFILE_SCOPE(PROFILE_LINK, 2 * (interconnects.size() - hosts.size()));
+        for (int i = hosts.size(); i < interconnects.size(); ++i)
+        {
+            interconnects[i].first.update();
+            interconnects[i].second.update();
+        }
     }
-    for (auto &i : devices)
     {
-        i.update();
+        PROFILE_SCOPE(PROFILE_DEVICE, devices.size());
+        for (auto &i : devices)
+        {
+            i.update();
+        }
     }
-    for (auto &i : hosts)
     {
-        i.update();
+        PROFILE_SCOPE(PROFILE_HOST, hosts.size());
+        for (auto &i : hosts)
+        {
+            i.update();
+        }
     }
     if(curr_tick%params.delay_ramulator_update==0)
     {
+        PROFILE_SCOPE(PROFILE_DAM, DAMs.size());
         for (int i = 0; i < DAMs.size(); i++)
         {
             DAMs[i]->update();
         }
     }
+    if (sampler.is_due())
+        sample();
+}
+
+//! Print the simulated ticks and requests per wall clock second, and with PROFILE the updates per second every kind of
+//! component would manage on its own. A host update includes the cycles it skips, a device update its ramulator
+void CXLSystem::print_profile(double wall_seconds, uint64_t requests)
+{
+    const char *names[NUM_PROFILE_COMPONENTS] = {"links", "switch", "devices", "hosts", "DAMs"};
+    std::cout << "=====================================================\n";
+    std::cout << "Simulation speed\n";
+    std::cout << "Profile, total, " << curr_tick << ", " << wall_seconds << ", " << curr_tick / wall_seconds << ", " << requests / wall_seconds << "\n";
+    for (int i = 0; i < NUM_PROFILE_COMPONENTS; i++)
+        if (profile[i].updates > 0)
+            std::cout << "Profile, " << names[i] << ", " << profile[i].updates << ", " << profile[i].seconds << ", " << profile[i].updates / profile[i].seconds << "\n";
+    std::cout << "=====================================================\n";
 }
@@ -0,0 +1,171 @@
+#include "CXLTimeline.h"
+#include "CXLSampler.h"
+#include "CXLParams.h"
+#include "utils.h"
+#include <iomanip>
+
+using namespace CXL;
+
+namespace CXL
+{
+    extern CXLParams params;
+}
+
+//! A stage of the lifecycle of a CXL access, the time between two of its timestamps
+typedef struct
+{
+    timeline_track track;
+    const char *name;
+    int64_t msg_timing::*from;
+    int64_t msg_timing::*to;
+} lifecycle_stage;
+
+static const lifecycle_stage stages[] = {
+    {TRACK_HOST, "M2S VC", &msg_timing::tick_created, &msg_timing::tick_packed},
+    {TRACK_HOST, "tx buffer", &msg_timing::tick_packed, &msg_timing::tick_transmitted},
+    {TRACK_HOST_LINK, "flit to switch", &msg_timing::tick_transmitted, &msg_timing::tick_switch_ds_rx},
+    {TRACK_SWITCH, "downstream", &msg_timing::tick_switch_ds_rx, &msg_timing::tick_switch_ds_tx},
+    {TRACK_DEVICE_LINK, "flit to device", &msg_timing::tick_switch_ds_tx, &msg_timing::tick_received},
+    {TRACK_DEVICE, "rx buffer", &msg_timing::tick_received, &msg_timing::tick_unpacked},
+    {TRACK_DEVICE, "M2S VC", &msg_timing::tick_unpacked, &msg_timing::tick_at_ramulator},
+    {TRACK_DRAM, "access", &msg_timing::tick_at_ramulator, &msg_timing::tick_ramulator_complete},
+    {TRACK_DEVICE, "S2M VC", &msg_timing::tick_ramulator_complete, &msg_timing::tick_repacked},
+    {TRACK_DEVICE, "tx buffer", &msg_timing::tick_repacked, &msg_timing::tick_retransmitted},
+    {TRACK_DEVICE_LINK, "flit to switch", &msg_timing::tick_retransmitted, &msg_timing::tick_switch_us_rx},
+    {TRACK_SWITCH, "upstream", &msg_timing::tick_switch_us_rx, &msg_timing::tick_switch_us_tx},
+    {TRACK_HOST_LINK, "flit to host", &msg_timing::tick_switch_us_tx, &msg_timing::tick_resp_received},
+    {TRACK_HOST, "rx buffer", &msg_timing::tick_resp_received, &msg_timing::tick_resp_unpacked},
+    {TRACK_HOST, "S2M VC", &msg_timing::tick_resp_unpacked, &msg_timing::tick_req_complete},
+};
+
+static const char *track_names[NUM_TRACKS] = {"Host", "Host link", "Switch", "Device link", "Device", "Device DRAM", "Direct attached DRAM"};
+
+CXLTimeline::CXLTimeline()
+{
+    enabled = false;
+    first_event = true;
+    sample_every = 1;
+    start_tick = 0;
+    end_tick = INT64_MAX;
+    ticks_per_us = 1;
+    spans = 0;
+}
+
+void CXLTimeline::open(const std::string &filename, uint64_t sample_every, int64_t start_tick, int64_t end_tick)
+{
+    CXL_ASSERT(sample_every > 0 && "Timeline sampling rate should be positive");
+    out_buffer.resize(1 << 20);
+    out.rdbuf()->pubsetbuf(out_buffer.data(), out_buffer.size());
+    out.open(filename);
+    CXL_ASSERT(out.is_open() && "Could not open timeline file");
+    this->sample_every = sample_every;
+    this->start_tick = start_tick;
+    this->end_tick = end_tick;
+    ticks_per_us = params.ticks_per_ns * 1000.0;
+    out << std::fixed << std::setprecision(4);
+    out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    first_event = true;
+    enabled = true;
+    // Name the track group of every component and keep them in the order of the path of an access
+    for (int t = 0; t < NUM_TRACKS; t++)
+    {
+        begin_event();
+        out << "{\"ph\":\"M\",\"pid\":" << t + 1 << ",\"name\":\"process_name\",\"args\":{\"name\":\"" << track_names[t] << "\"}}";
+        begin_event();
+        out << "{\"ph\":\"M\",\"pid\":" << t + 1 << ",\"name\":\"process_sort_index\",\"args\":{\"sort_index\":" << t + 1 << "}}";
+    }
+}
+
+void CXLTimeline::begin_event()
+{
+    if (!first_event)
+        out << ",\n";
+    first_event = false;
+}
+
+double CXLTimeline::to_us(int64_t tick) const
+{
+    return tick / ticks_per_us;
+}
+
+void CXLTimeline::add_span(timeline_track track, const char *name, const char *category, int64_t start, int64_t end, uint64_t msg_id, uint64_t address)
+{
+    // Put the span in the first lane that is free by the time it starts, so spans of a lane never overlap
+    std::vector<int64_t> &lanes = lane_end[track];
+    size_t lane = 0;
+    while (lane < lanes.size() && lanes[lane] > start)
+        lane++;
+    if (lane == lanes.size())
+        lanes.push_back(end);
+    else
+        lanes[lane] = end;
+    begin_event();
+    out << "{\"ph\":\"X\",\"pid\":" << track + 1 << ",\"tid\":" << lane << ",\"ts\":" << to_us(start) << ",\"dur\":" << to_us(end - start)
+        << ",\"name\":\"" << name << "\",\"cat\":\"" << category << "\",\"args\":{\"msg\":" << msg_id << ",\"addr\":\"0x" << std::hex << address
+        << std::dec << "\",\"table\":" << ((address >> 48) & 0xFFF) << "}}";
+    spans++;
+}
+
+void CXLTimeline::add_message(const message &m)
+{
+    const char *category = m.time.read_write ? "write" : "read";
+    if (m.is_prefetch)
+        category = "prefetch";
+    for (const lifecycle_stage &s : stages)
+    {
+        int64_t from = m.time.*s.from, to = m.time.*s.to;
+        // Stages of components the access did not pass through have no timestamps
+        if (from <= 0 || to < from)
+            continue;
+        add_span(s.track, s.name, category, from, to, m.msg_id, m.address);
+    }
+}
+
+void CXLTimeline::add_dam_access(uint64_t msg_id, uint64_t address, int64_t tick_created, int64_t tick_complete)
+{
+    add_span(TRACK_DAM, "access", "dam", tick_created, tick_complete, msg_id, address);
+}
+
+void CXLTimeline::add_counters(const CXLSampler &s)
+{
+    // The component is the part of the column name before the first underscore, e.g. host0 in host0_tx_buf
+    if (counter_groups.empty())
+    {
+        for (int i = 0; i < s.num_columns(); i++)
+        {
+            const std::string &name = s.column_name(i);
+            size_t split = name.find('_');
+            counter_groups.push_back(split == std::string::npos ? "" : name.substr(0, split));
+            counter_names.push_back(split == std::string::npos ? name : name.substr(split + 1));
+        }
+    }
+    int64_t tick = s.last_value(0);
+    for (size_t i = 0; i < counter_groups.size();)
+    {
+        if (counter_groups[i].empty())
+        {
+            i++;
+            continue;
+        }
+        // One counter event per component, with one series per column
+        begin_event();
+        out << "{\"ph\":\"C\",\"pid\":0,\"ts\":" << to_us(tick) << ",\"name\":\"" << counter_groups[i] << "\",\"args\":{";
+        size_t j = i;
+        for (; j < counter_groups.size() && counter_groups[j] == counter_groups[i]; j++)
+            out << (j == i ? "" : ",") << "\"" << counter_names[j] << "\":" << s.last_value(j);
+        out << "}}";
+        i = j;
+    }
+}
+
+void CXLTimeline::close()
+{
+    if (!enabled)
+        return;
+    begin_event();
+    out << "{\"ph\":\"M\",\"pid\":0,\"name\":\"process_name\",\"args\":{\"name\":\"Occupancy\"}}";
+    out << "\n]}\n";
+    out.close();
+    enabled = false;
+    std::cout << "Timeline: " << spans << " spans\n";
+}
@@ -0,0 +1,100 @@
+#include "CXLWriteBuffer.h"
+#include "utils.h"
+#include <algorithm>
+#include <iterator>
+
+using namespace CXL;
+
+namespace CXL
+{
+    extern int64_t curr_tick;
+}
+
+CXLWriteBuffer::CXLWriteBuffer(int entries, int high_watermark, int low_watermark, write_drain_policy policy)
+    : stats{}, entries(entries), high_watermark(high_watermark), low_watermark(low_watermark), policy(policy)
+{
+    CXL_ASSERT(entries > 0 && low_watermark < high_watermark && high_watermark <= entries && "Invalid write buffer watermarks");
+    draining = false;
+    stalled = false;
+}
+
+bool CXLWriteBuffer::post(const message &m)
+{
+    uint64_t line = m.address & ~(uint64_t)0x3f;
+    if (line_index.count(line) == 1)
+    {
+        stats.posted++;
+        stats.coalesced++;
+        stalled = false;
+        return true;
+    }
+    if ((int)lines.size() >= entries)
+    {
+        // The host retries the same write every tick until there is room
+        if (!stalled)
+            stats.full++;
+        stalled = true;
+        return false;
+    }
+    stalled = false;
+    lines.push_back({curr_tick, m});
+    line_index[line] = std::prev(lines.end());
+    stats.posted++;
+    stats.peak = std::max<uint64_t>(stats.peak, lines.size());
+    if ((int)lines.size() >= high_watermark)
+        draining = true;
+    return true;
+}
+
+bool CXLWriteBuffer::forward(uint64_t address)
+{
+    if (line_index.count(address & ~(uint64_t)0x3f) == 0)
+        return false;
+    stats.forwarded++;
+    return true;
+}
+
+bool CXLWriteBuffer::wants_drain(bool reads_waiting, bool flush) const
+{
+    if (lines.empty())
+        return false;
+    if (flush)
+        return true;
+    switch (policy)
+    {
+    case drain_eager:
+        return true;
+    case drain_watermark:
+        return draining;
+    case drain_idle:
+        return draining || !reads_waiting;
+    default:
+        CXL_ASSERT(false && "Unknown write drain policy");
+    }
+    return false;
+}
+
+void CXLWriteBuffer::pop()
+{
+    auto &oldest = lines.front();
+    stats.drained++;
+    stats.residency = stats.residency + (curr_tick - oldest.first - stats.residency) / stats.drained;
+    line_index.erase(oldest.second.address & ~(uint64_t)0x3f);
+    lines.pop_front();
+    if ((int)lines.size() <= low_watermark)
+        draining = false;
+}
+
+const char *CXLWriteBuffer::policy_name() const
+{
+    switch (policy)
+    {
+    case drain_eager:
+        return "eager";
+    case drain_watermark:
+        return "watermark";
+    case drain_idle:
+        return "idle";
+    }
+    return "unknown";
+}
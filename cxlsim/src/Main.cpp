@@ -2,11 +2,92 @@
 #include "CXLSwitch.h"
 #include "CXLSys.h"
 #include "CXLParams.h"
+#include "CXLHybrid.h"
 #include <iostream>
 #include <iomanip>
 #include <fstream>
 #include <iterator>
 #include <unistd.h>
+#include <chrono>
+
+#ifndef PREFETCHER
+    #define PREFETCHER 0
+#endif
+#ifndef PREFETCH_DEGREE
+    #define PREFETCH_DEGREE 4
+#endif
+#ifndef PREFETCH_DISTANCE
+    #define PREFETCH_DISTANCE 1
+#endif
+#ifndef QOS_THROTTLE
+    #define QOS_THROTTLE 0
+#endif
+#ifndef LINK_BER
+    #define LINK_BER 0
+#endif
+#ifndef SAMPLE_INTERVAL
+    #define SAMPLE_INTERVAL 0
+#endif
+#ifndef CORE_MODEL
+    #define CORE_MODEL 0
+#endif
+#ifndef ROB_SIZE
+    #define ROB_SIZE 224
+#endif
+#ifndef NUM_MSHRS
+    #define NUM_MSHRS 16
+#endif
+#ifndef TRACE_RING_CAPACITY
+    #define TRACE_RING_CAPACITY (1 << 20)
+#endif
+#ifndef WRITE_BUFFER
+    #define WRITE_BUFFER 0
+#endif
+#ifndef WRITE_DRAIN
+    #define WRITE_DRAIN 1
+#endif
+#ifndef WRITE_HIGH
+    #define WRITE_HIGH (3 * WRITE_BUFFER / 4)
+#endif
+#ifndef WRITE_LOW
+    #define WRITE_LOW (WRITE_BUFFER / 4)
+#endif
+#ifndef DRAM_WRITE_HIGH
+    #define DRAM_WRITE_HIGH 0.8
+#endif
+#ifndef DRAM_WRITE_LOW
+    #define DRAM_WRITE_LOW 0.2
+#endif
+#ifndef TIMELINE
+    #define TIMELINE 0
+#endif
+#ifndef TIMELINE_START
+    #define TIMELINE_START 0
+#endif
+#ifndef TIMELINE_END
+    #define TIMELINE_END INT64_MAX
+#endif
+#ifndef BI_SNOOP_FILTER
+    #define BI_SNOOP_FILTER 0
+#endif
+#ifndef BI_SNOOP_FILTER_WAYS
+    #define BI_SNOOP_FILTER_WAYS 16
+#endif
+#ifndef BI_PEER_SHARE
+    #define BI_PEER_SHARE 0.0
+#endif
+#ifndef BI_PEER_SNOOP_NS
+    #define BI_PEER_SNOOP_NS 150
+#endif
+#ifndef FAST_MODE
+    #define FAST_MODE 0 // 0 detailed, 1 analytical, 2 hybrid
+#endif
+#ifndef HYBRID_WINDOW
+    #define HYBRID_WINDOW 10000
+#endif
+#ifndef HYBRID_PERIOD
+    #define HYBRID_PERIOD 100000
+#endif
 
 using namespace CXL;
 
@@ -15,6 +96,7 @@ namespace CXL
     int64_t curr_tick = 0;
     CXLParams params;
     CXLLog log("Event.log");
+    CXLTimeline timeline; /*!< Only records once it is opened*/
     uint64_t num_reqs_completed = 0; /*!< Variable to store how many requests sent out by the host have been completed till now. Includes both DAM and CXLDevice requests*/
     uint64_t num_dam_reqs = 0;
     #ifdef TRACK_LATENCY
@@ -61,8 +143,27 @@ int main(int argc, char *argv[])
         CXLAssert(false, "Invalid number of arguments");
     }
 
-    std::ifstream fin(trace_file);
-    num_reqs = std::count(std::istream_iterator<char>(fin >> std::noskipws), {}, '\n');
+    // A comma separated list of traces runs one core per trace on host 0, e.g. the per thread traces of a query.
+    // A trace of the form ring:<path> is streamed live from the pintool through a shared memory ring. The number of
+    // requests is only known once the pintool closes the ring
+    std::vector<std::string> core_traces;
+    std::stringstream trace_list(trace_file);
+    for (std::string t; std::getline(trace_list, t, ',');)
+        core_traces.push_back(t);
+    bool streaming = false;
+    num_reqs = 0;
+    for (std::string &t : core_traces)
+    {
+        if (t.compare(0, 5, "ring:") == 0)
+            streaming = true;
+        else
+        {
+            std::ifstream fin(t);
+            num_reqs += std::count(std::istream_iterator<char>(fin >> std::noskipws), {}, '\n');
+        }
+    }
+    if (streaming)
+        num_reqs = INT64_MAX;
 
     params.spec_bandwidth = (int64_t)4 << 30;
     params.bytes_per_slot = 16;
@@ -80,6 +181,52 @@ int main(int argc, char *argv[])
     params.delay_cxl_noc_switch_ns = 10;
     params.delay_cxl_port_switch_ns = 13;
     params.ticks_per_ins = 1 * params.ticks_per_ns; //Defaulted it to 1 instruction per 1ns on a 1GHz machine
+    params.prefetcher = PREFETCHER;
+    params.prefetch_degree = PREFETCH_DEGREE;
+    params.prefetch_distance = PREFETCH_DISTANCE;
+    params.prefetch_queue_size = 64;
+    params.prefetch_table_size = 256;
+    // Traffic class 0 is the latency sensitive class, higher classes get proportionally less of the switch and device packers
+    params.tc_weights[0] = 8;
+    params.tc_weights[1] = 4;
+    params.tc_weights[2] = 2;
+    params.tc_weights[3] = 1;
+    params.devload_optimal = 32;
+    params.devload_moderate = 64;
+    params.devload_severe = 128;
+    params.qos_throttle = QOS_THROTTLE;
+    params.qos_throttle_min_tc = 1;
+    params.qos_window_min = 4;
+    params.qos_window_max = 256;
+    params.link_ber = LINK_BER;
+    params.llr_buf_size = 64;
+    params.llr_ack_margin = 8;
+    params.llr_ack_timeout_ns = 20;
+    params.llr_seed = 1;
+    params.core_model = CORE_MODEL;
+    params.rob_size = ROB_SIZE;
+    params.num_mshrs = NUM_MSHRS;
+    params.sample_interval = SAMPLE_INTERVAL;
+    params.sample_buffer_rows = 4096;
+    params.write_buffer_size = WRITE_BUFFER;
+    // The default watermarks round down to 0 for tiny buffers, keep at least one line above the low watermark
+    params.write_buffer_high = std::min(std::max(WRITE_HIGH, 1), std::max(WRITE_BUFFER, 1));
+    params.write_buffer_low = std::max(std::min(WRITE_LOW, params.write_buffer_high - 1), 0);
+    params.write_drain_policy = WRITE_DRAIN;
+    params.dram_write_high = DRAM_WRITE_HIGH;
+    params.dram_write_low = DRAM_WRITE_LOW;
+    params.timeline_sample = TIMELINE;
+    params.timeline_start = TIMELINE_START;
+    params.timeline_end = TIMELINE_END;
+    params.bi_snoop_filter = BI_SNOOP_FILTER;
+    params.bi_snoop_filter_ways = std::min(BI_SNOOP_FILTER_WAYS, std::max(BI_SNOOP_FILTER, 1));
+    params.bi_peer_share = BI_PEER_SHARE;
+    params.bi_host_snoop_ns = 20;
+    params.bi_peer_snoop_ns = BI_PEER_SNOOP_NS;
+    params.bi_seed = 1;
+    // The occupancy counters of the timeline come from the sampler
+    if (params.timeline_sample > 0 && params.sample_interval == 0)
+        params.sample_interval = 1000;
     // params.ticks_per_ins = 1; // Defaulted it to 1 instruction per 1ns on a 1GHz machine
 
     params.recalculate();
@@ -102,7 +249,22 @@ int main(int argc, char *argv[])
     // device_host.push_back(0);
     CXLSystem cxl(1, 1, 1, address_interval_DAM, address_interval, device_host);
     CXLHost &host0 = cxl.hosts[0];
-    host0.set_trace_file(trace_file);
+    for (size_t core = 0; core < core_traces.size(); core++)
+    {
+        std::string &t = core_traces[core];
+        if (t.compare(0, 5, "ring:") == 0)
+        {
+            if (!host0.set_trace_ring(t.substr(5), TRACE_RING_CAPACITY, core))
+            {
+                std::cerr << "Failed to create trace ring " << t.substr(5) << std::endl;
+                return 1;
+            }
+            std::cout << "Core " << core << " waiting for trace records on " << t.substr(5) << "\n";
+        }
+        else
+            host0.set_trace_file(t, core);
+    }
+    std::cout << "Cores " << host0.num_cores() << "\n";
 
     printf("Credits: %d,%d,%d\n", cxl.hosts[0].int_cred.data_credit, cxl.hosts[0].int_cred.req_credit, cxl.hosts[0].int_cred.rsp_credit);
 
@@ -116,13 +278,39 @@ int main(int argc, char *argv[])
         std::cerr << "Failed to open file " << output_latency_file << " for writing." << std::endl;
         return 1;
     }
+    if (params.sample_interval > 0)
+        cxl.sampler.open(base_dir + "/" + query_id + "/samples_" + std::to_string(getpid()) + ".csv", params.sample_interval, params.sample_buffer_rows);
+    if (params.timeline_sample > 0)
+        timeline.open(base_dir + "/" + query_id + "/timeline_" + std::to_string(getpid()) + ".json", params.timeline_sample, params.timeline_start, params.timeline_end);
+#ifdef PROFILE
+    auto sim_start = std::chrono::steady_clock::now();
+#endif
+    // The analytical model is calibrated by the detailed windows of hybrid runs, analytical runs reuse the calibration
+    CXLAnalytical model;
+    std::string calibration_file = base_dir + "/calibration.csv";
+#if FAST_MODE == 1
+    if (!model.load(calibration_file))
+        std::cout << "No calibration in " << calibration_file << ", the analytical estimate is uncorrected\n";
+    TraceWindowStats whole_trace;
+    host0.fast_forward(UINT64_MAX, whole_trace);
+    analytical_estimate estimate = model.estimate(whole_trace);
+    curr_tick += estimate.ticks;
+    host0.account_estimate(whole_trace, estimate);
+#elif FAST_MODE == 2
+    CXLHybrid hybrid(host0, model, HYBRID_WINDOW, HYBRID_PERIOD);
+#endif
     while (true)
     {
         cxl.update();
         curr_tick++;
+#if FAST_MODE == 2
+        hybrid.update();
+#endif
         if(cxl.hosts[0].no_active_transaction())
             inactive_cycle_count++;
-        if (cxl.hosts[0].messages_sent_to_device.size() == 0 && cxl.hosts[0].reqs_in_dam.size() == 0 && num_reqs_completed >= num_reqs)
+        if (streaming && cxl.hosts[0].trace_finished())
+            num_reqs = cxl.hosts[0].trace_entries();
+        if (cxl.hosts[0].messages_sent_to_device.size() == 0 && cxl.hosts[0].reqs_in_dam.size() == 0 && num_reqs_completed >= num_reqs && !cxl.hosts[0].has_buffered_writes())
         {
             printf("%d, %d\n", cxl.hosts[0].messages_sent_to_device.size(), cxl.hosts[0].reqs_in_dam.size());
             for(const auto& pair : cxl.hosts[0].amat_per_table_dam) {
@@ -131,18 +319,47 @@ int main(int argc, char *argv[])
             for(const auto& pair : cxl.hosts[0].amat_per_table_cxl) {
                 outputFile << std::fixed << 1 << ", " << std::hex << pair.first << ", " << pair.second[0] << ", " << pair.second[1] << ", " << pair.second[2] << std::endl;
             }
+            cxl.hosts[0].print_core_stats(outputFile);
             // Closing the file
             outputFile.close();
+            cxl.sampler.close();
+            timeline.close();
             break;
         }
     }
 
+#ifdef PROFILE
+    cxl.print_profile(std::chrono::duration<double>(std::chrono::steady_clock::now() - sim_start).count(), num_reqs_completed);
+#endif
     // Print the skipped cycles for host
     cxl.hosts[0].print_skipped_cycles();
+    cxl.hosts[0].print_prefetch_stats();
+    cxl.hosts[0].print_write_buffer_stats();
+    cxl.hosts[0].print_qos_stats();
+    cxl.hosts[0].print_latency_tail();
+    cxl.hosts[0].print_trace_ring_stats();
+#if FAST_MODE == 1
+    model.print();
+    std::cout << "Analytical estimate: DAM AMAT " << estimate.amat[dam_tier] << " CXL AMAT " << estimate.amat[cxl_tier]
+              << " link utilization " << estimate.link_utilization[0] << ", " << estimate.link_utilization[1]
+              << (estimate.saturated ? " (saturated, lower bound)" : "") << "\n";
+    for (int tier = 0; tier < NUM_TIERS; tier++)
+        if (model.relative_error_bound((memory_tier)tier) >= 0)
+            std::cout << (tier == dam_tier ? "DAM" : "CXL") << " AMAT error bound +-" << model.relative_error_bound((memory_tier)tier) * estimate.amat[tier] << " ticks (95%)\n";
+#elif FAST_MODE == 2
+    hybrid.print();
+    model.save(calibration_file);
+#endif
+    for (auto &link : cxl.interconnects)
+    {
+        link.first.print_link_stats();
+        link.second.print_link_stats();
+    }
     std::cout << "DAM completed " << CXL::num_dam_reqs << "\n";
     for (int i = 0; i < cxl.devices.size(); i++)
     {
         cxl.devices[i].print_skipped_cycles();
+        cxl.devices[i].print_coherence_stats();
     }
 
     std::cout << "Break 9\n";
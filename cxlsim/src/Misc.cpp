@@ -1,6 +1,8 @@
 #include "flit.h"
 #include "CXLParams.h"
+#include "CXLQoS.h"
 #include <iostream>
+#include <algorithm>
 #include "utils.h"
 // File includes all sorts of miscellaneous constructors and functions for which we dont want to have a separate file
 
@@ -16,6 +18,11 @@ namespace CXL
 
 flit_header::flit_header()
 {
+    type = protocol;
+    ack = false;
+    seq = 0;
+    ctrl = llcrd_ack;
+    acks = 0;
     slots.resize(4);
 }
 
@@ -62,14 +69,14 @@ void message::init_time()
     time.ramulator_clk_end = 0;
 }
 
-message::message(opcode oc, uint64_t addr) : opCode(oc), address(addr)
+message::message(opcode oc, uint64_t addr) : opCode(oc), address(addr), traffic_class(0), dev_load(light_load)
 {
     init_time();
     msg_id = message::msg_count;
     msg_count++;
 }
 
-message::message(opcode oc, uint64_t addr, int dp_id, int sp_id) : opCode(oc), address(addr), dp_id(dp_id), sp_id(sp_id)
+message::message(opcode oc, uint64_t addr, int dp_id, int sp_id) : opCode(oc), address(addr), dp_id(dp_id), sp_id(sp_id), traffic_class(0), dev_load(light_load)
 {
     init_time();
     msg_id = message::msg_count;
@@ -107,6 +114,9 @@ void message::copy(const message &m)
 
     dev_load = m.dev_load;
     msg_id = m.msg_id;
+    is_prefetch = m.is_prefetch;
+    is_posted = m.is_posted;
+    depends_on_load = m.depends_on_load;
 }
 
 slot::slot(message &msg)
@@ -130,7 +140,7 @@ void flit::print()
 }
 
 // Return string with flit parameters
-std::string flit::sprint()
+std::string flit::sprint() const
 {
     std::string s;
     s += "#" + std::to_string(flit_id) + " ";
@@ -150,6 +160,12 @@ std::string flit::sprint()
         case slot_type::s2m_ndr:
             s = s + "(ndr - " + std::to_string(this->slots[i].msg.msg_id) + ") ";
             break;
+        case slot_type::s2m_bisnp:
+            s = s + "(bisnp - " + std::to_string(this->slots[i].msg.msg_id) + ") ";
+            break;
+        case slot_type::m2s_birsp:
+            s = s + "(birsp - " + std::to_string(this->slots[i].msg.msg_id) + ") ";
+            break;
         case slot_type::data:
             s = s + "(data - " + std::to_string(this->slots[i].msg.msg_id) + ") ";
             break;
@@ -177,6 +193,21 @@ uint64_t flit::get_first_address() const
     return 0;
 }
 
+//! A flit carries the highest priority (lowest) traffic class of the messages in it. Data slots belong to the header of an earlier flit and are ignored
+int flit::traffic_class() const
+{
+    int tc = NUM_TC - 1;
+    bool found = false;
+    for (const slot &s : slots)
+    {
+        if (s.type == slot_type::empty || s.type == slot_type::data)
+            continue;
+        tc = found ? std::min(tc, s.msg.traffic_class) : s.msg.traffic_class;
+        found = true;
+    }
+    return found ? tc : 0;
+}
+
 // message::message(message& m2){
 //     this->valid = m2.valid;
 //     this->opCode = m2.opCode;
@@ -211,6 +242,9 @@ void CXLParams::recalculate()
     delay_vc_to_retire = delay_vc_to_retire_ns * ticks_per_ns;
     delay_cxl_noc_switch = delay_cxl_noc_switch_ns * ticks_per_ns;
     delay_cxl_port_switch = delay_cxl_port_switch_ns * ticks_per_ns;
+    llr_ack_timeout = llr_ack_timeout_ns * ticks_per_ns;
+    bi_host_snoop = bi_host_snoop_ns * ticks_per_ns;
+    bi_peer_snoop = bi_peer_snoop_ns * ticks_per_ns;
 }
 
 //! Print all CLX params;
@@ -0,0 +1,215 @@
+// Synthetic trace generator for cxlsim
+// Writes a trace in the format cxlsim reads, one access per line: `addr R|W gap [tc dep]`
+//
+// Usage: cxlsim-gen <pattern> <number of accesses> [key=value ...]
+// Patterns
+//   stream  sequential lines
+//   strided every stride bytes
+//   random  uniform random lines
+//   zipf    Zipfian distributed lines, the hot lines are scattered over the footprint
+//   chase   pointer chase through a random cycle over all lines, every load depends on the previous one
+//   mix     uniform random lines, 30% writes unless writes= is given
+// Keys
+//   footprint=64M     bytes touched in each memory, K, M and G suffixes are allowed
+//   stride=256        bytes between the accesses of strided
+//   gap=fixed:10      instructions between accesses, fixed:N, uniform:MIN:MAX or exp:MEAN
+//   cxl=0.7           fraction of the accesses that go to CXL memory, the others go to direct attached memory
+//   writes=0          fraction of writes
+//   alpha=0.99        skew of zipf
+//   seed=1
+//   out=<file>        defaults to stdout
+//   dam_base, cxl_base  start of the two memories, default to the address intervals in Main.cpp
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+const uint64_t LINE_SIZE = 64;
+
+static void usage()
+{
+    fprintf(stderr, "Usage: cxlsim-gen stream|strided|random|zipf|chase|mix <number of accesses> [footprint=64M] [stride=256] "
+                    "[gap=fixed:10|uniform:MIN:MAX|exp:MEAN] [cxl=0.7] [writes=0] [alpha=0.99] [seed=1] [out=<file>] "
+                    "[dam_base=0x100000000000] [cxl_base=0xb00000000000000]\n");
+    exit(1);
+}
+
+static uint64_t parse_size(const std::string &s)
+{
+    char *end;
+    uint64_t v = strtoull(s.c_str(), &end, 0);
+    switch (*end)
+    {
+    case 'G':
+    case 'g':
+        v <<= 10; // fall through
+    case 'M':
+    case 'm':
+        v <<= 10; // fall through
+    case 'K':
+    case 'k':
+        v <<= 10;
+    }
+    return v;
+}
+
+//! Instruction gap between two accesses
+class GapDistribution
+{
+public:
+    GapDistribution(const std::string &spec)
+    {
+        std::vector<std::string> f;
+        size_t start = 0, pos;
+        while ((pos = spec.find(':', start)) != std::string::npos)
+        {
+            f.push_back(spec.substr(start, pos - start));
+            start = pos + 1;
+        }
+        f.push_back(spec.substr(start));
+        kind = f[0];
+        if ((kind == "fixed" || kind == "exp") && f.size() == 2)
+            a = b = strtod(f[1].c_str(), nullptr);
+        else if (kind == "uniform" && f.size() == 3)
+        {
+            a = strtod(f[1].c_str(), nullptr);
+            b = strtod(f[2].c_str(), nullptr);
+        }
+        else
+            usage();
+    }
+
+    uint64_t next(std::mt19937_64 &rng)
+    {
+        if (kind == "fixed")
+            return (uint64_t)a;
+        if (kind == "uniform")
+            return std::uniform_int_distribution<uint64_t>((uint64_t)a, (uint64_t)b)(rng);
+        return (uint64_t)std::llround(std::exponential_distribution<double>(1.0 / a)(rng));
+    }
+
+private:
+    std::string kind;
+    double a, b;
+};
+
+//! Line index generator of one memory, every memory keeps its own position so that each of them sees the pattern
+class LineGenerator
+{
+public:
+    LineGenerator(const std::string &pattern, uint64_t lines, uint64_t stride_lines, double alpha, std::mt19937_64 &rng)
+        : pattern(pattern), lines(lines), stride_lines(stride_lines), pos(0)
+    {
+        if (pattern == "zipf")
+        {
+            // Cumulative distribution over the ranks, the rank is mapped to a line by a multiplication with a number
+            // that is coprime to the number of lines
+            cdf.resize(lines);
+            double sum = 0;
+            for (uint64_t i = 0; i < lines; i++)
+                cdf[i] = (sum += 1.0 / std::pow((double)(i + 1), alpha));
+            for (double &c : cdf)
+                c /= sum;
+            scatter = 0x9E3779B97F4A7C15ULL % lines | 1;
+            while (std::gcd(scatter, lines) != 1)
+                scatter += 2;
+        }
+        else if (pattern == "chase")
+        {
+            // Sattolo's algorithm gives a single cycle through all the lines
+            next_line.resize(lines);
+            std::iota(next_line.begin(), next_line.end(), 0);
+            for (uint64_t i = lines - 1; i > 0; i--)
+                std::swap(next_line[i], next_line[std::uniform_int_distribution<uint64_t>(0, i - 1)(rng)]);
+        }
+    }
+
+    uint64_t next(std::mt19937_64 &rng)
+    {
+        uint64_t line;
+        if (pattern == "stream" || pattern == "strided")
+        {
+            line = pos;
+            pos = (pos + stride_lines) % lines;
+        }
+        else if (pattern == "zipf")
+        {
+            double u = std::uniform_real_distribution<double>(0, 1)(rng);
+            uint64_t rank = std::lower_bound(cdf.begin(), cdf.end(), u) - cdf.begin();
+            line = (unsigned __int128)std::min(rank, lines - 1) * scatter % lines;
+        }
+        else if (pattern == "chase")
+        {
+            line = pos;
+            pos = next_line[pos];
+        }
+        else
+            line = std::uniform_int_distribution<uint64_t>(0, lines - 1)(rng);
+        return line;
+    }
+
+private:
+    std::string pattern;
+    uint64_t lines, stride_lines, pos, scatter;
+    std::vector<double> cdf;
+    std::vector<uint64_t> next_line;
+};
+
+int main(int argc, char *argv[])
+{
+    if (argc < 3)
+        usage();
+    std::string pattern = argv[1];
+    if (pattern != "stream" && pattern != "strided" && pattern != "random" && pattern != "zipf" && pattern != "chase" && pattern != "mix")
+        usage();
+    uint64_t num_accesses = parse_size(argv[2]);
+
+    std::map<std::string, std::string> opts = {{"footprint", "64M"}, {"stride", "256"}, {"gap", "fixed:10"}, {"cxl", "0.7"}, {"writes", pattern == "mix" ? "0.3" : "0"}, {"alpha", "0.99"}, {"seed", "1"}, {"out", "-"}, {"dam_base", "0x100000000000"}, {"cxl_base", "0xb00000000000000"}};
+    for (int i = 3; i < argc; i++)
+    {
+        const char *eq = strchr(argv[i], '=');
+        if (eq == nullptr || opts.count(std::string(argv[i], eq - argv[i])) == 0)
+            usage();
+        opts[std::string(argv[i], eq - argv[i])] = eq + 1;
+    }
+
+    uint64_t lines = std::max(parse_size(opts["footprint"]) / LINE_SIZE, (uint64_t)1);
+    uint64_t stride_lines = pattern == "strided" ? std::max(parse_size(opts["stride"]) / LINE_SIZE, (uint64_t)1) : 1;
+    double cxl_fraction = strtod(opts["cxl"].c_str(), nullptr);
+    double write_fraction = strtod(opts["writes"].c_str(), nullptr);
+    double alpha = strtod(opts["alpha"].c_str(), nullptr);
+    uint64_t base[2] = {parse_size(opts["dam_base"]), parse_size(opts["cxl_base"])};
+    std::mt19937_64 rng(strtoull(opts["seed"].c_str(), nullptr, 0));
+    GapDistribution gap(opts["gap"]);
+    LineGenerator gen[2] = {LineGenerator(pattern, lines, stride_lines, alpha, rng), LineGenerator(pattern, lines, stride_lines, alpha, rng)};
+
+    FILE *out = opts["out"] == "-" ? stdout : fopen(opts["out"].c_str(), "w");
+    if (out == nullptr)
+    {
+        perror(opts["out"].c_str());
+        return 1;
+    }
+    std::uniform_real_distribution<double> coin(0, 1);
+    for (uint64_t i = 0; i < num_accesses; i++)
+    {
+        int tier = coin(rng) < cxl_fraction;
+        uint64_t addr = base[tier] + gen[tier].next(rng) * LINE_SIZE;
+        bool is_write = pattern != "chase" && coin(rng) < write_fraction;
+        // The loads of a pointer chase need the data of the previous load, cxlsim only uses this with CORE_MODEL=1
+        if (pattern == "chase" && i > 0)
+            fprintf(out, "0x%lx R %lu 0 1\n", addr, gap.next(rng));
+        else
+            fprintf(out, "0x%lx %c %lu\n", addr, is_write ? 'W' : 'R', gap.next(rng));
+    }
+    if (out != stdout)
+        fclose(out);
+    return 0;
+}
@@ -5,6 +5,7 @@
 #include "hyrise.hpp"
 #include "import_export/binary/binary_parser.hpp"
 #include "import_export/binary/binary_writer.hpp"
+#include "memory/tiered_memory_resource.hpp"
 #include "operators/sort.hpp"
 #include "operators/table_wrapper.hpp"
 #include "scheduler/job_task.hpp"
@@ -301,6 +302,28 @@ void AbstractTableGenerator::generate_and_store()
                      "statistics"
                   << std::endl;
 
+        const auto &encoding_config = _benchmark_config->encoding_config;
+        if (!encoding_config.custom_placement_mapping.empty())
+        {
+            configure_far_memory_tier(encoding_config.far_tier_capacity,
+                                      encoding_config.far_tier_numa_node);
+            const auto [region_begin, region_end] =
+                get_far_memory_tier()->region();
+            std::cout << "- Placing columns in the far memory tier ";
+            if (encoding_config.far_tier_numa_node)
+            {
+                std::cout << "on NUMA node "
+                          << *encoding_config.far_tier_numa_node;
+            }
+            else
+            {
+                std::cout << "emulated in DRAM";
+            }
+            std::cout << " at [" << static_cast<const void *>(region_begin)
+                      << ", " << static_cast<const void *>(region_end) << ")"
+                      << std::endl;
+        }
+
         auto jobs = std::vector<std::shared_ptr<AbstractTask>>{};
         jobs.reserve(table_info_by_name.size());
         for (auto &table_info_by_name_pair : table_info_by_name)
@@ -64,6 +64,21 @@ class BenchmarkConfig
     bool system_metrics{false};
     bool pipeline_metrics{false};
     std::vector<std::string> plugins{};
+    // Record page-level access heatmaps of all segments (see
+    // SegmentAccessCounter::enable_heatmaps) and sample the system utilization
+    // of each statement (see SystemSampler). Let concurrent TableScans share
+    // their chunk reads (see SharedScanCursor). Cap the near-tier memory of the
+    // operator arenas of each query in bytes (see QueryMemoryPool), 0 means
+    // unlimited. Cap the concurrent far-memory tasks of the scheduler by the
+    // far link bandwidth and the bandwidth of one task in bytes per second
+    // (see FarMemoryBandwidthBudget), a link bandwidth of 0 means unlimited.
+    // Not part of the constructor as they are only set via the CLI.
+    bool segment_heatmaps{false};
+    bool system_sampling{false};
+    bool shared_scans{false};
+    size_t query_memory_budget{0};
+    size_t far_link_bandwidth{0};
+    size_t far_task_bandwidth{0};
 
   private:
     BenchmarkConfig() = default;
@@ -16,6 +16,7 @@
 #include "scheduler/job_task.hpp"
 #include "sql/sql_pipeline_builder.hpp"
 #include "storage/chunk.hpp"
+#include "storage/segment_access_counter.hpp"
 #include "tpch/tpch_table_generator.hpp"
 #include "utils/format_duration.hpp"
 #include "utils/print_utils.hpp"
@@ -72,6 +73,8 @@ BenchmarkRunner::BenchmarkRunner(
             {"utilized_cores_per_numa_node", numa_cores_per_node});
 
         const auto scheduler = std::make_shared<NodeQueueScheduler>();
+        scheduler->far_memory_budget().configure(config.far_link_bandwidth,
+                                                 config.far_task_bandwidth);
         Hyrise::get().set_scheduler(scheduler);
     }
 
@@ -175,6 +178,16 @@ void BenchmarkRunner::run()
             .get_result_table();
     }
 
+    // Only record heatmaps for the benchmark items, not for the data
+    // preparation.
+    if (_config.segment_heatmaps)
+    {
+        SegmentAccessCounter::enable_heatmaps(true);
+    }
+    Hyrise::get().set_system_sampling(_config.system_sampling);
+    Hyrise::get().shared_scans.set_enabled(_config.shared_scans);
+    Hyrise::get().set_query_memory_budget(_config.query_memory_budget);
+
     // Retrieve the items to be executed and prepare the result vector.
     const auto &items = _benchmark_item_runner->items();
     if (!items.empty())
@@ -618,6 +631,29 @@ nlohmann::json BenchmarkRunner::_create_report() const
                             {"query_plan_cache_hit",
                              sql_statement_metrics->query_plan_cache_hit}};
 
+                        if (sql_statement_metrics->system_utilization)
+                        {
+                            sql_statement_metrics_json["system_utilization"] =
+                                _system_utilization_to_json(
+                                    *sql_statement_metrics->system_utilization);
+                        }
+
+                        if (const auto &operator_memory =
+                                sql_statement_metrics->operator_memory)
+                        {
+                            sql_statement_metrics_json["operator_memory"] =
+                                nlohmann::json{
+                                    {"budget", operator_memory->budget},
+                                    {"peak_reserved_bytes",
+                                     operator_memory->peak_reserved_bytes},
+                                    {"peak_allocated_bytes",
+                                     operator_memory->peak_allocated_bytes},
+                                    {"reused_bytes",
+                                     operator_memory->reused_bytes},
+                                    {"over_budget_bytes",
+                                     operator_memory->over_budget_bytes}};
+                        }
+
                         pipeline_metrics_json["statements"].push_back(
                             sql_statement_metrics_json);
                     }
@@ -709,6 +745,13 @@ nlohmann::json BenchmarkRunner::_create_report() const
         report["segments"] =
             _sql_to_json("SELECT * FROM benchmark_segments_log");
     }
+
+    if (_config.segment_heatmaps)
+    {
+        report["segment_heatmap"] =
+            _sql_to_json("SELECT * FROM meta_segment_heatmap WHERE table_name "
+                         "NOT LIKE 'benchmark%'");
+    }
     return report;
 }
 
@@ -770,6 +813,12 @@ BenchmarkRunner::get_basic_cli_options(const std::string &benchmark_name)
     ("dont_cache_binary_tables", "Do not cache tables as binary files for faster loading on subsequent runs", cxxopts::value<bool>()->default_value("false"))  // NOLINT(whitespace/line_length)
     ("system_metrics", "Track system metrics (system utilization, segment accesses, etc.) and add them to the output JSON (see -o).", cxxopts::value<bool>()->default_value("false"))  // NOLINT(whitespace/line_length)
     ("pipeline_metrics", "Track SQL pipeline metrics (runtime of steps in SQL pipeline, optimizer rule durations) and add them to the output JSON (see -o). Tracking pipeline metrics switches off plan caching.", cxxopts::value<bool>()->default_value("false"))  // NOLINT(whitespace/line_length)
+    ("system_sampling", "Sample the I/O, CPU, and memory utilization while each statement executes and add it to the pipeline metrics (requires --pipeline_metrics).", cxxopts::value<bool>()->default_value("false"))  // NOLINT(whitespace/line_length)
+    ("shared_scans", "Let concurrent table scans of the same table share their chunk reads (cooperative scans), mostly useful with --clients > 1.", cxxopts::value<bool>()->default_value("false"))  // NOLINT(whitespace/line_length)
+    ("far_link_bandwidth", "Bandwidth of the far memory tier in MB/s. Caps the number of concurrently running tasks that read far memory so that they just saturate it (requires --scheduler). 0 means unlimited.", cxxopts::value<size_t>()->default_value("0"))  // NOLINT(whitespace/line_length)
+    ("far_task_bandwidth", "Far memory bandwidth in MB/s that a single scanning task draws, see --far_link_bandwidth.", cxxopts::value<size_t>()->default_value("2000"))  // NOLINT(whitespace/line_length)
+    ("query_memory_budget", "Near-tier memory in MB that the operators of each query may hold for their intermediate state (hash tables, sort buffers, etc.). Exceeding it only issues a performance warning. 0 means unlimited.", cxxopts::value<size_t>()->default_value("0"))  // NOLINT(whitespace/line_length)
+    ("segment_heatmaps", "Record page-level (4 KB) access heatmaps of all segments and add them to the output JSON (see -o).", cxxopts::value<bool>()->default_value("false"))  // NOLINT(whitespace/line_length)
     // This option is only advised when the underlying system's memory capacity is overleaded by the preparation phase.
     ("data_preparation_cores", "Specify the number of cores used by the scheduler for data preparation, i.e., sorting and encoding tables and generating table statistics. 0 means all available cores.", cxxopts::value<uint32_t>()->default_value("0"));  // NOLINT(whitespace/line_length)
     // clang-format on
@@ -859,6 +908,47 @@ nlohmann::json BenchmarkRunner::_sql_to_json(const std::string &sql)
     return output;
 }
 
+nlohmann::json BenchmarkRunner::_system_utilization_to_json(
+    const SystemUtilization &utilization)
+{
+    auto samples = nlohmann::json::array();
+    for (const auto &sample : utilization.samples)
+    {
+        auto sample_json =
+            nlohmann::json{{"timestamp", sample.timestamp.count()},
+                           {"io_read_bytes", sample.io_read_bytes},
+                           {"io_write_bytes", sample.io_write_bytes},
+                           {"io_read_chars", sample.io_read_chars},
+                           {"io_write_chars", sample.io_write_chars},
+                           {"system_busy_time", sample.system_busy_time},
+                           {"system_idle_time", sample.system_idle_time},
+                           {"system_iowait_time", sample.system_iowait_time},
+                           {"process_cpu_time", sample.process_cpu_time},
+                           {"process_rss", sample.process_rss},
+                           {"process_threads", sample.process_threads}};
+        if (const auto &counters = sample.hardware_counters)
+        {
+            sample_json["cycles"] = counters->cycles;
+            sample_json["instructions"] = counters->instructions;
+            sample_json["cache_misses"] = counters->cache_misses;
+        }
+        samples.push_back(std::move(sample_json));
+    }
+
+    auto thread_cpu_times = nlohmann::json::array();
+    for (const auto &thread_time : utilization.thread_cpu_times)
+    {
+        thread_cpu_times.push_back(
+            nlohmann::json{{"thread_id", thread_time.thread_id},
+                           {"user_time", thread_time.user_time.count()},
+                           {"system_time", thread_time.system_time.count()}});
+    }
+
+    return nlohmann::json{{"interval", utilization.interval.count()},
+                          {"samples", std::move(samples)},
+                          {"thread_cpu_times", std::move(thread_cpu_times)}};
+}
+
 void BenchmarkRunner::_snapshot_segment_access_counters(
     const std::string &moment)
 {
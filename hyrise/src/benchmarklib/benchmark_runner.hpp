@@ -89,6 +89,10 @@ class BenchmarkRunner : public Noncopyable
     // Converts the result of a SQL query into a JSON object.
     static nlohmann::json _sql_to_json(const std::string &sql);
 
+    // Converts the samples of a SystemSampler into a JSON object.
+    static nlohmann::json
+    _system_utilization_to_json(const SystemUtilization &utilization);
+
     // Writes the current meta_segments table into the benchmark_segments_log
     // tables. The `moment` parameter can be used to identify a certain point in
     // the benchmark, e.g., when an item is finished in the ordered mode.
@@ -146,7 +146,28 @@ bool BenchmarkTableEncoder::encode(const std::string &table_name,
     }
 
     /**
-     * 2. Actually encode chunks
+     * 2. Build the ChunkPlacementSpec if columns of this table are placed in
+     *    the far tier. Otherwise, segments stay where they are.
+     */
+    auto chunk_placement_spec = ChunkPlacementSpec{};
+    const auto &placement_mapping = encoding_config.custom_placement_mapping;
+    const auto placement_mapping_it = placement_mapping.find(table_name);
+    if (placement_mapping_it != placement_mapping.end())
+    {
+        const auto &tier_by_column_name = placement_mapping_it->second;
+        for (auto column_id = ColumnID{0}; column_id < table->column_count();
+             ++column_id)
+        {
+            const auto tier_it =
+                tier_by_column_name.find(table->column_name(column_id));
+            chunk_placement_spec.push_back(tier_it != tier_by_column_name.end()
+                                               ? tier_it->second
+                                               : MemoryTier::Near);
+        }
+    }
+
+    /**
+     * 3. Actually encode chunks
      */
     auto encoding_performed = std::atomic_bool{false};
     const auto column_data_types = table->column_data_types();
@@ -162,11 +183,19 @@ bool BenchmarkTableEncoder::encode(const std::string &table_name,
             const auto chunk = table->get_chunk(ChunkID{chunk_id});
             Assert(chunk, "Physically deleted chunk should not reach this "
                           "point, see get_chunk / #1686.");
-            if (!is_chunk_encoding_spec_satisfied(
-                    chunk_encoding_spec, get_chunk_encoding_spec(*chunk)))
+            const auto encoding_satisfied = is_chunk_encoding_spec_satisfied(
+                chunk_encoding_spec, get_chunk_encoding_spec(*chunk));
+            // Placed tables are passed to the ChunkEncoder even if they are
+            // encoded already, because tables loaded from binary files are
+            // allocated in the near tier.
+            if (!encoding_satisfied || !chunk_placement_spec.empty())
             {
                 ChunkEncoder::encode_chunk(chunk, column_data_types,
-                                           chunk_encoding_spec);
+                                           chunk_encoding_spec,
+                                           chunk_placement_spec);
+            }
+            if (!encoding_satisfied)
+            {
                 encoding_performed = true;
             }
         };
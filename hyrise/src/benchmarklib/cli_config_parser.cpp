@@ -225,6 +225,54 @@ CLIConfigParser::parse_cli_options(const cxxopts::ParseResult &parse_result)
         std::cout << "- Not tracking SQL pipeline metrics." << std::endl;
     }
 
+    const auto segment_heatmaps = parse_result["segment_heatmaps"].as<bool>();
+    if (segment_heatmaps)
+    {
+        Assert(
+            !output_file_string.empty(),
+            "--segment_heatmaps only makes sense when an output file is set.");
+        std::cout << "- Recording segment heatmaps." << std::endl;
+    }
+
+    const auto system_sampling = parse_result["system_sampling"].as<bool>();
+    if (system_sampling)
+    {
+        Assert(pipeline_metrics,
+               "--system_sampling is reported as part of --pipeline_metrics.");
+        std::cout << "- Sampling system utilization of each statement."
+                  << std::endl;
+    }
+
+    const auto shared_scans = parse_result["shared_scans"].as<bool>();
+    if (shared_scans)
+    {
+        std::cout << "- Sharing chunk reads between concurrent table scans."
+                  << std::endl;
+    }
+
+    const auto query_memory_budget_mb =
+        parse_result["query_memory_budget"].as<size_t>();
+    if (query_memory_budget_mb > 0)
+    {
+        std::cout << "- Limiting the operator memory of each query to "
+                  << query_memory_budget_mb << " MB" << std::endl;
+    }
+
+    const auto far_link_bandwidth_mb =
+        parse_result["far_link_bandwidth"].as<size_t>();
+    const auto far_task_bandwidth_mb =
+        parse_result["far_task_bandwidth"].as<size_t>();
+    if (far_link_bandwidth_mb > 0)
+    {
+        Assert(enable_scheduler,
+               "--far_link_bandwidth limits the tasks of the scheduler.");
+        Assert(far_task_bandwidth_mb > 0,
+               "--far_task_bandwidth must be positive.");
+        std::cout << "- Limiting concurrent far-memory tasks to a link of "
+                  << far_link_bandwidth_mb << " MB/s at "
+                  << far_task_bandwidth_mb << " MB/s per task" << std::endl;
+    }
+
     auto plugins = std::vector<std::string>{};
     auto comma_separated_plugins = parse_result["plugins"].as<std::string>();
     if (!comma_separated_plugins.empty())
@@ -234,7 +282,7 @@ CLIConfigParser::parse_cli_options(const cxxopts::ParseResult &parse_result)
                      boost::token_compress_on);
     }
 
-    return BenchmarkConfig{benchmark_mode,
+    auto config = BenchmarkConfig{benchmark_mode,
                            chunk_size,
                            *encoding_config,
                            chunk_indexes,
@@ -253,6 +301,13 @@ CLIConfigParser::parse_cli_options(const cxxopts::ParseResult &parse_result)
                            system_metrics,
                            pipeline_metrics,
                            plugins};
+    config.segment_heatmaps = segment_heatmaps;
+    config.system_sampling = system_sampling;
+    config.shared_scans = shared_scans;
+    config.query_memory_budget = query_memory_budget_mb * 1'000'000;
+    config.far_link_bandwidth = far_link_bandwidth_mb * 1'000'000;
+    config.far_task_bandwidth = far_task_bandwidth_mb * 1'000'000;
+    return config;
 }
 
 EncodingConfig
@@ -341,8 +396,54 @@ CLIConfigParser::parse_encoding_config(const std::string &encoding_file_str)
         }
     }
 
-    return EncodingConfig{default_spec, std::move(type_encoding_mapping),
-                          std::move(custom_encoding_mapping)};
+    auto encoding_config =
+        EncodingConfig{default_spec, std::move(type_encoding_mapping),
+                       std::move(custom_encoding_mapping)};
+
+    const auto has_placement =
+        encoding_config_json.find("placement") != encoding_config_json.end();
+    if (has_placement)
+    {
+        const auto placement = encoding_config_json["placement"];
+        Assert(placement.is_object(),
+               "The placement needs to be specified as a json object.");
+
+        if (placement.contains("far_tier"))
+        {
+            const auto &far_tier = placement["far_tier"];
+            if (far_tier.contains("numa_node"))
+            {
+                encoding_config.far_tier_numa_node =
+                    NodeID{far_tier["numa_node"].get<uint32_t>()};
+            }
+            if (far_tier.contains("capacity_gb"))
+            {
+                encoding_config.far_tier_capacity =
+                    far_tier["capacity_gb"].get<size_t>() << 30U;
+            }
+        }
+
+        const auto custom_placement =
+            placement.value("custom", nlohmann::json::object());
+        for (const auto &table : custom_placement.items())
+        {
+            const auto &table_name = table.key();
+            Assert(table.value().is_object(),
+                   "The placement of columns needs to be specified as a json "
+                   "object.");
+
+            for (const auto &column : table.value().items())
+            {
+                const auto tier_str = column.value().get<std::string>();
+                const auto tier = magic_enum::enum_cast<MemoryTier>(tier_str);
+                Assert(tier, "Invalid memory tier: '" + tier_str + "'");
+                encoding_config.custom_placement_mapping[table_name]
+                                                        [column.key()] = *tier;
+            }
+        }
+    }
+
+    return encoding_config;
 }
 
 bool CLIConfigParser::print_help_if_requested(
@@ -112,6 +112,29 @@ nlohmann::json EncodingConfig::to_json() const
         json["custom"] = table_mapping;
     }
 
+    if (!custom_placement_mapping.empty())
+    {
+        nlohmann::json placement_mapping{};
+        for (const auto &[table, column_config] : custom_placement_mapping)
+        {
+            for (const auto &[column, tier] : column_config)
+            {
+                placement_mapping[table][column] =
+                    std::string{magic_enum::enum_name(tier)};
+            }
+        }
+
+        nlohmann::json far_tier{};
+        far_tier["capacity_gb"] = far_tier_capacity / (size_t{1} << 30U);
+        if (far_tier_numa_node)
+        {
+            far_tier["numa_node"] = static_cast<uint32_t>(*far_tier_numa_node);
+        }
+
+        json["placement"]["custom"] = placement_mapping;
+        json["placement"]["far_tier"] = far_tier;
+    }
+
     return json;
 }
 
@@ -165,7 +188,23 @@ The encoding is always required, the compression is optional.
         "compression": <VECTOR_COMPRESSION_TYPE_STRING>
       }
     }
+  },
+
+  "placement": {
+    "far_tier": {
+      "numa_node": <NUMA_NODE_ID>,  // optional, emulated in DRAM if missing
+      "capacity_gb": <GB>           // optional, address space to reserve
+    },
+    "custom": {
+      <TABLE_NAME>: {
+        <column_name>: <MEMORY_TIER_STRING>   // "Near" or "Far"
+      }
+    }
   }
-})";
+}
+
+The placement is optional. Columns without a placement stay in the near tier
+(regular DRAM). Segments of columns in the far tier are allocated from memory
+that is bound to the given NUMA node (e.g., a CPU-less CXL memory node).)";
 
 } // namespace hyrise
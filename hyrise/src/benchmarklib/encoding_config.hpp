@@ -5,6 +5,7 @@
 
 #include "nlohmann/json.hpp"
 
+#include "memory/tiered_memory_resource.hpp"
 #include "storage/chunk_encoder.hpp"
 #include "storage/encoding_type.hpp"
 
@@ -19,6 +20,11 @@ using TableSegmentEncodingMapping =
     std::unordered_map<std::string,
                        std::unordered_map<std::string, SegmentEncodingSpec>>;
 
+// Map<TABLE_NAME, Map<column_name, MemoryTier>>
+using TableSegmentPlacementMapping =
+    std::unordered_map<std::string,
+                       std::unordered_map<std::string, MemoryTier>>;
+
 // View EncodingConfig::description to see format of encoding JSON
 class EncodingConfig
 {
@@ -35,6 +41,12 @@ class EncodingConfig
     DataTypeEncodingMapping type_encoding_mapping;
     TableSegmentEncodingMapping custom_encoding_mapping;
 
+    // Columns not listed here are placed in the near tier.
+    TableSegmentPlacementMapping custom_placement_mapping;
+    // If no NUMA node is set, the far tier is emulated in DRAM.
+    std::optional<NodeID> far_tier_numa_node;
+    size_t far_tier_capacity{DEFAULT_FAR_TIER_CAPACITY};
+
     static SegmentEncodingSpec
     encoding_spec_from_strings(const std::string &encoding_str,
                                const std::string &compression_str);
@@ -183,10 +183,12 @@ Console::Console()
     register_command("wait", std::bind(&Console::_wait, this, std::placeholders::_1));
     register_command("cores", std::bind(&Console::_cores, this, std::placeholders::_1));
     register_command("pintool", std::bind(&Console::_pintool, this, std::placeholders::_1));
-    register_command("iotop", std::bind(&Console::_iotop, this, std::placeholders::_1));
-    register_command("iostat", std::bind(&Console::_iostat, this, std::placeholders::_1));
+    register_command("sampling", std::bind(&Console::_system_sampling, this, std::placeholders::_1));
+    // The external tools these commands used to launch are replaced by the in-process SystemSampler.
+    register_command("iotop", std::bind(&Console::_system_sampling, this, std::placeholders::_1));
+    register_command("iostat", std::bind(&Console::_system_sampling, this, std::placeholders::_1));
+    register_command("coreutil", std::bind(&Console::_system_sampling, this, std::placeholders::_1));
     register_command("vtune", std::bind(&Console::_vtune, this, std::placeholders::_1));
-    register_command("coreutil", std::bind(&Console::_coreutil, this, std::placeholders::_1));
     register_command("python", std::bind(&Console::_python, this, std::placeholders::_1));
 }
 
@@ -2314,62 +2316,44 @@ int Console::_pintool(const std::string &args)
     return ReturnCode::Ok;
 }
 
-int Console::_iotop(const std::string &args)
+int Console::_system_sampling(const std::string &args)
 {
     const auto arguments = tokenize(args);
 
-    if (arguments.size() != 1)
-    {
-        // clang-format off
-    out("Usage: ");
-    out("iotop on/off   set iotop tracing on or off \n");
-        // clang-format on
-        return ReturnCode::Error;
-    }
-
-    if (arguments[0] == "on")
-    {
-        Hyrise::get().set_iotop(true);
-    }
-    else if (arguments[0] == "off")
-    {
-        Hyrise::get().set_iotop(false);
-    }
-    else
+    const auto usage = [&]
     {
         out("Usage: ");
-        out("iotop on/off   set iotop tracing on or off \n");
+        out("sampling on [INTERVAL_MS]/off   sample the system utilization "
+            "while each query executes \n");
         return ReturnCode::Error;
-    }
-    return ReturnCode::Ok;
-}
-
-int Console::_iostat(const std::string &args)
-{
-    const auto arguments = tokenize(args);
+    };
 
-    if (arguments.size() != 1)
+    if (arguments.empty() || arguments.size() > 2)
     {
-        // clang-format off
-    out("Usage: ");
-    out("iostat on/off   set iotop tracing on or off \n");
-        // clang-format on
-        return ReturnCode::Error;
+        return usage();
     }
 
     if (arguments[0] == "on")
     {
-        Hyrise::get().set_iostat(true);
+        if (arguments.size() == 2)
+        {
+            const auto interval = std::stoi(arguments[1]);
+            if (interval <= 0)
+            {
+                return usage();
+            }
+            Hyrise::get().set_system_sampling_interval(
+                std::chrono::milliseconds{interval});
+        }
+        Hyrise::get().set_system_sampling(true);
     }
-    else if (arguments[0] == "off")
+    else if (arguments[0] == "off" && arguments.size() == 1)
     {
-        Hyrise::get().set_iostat(false);
+        Hyrise::get().set_system_sampling(false);
     }
     else
     {
-        out("Usage: ");
-        out("iostat on/off   set iotop tracing on or off \n");
-        return ReturnCode::Error;
+        return usage();
     }
     return ReturnCode::Ok;
 }
@@ -2404,36 +2388,6 @@ int Console::_vtune(const std::string &args)
     return ReturnCode::Ok;
 }
 
-int Console::_coreutil(const std::string &args)
-{
-    const auto arguments = tokenize(args);
-
-    if (arguments.size() != 1)
-    {
-        // clang-format off
-    out("Usage: ");
-    out("coreutil on/off   set vtune tracing on or off \n");
-        // clang-format on
-        return ReturnCode::Error;
-    }
-
-    if (arguments[0] == "on")
-    {
-        Hyrise::get().set_coreutil(true);
-    }
-    else if (arguments[0] == "off")
-    {
-        Hyrise::get().set_coreutil(false);
-    }
-    else
-    {
-        out("Usage: ");
-        out("coreutil on/off   set vtune tracing on or off \n");
-        return ReturnCode::Error;
-    }
-    return ReturnCode::Ok;
-}
-
 int Console::_python(const std::string &args)
 {
     const auto arguments = tokenize(args);
@@ -158,9 +158,7 @@ class Console : public Singleton<Console>
     int _cores(const std::string &time);
     int _pintool(const std::string &time);
     int _vtune(const std::string &time);
-    int _iotop(const std::string &time);
-    int _iostat(const std::string &time);
-    int _coreutil(const std::string &time);
+    int _system_sampling(const std::string &args);
     int _python(const std::string &args);
     int _mem_blks();
     int _coalesce();
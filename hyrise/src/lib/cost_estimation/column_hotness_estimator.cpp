@@ -0,0 +1,244 @@
+#include "column_hotness_estimator.hpp"
+
+#include <algorithm>
+#include <map>
+#include <tuple>
+#include <unordered_set>
+
+#include "expression/expression_utils.hpp"
+#include "expression/lqp_column_expression.hpp"
+#include "expression/lqp_subquery_expression.hpp"
+#include "hyrise.hpp"
+#include "logical_query_plan/abstract_lqp_node.hpp"
+#include "logical_query_plan/lqp_utils.hpp"
+#include "logical_query_plan/stored_table_node.hpp"
+#include "operators/abstract_operator.hpp"
+#include "statistics/abstract_cardinality_estimator.hpp"
+#include "utils/assert.hpp"
+
+namespace
+{
+
+using namespace hyrise; // NOLINT
+
+struct SegmentAccess
+{
+    Cardinality row_count{0.0f};
+    float bytes{0.0f};
+};
+
+using SegmentAccesses =
+    std::map<std::tuple<std::string, ColumnID, ChunkID>, SegmentAccess>;
+
+using VisitedSubqueries =
+    std::unordered_set<std::shared_ptr<const AbstractLQPNode>>;
+
+// Validate nodes only filter the position lists, so a node on top of a
+// ValidateNode still scans the stored table.
+std::shared_ptr<const AbstractLQPNode>
+skip_validate_nodes(std::shared_ptr<const AbstractLQPNode> node)
+{
+    while (node && node->type == LQPNodeType::Validate)
+    {
+        node = node->left_input();
+    }
+    return node;
+}
+
+// Adds the accesses of a node that reads @param column for each row of
+// @param input.
+void add_column_access(const LQPColumnExpression &column,
+                       const std::shared_ptr<const AbstractLQPNode> &input,
+                       const AbstractCardinalityEstimator &estimator,
+                       SegmentAccesses &accesses)
+{
+    const auto original_node = column.original_node.lock();
+    Assert(original_node, "LQPColumnExpression is expired, LQP is invalid.");
+    if (original_node->type != LQPNodeType::StoredTable)
+    {
+        // Columns of static or mock tables are not stored.
+        return;
+    }
+
+    const auto &stored_table_node =
+        static_cast<const StoredTableNode &>(*original_node);
+    const auto &storage_manager = Hyrise::get().storage_manager;
+    if (!storage_manager.has_table(stored_table_node.table_name))
+    {
+        return;
+    }
+    const auto table = storage_manager.get_table(stored_table_node.table_name);
+
+    const auto &pruned_chunk_ids = stored_table_node.pruned_chunk_ids();
+    auto chunks = std::vector<std::pair<ChunkID, std::shared_ptr<Chunk>>>{};
+    auto unpruned_row_count = 0.0f;
+    const auto chunk_count = table->chunk_count();
+    for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id)
+    {
+        const auto chunk = table->get_chunk(chunk_id);
+        if (!chunk || std::find(pruned_chunk_ids.cbegin(),
+                                pruned_chunk_ids.cend(),
+                                chunk_id) != pruned_chunk_ids.cend())
+        {
+            continue;
+        }
+        chunks.emplace_back(chunk_id, chunk);
+        unpruned_row_count += static_cast<float>(chunk->size());
+    }
+
+    if (unpruned_row_count == 0.0f)
+    {
+        return;
+    }
+
+    // Fraction of each unpruned segment that is read.
+    auto fraction = 1.0f;
+    if (skip_validate_nodes(input) != original_node)
+    {
+        fraction = std::min(
+            1.0f, estimator.estimate_cardinality(input) / unpruned_row_count);
+    }
+
+    for (const auto &[chunk_id, chunk] : chunks)
+    {
+        const auto segment = chunk->get_segment(column.original_column_id);
+        const auto segment_bytes = static_cast<float>(
+            segment->memory_usage(MemoryUsageCalculationMode::Sampled));
+
+        auto &access = accesses[{stored_table_node.table_name,
+                                 column.original_column_id, chunk_id}];
+        access.row_count += static_cast<float>(chunk->size()) * fraction;
+        access.bytes += segment_bytes * fraction;
+    }
+}
+
+void add_plan_accesses(const std::shared_ptr<const AbstractLQPNode> &lqp,
+                       const AbstractCardinalityEstimator &estimator,
+                       SegmentAccesses &accesses,
+                       VisitedSubqueries &visited_subqueries)
+{
+    // The columns of the plan's output are materialized for the client (or the
+    // outer query).
+    auto output_node = lqp;
+    if (lqp->type == LQPNodeType::Root)
+    {
+        output_node = lqp->left_input();
+    }
+    for (const auto &expression : output_node->output_expressions())
+    {
+        if (expression->type == ExpressionType::LQPColumn)
+        {
+            add_column_access(
+                static_cast<const LQPColumnExpression &>(*expression),
+                output_node, estimator, accesses);
+        }
+    }
+
+    visit_lqp(
+        lqp,
+        [&](const auto &node)
+        {
+            switch (node->type)
+            {
+            case LQPNodeType::Aggregate:
+            case LQPNodeType::Join:
+            case LQPNodeType::Predicate:
+            case LQPNodeType::Projection:
+            case LQPNodeType::Sort:
+            case LQPNodeType::Window:
+                break;
+            default:
+                return LQPVisitation::VisitInputs;
+            }
+
+            for (const auto &node_expression : node->node_expressions)
+            {
+                // Projections only forward plain columns.
+                if (node->type == LQPNodeType::Projection &&
+                    node_expression->type == ExpressionType::LQPColumn)
+                {
+                    continue;
+                }
+
+                visit_expression(
+                    node_expression,
+                    [&](const auto &sub_expression)
+                    {
+                        if (sub_expression->type == ExpressionType::LQPSubquery)
+                        {
+                            const auto &subquery_lqp =
+                                static_cast<const LQPSubqueryExpression &>(
+                                    *sub_expression)
+                                    .lqp;
+                            if (visited_subqueries.emplace(subquery_lqp).second)
+                            {
+                                add_plan_accesses(subquery_lqp, estimator,
+                                                  accesses, visited_subqueries);
+                            }
+                            return ExpressionVisitation::DoNotVisitArguments;
+                        }
+
+                        if (sub_expression->type != ExpressionType::LQPColumn)
+                        {
+                            return ExpressionVisitation::VisitArguments;
+                        }
+
+                        // Find the input that provides the column.
+                        auto input = node->left_input();
+                        if (!input->find_column_id(*sub_expression) &&
+                            node->right_input())
+                        {
+                            input = node->right_input();
+                        }
+                        add_column_access(
+                            static_cast<const LQPColumnExpression &>(
+                                *sub_expression),
+                            input, estimator, accesses);
+                        return ExpressionVisitation::DoNotVisitArguments;
+                    });
+            }
+
+            return LQPVisitation::VisitInputs;
+        });
+}
+
+} // namespace
+
+namespace hyrise
+{
+
+ColumnHotnessEstimator::ColumnHotnessEstimator(
+    const std::shared_ptr<AbstractCardinalityEstimator>
+        &init_cardinality_estimator)
+    : cardinality_estimator(init_cardinality_estimator)
+{
+}
+
+std::vector<ColumnHotness> ColumnHotnessEstimator::estimate(
+    const std::shared_ptr<const AbstractLQPNode> &lqp) const
+{
+    auto accesses = SegmentAccesses{};
+    auto visited_subqueries = VisitedSubqueries{};
+    add_plan_accesses(lqp, *cardinality_estimator, accesses,
+                      visited_subqueries);
+
+    auto hotness = std::vector<ColumnHotness>{};
+    hotness.reserve(accesses.size());
+    for (const auto &[segment, access] : accesses)
+    {
+        const auto &[table_name, column_id, chunk_id] = segment;
+        hotness.push_back(
+            {table_name, column_id, chunk_id, access.row_count, access.bytes});
+    }
+    return hotness;
+}
+
+std::vector<ColumnHotness> ColumnHotnessEstimator::estimate(
+    const std::shared_ptr<const AbstractOperator> &pqp) const
+{
+    Assert(pqp->lqp_node,
+           "Cannot estimate column hotness of a PQP without LQP.");
+    return estimate(pqp->lqp_node);
+}
+
+} // namespace hyrise
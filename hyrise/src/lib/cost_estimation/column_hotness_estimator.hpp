@@ -0,0 +1,60 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "types.hpp"
+
+namespace hyrise
+{
+
+class AbstractCardinalityEstimator;
+class AbstractLQPNode;
+class AbstractOperator;
+
+// Estimated accesses of a query to one segment of a stored table.
+struct ColumnHotness
+{
+    std::string table_name;
+    ColumnID column_id;
+    ChunkID chunk_id;
+    Cardinality row_count;
+    float bytes;
+};
+
+/**
+ * Predicts how many bytes a query plan reads from each segment of the stored
+ * tables it accesses. This allows to decide on the placement of segments at
+ * plan time instead of profiling the query first.
+ *
+ * Columns are read by the nodes whose expressions use them (predicates, join
+ * predicates, group-by columns and aggregates, computed projections, and sort
+ * keys) and by the plan's output. A node reads as many values as its input has
+ * rows (estimated by the cardinality estimator). If the input is the stored
+ * table itself, all unpruned segments are scanned. Otherwise, the rows are
+ * assumed to be spread across the unpruned chunks proportionally to their
+ * sizes. The bytes read per value are the segment's memory usage divided by its
+ * size.
+ *
+ * Correlated subqueries are estimated as if they were executed once.
+ */
+class ColumnHotnessEstimator
+{
+  public:
+    explicit ColumnHotnessEstimator(
+        const std::shared_ptr<AbstractCardinalityEstimator>
+            &init_cardinality_estimator);
+
+    // The result is sorted by table name, column, and chunk.
+    std::vector<ColumnHotness>
+    estimate(const std::shared_ptr<const AbstractLQPNode> &lqp) const;
+
+    // Uses the LQP the PQP was translated from.
+    std::vector<ColumnHotness>
+    estimate(const std::shared_ptr<const AbstractOperator> &pqp) const;
+
+    const std::shared_ptr<AbstractCardinalityEstimator> cardinality_estimator;
+};
+
+} // namespace hyrise
@@ -61,49 +61,47 @@ bool Hyrise::is_pin_enabled()
     return _pintool_enabled;
 }
 
-void Hyrise::set_iotop(bool value)
+void Hyrise::set_system_sampling(bool value)
 {
-    //Set the pintool enabled value to true or false
-    _iotop_enabled = value;
+    _system_sampling_enabled = value;
 }
 
-bool Hyrise::is_iotop_enabled()
+bool Hyrise::is_system_sampling_enabled()
 {
-    return _iotop_enabled;
+    return _system_sampling_enabled;
 }
 
-void Hyrise::set_iostat(bool value)
+void Hyrise::set_system_sampling_interval(std::chrono::milliseconds interval)
 {
-    //Set the pintool enabled value to true or false
-    _iostat_enabled = value;
+    _system_sampling_interval = interval;
 }
 
-bool Hyrise::is_iostat_enabled()
+std::chrono::milliseconds Hyrise::system_sampling_interval()
 {
-    return _iostat_enabled;
+    return _system_sampling_interval;
 }
 
-void Hyrise::set_vtune(bool value)
+void Hyrise::set_query_memory_budget(size_t bytes)
 {
-    //Set the pintool enabled value to true or false
-    _vtune_enabled = value;
+    _query_memory_budget = bytes;
 }
 
-bool Hyrise::is_vtune_enabled()
+size_t Hyrise::query_memory_budget() const
 {
-    return _vtune_enabled;
+    return _query_memory_budget;
 }
 
-void Hyrise::set_coreutil(bool value)
+void Hyrise::set_vtune(bool value)
 {
     //Set the pintool enabled value to true or false
-    _coreutil_enabled = value;
+    _vtune_enabled = value;
 }
 
-bool Hyrise::is_coreutil_enabled()
+bool Hyrise::is_vtune_enabled()
 {
-    return _coreutil_enabled;
+    return _vtune_enabled;
 }
+
 int Hyrise::get_query_count()
 {
     return _query_count;
@@ -3,6 +3,7 @@
 #include <boost/container/pmr/memory_resource.hpp>
 
 #include "concurrency/transaction_manager.hpp"
+#include "operators/table_scan/shared_scan_cursor.hpp"
 #include "scheduler/immediate_execution_scheduler.hpp"
 #include "scheduler/topology.hpp"
 #include "sql/sql_plan_cache.hpp"
@@ -12,6 +13,7 @@
 #include "utils/plugin_manager.hpp"
 #include "utils/settings_manager.hpp"
 #include "utils/singleton.hpp"
+#include "utils/system_sampler.hpp"
 
 namespace hyrise
 {
@@ -43,14 +45,14 @@ class Hyrise : public Singleton<Hyrise>
 
     void set_pintool(bool value);
     bool is_pin_enabled();
-    void set_iotop(bool value);
-    bool is_iotop_enabled();
-    void set_iostat(bool value);
-    bool is_iostat_enabled();
+    void set_system_sampling(bool value);
+    bool is_system_sampling_enabled();
+    void set_system_sampling_interval(std::chrono::milliseconds interval);
+    std::chrono::milliseconds system_sampling_interval();
+    void set_query_memory_budget(size_t bytes);
+    size_t query_memory_budget() const;
     void set_vtune(bool value);
     bool is_vtune_enabled();
-    void set_coreutil(bool value);
-    bool is_coreutil_enabled();
     int get_query_count();
     void incr_query_count();
 
@@ -68,6 +70,10 @@ class Hyrise : public Singleton<Hyrise>
     LogManager log_manager;
     Topology topology;
 
+    // Cursors of the TableScans that share the reads of a table (see
+    // SharedScanCursor), if enabled.
+    SharedScanRegistry shared_scans;
+
     // Plan caches used by the SQLPipelineBuilder if `with_{l/p}qp_cache()` are
     // not used. Both default caches can be nullptr themselves. If both
     // default_{l/p}qp_cache and _{l/p}qp_cache are nullptr, no plan caching is
@@ -91,21 +97,20 @@ class Hyrise : public Singleton<Hyrise>
     //I'm making this dynamic because I feel it'll be quicker to configure than with a #ifdef
     bool _pintool_enabled = false;
 
-    //Bool value which is used to check if we want to figure out io utilization
-    //I'm making this dynamic because I feel it'll be quicker to configure than with a #ifdef
-    bool _iotop_enabled = false;
-    
-    //Bool value which is used to check if we want to figure out io utilization
-    //I'm making this dynamic because I feel it'll be quicker to configure than with a #ifdef
-    bool _iostat_enabled = false;
-    
+    // If enabled, each SQLPipelineStatement samples the I/O, CPU, and memory
+    // utilization while it executes (see SystemSampler).
+    bool _system_sampling_enabled = false;
+    std::chrono::milliseconds _system_sampling_interval =
+        SystemSampler::DEFAULT_INTERVAL;
+
+    // Near-tier memory each query may hold for the arenas of its operators
+    // (see QueryMemoryPool), 0 means unlimited.
+    size_t _query_memory_budget = 0;
+
     //Bool value which is used to check if we want to figure out DRAM utilization using vtune
     //I'm making this dynamic because I feel it'll be quicker to configure than with a #ifdef
     bool _vtune_enabled = false;
 
-    //Bool value which is used to check if we want to figure out cpu core utilization using top
-    //I'm making this dynamic because I feel it'll be quicker to configure than with a #ifdef
-    bool _coreutil_enabled = false;
     //An integer that keeps track of how many queries we have executed till now
     int _query_count = 0;
 };
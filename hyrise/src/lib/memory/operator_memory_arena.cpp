@@ -0,0 +1,240 @@
+#include "operator_memory_arena.hpp"
+
+#include <algorithm>
+
+#include "memory/tiered_memory_resource.hpp"
+#include "utils/assert.hpp"
+#include "utils/performance_warning.hpp"
+
+namespace
+{
+
+using namespace hyrise; // NOLINT
+
+size_t round_up(const size_t value, const size_t multiple)
+{
+    return (value + multiple - 1) / multiple * multiple;
+}
+
+// Allocations larger than this get a block of their own instead of wasting the
+// rest of the current block.
+constexpr auto DEDICATED_BLOCK_THRESHOLD = QueryMemoryPool::BLOCK_SIZE / 4;
+
+} // namespace
+
+namespace hyrise
+{
+
+QueryMemoryPool::QueryMemoryPool(const size_t budget)
+    : _budget{budget}, _upstream{get_memory_tier_resource(MemoryTier::Near)}
+{
+}
+
+QueryMemoryPool::~QueryMemoryPool()
+{
+    release_free_blocks();
+    DebugAssert(_reserved_bytes == 0, "Operator arenas still use blocks.");
+}
+
+std::pair<std::byte *, size_t>
+QueryMemoryPool::acquire_block(const size_t min_size)
+{
+    const auto size = std::max(round_up(min_size, BLOCK_SIZE), BLOCK_SIZE);
+    const auto lock = std::lock_guard<std::mutex>{_mutex};
+
+    // Reuse a free block unless it is much larger than needed.
+    const auto free_block_it = _free_blocks.lower_bound(size);
+    if (free_block_it != _free_blocks.end() && free_block_it->first < 2 * size)
+    {
+        const auto block = std::pair{free_block_it->second, free_block_it->first};
+        _free_blocks.erase(free_block_it);
+        _reused_bytes += block.second;
+        return block;
+    }
+
+    if (_budget > 0)
+    {
+        while (_reserved_bytes + size > _budget && !_free_blocks.empty())
+        {
+            _free_block(std::prev(_free_blocks.end()));
+        }
+
+        if (_reserved_bytes + size > _budget)
+        {
+            PerformanceWarning("Query memory budget exceeded.");
+            _over_budget_bytes += size;
+        }
+    }
+
+    auto *block = static_cast<std::byte *>(
+        _upstream->allocate(size, TieredMemoryResource::BLOCK_ALIGNMENT));
+    _reserved_bytes += size;
+    _peak_reserved_bytes = std::max(_peak_reserved_bytes, _reserved_bytes);
+    return {block, size};
+}
+
+void QueryMemoryPool::release_block(std::byte *block, const size_t size)
+{
+    const auto lock = std::lock_guard<std::mutex>{_mutex};
+    const auto free_block_it = _free_blocks.emplace(size, block);
+    if (_budget > 0 && _reserved_bytes > _budget)
+    {
+        _free_block(free_block_it);
+    }
+}
+
+void QueryMemoryPool::release_free_blocks()
+{
+    const auto lock = std::lock_guard<std::mutex>{_mutex};
+    while (!_free_blocks.empty())
+    {
+        _free_block(_free_blocks.begin());
+    }
+}
+
+void QueryMemoryPool::add_allocated_bytes(const size_t bytes)
+{
+    const auto allocated_bytes = _allocated_bytes.fetch_add(bytes) + bytes;
+    auto peak_allocated_bytes = _peak_allocated_bytes.load();
+    while (allocated_bytes > peak_allocated_bytes &&
+           !_peak_allocated_bytes.compare_exchange_weak(peak_allocated_bytes,
+                                                        allocated_bytes))
+    {
+    }
+}
+
+void QueryMemoryPool::remove_allocated_bytes(const size_t bytes)
+{
+    _allocated_bytes -= bytes;
+}
+
+QueryMemoryStatistics QueryMemoryPool::statistics() const
+{
+    const auto lock = std::lock_guard<std::mutex>{_mutex};
+    auto statistics = QueryMemoryStatistics{};
+    statistics.budget = _budget;
+    statistics.reserved_bytes = _reserved_bytes;
+    statistics.peak_reserved_bytes = _peak_reserved_bytes;
+    statistics.peak_allocated_bytes = _peak_allocated_bytes.load();
+    statistics.reused_bytes = _reused_bytes;
+    statistics.over_budget_bytes = _over_budget_bytes;
+    return statistics;
+}
+
+void QueryMemoryPool::_free_block(
+    std::multimap<size_t, std::byte *>::iterator block_it)
+{
+    _upstream->deallocate(block_it->second, block_it->first,
+                          TieredMemoryResource::BLOCK_ALIGNMENT);
+    _reserved_bytes -= block_it->first;
+    _free_blocks.erase(block_it);
+}
+
+OperatorMemoryArena::OperatorMemoryArena(std::shared_ptr<QueryMemoryPool> pool)
+    : _pool{std::move(pool)}
+{
+    Assert(_pool, "Operator arenas need a query memory pool.");
+}
+
+OperatorMemoryArena::~OperatorMemoryArena()
+{
+    for (const auto &[block, size] : _blocks)
+    {
+        _pool->release_block(block, size);
+    }
+    for (const auto &[block, size] : _dedicated_blocks)
+    {
+        _pool->release_block(block, size);
+    }
+
+    // Memory resources such as monotonic_buffer_resource do not deallocate
+    // everything they allocate.
+    _pool->remove_allocated_bytes(_allocated_bytes);
+}
+
+size_t OperatorMemoryArena::allocated_bytes() const
+{
+    const auto lock = std::lock_guard<std::mutex>{_mutex};
+    return _allocated_bytes;
+}
+
+size_t OperatorMemoryArena::peak_allocated_bytes() const
+{
+    const auto lock = std::lock_guard<std::mutex>{_mutex};
+    return _peak_allocated_bytes;
+}
+
+size_t OperatorMemoryArena::reserved_bytes() const
+{
+    const auto lock = std::lock_guard<std::mutex>{_mutex};
+    return _reserved_bytes;
+}
+
+void *OperatorMemoryArena::do_allocate(std::size_t bytes,
+                                       std::size_t alignment)
+{
+    DebugAssert(alignment <= TieredMemoryResource::BLOCK_ALIGNMENT,
+                "Operator arenas do not support over-aligned allocations.");
+    const auto lock = std::lock_guard<std::mutex>{_mutex};
+
+    auto *pointer = static_cast<std::byte *>(nullptr);
+    if (bytes > DEDICATED_BLOCK_THRESHOLD)
+    {
+        const auto [block, size] = _pool->acquire_block(bytes);
+        _dedicated_blocks.emplace(block, size);
+        _reserved_bytes += size;
+        pointer = block;
+    }
+    else
+    {
+        auto offset = round_up(_current_offset, alignment);
+        if (_blocks.empty() || offset + bytes > _blocks.back().second)
+        {
+            const auto block = _pool->acquire_block(QueryMemoryPool::BLOCK_SIZE);
+            _blocks.push_back(block);
+            _reserved_bytes += block.second;
+            offset = 0;
+        }
+        pointer = _blocks.back().first + offset;
+        _current_offset = offset + bytes;
+    }
+
+    _allocated_bytes += bytes;
+    _peak_allocated_bytes = std::max(_peak_allocated_bytes, _allocated_bytes);
+    _pool->add_allocated_bytes(bytes);
+    return pointer;
+}
+
+void OperatorMemoryArena::do_deallocate(void *pointer, std::size_t bytes,
+                                        std::size_t /*alignment*/)
+{
+    const auto lock = std::lock_guard<std::mutex>{_mutex};
+    _allocated_bytes -= bytes;
+    _pool->remove_allocated_bytes(bytes);
+
+    auto *const bytes_begin = static_cast<std::byte *>(pointer);
+    const auto dedicated_block_it = _dedicated_blocks.find(bytes_begin);
+    if (dedicated_block_it != _dedicated_blocks.end())
+    {
+        _pool->release_block(bytes_begin, dedicated_block_it->second);
+        _reserved_bytes -= dedicated_block_it->second;
+        _dedicated_blocks.erase(dedicated_block_it);
+        return;
+    }
+
+    // The most recent allocation of the current block can be undone, e.g.,
+    // for temporary buffers.
+    if (!_blocks.empty() &&
+        bytes_begin + bytes == _blocks.back().first + _current_offset)
+    {
+        _current_offset = bytes_begin - _blocks.back().first;
+    }
+}
+
+bool OperatorMemoryArena::do_is_equal(
+    const boost::container::pmr::memory_resource &other) const noexcept
+{
+    return this == &other;
+}
+
+} // namespace hyrise
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <boost/container/pmr/memory_resource.hpp>
+
+#include "types.hpp"
+
+namespace hyrise
+{
+
+// Near-tier memory of the operator arenas of one query.
+struct QueryMemoryStatistics
+{
+    // 0 means that the query has no budget.
+    size_t budget{0};
+
+    // Bytes of the blocks the pool holds, whether arenas use them or they wait
+    // for reuse, and their maximum.
+    size_t reserved_bytes{0};
+    size_t peak_reserved_bytes{0};
+
+    // Maximum of the bytes allocated by all arenas of the query at once.
+    size_t peak_allocated_bytes{0};
+
+    // Bytes of the blocks handed to arenas from the pool instead of the near
+    // tier, i.e., that an earlier operator of the query has used already.
+    size_t reused_bytes{0};
+
+    // Bytes of the blocks reserved although the budget was exhausted.
+    size_t over_budget_bytes{0};
+};
+
+/**
+ * Pool of near-tier memory blocks shared by the operators of one query (see
+ * SQLPipelineStatement). The blocks come from get_memory_tier_resource(
+ * MemoryTier::Near), so operator state stays in the near tier wherever the base
+ * data is placed. Blocks that an OperatorMemoryArena releases stay in the pool
+ * and are handed to the arenas of the following operators, so that a query
+ * pays for faulting in its intermediates' memory only once.
+ *
+ * The budget caps the bytes the pool holds. Once it is exhausted, free blocks
+ * are returned to the near tier to make room. If that is not enough, the block
+ * is reserved anyway (failing a query halfway is worse than exceeding the
+ * budget) and counted in over_budget_bytes.
+ */
+class QueryMemoryPool : public Noncopyable
+{
+  public:
+    explicit QueryMemoryPool(const size_t budget = 0);
+    ~QueryMemoryPool();
+
+    // Returns a block of at least @param min_size bytes and its actual size.
+    std::pair<std::byte *, size_t> acquire_block(const size_t min_size);
+    void release_block(std::byte *block, const size_t size);
+
+    // Returns the blocks no arena uses to the near tier.
+    void release_free_blocks();
+
+    // Called by the arenas for every allocation and deallocation.
+    void add_allocated_bytes(const size_t bytes);
+    void remove_allocated_bytes(const size_t bytes);
+
+    QueryMemoryStatistics statistics() const;
+
+    // Arenas allocate in blocks of this size. Larger allocations get a block
+    // of their own.
+    static constexpr size_t BLOCK_SIZE = size_t{1} << 20U;
+
+  private:
+    void _free_block(std::multimap<size_t, std::byte *>::iterator block_it);
+
+    const size_t _budget;
+    boost::container::pmr::memory_resource *const _upstream;
+
+    // Blocks that wait for reuse, by size.
+    std::multimap<size_t, std::byte *> _free_blocks;
+    size_t _reserved_bytes{0};
+    size_t _peak_reserved_bytes{0};
+    size_t _reused_bytes{0};
+    size_t _over_budget_bytes{0};
+    mutable std::mutex _mutex;
+
+    std::atomic<size_t> _allocated_bytes{0};
+    std::atomic<size_t> _peak_allocated_bytes{0};
+};
+
+/**
+ * Memory resource for the private state of one operator execution, e.g., hash
+ * tables, materialized columns, and sort buffers. Allocations are carved out
+ * of blocks from the query's QueryMemoryPool. Deallocations only free memory
+ * for reuse if they release the most recent allocation of a block or a
+ * dedicated block. All blocks go back to the pool when the arena is destroyed,
+ * so nothing allocated from the arena may outlive it. In particular, the
+ * operator's output must not be allocated from it.
+ *
+ * The arena is thread-safe, so the jobs of an operator can share it.
+ */
+class OperatorMemoryArena : public boost::container::pmr::memory_resource,
+                            public Noncopyable
+{
+  public:
+    explicit OperatorMemoryArena(std::shared_ptr<QueryMemoryPool> pool);
+    ~OperatorMemoryArena() override;
+
+    size_t allocated_bytes() const;
+    size_t peak_allocated_bytes() const;
+    size_t reserved_bytes() const;
+
+  protected:
+    void *do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void *pointer, std::size_t bytes,
+                       std::size_t alignment) override;
+    [[nodiscard]] bool do_is_equal(
+        const boost::container::pmr::memory_resource &other) const
+        noexcept override;
+
+  private:
+    const std::shared_ptr<QueryMemoryPool> _pool;
+
+    // Blocks that allocations are carved out of, the last one is current.
+    std::vector<std::pair<std::byte *, size_t>> _blocks;
+    size_t _current_offset{0};
+
+    // Allocations too large to share a block.
+    std::unordered_map<std::byte *, size_t> _dedicated_blocks;
+
+    size_t _allocated_bytes{0};
+    size_t _peak_allocated_bytes{0};
+    size_t _reserved_bytes{0};
+    mutable std::mutex _mutex;
+};
+
+} // namespace hyrise
@@ -0,0 +1,36 @@
+#include "prefetching.hpp"
+
+#include <array>
+#include <atomic>
+
+namespace
+{
+
+using namespace hyrise; // NOLINT
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+std::array<std::atomic<size_t>, 2> prefetch_distances{
+    DEFAULT_NEAR_TIER_PREFETCH_DISTANCE, DEFAULT_FAR_TIER_PREFETCH_DISTANCE};
+
+} // namespace
+
+namespace hyrise
+{
+
+void set_prefetch_distance(const MemoryTier tier, const size_t distance)
+{
+    prefetch_distances[static_cast<size_t>(tier)] = distance;
+}
+
+size_t prefetch_distance(const MemoryTier tier)
+{
+    return prefetch_distances[static_cast<size_t>(tier)].load(
+        std::memory_order_relaxed);
+}
+
+size_t prefetch_distance(const void *pointer)
+{
+    return prefetch_distance(memory_tier_of(pointer));
+}
+
+} // namespace hyrise
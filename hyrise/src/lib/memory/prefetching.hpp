@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstddef>
+
+#include "memory/tiered_memory_resource.hpp"
+
+namespace hyrise
+{
+
+/**
+ * Point accesses through a position list (e.g., when a ReferenceSegment is
+ * dereferenced) jump to random offsets of the referenced segment. Each access
+ * waits for the memory latency, which is several times higher for the far tier
+ * than for local DRAM. To overlap these latencies, the point-access iterators
+ * issue a software prefetch for the position that lies a given distance ahead
+ * of the current one.
+ *
+ * The distance should cover the memory latency divided by the time spent per
+ * position. Thus, it is configured per memory tier and chosen by the tier the
+ * accessed segment has been allocated from. A distance of zero disables
+ * prefetching for that tier.
+ */
+void set_prefetch_distance(const MemoryTier tier, const size_t distance);
+
+size_t prefetch_distance(const MemoryTier tier);
+
+// Returns the distance for the tier of the memory at @param pointer.
+size_t prefetch_distance(const void *pointer);
+
+constexpr size_t DEFAULT_NEAR_TIER_PREFETCH_DISTANCE = 8;
+constexpr size_t DEFAULT_FAR_TIER_PREFETCH_DISTANCE = 24;
+
+// Hints the CPU to load the cache line at @param pointer for reading.
+inline void prefetch_for_read(const void *pointer)
+{
+    __builtin_prefetch(pointer, 0, 3);
+}
+
+} // namespace hyrise
@@ -0,0 +1,267 @@
+#include "tiered_memory_resource.hpp"
+
+#include <sys/mman.h>
+
+#if HYRISE_NUMA_SUPPORT
+
+#include <numa.h>
+#include <numaif.h>
+
+#endif
+
+#include <cerrno>
+#include <cstring>
+#include <string>
+
+#include <boost/container/pmr/global_resource.hpp>
+
+#include "utils/assert.hpp"
+
+namespace
+{
+
+using namespace hyrise; // NOLINT
+
+size_t round_up(const size_t value, const size_t multiple)
+{
+    return (value + multiple - 1) / multiple * multiple;
+}
+
+// Guards the creation of the tiers, see get_memory_tier_resource().
+std::mutex tier_mutex; // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+std::atomic<TieredMemoryResource *> far_tier{nullptr}; // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+std::atomic<TieredMemoryResource *> near_tier{nullptr}; // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+} // namespace
+
+namespace hyrise
+{
+
+TieredMemoryResource::TieredMemoryResource(
+    const MemoryTier tier, const size_t capacity,
+    const std::optional<NodeID> numa_node)
+    : _tier{tier}, _capacity{round_up(capacity, BLOCK_ALIGNMENT)},
+      _numa_node{numa_node}
+{
+    Assert(_capacity > 0, "Tiered memory resource needs a capacity.");
+
+    // MAP_NORESERVE only reserves the address range. Physical pages are
+    // allocated when they are first touched, so that mbind below applies to
+    // all of them.
+    auto *region = mmap(nullptr, _capacity, PROT_READ | PROT_WRITE,
+                        MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    Assert(region != MAP_FAILED, "Could not reserve " +
+                                     std::to_string(_capacity) +
+                                     " bytes: " + std::strerror(errno));
+    _region = static_cast<std::byte *>(region);
+
+    if (_numa_node)
+    {
+#if HYRISE_NUMA_SUPPORT
+        Assert(numa_available() >= 0, "NUMA is not available on this system.");
+        Assert(static_cast<int>(*_numa_node) <= numa_max_node(),
+               "NUMA node " + std::to_string(*_numa_node) + " does not exist.");
+        auto *node_mask = numa_allocate_nodemask();
+        numa_bitmask_setbit(node_mask, *_numa_node);
+        const auto result = mbind(_region, _capacity, MPOL_BIND,
+                                  node_mask->maskp, node_mask->size + 1, 0);
+        numa_free_nodemask(node_mask);
+        Assert(result == 0,
+               std::string{"mbind failed: "} + std::strerror(errno));
+#else
+        Fail("Cannot bind memory tier to a NUMA node, Hyrise was built "
+             "without NUMA support.");
+#endif
+    }
+
+    _insert_free_block(0, _capacity);
+}
+
+TieredMemoryResource::~TieredMemoryResource()
+{
+    munmap(_region, _capacity);
+}
+
+MemoryTier TieredMemoryResource::tier() const { return _tier; }
+
+std::optional<NodeID> TieredMemoryResource::numa_node() const
+{
+    return _numa_node;
+}
+
+size_t TieredMemoryResource::capacity() const { return _capacity; }
+
+size_t TieredMemoryResource::allocated_bytes() const
+{
+    const auto lock = std::lock_guard<std::mutex>{_mutex};
+    return _allocated_bytes;
+}
+
+size_t TieredMemoryResource::fallback_bytes() const { return _fallback_bytes; }
+
+std::pair<const std::byte *, const std::byte *>
+TieredMemoryResource::region() const
+{
+    return {_region, _region + _capacity};
+}
+
+bool TieredMemoryResource::contains(const void *pointer) const
+{
+    const auto *byte_pointer = static_cast<const std::byte *>(pointer);
+    return byte_pointer >= _region && byte_pointer < _region + _capacity;
+}
+
+void *TieredMemoryResource::do_allocate(std::size_t bytes,
+                                        std::size_t alignment)
+{
+    const auto size = round_up(std::max(bytes, size_t{1}), BLOCK_ALIGNMENT);
+
+    if (alignment <= BLOCK_ALIGNMENT)
+    {
+        const auto lock = std::lock_guard<std::mutex>{_mutex};
+        const auto best_fit_it = _free_blocks_by_size.lower_bound(size);
+        if (best_fit_it != _free_blocks_by_size.end())
+        {
+            const auto [block_size, block_offset] = *best_fit_it;
+            _erase_free_block(_free_blocks_by_offset.find(block_offset));
+            if (block_size > size)
+            {
+                _insert_free_block(block_offset + size, block_size - size);
+            }
+            _allocated_bytes += size;
+            return _region + block_offset;
+        }
+    }
+
+    // The tier is full (or the alignment cannot be served). Rather than
+    // failing the query, we place the data in the near tier.
+    _fallback_bytes += bytes;
+    return boost::container::pmr::get_default_resource()->allocate(bytes,
+                                                                   alignment);
+}
+
+void TieredMemoryResource::do_deallocate(void *pointer, std::size_t bytes,
+                                         std::size_t alignment)
+{
+    if (!contains(pointer))
+    {
+        _fallback_bytes -= bytes;
+        boost::container::pmr::get_default_resource()->deallocate(
+            pointer, bytes, alignment);
+        return;
+    }
+
+    const auto size = round_up(std::max(bytes, size_t{1}), BLOCK_ALIGNMENT);
+    auto offset = static_cast<size_t>(static_cast<std::byte *>(pointer) - _region);
+    auto block_size = size;
+
+    const auto lock = std::lock_guard<std::mutex>{_mutex};
+    DebugAssert(_allocated_bytes >= size, "Deallocating more than allocated.");
+    _allocated_bytes -= size;
+
+    // Coalesce with the following and the preceding free block.
+    const auto next_it = _free_blocks_by_offset.find(offset + size);
+    if (next_it != _free_blocks_by_offset.end())
+    {
+        block_size += next_it->second;
+        _erase_free_block(next_it);
+    }
+
+    const auto following_it = _free_blocks_by_offset.lower_bound(offset);
+    if (following_it != _free_blocks_by_offset.begin())
+    {
+        const auto previous_it = std::prev(following_it);
+        if (previous_it->first + previous_it->second == offset)
+        {
+            offset = previous_it->first;
+            block_size += previous_it->second;
+            _erase_free_block(previous_it);
+        }
+    }
+
+    _insert_free_block(offset, block_size);
+}
+
+bool TieredMemoryResource::do_is_equal(
+    const boost::container::pmr::memory_resource &other) const noexcept
+{
+    return &other == this;
+}
+
+void TieredMemoryResource::_insert_free_block(size_t offset, size_t size)
+{
+    _free_blocks_by_offset.emplace(offset, size);
+    _free_blocks_by_size.emplace(size, offset);
+}
+
+void TieredMemoryResource::_erase_free_block(
+    std::map<size_t, size_t>::iterator block_it)
+{
+    const auto [offset, size] = *block_it;
+    auto [begin, end] = _free_blocks_by_size.equal_range(size);
+    for (; begin != end; ++begin)
+    {
+        if (begin->second == offset)
+        {
+            _free_blocks_by_size.erase(begin);
+            break;
+        }
+    }
+    _free_blocks_by_offset.erase(block_it);
+}
+
+void configure_far_memory_tier(const size_t capacity,
+                               const std::optional<NodeID> numa_node)
+{
+    const auto lock = std::lock_guard<std::mutex>{tier_mutex};
+    Assert(!far_tier, "Far memory tier has already been set up.");
+
+    // Like the default resource, the far tier is leaked on purpose so that it
+    // outlives all segments allocated from it.
+    far_tier = new TieredMemoryResource(MemoryTier::Far, capacity, numa_node); // NOLINT(cppcoreguidelines-owning-memory)
+}
+
+void configure_near_memory_tier(const size_t capacity, const NodeID numa_node)
+{
+    const auto lock = std::lock_guard<std::mutex>{tier_mutex};
+    Assert(!near_tier, "Near memory tier has already been set up.");
+    near_tier = new TieredMemoryResource(MemoryTier::Near, capacity, numa_node); // NOLINT(cppcoreguidelines-owning-memory)
+}
+
+boost::container::pmr::memory_resource *
+get_memory_tier_resource(const MemoryTier tier)
+{
+    if (tier == MemoryTier::Near)
+    {
+        if (auto *resource = near_tier.load())
+        {
+            return resource;
+        }
+        return boost::container::pmr::get_default_resource();
+    }
+
+    if (auto *resource = far_tier.load())
+    {
+        return resource;
+    }
+
+    const auto lock = std::lock_guard<std::mutex>{tier_mutex};
+    if (!far_tier)
+    {
+        far_tier = new TieredMemoryResource(MemoryTier::Far, DEFAULT_FAR_TIER_CAPACITY); // NOLINT(cppcoreguidelines-owning-memory)
+    }
+    return far_tier;
+}
+
+const TieredMemoryResource *get_far_memory_tier() { return far_tier; }
+
+const TieredMemoryResource *get_near_memory_tier() { return near_tier; }
+
+MemoryTier memory_tier_of(const void *pointer)
+{
+    const auto *resource = far_tier.load();
+    return resource && resource->contains(pointer) ? MemoryTier::Far
+                                                   : MemoryTier::Near;
+}
+
+} // namespace hyrise
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+#include <boost/container/pmr/memory_resource.hpp>
+
+#include "types.hpp"
+
+namespace hyrise
+{
+
+// Memory tiers a segment can be placed in. Near is the regular DRAM that
+// Hyrise allocates from by default, Far is the slower, larger tier (e.g., CXL
+// memory exposed as a CPU-less NUMA node).
+enum class MemoryTier : uint8_t
+{
+    Near,
+    Far
+};
+
+/**
+ * Memory resource that serves all allocations from a single, contiguous
+ * virtual memory region. The region is reserved upfront (without committing
+ * physical memory) and can be bound to a NUMA node via mbind, so that all pages
+ * touched later are placed on that node. If no NUMA node is given, the region is
+ * not bound and the resource emulates a slow tier: the memory is regular DRAM,
+ * but all its allocations live in a known address range that memory traces
+ * can attribute to the far tier.
+ *
+ * Free blocks are managed with a best-fit free list that coalesces neighboring
+ * blocks. If the region is exhausted, allocations fall back to the default
+ * resource (and are counted in fallback_bytes()) instead of failing.
+ */
+class TieredMemoryResource : public boost::container::pmr::memory_resource,
+                             public Noncopyable
+{
+  public:
+    TieredMemoryResource(const MemoryTier tier, const size_t capacity,
+                         const std::optional<NodeID> numa_node = std::nullopt);
+    ~TieredMemoryResource() override;
+
+    MemoryTier tier() const;
+
+    // The NUMA node the region is bound to, std::nullopt for the emulated tier.
+    std::optional<NodeID> numa_node() const;
+
+    size_t capacity() const;
+    size_t allocated_bytes() const;
+    size_t fallback_bytes() const;
+
+    // Address range [begin, end) of the region.
+    std::pair<const std::byte *, const std::byte *> region() const;
+    bool contains(const void *pointer) const;
+
+    // All blocks are aligned to (and rounded up to multiples of) a cache line.
+    static constexpr size_t BLOCK_ALIGNMENT = 64;
+
+  protected:
+    void *do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void *pointer, std::size_t bytes,
+                       std::size_t alignment) override;
+    [[nodiscard]] bool do_is_equal(
+        const boost::container::pmr::memory_resource &other) const
+        noexcept override;
+
+  private:
+    void _insert_free_block(size_t offset, size_t size);
+    void _erase_free_block(std::map<size_t, size_t>::iterator block_it);
+
+    const MemoryTier _tier;
+    const size_t _capacity;
+    const std::optional<NodeID> _numa_node;
+    std::byte *_region{nullptr};
+
+    // Free blocks by offset (for coalescing) and by size (for best fit).
+    std::map<size_t, size_t> _free_blocks_by_offset;
+    std::multimap<size_t, size_t> _free_blocks_by_size;
+    size_t _allocated_bytes{0};
+    mutable std::mutex _mutex;
+
+    std::atomic<size_t> _fallback_bytes{0};
+};
+
+// Sets up the far tier. Must be called before the far tier is used for the
+// first time; otherwise, an emulated far tier with DEFAULT_FAR_TIER_CAPACITY is
+// created on first use.
+void configure_far_memory_tier(
+    const size_t capacity, const std::optional<NodeID> numa_node = std::nullopt);
+
+// Binds the near tier to a NUMA node, e.g., so that operator state (see
+// OperatorMemoryArena) cannot be placed on the far tier's node by the system
+// allocator. Must be called before the near tier is used for the first time.
+void configure_near_memory_tier(const size_t capacity,
+                                const NodeID numa_node);
+
+// Returns the resource to allocate memory of the given tier from. Unless it has
+// been configured, the near tier is the default resource.
+boost::container::pmr::memory_resource *
+get_memory_tier_resource(const MemoryTier tier);
+
+// Returns the far tier resource if it has been created already.
+const TieredMemoryResource *get_far_memory_tier();
+
+// Returns the near tier resource if it has been configured.
+const TieredMemoryResource *get_near_memory_tier();
+
+// Returns the tier the memory at @param pointer has been allocated from.
+// Memory outside of the far tier's region is considered to be near.
+MemoryTier memory_tier_of(const void *pointer);
+
+// Only virtual memory is reserved, so this can be generous.
+constexpr size_t DEFAULT_FAR_TIER_CAPACITY = size_t{64} * 1024 * 1024 * 1024;
+
+} // namespace hyrise
@@ -3,8 +3,10 @@
 #include "concurrency/transaction_context.hpp"
 #include "expression/expression_utils.hpp"
 #include "expression/pqp_subquery_expression.hpp"
+#include "hyrise.hpp"
 #include "logical_query_plan/abstract_non_query_node.hpp"
 #include "logical_query_plan/dummy_table_node.hpp"
+#include "memory/operator_memory_arena.hpp"
 #include "operators/get_table.hpp"
 #include "resolve_type.hpp"
 #include "scheduler/operator_task.hpp"
@@ -108,6 +110,14 @@ void AbstractOperator::execute()
 
     auto performance_timer = Timer{};
 
+    auto memory_pool = _memory_pool.lock();
+    if (!memory_pool)
+    {
+        memory_pool = std::make_shared<QueryMemoryPool>(
+            Hyrise::get().query_memory_budget());
+    }
+    _memory_arena = std::make_unique<OperatorMemoryArena>(memory_pool);
+
     auto transaction_context = this->transaction_context();
     if (transaction_context)
     {
@@ -118,6 +128,7 @@ void AbstractOperator::execute()
          */
         if (transaction_context->aborted())
         {
+            _memory_arena.reset();
             return;
         }
 
@@ -133,6 +144,10 @@ void AbstractOperator::execute()
     // release any temporary data if possible
     _on_cleanup();
 
+    // Hand the arena's blocks on to the next operator of the query.
+    performance_data->peak_arena_bytes = _memory_arena->peak_allocated_bytes();
+    _memory_arena.reset();
+
     if (_output)
     {
         performance_data->has_output = true;
@@ -321,6 +336,9 @@ std::shared_ptr<AbstractOperator> AbstractOperator::deep_copy(
         copied_op->set_transaction_context(*_transaction_context);
     }
 
+    // Likewise, the copies of correlated subqueries use the pool of the query.
+    copied_op->set_memory_pool(_memory_pool);
+
     copied_ops.emplace(this, copied_op);
 
     return copied_op;
@@ -419,6 +437,46 @@ void AbstractOperator::set_transaction_context_recursively(
     }
 }
 
+void AbstractOperator::set_memory_pool(
+    const std::weak_ptr<QueryMemoryPool> &memory_pool)
+{
+    _memory_pool = memory_pool;
+}
+
+void AbstractOperator::set_memory_pool_recursively(
+    const std::weak_ptr<QueryMemoryPool> &memory_pool)
+{
+    set_memory_pool(memory_pool);
+
+    if (_left_input)
+    {
+        mutable_left_input()->set_memory_pool_recursively(memory_pool);
+    }
+
+    if (_right_input)
+    {
+        mutable_right_input()->set_memory_pool_recursively(memory_pool);
+    }
+
+    for (const auto &subquery_expression : _uncorrelated_subquery_expressions)
+    {
+        subquery_expression->pqp->set_memory_pool_recursively(memory_pool);
+    }
+
+    for (const auto &subquery_expression : _correlated_subquery_expressions)
+    {
+        subquery_expression->pqp->set_memory_pool_recursively(memory_pool);
+    }
+}
+
+boost::container::pmr::memory_resource *AbstractOperator::memory_arena() const
+{
+    DebugAssert(_memory_arena,
+                "The memory arena is only available while the operator "
+                "executes.");
+    return _memory_arena.get();
+}
+
 std::shared_ptr<AbstractOperator> AbstractOperator::mutable_left_input() const
 {
     return std::const_pointer_cast<AbstractOperator>(_left_input);
@@ -539,6 +597,7 @@ void AbstractOperator::_search_and_register_uncorrelated_subqueries(
     {
         if (subquery_expression->is_correlated())
         {
+            _correlated_subquery_expressions.emplace_back(subquery_expression);
             continue;
         }
         /**
@@ -5,6 +5,8 @@
 #include <mutex>
 #include <unordered_map>
 
+#include <boost/container/pmr/memory_resource.hpp>
+
 #include "all_parameter_variant.hpp"
 #include "logical_query_plan/abstract_lqp_node.hpp"
 #include "operator_performance_data.hpp"
@@ -12,7 +14,9 @@
 namespace hyrise
 {
 
+class OperatorMemoryArena;
 class OperatorTask;
+class QueryMemoryPool;
 class Table;
 class TransactionContext;
 class PQPSubqueryExpression;
@@ -208,6 +212,22 @@ class AbstractOperator : public std::enable_shared_from_this<AbstractOperator>,
                                  std::shared_ptr<AbstractOperator>> &copied_ops)
         const;
 
+    // The operators of a query share the near-tier blocks of their memory
+    // arenas through a pool (see QueryMemoryPool). Without one, an operator
+    // uses a pool of its own.
+    void set_memory_pool(const std::weak_ptr<QueryMemoryPool> &memory_pool);
+
+    // Calls set_memory_pool on itself, its inputs, and its subqueries
+    // recursively. The per-row copies of correlated subqueries get the pool
+    // through deep_copy.
+    void set_memory_pool_recursively(
+        const std::weak_ptr<QueryMemoryPool> &memory_pool);
+
+    // Near-tier arena for the private state of the operator (e.g., hash tables)
+    // while it executes, see OperatorMemoryArena. It is released after
+    // _on_cleanup(), so the output must not be allocated from it.
+    boost::container::pmr::memory_resource *memory_arena() const;
+
     // Get the input operators.
     std::shared_ptr<const AbstractOperator> left_input() const;
     std::shared_ptr<const AbstractOperator> right_input() const;
@@ -314,12 +334,21 @@ class AbstractOperator : public std::enable_shared_from_this<AbstractOperator>,
     // Weak pointer breaks cyclical dependency between operators and context
     std::optional<std::weak_ptr<TransactionContext>> _transaction_context;
 
+    // Weak, so that cached plans do not keep the memory of past queries.
+    std::weak_ptr<QueryMemoryPool> _memory_pool;
+    std::unique_ptr<OperatorMemoryArena> _memory_arena;
+
     // Some operators, e.g., TableScans or Projections, have predicates with
     // uncorrelated subqueries. We store these subqueries in AbstractOperator to
     // create their tasks.
     std::vector<std::shared_ptr<PQPSubqueryExpression>>
         _uncorrelated_subquery_expressions;
 
+    // Correlated subqueries are executed by the ExpressionEvaluator. They are
+    // only stored to pass the memory pool on to them.
+    std::vector<std::shared_ptr<PQPSubqueryExpression>>
+        _correlated_subquery_expressions;
+
     /**
      * OperatorTasks wrap operators for scheduling. Since operator results are
      * shared between uncorrelated subqueries and their outer queries,
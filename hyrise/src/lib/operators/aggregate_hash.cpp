@@ -240,9 +240,14 @@ struct AggregateResultContext : SegmentVisitorContext
         AggregateResults<ColumnDataType, aggregate_function>>;
 
     // In cases where we know how many values to expect, we can preallocate the
-    // context in order to avoid later re-allocations.
-    explicit AggregateResultContext(const size_t preallocated_size = 0)
-        : results(preallocated_size, AggregateResultAllocator{&buffer})
+    // context in order to avoid later re-allocations. The buffer draws from
+    // @param upstream, usually the operator's memory arena.
+    explicit AggregateResultContext(
+        const size_t preallocated_size = 0,
+        boost::container::pmr::memory_resource *upstream =
+            boost::container::pmr::get_default_resource())
+        : buffer(upstream),
+          results(preallocated_size, AggregateResultAllocator{&buffer})
     {
     }
 
@@ -255,9 +260,12 @@ template <typename ColumnDataType, WindowFunction aggregate_function,
 struct AggregateContext
     : public AggregateResultContext<ColumnDataType, aggregate_function>
 {
-    explicit AggregateContext(const size_t preallocated_size = 0)
+    explicit AggregateContext(
+        const size_t preallocated_size = 0,
+        boost::container::pmr::memory_resource *upstream =
+            boost::container::pmr::get_default_resource())
         : AggregateResultContext<ColumnDataType, aggregate_function>(
-              preallocated_size)
+              preallocated_size, upstream)
     {
         auto allocator =
             AggregateResultIdMapAllocator<AggregateKey>{&this->buffer};
@@ -358,7 +366,7 @@ AggregateHash::_aggregate_segment(ChunkID chunk_id, ColumnID column_index,
 template <typename AggregateKey>
 KeysPerChunk<AggregateKey> AggregateHash::_partition_by_groupby_keys()
 {
-    auto keys_per_chunk = KeysPerChunk<AggregateKey>{};
+    auto keys_per_chunk = KeysPerChunk<AggregateKey>{memory_arena()};
 
     if constexpr (!std::is_same_v<AggregateKey, EmptyAggregateKey>)
     {
@@ -1015,7 +1023,7 @@ template <typename AggregateKey> void AggregateHash::_aggregate()
         */
         auto context = std::make_shared<
             AggregateContext<int32_t, WindowFunction::Min, AggregateKey>>(
-            _expected_result_size);
+            _expected_result_size, memory_arena());
 
         _contexts_per_column.push_back(context);
     }
@@ -1044,7 +1052,7 @@ template <typename AggregateKey> void AggregateHash::_aggregate()
             // need a visitor
             auto context = std::make_shared<AggregateContext<
                 CountColumnType, WindowFunction::Count, AggregateKey>>(
-                _expected_result_size);
+                _expected_result_size, memory_arena());
 
             _contexts_per_column[aggregate_idx] = context;
             continue;
@@ -1900,42 +1908,49 @@ std::shared_ptr<SegmentVisitorContext> AggregateHash::_create_aggregate_context(
         [&](auto type)
         {
             const auto size = _expected_result_size.load();
+            auto *const arena = memory_arena();
             using ColumnDataType = typename decltype(type)::type;
             switch (aggregate_function)
             {
             case WindowFunction::Min:
                 context = std::make_shared<AggregateContext<
-                    ColumnDataType, WindowFunction::Min, AggregateKey>>(size);
+                    ColumnDataType, WindowFunction::Min,
+                    AggregateKey>>(size, arena);
                 break;
             case WindowFunction::Max:
                 context = std::make_shared<AggregateContext<
-                    ColumnDataType, WindowFunction::Max, AggregateKey>>(size);
+                    ColumnDataType, WindowFunction::Max,
+                    AggregateKey>>(size, arena);
                 break;
             case WindowFunction::Sum:
                 context = std::make_shared<AggregateContext<
-                    ColumnDataType, WindowFunction::Sum, AggregateKey>>(size);
+                    ColumnDataType, WindowFunction::Sum,
+                    AggregateKey>>(size, arena);
                 break;
             case WindowFunction::Avg:
                 context = std::make_shared<AggregateContext<
-                    ColumnDataType, WindowFunction::Avg, AggregateKey>>(size);
+                    ColumnDataType, WindowFunction::Avg,
+                    AggregateKey>>(size, arena);
                 break;
             case WindowFunction::Count:
                 context = std::make_shared<AggregateContext<
-                    ColumnDataType, WindowFunction::Count, AggregateKey>>(size);
+                    ColumnDataType, WindowFunction::Count,
+                    AggregateKey>>(size, arena);
                 break;
             case WindowFunction::CountDistinct:
                 context = std::make_shared<AggregateContext<
                     ColumnDataType, WindowFunction::CountDistinct,
-                    AggregateKey>>(size);
+                    AggregateKey>>(size, arena);
                 break;
             case WindowFunction::StandardDeviationSample:
                 context = std::make_shared<AggregateContext<
                     ColumnDataType, WindowFunction::StandardDeviationSample,
-                    AggregateKey>>(size);
+                    AggregateKey>>(size, arena);
                 break;
             case WindowFunction::Any:
                 context = std::make_shared<AggregateContext<
-                    ColumnDataType, WindowFunction::Any, AggregateKey>>(size);
+                    ColumnDataType, WindowFunction::Any,
+                    AggregateKey>>(size, arena);
                 break;
             case WindowFunction::CumeDist:
             case WindowFunction::DenseRank:
@@ -20,6 +20,44 @@
 #include "utils/format_duration.hpp"
 #include "utils/timer.hpp"
 
+namespace
+{
+
+using namespace hyrise; // NOLINT
+
+// We assume a cache of 1024 KB for an Intel Xeon Platinum 8180. For local
+// deployments or other CPUs, this size might be different (e.g., an AMD EPYC
+// 7F72 CPU has an L2 cache size of 512 KB and Apple's M1 has 128 KB).
+constexpr auto L2_CACHE_SIZE = 1'024'000; // bytes
+constexpr auto L2_CACHE_MAX_USABLE =
+    L2_CACHE_SIZE * 0.75; // use 75% of the L2 cache size
+
+// We limit the max fan out for radix partitioning to 8 bits (i.e., 256
+// partitions). "An Experimental Comparison of Thirteen Relational Equi-Joins in
+// Main Memory" by Schuh et al. analyzed the number of radix bits and how much
+// large fan outs hurt performance due to TLB misses. As we do not use
+// software-managed buffers, a smaller number of bits has shown the best
+// results.
+constexpr auto MAX_RADIX_BITS = size_t{8};
+
+double estimate_hash_map_size(const size_t build_side_size)
+{
+    // For information about the sizing of the bytell hash map, see the
+    // comments:
+    // https://probablydance.com/2018/05/28/a-new-fast-hash-table-in-response-to-googles-new-fast-hash-table/
+    // Bytell hash map has a maximum fill factor of 0.9375. Since it's hard to
+    // estimate the number of distinct values in a radix partition (and thus the
+    // size of each hash table), we accomodate a little bit extra space for
+    // slightly skewed data distributions and aim for a fill level of 80%.
+    return
+        // number of items in map
+        static_cast<double>(build_side_size) *
+        // key + value (and one byte overhead, see link above)
+        static_cast<double>(sizeof(uint32_t)) / 0.8;
+}
+
+} // namespace
+
 namespace hyrise
 {
 
@@ -103,39 +141,22 @@ size_t JoinHash::calculate_radix_bits(const size_t build_side_size,
         PerformanceWarning("Build side larger than probe side in hash join");
     }
 
-    // We assume a cache of 1024 KB for an Intel Xeon Platinum 8180. For local
-    // deployments or other CPUs, this size might be different (e.g., an AMD
-    // EPYC 7F72 CPU has an L2 cache size of 512 KB and Apple's M1 has 128 KB).
-    constexpr auto L2_CACHE_SIZE = 1'024'000; // bytes
-    constexpr auto L2_CACHE_MAX_USABLE =
-        L2_CACHE_SIZE * 0.75; // use 75% of the L2 cache size
+    const auto cluster_count = std::max(
+        1.0, estimate_hash_map_size(build_side_size) / L2_CACHE_MAX_USABLE);
 
-    // For information about the sizing of the bytell hash map, see the
-    // comments:
-    // https://probablydance.com/2018/05/28/a-new-fast-hash-table-in-response-to-googles-new-fast-hash-table/
-    // Bytell hash map has a maximum fill factor of 0.9375. Since it's hard to
-    // estimate the number of distinct values in a radix partition (and thus the
-    // size of each hash table), we accomodate a little bit extra space for
-    // slightly skewed data distributions and aim for a fill level of 80%.
-    const auto complete_hash_map_size =
-        // number of items in map
-        static_cast<double>(build_side_size) *
-        // key + value (and one byte overhead, see link above)
-        static_cast<double>(sizeof(uint32_t)) / 0.8;
-
-    const auto cluster_count =
-        std::max(1.0, complete_hash_map_size / L2_CACHE_MAX_USABLE);
-
-    // We limit the max fan out for radix partitioning to 8 bits (i.e., 256
-    // partitions). "An Experimental Comparison of Thirteen Relational
-    // Equi-Joins in Main Memory" by Schuh et al. analyzed the number of radix
-    // bits and how much large fan outs hurt performance due to TLB misses. As
-    // we do not use software-managed buffers, a smaller number of bits has
-    // shown the best results.
-    return std::min(size_t{8},
+    return std::min(MAX_RADIX_BITS,
                     static_cast<size_t>(std::ceil(std::log2(cluster_count))));
 }
 
+bool JoinHash::use_batched_probe(const size_t build_side_size,
+                                 const size_t radix_bits)
+{
+    const auto partition_hash_map_size =
+        estimate_hash_map_size(build_side_size) /
+        static_cast<double>(size_t{1} << radix_bits);
+    return partition_hash_map_size > L2_CACHE_MAX_USABLE;
+}
+
 std::shared_ptr<const Table> JoinHash::_on_execute()
 {
     Assert(supports({_mode, _primary_predicate.predicate_condition,
@@ -386,6 +407,11 @@ class JoinHash::JoinHashImpl : public AbstractReadOnlyOperatorImpl
         // HashTables for the build column, one for each partition
         std::vector<std::optional<PosHashTable<HashedType>>> hash_tables;
 
+        // The materialized columns and the hash tables are private to this
+        // execution, so they are allocated from the operator's near-tier arena
+        // wherever the input segments are placed.
+        auto *const memory_arena = _join_hash.memory_arena();
+
         /**
          * Depiction of the hash join parallelization (radix partitioning can be
          * skipped when radix_bits = 0)
@@ -429,7 +455,8 @@ class JoinHash::JoinHashImpl : public AbstractReadOnlyOperatorImpl
                     materialize_input<BuildColumnType, HashedType, true>(
                         _build_input_table, _column_ids.first,
                         histograms_build_column, _radix_bits,
-                        build_side_bloom_filter, input_bloom_filter);
+                        build_side_bloom_filter, input_bloom_filter,
+                        memory_arena);
             }
             else
             {
@@ -437,7 +464,8 @@ class JoinHash::JoinHashImpl : public AbstractReadOnlyOperatorImpl
                     materialize_input<BuildColumnType, HashedType, false>(
                         _build_input_table, _column_ids.first,
                         histograms_build_column, _radix_bits,
-                        build_side_bloom_filter, input_bloom_filter);
+                        build_side_bloom_filter, input_bloom_filter,
+                        memory_arena);
             }
         };
 
@@ -454,7 +482,8 @@ class JoinHash::JoinHashImpl : public AbstractReadOnlyOperatorImpl
                     materialize_input<ProbeColumnType, HashedType, true>(
                         _probe_input_table, _column_ids.second,
                         histograms_probe_column, _radix_bits,
-                        probe_side_bloom_filter, input_bloom_filter);
+                        probe_side_bloom_filter, input_bloom_filter,
+                        memory_arena);
             }
             else
             {
@@ -462,7 +491,8 @@ class JoinHash::JoinHashImpl : public AbstractReadOnlyOperatorImpl
                     materialize_input<ProbeColumnType, HashedType, false>(
                         _probe_input_table, _column_ids.second,
                         histograms_probe_column, _radix_bits,
-                        probe_side_bloom_filter, input_bloom_filter);
+                        probe_side_bloom_filter, input_bloom_filter,
+                        memory_arena);
             }
         };
 
@@ -537,7 +567,8 @@ class JoinHash::JoinHashImpl : public AbstractReadOnlyOperatorImpl
                             partition_by_radix<BuildColumnType, HashedType,
                                                true>(materialized_build_column,
                                                      histograms_build_column,
-                                                     _radix_bits);
+                                                     _radix_bits, ALL_TRUE_BLOOM_FILTER,
+                                                     memory_arena);
                     }
                     else
                     {
@@ -545,7 +576,8 @@ class JoinHash::JoinHashImpl : public AbstractReadOnlyOperatorImpl
                             partition_by_radix<BuildColumnType, HashedType,
                                                false>(materialized_build_column,
                                                       histograms_build_column,
-                                                      _radix_bits);
+                                                      _radix_bits, ALL_TRUE_BLOOM_FILTER,
+                                                      memory_arena);
                     }
 
                     // After the data in materialized_build_column has been
@@ -563,7 +595,8 @@ class JoinHash::JoinHashImpl : public AbstractReadOnlyOperatorImpl
                             partition_by_radix<ProbeColumnType, HashedType,
                                                true>(materialized_probe_column,
                                                      histograms_probe_column,
-                                                     _radix_bits);
+                                                     _radix_bits, ALL_TRUE_BLOOM_FILTER,
+                                                     memory_arena);
                     }
                     else
                     {
@@ -571,7 +604,8 @@ class JoinHash::JoinHashImpl : public AbstractReadOnlyOperatorImpl
                             partition_by_radix<ProbeColumnType, HashedType,
                                                false>(materialized_probe_column,
                                                       histograms_probe_column,
-                                                      _radix_bits);
+                                                      _radix_bits, ALL_TRUE_BLOOM_FILTER,
+                                                      memory_arena);
                     }
 
                     // After the data in materialized_probe_column has been
@@ -609,13 +643,13 @@ class JoinHash::JoinHashImpl : public AbstractReadOnlyOperatorImpl
         {
             hash_tables = build<BuildColumnType, HashedType>(
                 radix_build_column, JoinHashBuildMode::ExistenceOnly,
-                _radix_bits, probe_side_bloom_filter);
+                _radix_bits, probe_side_bloom_filter, memory_arena);
         }
         else
         {
             hash_tables = build<BuildColumnType, HashedType>(
                 radix_build_column, JoinHashBuildMode::AllPositions,
-                _radix_bits, probe_side_bloom_filter);
+                _radix_bits, probe_side_bloom_filter, memory_arena);
         }
         _performance_data.set_step_runtime(OperatorSteps::Building,
                                            timer_hash_map_building.lap());
@@ -696,6 +730,11 @@ class JoinHash::JoinHashImpl : public AbstractReadOnlyOperatorImpl
                 result_rows_per_partition);
         }
 
+        // The distinct values that ended up in the hash tables are a better
+        // estimate of their size than the build side's row count.
+        const auto batched_probe = JoinHash::use_batched_probe(
+            _performance_data.hash_tables_distinct_value_count, _radix_bits);
+
         Timer timer_probing;
         switch (_mode)
         {
@@ -703,7 +742,8 @@ class JoinHash::JoinHashImpl : public AbstractReadOnlyOperatorImpl
             probe<ProbeColumnType, HashedType, false>(
                 radix_probe_column, hash_tables, build_side_pos_lists,
                 probe_side_pos_lists, _mode, *_build_input_table,
-                *_probe_input_table, _secondary_predicates);
+                *_probe_input_table, _secondary_predicates, batched_probe);
+            _performance_data.batched_probe = batched_probe;
             break;
 
         case JoinMode::Left:
@@ -711,7 +751,8 @@ class JoinHash::JoinHashImpl : public AbstractReadOnlyOperatorImpl
             probe<ProbeColumnType, HashedType, true>(
                 radix_probe_column, hash_tables, build_side_pos_lists,
                 probe_side_pos_lists, _mode, *_build_input_table,
-                *_probe_input_table, _secondary_predicates);
+                *_probe_input_table, _secondary_predicates, batched_probe);
+            _performance_data.batched_probe = batched_probe;
             break;
 
         case JoinMode::Semi:
@@ -793,6 +834,10 @@ void JoinHash::PerformanceData::output_to_stream(
     stream << separator << "Radix bits: " << radix_bits << ".";
     stream << separator << "Build side is "
            << (left_input_is_build_side ? "left." : "right.");
+    if (batched_probe)
+    {
+        stream << separator << "Batched probe.";
+    }
 }
 
 } // namespace hyrise
@@ -44,6 +44,17 @@ class JoinHash : public AbstractJoinOperator
     static size_t calculate_radix_bits(const size_t build_side_size,
                                        const size_t probe_side_size);
 
+    // Radix partitioning sizes the hash tables to fit into the cache, but the
+    // fan out is limited. If the hash tables of the partitions still exceed the
+    // cache, nearly every probe misses and the probe step looks up values in
+    // batches of PROBE_BATCH_SIZE to overlap the misses (see probe() in
+    // join_hash_steps.hpp). For small hash tables, the batching only adds
+    // overhead.
+    static bool use_batched_probe(const size_t build_side_size,
+                                  const size_t radix_bits);
+
+    static constexpr size_t PROBE_BATCH_SIZE = 16;
+
     enum class OperatorSteps : uint8_t
     {
         BuildSideMaterializing,
@@ -63,6 +74,7 @@ class JoinHash : public AbstractJoinOperator
         // Initially, the left input is the build side and the right side is the
         // probe side.
         bool left_input_is_build_side{true};
+        bool batched_probe{false};
 
         // Due to the used Bloom filters, the number of actually joined tuples
         // can significantly differ from the sizes of the input tables. To
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <array>
+
 #include <boost/container/pmr/monotonic_buffer_resource.hpp>
 #include <boost/container/pmr/unsynchronized_pool_resource.hpp>
 #include <boost/container/small_vector.hpp>
@@ -9,6 +11,7 @@
 
 #include "bytell_hash_map.hpp"
 #include "hyrise.hpp"
+#include "memory/prefetching.hpp"
 #include "operators/join_hash.hpp"
 #include "operators/multi_predicate_join/multi_predicate_join_evaluator.hpp"
 #include "resolve_type.hpp"
@@ -61,19 +64,29 @@ template <typename T> struct PartitionedElement
 // matching rows in exactly one partition on the build side (1:1).
 template <typename T> struct Partition
 {
+    Partition() = default;
+
+    // JoinHash allocates its partitions from the operator's memory arena.
+    explicit Partition(boost::container::pmr::memory_resource *memory_resource)
+        : elements(memory_resource), null_values(memory_resource)
+    {
+    }
+
     // Initializing the partition vector takes some time. This is not necessary,
     // because it will be overwritten anyway. The uninitialized_vector behaves
     // like a regular std::vector, but the entries are initially invalid.
-    std::conditional_t<std::is_trivially_destructible_v<T>,
-                       uninitialized_vector<PartitionedElement<T>>,
-                       std::vector<PartitionedElement<T>>>
+    std::conditional_t<
+        std::is_trivially_destructible_v<T>,
+        uninitialized_vector<PartitionedElement<T>,
+                             PolymorphicAllocator<PartitionedElement<T>>>,
+        pmr_vector<PartitionedElement<T>>>
         elements;
 
     // Bit vector to store NULL flags - not using uninitialized_vector because
     // it is not specialized for bool. It is stored independently of the
     // elements as adding a single bit to PartitionedElement would cause memory
     // waste due to padding.
-    std::vector<bool> null_values;
+    pmr_vector<bool> null_values;
 };
 
 // This alias is used in two phases:
@@ -129,8 +142,21 @@ template <typename HashedType> class PosHashTable
         std::vector<size_t> offsets;
     };
 
-    explicit PosHashTable(const JoinHashBuildMode mode, const size_t max_size)
-        : _mode(mode),
+    // The build structures and the UnifiedPosList are allocated from
+    // @param memory_resource, usually the operator's memory arena.
+    explicit PosHashTable(
+        const JoinHashBuildMode mode, const size_t max_size,
+        boost::container::pmr::memory_resource *memory_resource =
+            boost::container::pmr::get_default_resource())
+        : _memory_resource(memory_resource),
+          _monotonic_buffer(
+              std::make_unique<
+                  boost::container::pmr::monotonic_buffer_resource>(
+                  memory_resource)),
+          _memory_pool(std::make_unique<
+                       boost::container::pmr::unsynchronized_pool_resource>(
+              _monotonic_buffer.get())),
+          _mode(mode),
           _small_pos_lists(
               mode == JoinHashBuildMode::AllPositions ? max_size + 1 : 0,
               SmallPosList{SmallPosList::allocator_type(_memory_pool.get())})
@@ -178,7 +204,9 @@ template <typename HashedType> class PosHashTable
 
         if (_mode == JoinHashBuildMode::AllPositions)
         {
-            _unified_pos_list = UnifiedPosList{};
+            _unified_pos_list = UnifiedPosList{
+                RowIDPosList{RowIDPosList::allocator_type{_memory_resource}},
+                {}};
             // Resize so that we can store the start offset of each range as
             // well as the final end offset.
             _unified_pos_list->offsets.resize(hash_table_size + 1);
@@ -216,6 +244,20 @@ template <typename HashedType> class PosHashTable
     template <typename InputType>
     const std::pair<RowIDPosList::const_iterator, RowIDPosList::const_iterator>
     find(const InputType &value) const
+    {
+        return range(find_range(value));
+    }
+
+    // find() consists of three dependent loads: the hash table bucket, the
+    // range's offsets, and the positions. For hash tables that exceed the
+    // cache, each of them is likely to miss. The batched probe (see probe())
+    // thus calls the following steps for a batch of probe values, one step
+    // after the other, so that the misses of the batch overlap.
+
+    // Return the index of the value's range in the UnifiedPosList or
+    // std::nullopt if the value has not been seen on the build side.
+    template <typename InputType>
+    std::optional<Offset> find_range(const InputType &value) const
     {
         DebugAssert(_mode == JoinHashBuildMode::AllPositions,
                     "find is invalid for ExistenceOnly mode, use contains");
@@ -224,8 +266,34 @@ template <typename HashedType> class PosHashTable
 
         const auto casted_value = static_cast<HashedType>(value);
         const auto hash_table_iter = _offset_hash_table.find(casted_value);
-
         if (hash_table_iter == _offset_hash_table.end())
+        {
+            return std::nullopt;
+        }
+        return hash_table_iter->second;
+    }
+
+    // Prefetch the offsets of the range. The end offset is the next entry and
+    // thus usually shares the cache line.
+    void prefetch_range(const Offset range_index) const
+    {
+        prefetch_for_read(&_unified_pos_list->offsets[range_index]);
+    }
+
+    // Prefetch the first positions of the range. Reads the range's offsets, so
+    // prefetch_range() should have been called before.
+    void prefetch_positions(const Offset range_index) const
+    {
+        prefetch_for_read(_unified_pos_list->pos_list.data() +
+                          _unified_pos_list->offsets[range_index]);
+    }
+
+    // Return the iterator pair of the range with the given index, an empty
+    // range for std::nullopt.
+    const std::pair<RowIDPosList::const_iterator, RowIDPosList::const_iterator>
+    range(const std::optional<Offset> range_index) const
+    {
+        if (!range_index)
         {
             // Not found, return an empty range
             return {_unified_pos_list->pos_list.end(),
@@ -237,9 +305,9 @@ template <typename HashedType> class PosHashTable
         // first value of the next value. This is what we added `total_size` to
         // the offset list for.
         return {_unified_pos_list->pos_list.begin() +
-                    _unified_pos_list->offsets[hash_table_iter->second],
+                    _unified_pos_list->offsets[*range_index],
                 _unified_pos_list->pos_list.begin() +
-                    _unified_pos_list->offsets[hash_table_iter->second + 1]};
+                    _unified_pos_list->offsets[*range_index + 1]};
     }
 
     // For a value seen on the probe side, return whether it has been seen on
@@ -279,13 +347,11 @@ template <typename HashedType> class PosHashTable
     // for each allocation. Instead, we synchronize only when we refill the
     // underlying monotonic_buffer_resource. This works because each
     // PosHashTable is used by exactly one thread.
+    boost::container::pmr::memory_resource *_memory_resource;
     std::unique_ptr<boost::container::pmr::monotonic_buffer_resource>
-        _monotonic_buffer = std::make_unique<
-            boost::container::pmr::monotonic_buffer_resource>();
+        _monotonic_buffer;
     std::unique_ptr<boost::container::pmr::unsynchronized_pool_resource>
-        _memory_pool = std::make_unique<
-            boost::container::pmr::unsynchronized_pool_resource>(
-            _monotonic_buffer.get());
+        _memory_pool;
 
     JoinHashBuildMode _mode{};
     OffsetHashTable _offset_hash_table{};
@@ -351,7 +417,9 @@ materialize_input(const std::shared_ptr<const Table> &in_table,
                   const ColumnID column_id,
                   std::vector<std::vector<size_t>> &histograms,
                   const size_t radix_bits, BloomFilter &output_bloom_filter,
-                  const BloomFilter &input_bloom_filter = ALL_TRUE_BLOOM_FILTER)
+                  const BloomFilter &input_bloom_filter = ALL_TRUE_BLOOM_FILTER,
+                  boost::container::pmr::memory_resource *memory_resource =
+                      boost::container::pmr::get_default_resource())
 {
     // Retrieve input chunk_count as it might change during execution if we work
     // on a non-reference table
@@ -360,7 +428,11 @@ materialize_input(const std::shared_ptr<const Table> &in_table,
     const std::hash<HashedType> hash_function;
     // List of all elements that will be partitioned
     auto radix_container = RadixContainer<T>{};
-    radix_container.resize(chunk_count);
+    radix_container.reserve(chunk_count);
+    for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id)
+    {
+        radix_container.emplace_back(memory_resource);
+    }
 
     // Fan-out
     const size_t num_radix_partitions = 1ull << radix_bits;
@@ -581,7 +653,9 @@ template <typename BuildColumnType, typename HashedType>
 std::vector<std::optional<PosHashTable<HashedType>>>
 build(const RadixContainer<BuildColumnType> &radix_container,
       const JoinHashBuildMode mode, const size_t radix_bits,
-      const BloomFilter &input_bloom_filter)
+      const BloomFilter &input_bloom_filter,
+      boost::container::pmr::memory_resource *memory_resource =
+          boost::container::pmr::get_default_resource())
 {
     Assert(input_bloom_filter.size() == BLOOM_FILTER_SIZE,
            "invalid input_bloom_filter");
@@ -607,7 +681,8 @@ build(const RadixContainer<BuildColumnType> &radix_container,
             total_size += radix_container[partition_idx].elements.size();
         }
         hash_tables.resize(1);
-        hash_tables[0] = PosHashTable<HashedType>(mode, total_size);
+        hash_tables[0] =
+            PosHashTable<HashedType>(mode, total_size, memory_resource);
     }
     else
     {
@@ -638,7 +713,8 @@ build(const RadixContainer<BuildColumnType> &radix_container,
             auto &hash_table = hash_tables[hash_table_idx];
             if (radix_bits > 0)
             {
-                hash_table = PosHashTable<HashedType>(mode, elements_count);
+                hash_table = PosHashTable<HashedType>(mode, elements_count,
+                                                      memory_resource);
             }
             for (const auto &element : elements)
             {
@@ -693,7 +769,9 @@ template <typename T, typename HashedType, bool keep_null_values>
 RadixContainer<T> partition_by_radix(
     const RadixContainer<T> &radix_container,
     std::vector<std::vector<size_t>> &histograms, const size_t radix_bits,
-    const BloomFilter &input_bloom_filter = ALL_TRUE_BLOOM_FILTER)
+    const BloomFilter &input_bloom_filter = ALL_TRUE_BLOOM_FILTER,
+    boost::container::pmr::memory_resource *memory_resource =
+        boost::container::pmr::get_default_resource())
 {
     if (radix_container.empty())
     {
@@ -720,7 +798,13 @@ RadixContainer<T> partition_by_radix(
         static_cast<uint32_t>(std::pow(2, radix_bits * (pass + 1)) - 1);
 
     // allocate new (shared) output
-    auto output = RadixContainer<T>(output_partition_count);
+    auto output = RadixContainer<T>{};
+    output.reserve(output_partition_count);
+    for (auto output_partition_idx = size_t{0};
+         output_partition_idx < output_partition_count; ++output_partition_idx)
+    {
+        output.emplace_back(memory_resource);
+    }
 
     Assert(histograms.size() == input_partition_count,
            "Expected one histogram per input partition");
@@ -860,7 +944,9 @@ RadixContainer<T> partition_by_radix(
   In the probe phase we take all partitions from the probe partition, iterate
   over them and compare each join candidate with the values in the hash table.
   Since build and probe are hashed using the same hash function, we can reduce
-  the number of hash tables that need to be looked into to just 1.
+  the number of hash tables that need to be looked into to just 1. With
+  batched_probe, the values are looked up in batches of
+  JoinHash::PROBE_BATCH_SIZE to overlap cache misses.
   */
 template <typename ProbeColumnType, typename HashedType, bool keep_null_values>
 void probe(
@@ -869,7 +955,8 @@ void probe(
     std::vector<RowIDPosList> &pos_lists_build_side,
     std::vector<RowIDPosList> &pos_lists_probe_side, const JoinMode mode,
     const Table &build_table, const Table &probe_table,
-    const std::vector<OperatorJoinPredicate> &secondary_join_predicates)
+    const std::vector<OperatorJoinPredicate> &secondary_join_predicates,
+    const bool batched_probe = false)
 {
     std::vector<std::shared_ptr<AbstractTask>> jobs;
     jobs.reserve(probe_radix_container.size());
@@ -938,27 +1025,31 @@ void probe(
                 pos_list_probe_side_local.reserve(
                     static_cast<size_t>(expected_output_size));
 
-                for (auto partition_offset = size_t{0};
-                     partition_offset < elements_count; ++partition_offset)
+                // The probe step is bounded by the latency of the hash table
+                // lookups. Once the hash table exceeds the cache, the probe
+                // values are looked up in batches (see
+                // JoinHash::use_batched_probe()).
+                const auto skip_probe_element =
+                    [&](const size_t partition_offset)
+                {
+                    // From previous joins, we could potentially have NULL
+                    // values that do not refer to an actual
+                    // probe_column_element but to the NULL_ROW_ID. Hence, we
+                    // can only skip for inner joins.
+                    return mode == JoinMode::Inner &&
+                           elements[partition_offset].row_id == NULL_ROW_ID;
+                };
+
+                // Write the result rows of a probe element, given the build
+                // side positions that match its value.
+                const auto emit_matches =
+                    [&](const size_t partition_offset,
+                        auto primary_predicate_matching_rows_iter,
+                        const auto primary_predicate_matching_rows_end)
                 {
                     const auto &probe_column_element =
                         elements[partition_offset];
 
-                    if (mode == JoinMode::Inner &&
-                        probe_column_element.row_id == NULL_ROW_ID)
-                    {
-                        // From previous joins, we could potentially have NULL
-                        // values that do not refer to an actual
-                        // probe_column_element but to the NULL_ROW_ID. Hence,
-                        // we can only skip for inner joins.
-                        continue;
-                    }
-
-                    auto [primary_predicate_matching_rows_iter,
-                          primary_predicate_matching_rows_end] =
-                        hash_table.find(static_cast<HashedType>(
-                            probe_column_element.value));
-
                     if (primary_predicate_matching_rows_iter !=
                         primary_predicate_matching_rows_end)
                     {
@@ -984,7 +1075,7 @@ void probe(
                                     probe_column_element.row_id);
                                 // ignore found matches and continue with next
                                 // probe item
-                                continue;
+                                return;
                             }
                         }
 
@@ -1056,6 +1147,92 @@ void probe(
                                 probe_column_element.row_id);
                         }
                     }
+                };
+
+                if (!batched_probe)
+                {
+                    for (auto partition_offset = size_t{0};
+                         partition_offset < elements_count; ++partition_offset)
+                    {
+                        if (skip_probe_element(partition_offset))
+                        {
+                            continue;
+                        }
+
+                        const auto [matching_rows_begin, matching_rows_end] =
+                            hash_table.find(static_cast<HashedType>(
+                                elements[partition_offset].value));
+                        emit_matches(partition_offset, matching_rows_begin,
+                                     matching_rows_end);
+                    }
+                }
+                else
+                {
+                    // Group prefetching: Each stage is executed for all
+                    // elements of the batch before the next stage starts.
+                    // Thus, the hash table lookups of the batch are
+                    // independent of each other and the CPU overlaps their
+                    // misses. The following loads (offsets and positions) are
+                    // prefetched one stage before they are needed.
+                    using Offset = typename PosHashTable<HashedType>::Offset;
+                    auto range_indices =
+                        std::array<std::optional<Offset>,
+                                   JoinHash::PROBE_BATCH_SIZE>{};
+
+                    for (auto batch_begin = size_t{0};
+                         batch_begin < elements_count;
+                         batch_begin += JoinHash::PROBE_BATCH_SIZE)
+                    {
+                        const auto batch_size =
+                            std::min(JoinHash::PROBE_BATCH_SIZE,
+                                     elements_count - batch_begin);
+
+                        for (auto batch_offset = size_t{0};
+                             batch_offset < batch_size; ++batch_offset)
+                        {
+                            const auto partition_offset =
+                                batch_begin + batch_offset;
+                            auto &range_index = range_indices[batch_offset];
+                            range_index =
+                                skip_probe_element(partition_offset)
+                                    ? std::nullopt
+                                    : hash_table.find_range(
+                                          static_cast<HashedType>(
+                                              elements[partition_offset]
+                                                  .value));
+                            if (range_index)
+                            {
+                                hash_table.prefetch_range(*range_index);
+                            }
+                        }
+
+                        for (auto batch_offset = size_t{0};
+                             batch_offset < batch_size; ++batch_offset)
+                        {
+                            if (range_indices[batch_offset])
+                            {
+                                hash_table.prefetch_positions(
+                                    *range_indices[batch_offset]);
+                            }
+                        }
+
+                        for (auto batch_offset = size_t{0};
+                             batch_offset < batch_size; ++batch_offset)
+                        {
+                            const auto partition_offset =
+                                batch_begin + batch_offset;
+                            if (skip_probe_element(partition_offset))
+                            {
+                                continue;
+                            }
+
+                            const auto [matching_rows_begin,
+                                        matching_rows_end] =
+                                hash_table.range(range_indices[batch_offset]);
+                            emit_matches(partition_offset, matching_rows_begin,
+                                         matching_rows_end);
+                        }
+                    }
                 }
             }
             else
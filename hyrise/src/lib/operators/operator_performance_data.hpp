@@ -33,6 +33,10 @@ struct AbstractOperatorPerformanceData : public Noncopyable
     bool has_output{false};
     uint64_t output_row_count{0};
     uint64_t output_chunk_count{0};
+
+    // Maximum of the bytes the operator allocated from its memory arena at
+    // once (see AbstractOperator::memory_arena).
+    uint64_t peak_arena_bytes{0};
 };
 
 /**
@@ -442,7 +442,7 @@ std::shared_ptr<const Table> Sort::_on_execute()
 
                               auto sort_impl = SortImpl<ColumnDataType>(
                                   input_table, sort_definition.column,
-                                  sort_definition.sort_mode);
+                                  sort_definition.sort_mode, memory_arena());
                               previously_sorted_pos_list =
                                   sort_impl.sort(previously_sorted_pos_list);
 
@@ -560,10 +560,16 @@ template <typename SortColumnType> class Sort::SortImpl
     std::chrono::nanoseconds temporary_result_writing_time{};
     std::chrono::nanoseconds sort_time{};
 
+    // The materialized sort column is allocated from @param memory_resource,
+    // usually the operator's memory arena. The returned PosLists are not.
     SortImpl(const std::shared_ptr<const Table> &table_in,
              const ColumnID column_id,
-             const SortMode sort_mode = SortMode::Ascending)
-        : _table_in(table_in), _column_id(column_id), _sort_mode(sort_mode)
+             const SortMode sort_mode = SortMode::Ascending,
+             boost::container::pmr::memory_resource *memory_resource =
+                 boost::container::pmr::get_default_resource())
+        : _table_in(table_in), _column_id(column_id), _sort_mode(sort_mode),
+          _row_id_value_vector(memory_resource),
+          _null_value_rows(memory_resource)
     {
         const auto row_count = _table_in->row_count();
         _row_id_value_vector.reserve(row_count);
@@ -717,11 +723,11 @@ template <typename SortColumnType> class Sort::SortImpl
     const SortMode _sort_mode;
     // NOLINTEND(cppcoreguidelines-avoid-const-or-ref-data-members)
 
-    std::vector<RowIDValuePair> _row_id_value_vector;
+    pmr_vector<RowIDValuePair> _row_id_value_vector;
 
     // Stored as RowIDValuePair for better type compatibility even if value is
     // unused.
-    std::vector<RowIDValuePair> _null_value_rows;
+    pmr_vector<RowIDValuePair> _null_value_rows;
 };
 
 } // namespace hyrise
@@ -28,6 +28,7 @@
 #include "storage/abstract_segment.hpp"
 #include "storage/chunk.hpp"
 #include "storage/reference_segment.hpp"
+#include "storage/segment_encoding_utils.hpp"
 #include "storage/segment_iterate.hpp"
 #include "storage/table.hpp"
 #include "table_scan/column_between_table_scan_impl.hpp"
@@ -36,6 +37,7 @@
 #include "table_scan/column_vs_column_table_scan_impl.hpp"
 #include "table_scan/column_vs_value_table_scan_impl.hpp"
 #include "table_scan/expression_evaluator_table_scan_impl.hpp"
+#include "table_scan/shared_scan_cursor.hpp"
 #include "utils/assert.hpp"
 #include "utils/lossless_predicate_cast.hpp"
 #include "utils/performance_warning.hpp"
@@ -136,183 +138,284 @@ std::shared_ptr<const Table> TableScan::_on_execute()
     auto jobs = std::vector<std::shared_ptr<AbstractTask>>{};
     jobs.reserve(chunks_to_scan);
 
-    for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id)
+    // The columns read by the predicate determine the memory tier hint of the
+    // scan jobs (see FarMemoryBandwidthBudget).
+    auto predicate_column_ids = std::vector<ColumnID>{};
+    visit_expression(
+        predicate(),
+        [&](const auto &sub_expression)
+        {
+            if (const auto column_expression =
+                    std::dynamic_pointer_cast<PQPColumnExpression>(
+                        sub_expression))
+            {
+                predicate_column_ids.emplace_back(
+                    column_expression->column_id);
+            }
+            return ExpressionVisitation::VisitArguments;
+        });
+
+    auto scan_chunk = [this, &in_table, &output_mutex,
+                       &output_chunks](const ChunkID chunk_id)
     {
-        if (excluded_chunk_ids_iter != excluded_chunk_ids->cend() &&
-            chunk_id == *excluded_chunk_ids_iter)
+        const auto chunk_in = in_table->get_chunk(chunk_id);
+        // The actual scan happens in the sub classes of BaseTableScanImpl
+        const auto matches_out = _impl->scan_chunk(chunk_id);
+        if (matches_out->empty())
         {
-            ++excluded_chunk_ids_iter;
-            continue;
+            return;
         }
 
-        const auto &chunk_in = in_table->get_chunk(chunk_id);
-        Assert(chunk_in, "Physically deleted chunk should not reach this "
-                         "point, see get_chunk / #1686.");
-
-        // chunk_in – Copy by value since copy by reference is not possible due
-        // to the limited scope of the for-iteration.
-        auto perform_table_scan = [this, chunk_id, chunk_in, &in_table,
-                                   &output_mutex, &output_chunks]()
+        const auto column_count = in_table->column_count();
+        auto out_segments = Segments{};
+        out_segments.reserve(column_count);
+
+        /**
+         * matches_out contains a list of row IDs into this chunk. If this
+         * is not a reference table, we can directly use the matches to
+         * construct the reference segments of the output. If it is a
+         * reference segment, we need to resolve the row IDs so that they
+         * reference the physical data segments (value, dictionary) instead,
+         * since we don’t allow multi-level referencing. To save time and
+         * space, we want to share position lists between segments as much
+         * as possible. Position lists can be shared between two segments
+         * iff (a) they point to the same table and (b) the reference
+         * segments of the input table point to the same positions in the
+         * same order (i.e. they share their position list).
+         */
+        auto keep_chunk_sort_order = true;
+        if (in_table->type() == TableType::References)
         {
-            // The actual scan happens in the sub classes of BaseTableScanImpl
-            const auto matches_out = _impl->scan_chunk(chunk_id);
-            if (matches_out->empty())
+            if (matches_out->size() == chunk_in->size())
             {
-                return;
-            }
-
-            const auto column_count = in_table->column_count();
-            auto out_segments = Segments{};
-            out_segments.reserve(column_count);
-
-            /**
-             * matches_out contains a list of row IDs into this chunk. If this
-             * is not a reference table, we can directly use the matches to
-             * construct the reference segments of the output. If it is a
-             * reference segment, we need to resolve the row IDs so that they
-             * reference the physical data segments (value, dictionary) instead,
-             * since we don’t allow multi-level referencing. To save time and
-             * space, we want to share position lists between segments as much
-             * as possible. Position lists can be shared between two segments
-             * iff (a) they point to the same table and (b) the reference
-             * segments of the input table point to the same positions in the
-             * same order (i.e. they share their position list).
-             */
-            auto keep_chunk_sort_order = true;
-            if (in_table->type() == TableType::References)
-            {
-                if (matches_out->size() == chunk_in->size())
+                // Shortcut - the entire input reference segment matches, so
+                // we can simply forward that chunk
+                for (auto column_id = ColumnID{0}; column_id < column_count;
+                     ++column_id)
                 {
-                    // Shortcut - the entire input reference segment matches, so
-                    // we can simply forward that chunk
-                    for (auto column_id = ColumnID{0}; column_id < column_count;
-                         ++column_id)
-                    {
-                        const auto segment_in =
-                            chunk_in->get_segment(column_id);
-                        out_segments.emplace_back(segment_in);
-                    }
+                    const auto segment_in =
+                        chunk_in->get_segment(column_id);
+                    out_segments.emplace_back(segment_in);
                 }
-                else
-                {
-                    auto filtered_pos_lists =
-                        std::map<std::shared_ptr<const AbstractPosList>,
-                                 std::shared_ptr<RowIDPosList>>{};
+            }
+            else
+            {
+                auto filtered_pos_lists =
+                    std::map<std::shared_ptr<const AbstractPosList>,
+                             std::shared_ptr<RowIDPosList>>{};
 
-                    for (auto column_id = ColumnID{0}; column_id < column_count;
-                         ++column_id)
-                    {
-                        const auto segment_in =
-                            chunk_in->get_segment(column_id);
+                for (auto column_id = ColumnID{0}; column_id < column_count;
+                     ++column_id)
+                {
+                    const auto segment_in =
+                        chunk_in->get_segment(column_id);
 
-                        auto ref_segment_in =
-                            std::dynamic_pointer_cast<const ReferenceSegment>(
-                                segment_in);
-                        DebugAssert(
-                            ref_segment_in,
-                            "All segments should be of type ReferenceSegment.");
+                    auto ref_segment_in =
+                        std::dynamic_pointer_cast<const ReferenceSegment>(
+                            segment_in);
+                    DebugAssert(
+                        ref_segment_in,
+                        "All segments should be of type ReferenceSegment.");
 
-                        const auto pos_list_in = ref_segment_in->pos_list();
+                    const auto pos_list_in = ref_segment_in->pos_list();
 
-                        const auto table_out =
-                            ref_segment_in->referenced_table();
-                        const auto column_id_out =
-                            ref_segment_in->referenced_column_id();
+                    const auto table_out =
+                        ref_segment_in->referenced_table();
+                    const auto column_id_out =
+                        ref_segment_in->referenced_column_id();
 
-                        auto &filtered_pos_list =
-                            filtered_pos_lists[pos_list_in];
+                    auto &filtered_pos_list =
+                        filtered_pos_lists[pos_list_in];
 
-                        if (!filtered_pos_list)
+                    if (!filtered_pos_list)
+                    {
+                        filtered_pos_list = std::make_shared<RowIDPosList>(
+                            matches_out->size());
+                        if (pos_list_in->references_single_chunk())
                         {
-                            filtered_pos_list = std::make_shared<RowIDPosList>(
-                                matches_out->size());
-                            if (pos_list_in->references_single_chunk())
-                            {
-                                filtered_pos_list->guarantee_single_chunk();
-                            }
-                            else
-                            {
-                                // When segments reference multiple chunks, we
-                                // do not keep the sort order of the input
-                                // chunk. The main reason is that several table
-                                // scan implementations split the pos lists by
-                                // chunks (see
-                                // AbstractDereferencedColumnTableScanImpl::_scan_reference_segment)
-                                // and thus shuffle the data. While this does
-                                // not affect all scan implementations, we chose
-                                // the safe and defensive path for now.
-                                keep_chunk_sort_order = false;
-                            }
-
-                            auto offset = size_t{0};
-                            for (const auto &match : *matches_out)
-                            {
-                                const auto row_id =
-                                    (*pos_list_in)[match.chunk_offset];
-                                (*filtered_pos_list)[offset] = row_id;
-                                ++offset;
-                            }
+                            filtered_pos_list->guarantee_single_chunk();
+                        }
+                        else
+                        {
+                            // When segments reference multiple chunks, we
+                            // do not keep the sort order of the input
+                            // chunk. The main reason is that several table
+                            // scan implementations split the pos lists by
+                            // chunks (see
+                            // AbstractDereferencedColumnTableScanImpl::_scan_reference_segment)
+                            // and thus shuffle the data. While this does
+                            // not affect all scan implementations, we chose
+                            // the safe and defensive path for now.
+                            keep_chunk_sort_order = false;
                         }
 
-                        const auto ref_segment_out =
-                            std::make_shared<ReferenceSegment>(
-                                table_out, column_id_out, filtered_pos_list);
-                        out_segments.push_back(ref_segment_out);
+                        auto offset = size_t{0};
+                        for (const auto &match : *matches_out)
+                        {
+                            const auto row_id =
+                                (*pos_list_in)[match.chunk_offset];
+                            (*filtered_pos_list)[offset] = row_id;
+                            ++offset;
+                        }
                     }
-                }
-            }
-            else
-            {
-                matches_out->guarantee_single_chunk();
-
-                // If the entire chunk is matched, create an EntireChunkPosList
-                // instead
-                const auto output_pos_list =
-                    matches_out->size() == chunk_in->size()
-                        ? static_cast<std::shared_ptr<AbstractPosList>>(
-                              std::make_shared<EntireChunkPosList>(
-                                  chunk_id, chunk_in->size()))
-                        : static_cast<std::shared_ptr<AbstractPosList>>(
-                              matches_out);
 
-                for (auto column_id = ColumnID{0}; column_id < column_count;
-                     ++column_id)
-                {
                     const auto ref_segment_out =
-                        std::make_shared<ReferenceSegment>(in_table, column_id,
-                                                           output_pos_list);
+                        std::make_shared<ReferenceSegment>(
+                            table_out, column_id_out, filtered_pos_list);
                     out_segments.push_back(ref_segment_out);
                 }
             }
+        }
+        else
+        {
+            matches_out->guarantee_single_chunk();
+
+            // If the entire chunk is matched, create an EntireChunkPosList
+            // instead
+            const auto output_pos_list =
+                matches_out->size() == chunk_in->size()
+                    ? static_cast<std::shared_ptr<AbstractPosList>>(
+                          std::make_shared<EntireChunkPosList>(
+                              chunk_id, chunk_in->size()))
+                    : static_cast<std::shared_ptr<AbstractPosList>>(
+                          matches_out);
+
+            for (auto column_id = ColumnID{0}; column_id < column_count;
+                 ++column_id)
+            {
+                const auto ref_segment_out =
+                    std::make_shared<ReferenceSegment>(in_table, column_id,
+                                                       output_pos_list);
+                out_segments.push_back(ref_segment_out);
+            }
+        }
+
+        const auto chunk = std::make_shared<Chunk>(
+            out_segments, nullptr, chunk_in->get_allocator());
+        chunk->finalize();
+        if (keep_chunk_sort_order &&
+            !chunk_in->individually_sorted_by().empty())
+        {
+            chunk->set_individually_sorted_by(
+                chunk_in->individually_sorted_by());
+        }
+        const auto lock = std::lock_guard<std::mutex>{output_mutex};
+        output_chunks.emplace_back(chunk);
+    };
+
+    // Spawn job when chunk sufficiently large. The upper bound of the chunk
+    // size, still needs to be re-evaluated over time to find the value which
+    // gives the best performance.
+    constexpr auto JOB_SPAWN_THRESHOLD = ChunkOffset{500};
+
+    if (Hyrise::get().shared_scans.is_enabled() &&
+        in_table->type() == TableType::Data)
+    {
+        // Concurrent scans of this table visit the chunks together, see
+        // SharedScanCursor. Every chunk job drives the cursor until this scan
+        // has been handed all of its chunks.
+        auto chunk_ids = std::vector<ChunkID>{};
+        chunk_ids.reserve(chunks_to_scan);
+        auto job_chunk_count = size_t{0};
+        auto memory_tier = MemoryTier::Near;
+        for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id)
+        {
+            if (excluded_chunk_ids_iter != excluded_chunk_ids->cend() &&
+                chunk_id == *excluded_chunk_ids_iter)
+            {
+                ++excluded_chunk_ids_iter;
+                continue;
+            }
 
-            const auto chunk = std::make_shared<Chunk>(
-                out_segments, nullptr, chunk_in->get_allocator());
-            chunk->finalize();
-            if (keep_chunk_sort_order &&
-                !chunk_in->individually_sorted_by().empty())
+            const auto &chunk_in = in_table->get_chunk(chunk_id);
+            Assert(chunk_in, "Physically deleted chunk should not reach "
+                             "this point, see get_chunk / #1686.");
+            chunk_ids.push_back(chunk_id);
+            if (chunk_in->size() >= JOB_SPAWN_THRESHOLD)
+            {
+                ++job_chunk_count;
+            }
+            for (const auto column_id : predicate_column_ids)
             {
-                chunk->set_individually_sorted_by(
-                    chunk_in->individually_sorted_by());
+                if (get_segment_memory_tier(*chunk_in->get_segment(
+                        column_id)) == MemoryTier::Far)
+                {
+                    memory_tier = MemoryTier::Far;
+                }
             }
-            const auto lock = std::lock_guard<std::mutex>{output_mutex};
-            output_chunks.emplace_back(chunk);
-        };
-        // Spawn job when chunk sufficiently large. The upper bound of the chunk
-        // size, still needs to be re-evaluated over time to find the value
-        // which gives the best performance.
-        constexpr auto JOB_SPAWN_THRESHOLD = ChunkOffset{500};
-        if (chunk_in->size() >= JOB_SPAWN_THRESHOLD)
+        }
+
+        const auto cursor = Hyrise::get().shared_scans.get_cursor(in_table);
+        const auto scan_id = cursor->attach(chunk_ids, scan_chunk);
+        const auto cpu_count =
+            static_cast<size_t>(Hyrise::get().topology.num_cpus());
+        // As in the unshared path, only chunks above JOB_SPAWN_THRESHOLD are
+        // worth a job. If there are none, this thread drives the cursor.
+        const auto job_count = std::min(job_chunk_count, cpu_count);
+        for (auto job_id = size_t{0}; job_id < job_count; ++job_id)
         {
-            auto job_task = std::make_shared<JobTask>(perform_table_scan);
+            auto job_task = std::make_shared<JobTask>(
+                [&cursor, scan_id]()
+                {
+                    while (cursor->process_next_chunk(scan_id))
+                    {
+                    }
+                });
+            job_task->set_memory_tier(memory_tier);
             jobs.push_back(job_task);
         }
-        else
+        if (jobs.empty())
         {
-            perform_table_scan();
+            while (cursor->process_next_chunk(scan_id))
+            {
+            }
         }
+        Hyrise::get().scheduler()->schedule_and_wait_for_tasks(jobs);
+
+        const auto statistics = cursor->detach(scan_id);
+        auto &scan_performance_data =
+            dynamic_cast<PerformanceData &>(*performance_data);
+        scan_performance_data.num_chunks_shared = statistics.shared_chunk_count;
     }
+    else
+    {
+        for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id)
+        {
+            if (excluded_chunk_ids_iter != excluded_chunk_ids->cend() &&
+                chunk_id == *excluded_chunk_ids_iter)
+            {
+                ++excluded_chunk_ids_iter;
+                continue;
+            }
+
+            const auto &chunk_in = in_table->get_chunk(chunk_id);
+            Assert(chunk_in, "Physically deleted chunk should not reach "
+                             "this point, see get_chunk / #1686.");
 
-    Hyrise::get().scheduler()->schedule_and_wait_for_tasks(jobs);
+            auto perform_table_scan = [&scan_chunk, chunk_id]()
+            { scan_chunk(chunk_id); };
+            if (chunk_in->size() >= JOB_SPAWN_THRESHOLD)
+            {
+                auto job_task = std::make_shared<JobTask>(perform_table_scan);
+                for (const auto column_id : predicate_column_ids)
+                {
+                    if (get_segment_memory_tier(*chunk_in->get_segment(
+                            column_id)) == MemoryTier::Far)
+                    {
+                        job_task->set_memory_tier(MemoryTier::Far);
+                        break;
+                    }
+                }
+                jobs.push_back(job_task);
+            }
+            else
+            {
+                perform_table_scan();
+            }
+        }
+
+        Hyrise::get().scheduler()->schedule_and_wait_for_tasks(jobs);
+    }
 
     auto &scan_performance_data =
         dynamic_cast<PerformanceData &>(*performance_data);
@@ -60,6 +60,8 @@ class TableScan : public AbstractReadOnlyOperator
         std::atomic_size_t num_chunks_with_early_out{0};
         std::atomic_size_t num_chunks_with_all_rows_matching{0};
         std::atomic_size_t num_chunks_with_binary_search{0};
+        // Chunks read together with concurrent scans (see SharedScanCursor).
+        std::atomic_size_t num_chunks_shared{0};
 
         void output_to_stream(std::ostream &stream,
                               DescriptionMode description_mode) const override
@@ -76,6 +78,11 @@ class TableScan : public AbstractReadOnlyOperator
                    << " skipped with all matching, ";
             stream << num_chunks_with_binary_search.load()
                    << " scanned using binary search.";
+            if (num_chunks_shared.load() > 0)
+            {
+                stream << separator << num_chunks_shared.load()
+                       << " shared with concurrent scans.";
+            }
         }
     };
 
@@ -0,0 +1,169 @@
+#include "shared_scan_cursor.hpp"
+
+#include <algorithm>
+#include <vector>
+
+#include "utils/assert.hpp"
+
+namespace hyrise
+{
+
+SharedScanCursor::ScanID
+SharedScanCursor::attach(const std::vector<ChunkID> &chunk_ids,
+                         const ChunkVisitor &visitor)
+{
+    const auto lock = std::lock_guard<std::mutex>{_mutex};
+    const auto scan_id = _next_scan_id++;
+    auto &scan = _scans[scan_id];
+    scan.visitor = visitor;
+
+    for (const auto chunk_id : chunk_ids)
+    {
+        if (chunk_id >= scan.pending_chunks.size())
+        {
+            scan.pending_chunks.resize(chunk_id + 1, false);
+        }
+        if (!scan.pending_chunks[chunk_id])
+        {
+            scan.pending_chunks[chunk_id] = true;
+            ++scan.pending_chunk_count;
+        }
+    }
+
+    // Tables only grow, so a later scan may know of more chunks.
+    _chunk_count = std::max(_chunk_count,
+                            static_cast<ChunkID>(scan.pending_chunks.size()));
+    return scan_id;
+}
+
+bool SharedScanCursor::process_next_chunk(const ScanID scan_id)
+{
+    auto lock = std::unique_lock<std::mutex>{_mutex};
+    DebugAssert(_scans.contains(scan_id), "Scan is not attached.");
+    if (_scans[scan_id].pending_chunk_count == 0)
+    {
+        return false;
+    }
+
+    // Skip the chunks no scan needs. The pending chunks of scan_id guarantee
+    // that this ends within one pass.
+    auto chunk_id = ChunkID{0};
+    auto consumers = std::vector<AttachedScan *>{};
+    while (consumers.empty())
+    {
+        chunk_id = _position;
+        _position = static_cast<ChunkID>((_position + 1) % _chunk_count);
+        for (auto &[_, scan] : _scans)
+        {
+            if (chunk_id < scan.pending_chunks.size() &&
+                scan.pending_chunks[chunk_id])
+            {
+                scan.pending_chunks[chunk_id] = false;
+                --scan.pending_chunk_count;
+                ++scan.running_visitor_count;
+                consumers.emplace_back(&scan);
+            }
+        }
+    }
+    ++_read_chunk_count;
+    _visited_chunk_count += consumers.size();
+
+    // Scans are only removed once none of their visitors runs, so the
+    // consumers stay valid without the lock.
+    lock.unlock();
+    for (auto *const consumer : consumers)
+    {
+        consumer->visitor(chunk_id);
+    }
+    lock.lock();
+
+    for (auto *const consumer : consumers)
+    {
+        --consumer->running_visitor_count;
+        ++consumer->statistics.visited_chunk_count;
+        if (consumers.size() > 1)
+        {
+            ++consumer->statistics.shared_chunk_count;
+        }
+    }
+    _visitor_done.notify_all();
+    return true;
+}
+
+SharedScanStatistics SharedScanCursor::detach(const ScanID scan_id)
+{
+    auto lock = std::unique_lock<std::mutex>{_mutex};
+    const auto scan_iter = _scans.find(scan_id);
+    Assert(scan_iter != _scans.end(), "Scan is not attached.");
+    Assert(scan_iter->second.pending_chunk_count == 0,
+           "Detaching a scan that has chunks left.");
+    _visitor_done.wait(lock, [&]
+                       { return scan_iter->second.running_visitor_count == 0; });
+
+    const auto statistics = scan_iter->second.statistics;
+    _scans.erase(scan_iter);
+    return statistics;
+}
+
+size_t SharedScanCursor::attached_scan_count() const
+{
+    const auto lock = std::lock_guard<std::mutex>{_mutex};
+    return _scans.size();
+}
+
+ChunkID SharedScanCursor::position() const
+{
+    const auto lock = std::lock_guard<std::mutex>{_mutex};
+    return _position;
+}
+
+size_t SharedScanCursor::read_chunk_count() const
+{
+    const auto lock = std::lock_guard<std::mutex>{_mutex};
+    return _read_chunk_count;
+}
+
+size_t SharedScanCursor::visited_chunk_count() const
+{
+    const auto lock = std::lock_guard<std::mutex>{_mutex};
+    return _visited_chunk_count;
+}
+
+SharedScanRegistry &
+SharedScanRegistry::operator=(SharedScanRegistry &&other) noexcept
+{
+    _enabled = other._enabled.load();
+    const auto lock = std::lock_guard<std::mutex>{_mutex};
+    _cursors.clear();
+    return *this;
+}
+
+void SharedScanRegistry::set_enabled(const bool enabled)
+{
+    _enabled = enabled;
+}
+
+bool SharedScanRegistry::is_enabled() const
+{
+    return _enabled;
+}
+
+std::shared_ptr<SharedScanCursor>
+SharedScanRegistry::get_cursor(const std::shared_ptr<const Table> &table)
+{
+    const auto lock = std::lock_guard<std::mutex>{_mutex};
+    auto &cursor = _cursors[table.get()];
+    if (auto existing_cursor = cursor.lock())
+    {
+        return existing_cursor;
+    }
+
+    // Drop the entries of finished scans before adding a new one.
+    std::erase_if(_cursors, [](const auto &entry)
+                  { return entry.second.expired(); });
+    auto new_cursor = std::make_shared<SharedScanCursor>();
+    _cursors[table.get()] = new_cursor;
+    return new_cursor;
+}
+
+} // namespace hyrise
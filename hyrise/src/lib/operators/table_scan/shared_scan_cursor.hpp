@@ -0,0 +1,117 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "types.hpp"
+
+namespace hyrise
+{
+
+class Table;
+
+// Chunks of a shared scan and how many of them were read together with other
+// scans.
+struct SharedScanStatistics
+{
+    size_t visited_chunk_count{0};
+    size_t shared_chunk_count{0};
+};
+
+/**
+ * Chunk-ordered cursor for cooperative scans of one table. Concurrent scans of
+ * the table attach to it with a visitor that evaluates their predicate on a
+ * chunk. The jobs of any attached scan drive the cursor: each takes the next
+ * chunk in chunk order and runs the visitors of all attached scans that still
+ * need that chunk. Each visitor still reads the chunk's segments itself, so the
+ * bytes read are not reduced. What the scans share is the cursor and the time
+ * at which they visit a chunk: the visitors after the first find its segments
+ * in the CPU caches (or, for buffer-managed pages, in the near tier) instead
+ * of fetching them from the far tier again in a separate pass.
+ *
+ * A scan that attaches while a pass is in progress starts at the current
+ * position and wraps around to the chunks it has missed.
+ */
+class SharedScanCursor : public Noncopyable
+{
+  public:
+    using ScanID = size_t;
+    using ChunkVisitor = std::function<void(const ChunkID)>;
+
+    // Attaches a scan that needs the chunks @param chunk_ids (in any order).
+    // @param visitor may be called concurrently from the jobs of all scans.
+    ScanID attach(const std::vector<ChunkID> &chunk_ids,
+                  const ChunkVisitor &visitor);
+
+    // Hands out the next chunk any attached scan needs and runs the visitors
+    // of all scans that need it. Returns false once all chunks of
+    // @param scan_id have been handed out, its jobs can then stop.
+    bool process_next_chunk(const ScanID scan_id);
+
+    // Waits until the visitor of @param scan_id has run for all of its chunks,
+    // including those other scans' jobs are still processing, and removes it.
+    SharedScanStatistics detach(const ScanID scan_id);
+
+    size_t attached_scan_count() const;
+    ChunkID position() const;
+
+    // Chunks handed out and visitor calls so far. Their ratio is the number of
+    // scans that visit a chunk together on average.
+    size_t read_chunk_count() const;
+    size_t visited_chunk_count() const;
+
+  private:
+    struct AttachedScan
+    {
+        ChunkVisitor visitor;
+        std::vector<bool> pending_chunks;
+        size_t pending_chunk_count{0};
+        size_t running_visitor_count{0};
+        SharedScanStatistics statistics;
+    };
+
+    // std::map, so that scans keep their address while others attach.
+    std::map<ScanID, AttachedScan> _scans;
+    ScanID _next_scan_id{0};
+    ChunkID _position{0};
+    ChunkID _chunk_count{0};
+    size_t _read_chunk_count{0};
+    size_t _visited_chunk_count{0};
+    mutable std::mutex _mutex;
+    std::condition_variable _visitor_done;
+};
+
+/**
+ * Hands out the SharedScanCursor of a table to the TableScans that run on it at
+ * the same time. A cursor lives as long as scans use it, the next scan of the
+ * table after that starts a new one. Disabled by default.
+ */
+class SharedScanRegistry : public Noncopyable
+{
+  public:
+    SharedScanRegistry() = default;
+
+    // Needed by Hyrise::reset. Cursors are not moved, scans still running at
+    // that point keep theirs.
+    SharedScanRegistry &operator=(SharedScanRegistry &&other) noexcept;
+
+    void set_enabled(const bool enabled);
+    bool is_enabled() const;
+
+    std::shared_ptr<SharedScanCursor>
+    get_cursor(const std::shared_ptr<const Table> &table);
+
+  private:
+    std::atomic<bool> _enabled{false};
+    std::unordered_map<const Table *, std::weak_ptr<SharedScanCursor>> _cursors;
+    std::mutex _mutex;
+};
+
+} // namespace hyrise
@@ -98,6 +98,17 @@ bool AbstractTask::try_mark_as_assigned_to_worker()
     return _try_transition_to(TaskState::AssignedToWorker);
 }
 
+void AbstractTask::set_memory_tier(MemoryTier memory_tier)
+{
+    DebugAssert(!is_scheduled(),
+                "Possible race: Don't set memory tier after the Task was "
+                "scheduled");
+
+    _memory_tier = memory_tier;
+}
+
+MemoryTier AbstractTask::memory_tier() const { return _memory_tier; }
+
 void AbstractTask::set_done_callback(const std::function<void()> &done_callback)
 {
     DebugAssert(
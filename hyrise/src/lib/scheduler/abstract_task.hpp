@@ -7,6 +7,7 @@
 #include <mutex>
 #include <shared_mutex>
 
+#include "memory/tiered_memory_resource.hpp"
 #include "types.hpp"
 
 namespace hyrise
@@ -171,6 +172,15 @@ class AbstractTask : public std::enable_shared_from_this<AbstractTask>
      */
     void set_node_id(NodeID node_id);
 
+    /**
+     * Hint of the memory tier that the task mostly reads from (e.g., the tier
+     * of the segments scanned by a JobTask). The NodeQueueScheduler limits the
+     * number of concurrently running far-memory tasks (see
+     * FarMemoryBandwidthBudget). Must be set before the task is scheduled.
+     */
+    void set_memory_tier(MemoryTier memory_tier);
+    MemoryTier memory_tier() const;
+
     /**
      * Callback to be executed right after the task finished. Notice the
      * execution of the callback might happen on ANY thread.
@@ -236,6 +246,7 @@ class AbstractTask : public std::enable_shared_from_this<AbstractTask>
     std::atomic<NodeID> _node_id{INVALID_NODE_ID};
     SchedulePriority _priority;
     std::atomic_bool _stealable;
+    MemoryTier _memory_tier{MemoryTier::Near};
     std::function<void()> _done_callback;
 
     // For dependencies.
@@ -0,0 +1,56 @@
+#include "far_memory_bandwidth_budget.hpp"
+
+#include <algorithm>
+
+#include "utils/assert.hpp"
+
+namespace hyrise
+{
+
+void FarMemoryBandwidthBudget::configure(const size_t link_bandwidth,
+                                         const size_t task_bandwidth)
+{
+    if (link_bandwidth == 0)
+    {
+        _max_task_count = 0;
+        return;
+    }
+
+    Assert(task_bandwidth > 0, "Bandwidth per task must be positive.");
+    // Round up, so that the link is saturated, and allow at least one task.
+    _max_task_count = std::max(
+        size_t{1}, (link_bandwidth + task_bandwidth - 1) / task_bandwidth);
+}
+
+size_t FarMemoryBandwidthBudget::max_task_count() const
+{
+    return _max_task_count;
+}
+
+size_t FarMemoryBandwidthBudget::active_task_count() const
+{
+    return _active_task_count;
+}
+
+bool FarMemoryBandwidthBudget::try_acquire()
+{
+    const auto max_task_count = _max_task_count.load();
+    auto active_task_count = _active_task_count.load();
+    do
+    {
+        if (max_task_count != 0 && active_task_count >= max_task_count)
+        {
+            return false;
+        }
+    } while (!_active_task_count.compare_exchange_weak(active_task_count,
+                                                       active_task_count + 1));
+    return true;
+}
+
+void FarMemoryBandwidthBudget::release()
+{
+    [[maybe_unused]] const auto previous_count = _active_task_count--;
+    DebugAssert(previous_count > 0, "Released more slots than acquired.");
+}
+
+} // namespace hyrise
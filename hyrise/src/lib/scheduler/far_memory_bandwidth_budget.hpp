@@ -0,0 +1,44 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+#include "types.hpp"
+
+namespace hyrise
+{
+
+/**
+ * Far memory (e.g., CXL memory) offers a fraction of the local DRAM bandwidth.
+ * A few workers that stream far-memory segments already saturate the link, so
+ * running more of them does not make them faster. Instead, every far access -
+ * including those of other queries - waits longer. The budget thus caps the
+ * number of tasks with a far memory tier hint (see
+ * AbstractTask::set_memory_tier()) that run at the same time. Surplus far
+ * tasks stay queued while the workers process near-memory tasks.
+ *
+ * The cap is derived from the link bandwidth and the bandwidth a single task
+ * draws when scanning far memory. A link bandwidth of zero disables the cap.
+ */
+class FarMemoryBandwidthBudget : private Noncopyable
+{
+  public:
+    void configure(const size_t link_bandwidth, const size_t task_bandwidth);
+
+    // Maximum number of concurrent far-memory tasks, 0 if unlimited.
+    size_t max_task_count() const;
+
+    size_t active_task_count() const;
+
+    // Reserves a slot for a far-memory task. Returns false if the budget is
+    // exhausted.
+    bool try_acquire();
+
+    void release();
+
+  private:
+    std::atomic<size_t> _max_task_count{0};
+    std::atomic<size_t> _active_task_count{0};
+};
+
+} // namespace hyrise
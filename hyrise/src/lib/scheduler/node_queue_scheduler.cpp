@@ -12,6 +12,7 @@
 #include <vector>
 
 #include "abstract_task.hpp"
+#include "far_memory_bandwidth_budget.hpp"
 #include "hyrise.hpp"
 #include "job_task.hpp"
 #include "shutdown_task.hpp"
@@ -27,6 +28,7 @@ namespace hyrise
 NodeQueueScheduler::NodeQueueScheduler()
 {
     _worker_id_allocator = std::make_shared<UidAllocator>();
+    _far_memory_budget = std::make_shared<FarMemoryBandwidthBudget>();
 }
 
 NodeQueueScheduler::~NodeQueueScheduler()
@@ -68,7 +70,8 @@ void NodeQueueScheduler::begin()
         if (!topology_node.cpus.empty())
         {
             _active_nodes.push_back(node_id);
-            auto queue = std::make_shared<TaskQueue>(node_id);
+            auto queue =
+                std::make_shared<TaskQueue>(node_id, _far_memory_budget);
             _queues[node_id] = queue;
 
             for (const auto &topology_cpu : topology_node.cpus)
@@ -393,4 +396,9 @@ const std::atomic_int64_t &NodeQueueScheduler::active_worker_count() const
     return _active_worker_count;
 }
 
+FarMemoryBandwidthBudget &NodeQueueScheduler::far_memory_budget() const
+{
+    return *_far_memory_budget;
+}
+
 } // namespace hyrise
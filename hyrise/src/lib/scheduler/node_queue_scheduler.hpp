@@ -46,8 +46,18 @@ namespace hyrise
  *  [1]
  * http://frankdenneman.nl/2016/07/13/numa-deep-dive-4-local-memory-optimization/
  *
+ *
+ * FAR MEMORY
+ *
+ * Tasks can be marked as reading mostly from the far memory tier (see
+ * AbstractTask::set_memory_tier()). Their concurrency is capped by the
+ * scheduler's FarMemoryBandwidthBudget, which is shared by all TaskQueues. As
+ * long as the budget is exhausted, workers process near-memory tasks and the
+ * far-memory tasks remain queued. By default, the budget is not limited.
+ *
  */
 
+class FarMemoryBandwidthBudget;
 class Worker;
 class TaskQueue;
 class UidAllocator;
@@ -99,6 +109,13 @@ class NodeQueueScheduler : public AbstractScheduler
 
     const std::atomic_int64_t &active_worker_count() const;
 
+    /**
+     * Budget for concurrently running far-memory tasks. Can be configured at
+     * any time, e.g., via
+     * far_memory_budget().configure(link_bandwidth, task_bandwidth).
+     */
+    FarMemoryBandwidthBudget &far_memory_budget() const;
+
     // Number of groups for _group_tasks
     static constexpr auto NUM_GROUPS = 10;
 
@@ -111,6 +128,7 @@ class NodeQueueScheduler : public AbstractScheduler
     std::shared_ptr<UidAllocator> _worker_id_allocator;
     std::vector<std::shared_ptr<TaskQueue>> _queues;
     std::vector<std::shared_ptr<Worker>> _workers;
+    std::shared_ptr<FarMemoryBandwidthBudget> _far_memory_budget;
     std::vector<NodeID> _active_nodes;
 
     std::atomic_bool _active{false};
@@ -4,12 +4,18 @@
 #include <utility>
 
 #include "abstract_task.hpp"
+#include "far_memory_bandwidth_budget.hpp"
 #include "utils/assert.hpp"
 
 namespace hyrise
 {
 
-TaskQueue::TaskQueue(NodeID node_id) : _node_id(node_id) {}
+TaskQueue::TaskQueue(
+    NodeID node_id,
+    const std::shared_ptr<FarMemoryBandwidthBudget> &far_memory_budget)
+    : _node_id(node_id), _far_memory_budget(far_memory_budget)
+{
+}
 
 bool TaskQueue::empty() const
 {
@@ -20,7 +26,7 @@ bool TaskQueue::empty() const
             return false;
         }
     }
-    return true;
+    return _far_memory_queue.size_approx() == size_t{0};
 }
 
 NodeID TaskQueue::node_id() const { return _node_id; }
@@ -38,8 +44,11 @@ void TaskQueue::push(const std::shared_ptr<AbstractTask> &task,
     }
 
     task->set_node_id(_node_id);
-    [[maybe_unused]] const auto enqueue_successful =
-        _queues[priority_uint].enqueue(task);
+    // Far-memory tasks are queued separately, regardless of their priority.
+    auto &queue = task->memory_tier() == MemoryTier::Far
+                      ? _far_memory_queue
+                      : _queues[priority_uint];
+    [[maybe_unused]] const auto enqueue_successful = queue.enqueue(task);
     DebugAssert(enqueue_successful, "Enqueuing did not succeed.");
     semaphore.signal();
 }
@@ -55,9 +64,20 @@ std::shared_ptr<AbstractTask> TaskQueue::pull()
         }
     }
 
+    auto budget_exhausted = false;
+    task = _pull_far_memory_task(false, budget_exhausted);
+    if (task)
+    {
+        return task;
+    }
+
     // We waited for the semaphore to enter pull() but did not receive a task.
-    // Ensure that queues are checked again.
-    semaphore.signal();
+    // Ensure that queues are checked again. If the remaining tasks wait for
+    // the far memory budget, the worker that frees a slot signals instead.
+    if (!budget_exhausted)
+    {
+        semaphore.signal();
+    }
     return nullptr;
 }
 
@@ -81,9 +101,19 @@ std::shared_ptr<AbstractTask> TaskQueue::steal()
         }
     }
 
+    auto budget_exhausted = false;
+    task = _pull_far_memory_task(true, budget_exhausted);
+    if (task)
+    {
+        return task;
+    }
+
     // We waited for the semaphore to enter steal() but did not receive a task.
     // Ensure that queues are checked again.
-    semaphore.signal();
+    if (!budget_exhausted)
+    {
+        semaphore.signal();
+    }
     return nullptr;
 }
 
@@ -102,9 +132,71 @@ size_t TaskQueue::estimate_load() const
                           (size_t{1} << (NUM_PRIORITY_LEVELS - 1 - queue_id));
     }
 
+    // Far-memory tasks are weighted like tasks of the default priority.
+    estimated_load += _far_memory_queue.size_approx();
+
     return estimated_load;
 }
 
+bool TaskQueue::has_far_memory_tasks() const
+{
+    return _far_memory_queue.size_approx() > size_t{0};
+}
+
+bool TaskQueue::try_acquire_far_memory_slot(const AbstractTask &task)
+{
+    if (task.memory_tier() != MemoryTier::Far || !_far_memory_budget)
+    {
+        return true;
+    }
+    return _far_memory_budget->try_acquire();
+}
+
+void TaskQueue::release_far_memory_slot(const AbstractTask &task)
+{
+    if (task.memory_tier() != MemoryTier::Far || !_far_memory_budget)
+    {
+        return;
+    }
+    _far_memory_budget->release();
+}
+
 void TaskQueue::signal(const size_t count) { semaphore.signal(count); }
 
+std::shared_ptr<AbstractTask>
+TaskQueue::_pull_far_memory_task(const bool steal, bool &budget_exhausted)
+{
+    if (!has_far_memory_tasks())
+    {
+        return nullptr;
+    }
+
+    if (_far_memory_budget && !_far_memory_budget->try_acquire())
+    {
+        budget_exhausted = true;
+        return nullptr;
+    }
+
+    auto task = std::shared_ptr<AbstractTask>{};
+    if (_far_memory_queue.try_dequeue(task))
+    {
+        if (!steal || task->is_stealable())
+        {
+            return task;
+        }
+
+        [[maybe_unused]] const auto enqueue_successful =
+            _far_memory_queue.enqueue(task);
+        DebugAssert(enqueue_successful,
+                    "Enqueuing stolen task did not succeed.");
+        semaphore.signal();
+    }
+
+    if (_far_memory_budget)
+    {
+        _far_memory_budget->release();
+    }
+    return nullptr;
+}
+
 } // namespace hyrise
@@ -15,16 +15,24 @@ namespace hyrise
 {
 
 class AbstractTask;
+class FarMemoryBandwidthBudget;
 
 /**
- * Holds a queue of AbstractTasks, usually one of these exists per node
+ * Holds a queue of AbstractTasks, usually one of these exists per node.
+ *
+ * Tasks with a far memory tier hint are kept in a separate queue that is only
+ * pulled from when the (optional) FarMemoryBandwidthBudget has a free slot.
+ * Thus, near-memory tasks are preferred. A worker that pulls a far-memory task
+ * holds a slot of the budget until the task is done.
  */
 class TaskQueue
 {
   public:
     static constexpr uint32_t NUM_PRIORITY_LEVELS = 2;
 
-    explicit TaskQueue(NodeID node_id);
+    explicit TaskQueue(NodeID node_id,
+                       const std::shared_ptr<FarMemoryBandwidthBudget>
+                           &far_memory_budget = nullptr);
 
     bool empty() const;
 
@@ -55,6 +63,20 @@ class TaskQueue
      */
     size_t estimate_load() const;
 
+    /**
+     * Returns true if far-memory tasks are waiting for the budget.
+     */
+    bool has_far_memory_tasks() const;
+
+    /**
+     * Far-memory tasks that are pulled from the queue hold a slot of the
+     * budget. Workers that execute far-memory tasks without pulling them
+     * acquire the slot themselves. Both calls have no effect for near-memory
+     * tasks and if no budget is set.
+     */
+    bool try_acquire_far_memory_slot(const AbstractTask &task);
+    void release_far_memory_slot(const AbstractTask &task);
+
     void signal(const size_t count);
 
     /**
@@ -67,6 +89,14 @@ class TaskQueue
     std::array<moodycamel::ConcurrentQueue<std::shared_ptr<AbstractTask>>,
                NUM_PRIORITY_LEVELS>
         _queues;
+    moodycamel::ConcurrentQueue<std::shared_ptr<AbstractTask>>
+        _far_memory_queue;
+    std::shared_ptr<FarMemoryBandwidthBudget> _far_memory_budget;
+
+    // Returns a far-memory task if the budget has a free slot. Sets
+    // @param budget_exhausted if tasks are waiting for the budget.
+    std::shared_ptr<AbstractTask> _pull_far_memory_task(const bool steal,
+                                                        bool &budget_exhausted);
 };
 
 } // namespace hyrise
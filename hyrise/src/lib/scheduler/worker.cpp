@@ -124,15 +124,19 @@ void Worker::_work(const AllowSleep allow_sleep)
         return;
     }
 
+    // Far-memory tasks pulled from a queue hold a slot of the far memory
+    // budget (see TaskQueue). Tasks passed via execute_next are never
+    // far-memory tasks.
     const auto successfully_assigned = task->try_mark_as_assigned_to_worker();
     if (!successfully_assigned)
     {
         // Some other worker has already started to work on this task - pick a
         // different one.
+        _release_far_memory_slot(*task);
         return;
     }
 
-    task->execute();
+    _execute(*task, true);
 
     // In case the processed task is a ShutdownTask, we shut down the worker
     // (see `operator()` loop).
@@ -152,7 +156,9 @@ void Worker::execute_next(const std::shared_ptr<AbstractTask> &task)
     DebugAssert(&*get_this_thread_worker() == this,
                 "execute_next must be called from the same thread that the "
                 "worker works in.");
-    if (!_next_task)
+    // Far-memory tasks have to wait for the far memory budget and are thus
+    // always queued.
+    if (!_next_task && task->memory_tier() != MemoryTier::Far)
     {
         const auto successfully_enqueued = task->try_mark_as_enqueued();
         if (!successfully_enqueued)
@@ -242,6 +248,21 @@ void Worker::_wait_for_tasks(
                 return false;
             }
 
+            // Far-memory tasks need a slot of the far memory budget. If this
+            // worker already executes a far-memory task that waits for its
+            // subtasks, the subtasks do not add to the number of concurrent
+            // far-memory tasks. Acquiring a slot for them could deadlock.
+            const auto needs_far_memory_slot =
+                task->memory_tier() == MemoryTier::Far &&
+                _far_memory_task_depth == 0;
+            if (needs_far_memory_slot &&
+                !_queue->try_acquire_far_memory_slot(*task))
+            {
+                all_done = false;
+                ++it;
+                continue;
+            }
+
             // Run one of our own tasks. First, let everyone know that we are
             // about to execute it. This is necessary because the task might
             // already be in a queue and some other worker might pull it at the
@@ -252,13 +273,17 @@ void Worker::_wait_for_tasks(
             {
                 // Some other worker has already started to work on this task -
                 // pick a different one.
+                if (needs_far_memory_slot)
+                {
+                    _release_far_memory_slot(*task);
+                }
                 all_done = false;
                 ++it;
                 continue;
             }
 
             // Actually execute it.
-            task->execute();
+            _execute(*task, needs_far_memory_slot);
             ++_num_finished_tasks;
 
             // Reset loop so that we re-visit tasks that may have finished in
@@ -281,6 +306,54 @@ void Worker::_wait_for_tasks(
     }
 }
 
+void Worker::_execute(AbstractTask &task, const bool holds_far_memory_slot)
+{
+    const auto far_memory_task = task.memory_tier() == MemoryTier::Far;
+    if (far_memory_task)
+    {
+        ++_far_memory_task_depth;
+    }
+
+    task.execute();
+
+    if (far_memory_task)
+    {
+        --_far_memory_task_depth;
+        if (holds_far_memory_slot)
+        {
+            _release_far_memory_slot(task);
+        }
+    }
+}
+
+void Worker::_release_far_memory_slot(const AbstractTask &task)
+{
+    if (task.memory_tier() != MemoryTier::Far)
+    {
+        return;
+    }
+
+    _queue->release_far_memory_slot(task);
+
+    // Queues do not signal for far-memory tasks that wait for the budget (see
+    // TaskQueue::pull). Wake one worker, preferably of this node, to pick them
+    // up now that a slot is free.
+    if (_queue->has_far_memory_tasks())
+    {
+        _queue->signal(1);
+        return;
+    }
+
+    for (const auto &queue : Hyrise::get().scheduler()->queues())
+    {
+        if (queue && queue->has_far_memory_tasks())
+        {
+            queue->signal(1);
+            return;
+        }
+    }
+}
+
 void Worker::_set_affinity()
 {
 #if HYRISE_NUMA_SUPPORT
@@ -71,6 +71,14 @@ class Worker : public std::enable_shared_from_this<Worker>, private Noncopyable
     void
     _wait_for_tasks(const std::vector<std::shared_ptr<AbstractTask>> &tasks);
 
+    // Executes the task. If it holds a slot of the far memory budget, the slot
+    // is released afterwards.
+    void _execute(AbstractTask &task, const bool holds_far_memory_slot);
+
+    // Releases the task's far memory slot and wakes a worker to pull one of the
+    // far-memory tasks that wait for the budget.
+    void _release_far_memory_slot(const AbstractTask &task);
+
   private:
     /**
      * Pin a worker to a particular core.
@@ -88,6 +96,10 @@ class Worker : public std::enable_shared_from_this<Worker>, private Noncopyable
 
     bool _active{true};
 
+    // Number of far-memory tasks that this worker is executing (i.e., nested
+    // through _wait_for_tasks).
+    size_t _far_memory_task_depth{0};
+
     std::vector<int> _random{};
     size_t _next_random{0};
 };
@@ -10,6 +10,7 @@
 #include "hyrise.hpp"
 #include "sql_plan_cache.hpp"
 #include "utils/assert.hpp"
+#include "utils/format_bytes.hpp"
 #include "utils/format_duration.hpp"
 
 namespace hyrise
@@ -442,9 +443,29 @@ std::ostream &operator<<(std::ostream &stream,
     auto total_lqp_translate_nanos = std::chrono::nanoseconds::zero();
     auto total_execute_nanos = std::chrono::nanoseconds::zero();
     std::vector<bool> query_plan_cache_hits;
+    auto has_system_utilization = false;
+    auto total_process_cpu_nanos = std::chrono::nanoseconds::zero();
+    auto total_io_read_bytes = uint64_t{0};
+    auto total_io_write_bytes = uint64_t{0};
+    auto max_rss = uint64_t{0};
 
     for (const auto &statement_metric : metrics.statement_metrics)
     {
+        if (const auto &utilization = statement_metric->system_utilization)
+        {
+            const auto &first = utilization->samples.front();
+            const auto &last = utilization->samples.back();
+            has_system_utilization = true;
+            total_process_cpu_nanos += std::chrono::nanoseconds{
+                last.process_cpu_time - first.process_cpu_time};
+            total_io_read_bytes += last.io_read_bytes - first.io_read_bytes;
+            total_io_write_bytes += last.io_write_bytes - first.io_write_bytes;
+            for (const auto &sample : utilization->samples)
+            {
+                max_rss = std::max(max_rss, sample.process_rss);
+            }
+        }
+
         total_sql_translate_nanos += statement_metric->sql_translation_duration;
         total_optimize_nanos += statement_metric->optimization_duration;
         total_lqp_translate_nanos += statement_metric->lqp_translation_duration;
@@ -470,6 +491,19 @@ std::ostream &operator<<(std::ostream &stream,
            << query_plan_cache_hits.size() << " statement(s)";
     stream << "]\n";
 
+    if (has_system_utilization)
+    {
+        stream << "System utilization: [";
+        stream << "PROCESS CPU: " << format_duration(total_process_cpu_nanos)
+               << ", ";
+        stream << "STORAGE READ: " << format_bytes(total_io_read_bytes)
+               << ", ";
+        stream << "STORAGE WRITTEN: " << format_bytes(total_io_write_bytes)
+               << ", ";
+        stream << "MAX RSS: " << format_bytes(max_rss);
+        stream << "]\n";
+    }
+
     return stream;
 }
 
@@ -1,11 +1,10 @@
 #include "sql_pipeline_statement.hpp"
 
 #include <cstdlib>
-#include <fcntl.h>
 #include <fstream>
 #include <iomanip>
 #include <memory>
-#include <signal.h>
+#include <mutex>
 #include <unistd.h>
 #include <utility>
 
@@ -30,6 +29,7 @@
 #include "sql/sql_translator.hpp"
 #include "utils/assert.hpp"
 #include "utils/pin_supplement.hpp"
+#include "utils/system_sampler.hpp"
 
 #ifdef VTUNE_PROFILE
 #include <ittnotify.h>
@@ -291,6 +291,9 @@ SQLPipelineStatement::get_tasks()
     else
     {
         _precheck_ddl_operators(get_physical_plan());
+        _memory_pool = std::make_shared<QueryMemoryPool>(
+            Hyrise::get().query_memory_budget());
+        get_physical_plan()->set_memory_pool_recursively(_memory_pool);
         std::tie(_tasks, _root_operator_task) =
             OperatorTask::make_tasks_from_operator(get_physical_plan());
     }
@@ -382,93 +385,22 @@ SQLPipelineStatement::get_result_table()
     //Increment query counter
     Hyrise::get().incr_query_count();
 
-    pid_t iotop_pid = 0;
-
-    // Launch pintool, it can only be killed once this current process ends
-    // We hope that region of interest will deal with a lot of the unnecessary
-    // overhead
+    // Launch pintool. It attaches to this process and can only be detached
+    // once the process ends, so it is launched for the first traced query
+    // only.
     if (Hyrise::get().is_pin_enabled())
     {
-
-        int returnValue = system(
-            "/usr/bin/python3 ../myscripts/launch_pin.py");
-        if (returnValue != 0)
-            std::cerr << "Pin failed to launch\n";
-    }
-
-    // Launch iotop, it will be killed once this sqp statement ends
-    if (Hyrise::get().is_iotop_enabled() || Hyrise::get().is_iostat_enabled() || Hyrise::get().is_coreutil_enabled())
-    {
-
-        // I'm just going to replace the iotop command with iostate command to achieve same functionality
-        // If both are enabled simulataneously, we'll go with iostat since it's more foolproof
-        // Fork a process and record IOTOP/IOSTAT
-        iotop_pid = fork();
-        
-        if (iotop_pid == -1)
-        {
-            std::cerr << "Unable to fork process for iotop\n";
-            exit(1);
-        }
-        else if (iotop_pid == 0)
-        {
-            // Child process
-            std::string dump_filename = "iotool_dump_" + std::to_string(getppid()) + "_" + std::to_string(getpid()) + ".txt";
-            int fd = open(dump_filename.c_str(), O_RDWR | O_CREAT, S_IRUSR | S_IWUSR);
-            std::cout << "New process:" << getpid() << std::endl;
-            pid_t parent_pid = getppid();
-            std::cout << "Hyrise PID: " << parent_pid << std::endl;
-            // Write out the sql query to a file. This is useful to check which queries ran and which didn't
-            std::ostringstream oss;
-            oss << "hyrise_dump_" << getppid() << "_" << getpid() << ".txt";
-            std::ofstream f(oss.str());
-            f << get_sql_string();
-            f.close();
-
-            if (fd == -1)
-            {
-                std::cerr << "Failed to open file to dump iotop output!" << std::endl;
-                exit(1);
-            }
-            dup2(fd, STDOUT_FILENO); // Redirect stdout to the file
-
-            close(fd); // Close the file descriptor
-
-            // const char *iotop_path = "/data1/sumanthu/iotop/iotop";
-            std::string pid_string = std::to_string(parent_pid);
-
-            std::string iotool_path;
-
-            if (Hyrise::get().is_iostat_enabled())
-            {
-                iotool_path = std::string("/usr/bin/iostat");
-                std::cout << "Launching iostat" << std::endl;
-                execl(iotool_path.c_str(), iotool_path.c_str(), "-c", "1", nullptr);
-            }
-            else if (Hyrise::get().is_iotop_enabled())
-            {
-                iotool_path = std::string("/data1/sumanthu/iotop/iotop");
-                std::cout << "Launching iotop" << std::endl;
-                execl(iotool_path.c_str(), iotool_path.c_str(), "-p", pid_string.c_str(), nullptr);
-            }
-            else
-            {
-                iotool_path = std::string("/usr/bin/top");
-                std::cout << "Launching top" << std::endl;
-                execl(iotool_path.c_str(), iotool_path.c_str(), "-p", pid_string.c_str(), "-d", "1", "-b", nullptr);
-            }
-            // execl(iotop_path, iotop_path,nullptr);
-
-            // If execution reaches here, execl has failed
-            std::cerr << "Failed to execute command!" << std::endl;
-            exit(1);
-        }
-        // 3 second buffer time for parent process
-        if (Hyrise::get().is_coreutil_enabled() || Hyrise::get().is_iostat_enabled())
-        {
-            std::cout << "Sleeping for 3 seconds\n";
-            sleep(1);
-        }
+        static auto pin_launched = std::once_flag{};
+        std::call_once(pin_launched,
+                       []
+                       {
+                           const auto return_value = system(
+                               "/usr/bin/python3 ../myscripts/launch_pin.py");
+                           if (return_value != 0)
+                           {
+                               std::cerr << "Pin failed to launch\n";
+                           }
+                       });
     }
 
 #ifdef SNIPERSIM
@@ -494,6 +426,16 @@ SQLPipelineStatement::get_result_table()
         sleep(10);
     }
 
+    // Sample the system utilization while the statement executes. Sampling
+    // happens in-process, so no warm-up or cool-down period is needed.
+    auto system_sampler = std::unique_ptr<SystemSampler>{};
+    if (Hyrise::get().is_system_sampling_enabled())
+    {
+        system_sampler = std::make_unique<SystemSampler>(
+            Hyrise::get().system_sampling_interval());
+        system_sampler->start();
+    }
+
     Hyrise::get().scheduler()->schedule_and_wait_for_tasks(tasks);
 
     if (has_failed())
@@ -520,6 +462,19 @@ SQLPipelineStatement::get_result_table()
     const auto done = std::chrono::steady_clock::now();
     _metrics->plan_execution_duration = done - started;
 
+    if (_memory_pool)
+    {
+        _metrics->operator_memory = _memory_pool->statistics();
+        // The result table is not allocated from the arenas, so the pool can
+        // return its blocks.
+        _memory_pool->release_free_blocks();
+    }
+
+    if (system_sampler)
+    {
+        _metrics->system_utilization = system_sampler->stop();
+    }
+
     if (Hyrise::get().is_vtune_enabled())
     {
         std::string vtune_stop_command = "vtune -r " + vtune_dest + " -command stop";
@@ -533,19 +488,6 @@ SQLPipelineStatement::get_result_table()
     SimRoiEnd();
 #endif
 
-    if (Hyrise::get().is_iotop_enabled() || Hyrise::get().is_iostat_enabled() || Hyrise::get().is_coreutil_enabled())
-    {
-        // Kill the iotop process
-        if (kill(iotop_pid, SIGTERM) == 0)
-        {
-            std::cout << "Child process " << iotop_pid << " terminated successfully." << std::endl;
-        }
-        else
-        {
-            std::cerr << "Error: Failed to terminate child process." << std::endl;
-        }
-    }
-
 #ifdef VTUNE_PROFILE
     __itt_detach();
 #endif
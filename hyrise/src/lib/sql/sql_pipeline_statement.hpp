@@ -7,6 +7,7 @@
 #include "cache/gdfs_cache.hpp"
 #include "concurrency/transaction_context.hpp"
 #include "logical_query_plan/lqp_translator.hpp"
+#include "memory/operator_memory_arena.hpp"
 #include "optimizer/optimizer.hpp"
 #include "scheduler/abstract_task.hpp"
 #include "scheduler/job_task.hpp"
@@ -14,6 +15,7 @@
 #include "sql/sql_translator.hpp"
 #include "sql_plan_cache.hpp"
 #include "storage/table.hpp"
+#include "utils/system_sampler.hpp"
 
 namespace hyrise
 {
@@ -28,6 +30,14 @@ struct SQLPipelineStatementMetrics
     std::chrono::nanoseconds plan_execution_duration{};
 
     bool query_plan_cache_hit = false;
+
+    // Only set if system sampling is enabled (see
+    // Hyrise::set_system_sampling).
+    std::optional<SystemUtilization> system_utilization;
+
+    // Near-tier memory of the operator arenas, set once the physical plan has
+    // been executed.
+    std::optional<QueryMemoryStatistics> operator_memory;
 };
 
 enum class SQLPipelineStatus
@@ -151,6 +161,9 @@ class SQLPipelineStatement : public Noncopyable
     std::shared_ptr<OperatorTask> _root_operator_task;
     std::vector<std::shared_ptr<AbstractTask>> _tasks;
 
+    // Shared by the operators of the physical plan, see QueryMemoryPool.
+    std::shared_ptr<QueryMemoryPool> _memory_pool;
+
     std::shared_ptr<const Table> _result_table;
     // Assume there is an output table. Only change if nullptr is returned from
     // execution.
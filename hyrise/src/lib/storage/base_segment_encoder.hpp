@@ -3,6 +3,7 @@
 #include <memory>
 #include <type_traits>
 
+#include <boost/container/pmr/global_resource.hpp>
 #include <boost/hana/type.hpp>
 
 #include "all_type_variant.hpp"
@@ -60,6 +61,13 @@ class BaseSegmentEncoder
     virtual bool uses_vector_compression() const = 0;
     virtual void set_vector_compression(VectorCompressionType type) = 0;
     /**@}*/
+
+    /**
+     * @brief Sets the memory resource the encoded segment is allocated from,
+     *        e.g., the resource of a memory tier.
+     */
+    virtual void set_memory_resource(
+        boost::container::pmr::memory_resource *memory_resource) = 0;
 };
 
 template <typename Derived> class SegmentEncoder : public BaseSegmentEncoder
@@ -124,6 +132,13 @@ template <typename Derived> class SegmentEncoder : public BaseSegmentEncoder
         _vector_compression_type = type;
     }
 
+    void set_memory_resource(
+        boost::container::pmr::memory_resource *memory_resource) final
+    {
+        Assert(memory_resource, "Memory resource must not be null.");
+        _memory_resource = memory_resource;
+    }
+
     /**@}*/
 
   public:
@@ -161,9 +176,8 @@ template <typename Derived> class SegmentEncoder : public BaseSegmentEncoder
         const auto iterable =
             create_any_segment_iterable<ColumnDataType>(*abstract_segment);
 
-        // For now, we allocate without a specific memory source.
-        return _self()._on_encode(iterable,
-                                  PolymorphicAllocator<ColumnDataType>{});
+        return _self()._on_encode(
+            iterable, PolymorphicAllocator<ColumnDataType>{_memory_resource});
     }
 
     /**@}*/
@@ -182,6 +196,9 @@ template <typename Derived> class SegmentEncoder : public BaseSegmentEncoder
             ? VectorCompressionType::BitPacking
             : VectorCompressionType::FixedWidthInteger;
 
+    boost::container::pmr::memory_resource *_memory_resource =
+        boost::container::pmr::get_default_resource();
+
   private:
     Derived &_self() { return static_cast<Derived &>(*this); }
 
@@ -0,0 +1,741 @@
+#include "buffer_manager.hpp"
+
+#include <signal.h>
+#include <sys/mman.h>
+
+#include <bit>
+#include <cerrno>
+#include <cstring>
+#include <string>
+#include <thread>
+
+#include "utils/assert.hpp"
+
+namespace
+{
+
+using namespace hyrise; // NOLINT
+
+// The SIGSEGV handler passes loaded pages to the eviction thread without locks.
+static_assert(std::atomic<uint64_t>::is_always_lock_free &&
+                  std::atomic<size_t>::is_always_lock_free,
+              "The page fault handler requires lock-free atomics.");
+
+// The buffer manager that owns the SIGSEGV handler and the handler it
+// replaced.
+std::atomic<BufferManager *> active_buffer_manager{nullptr}; // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+struct sigaction previous_segmentation_fault_action; // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+void handle_segmentation_fault(const int signal, siginfo_t *info,
+                               void *context)
+{
+    auto *buffer_manager = active_buffer_manager.load();
+    if (buffer_manager && buffer_manager->resolve_page_fault(info->si_addr))
+    {
+        // The faulting instruction is retried.
+        return;
+    }
+
+    const auto &previous_action = previous_segmentation_fault_action;
+    if (previous_action.sa_flags & SA_SIGINFO)
+    {
+        previous_action.sa_sigaction(signal, info, context);
+    }
+    else if (previous_action.sa_handler == SIG_DFL ||
+             previous_action.sa_handler == SIG_IGN)
+    {
+        // Let the retried instruction fault again with the default action.
+        sigaction(SIGSEGV, &previous_action, nullptr);
+    }
+    else
+    {
+        previous_action.sa_handler(signal);
+    }
+}
+
+} // namespace
+
+namespace hyrise
+{
+
+BufferPoolResource::BufferPoolResource(BufferManager &buffer_manager)
+    : _buffer_manager{buffer_manager}
+{
+}
+
+void *BufferPoolResource::do_allocate(std::size_t bytes, std::size_t alignment)
+{
+    Assert(bytes <= bytes_for_size_type(MAX_PAGE_SIZE_TYPE),
+           "Allocation of " + std::to_string(bytes) +
+               " bytes exceeds the largest page size.");
+    Assert(alignment <= OS_PAGE_SIZE,
+           "Pages are only aligned to the OS page size.");
+
+    auto size_type = MIN_PAGE_SIZE_TYPE;
+    while (bytes_for_size_type(size_type) < bytes)
+    {
+        size_type = magic_enum::enum_value<PageSizeType>(
+            static_cast<size_t>(size_type) + 1);
+    }
+    return _buffer_manager.page_address(
+        _buffer_manager.allocate_page(size_type));
+}
+
+void BufferPoolResource::do_deallocate(void *pointer,
+                                       std::size_t /*bytes*/,
+                                       std::size_t /*alignment*/)
+{
+    _buffer_manager.deallocate_page(_buffer_manager.find_page(pointer));
+}
+
+bool BufferPoolResource::do_is_equal(
+    const boost::container::pmr::memory_resource &other) const noexcept
+{
+    return &other == this;
+}
+
+BufferManager::BufferManager(const size_t near_capacity,
+                             const size_t virtual_capacity,
+                             const std::chrono::milliseconds eviction_interval)
+    : _near_capacity{near_capacity}, _memory_resource{*this}
+{
+    Assert(virtual_capacity >= bytes_for_size_type(MAX_PAGE_SIZE_TYPE),
+           "Virtual capacity must hold at least one page of each size.");
+
+    auto *expected_buffer_manager = static_cast<BufferManager *>(nullptr);
+    Assert(active_buffer_manager.compare_exchange_strong(
+               expected_buffer_manager, this),
+           "Only one BufferManager can be active at a time.");
+
+    for (auto size_type_index = size_t{0};
+         size_type_index < PAGE_SIZE_TYPES_COUNT; ++size_type_index)
+    {
+        const auto page_bytes = bytes_for_size_type(
+            magic_enum::enum_value<PageSizeType>(size_type_index));
+        auto &region = _regions[size_type_index];
+        region.page_count = virtual_capacity / page_bytes;
+
+        // Only the address range is reserved. Pages are backed by physical
+        // memory when they are first touched after being unprotected.
+        auto *data = mmap(nullptr, region.page_count * page_bytes, PROT_NONE,
+                          MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+        Assert(data != MAP_FAILED,
+               std::string{"Could not reserve buffer pool: "} +
+                   std::strerror(errno));
+        region.data = static_cast<std::byte *>(data);
+        region.frames = std::make_unique<Frame[]>(region.page_count);
+        region.far_pages.resize(region.page_count, nullptr);
+        region.queued.resize(region.page_count, false);
+    }
+
+    struct sigaction action
+    {
+    };
+    action.sa_sigaction = handle_segmentation_fault;
+    sigemptyset(&action.sa_mask);
+    action.sa_flags = SA_SIGINFO;
+    Assert(sigaction(SIGSEGV, &action, &previous_segmentation_fault_action) ==
+               0,
+           "Could not install the page fault handler.");
+
+    if (eviction_interval > std::chrono::milliseconds{0})
+    {
+        _eviction_thread = std::make_unique<PausableLoopThread>(
+            eviction_interval, [&](size_t) { evict_to_capacity(); });
+        _eviction_thread->resume();
+    }
+}
+
+BufferManager::~BufferManager()
+{
+    _eviction_thread.reset();
+    sigaction(SIGSEGV, &previous_segmentation_fault_action, nullptr);
+    active_buffer_manager = nullptr;
+
+    auto *far_resource = get_memory_tier_resource(MemoryTier::Far);
+    for (auto size_type_index = size_t{0};
+         size_type_index < PAGE_SIZE_TYPES_COUNT; ++size_type_index)
+    {
+        const auto page_bytes = bytes_for_size_type(
+            magic_enum::enum_value<PageSizeType>(size_type_index));
+        auto &region = _regions[size_type_index];
+        for (auto *far_page : region.far_pages)
+        {
+            if (far_page)
+            {
+                far_resource->deallocate(far_page, page_bytes,
+                                         TieredMemoryResource::BLOCK_ALIGNMENT);
+            }
+        }
+        munmap(region.data, region.page_count * page_bytes);
+    }
+}
+
+PageID BufferManager::allocate_page(const PageSizeType size_type)
+{
+    auto &region = _regions[static_cast<size_t>(size_type)];
+    auto index = size_t{0};
+    {
+        const auto lock = std::lock_guard<std::mutex>{_allocation_mutex};
+        if (!region.free_indices.empty())
+        {
+            index = region.free_indices.back();
+            region.free_indices.pop_back();
+        }
+        else
+        {
+            Assert(region.next_index < region.page_count,
+                   "Buffer pool has no free pages of size " +
+                       std::string{magic_enum::enum_name(size_type)} + ".");
+            index = region.next_index++;
+        }
+    }
+
+    const auto page_id = PageID{size_type, index};
+    auto &frame = _frame(page_id);
+    const auto locked = frame.try_lock_exclusive(frame.state_and_version());
+    Assert(locked, "Free page is in use.");
+
+    _reserve_near_memory(page_id.byte_count());
+    _protect(page_id, PROT_READ | PROT_WRITE);
+    frame.mark_dirty();
+    _enqueue(page_id);
+    frame.unlock_exclusive();
+    return page_id;
+}
+
+void BufferManager::deallocate_page(const PageID page_id)
+{
+    Assert(page_id.valid(), "Cannot deallocate an invalid page.");
+    auto &frame = _frame(page_id);
+    auto resident = false;
+    while (true)
+    {
+        const auto state_and_version = frame.state_and_version();
+        const auto state = Frame::state(state_and_version);
+        if ((state == Frame::UNLOCKED || state == Frame::MARKED ||
+             state == Frame::EVICTED) &&
+            frame.try_lock_exclusive(state_and_version))
+        {
+            resident = state != Frame::EVICTED;
+            break;
+        }
+        std::this_thread::yield();
+    }
+
+    const auto bytes = page_id.byte_count();
+    if (resident)
+    {
+        _protect(page_id, PROT_NONE);
+        madvise(page_address(page_id), bytes, MADV_DONTNEED);
+        _resident_bytes -= bytes;
+    }
+
+    auto &region = _region(page_id);
+    auto &far_page = region.far_pages[page_id.index()];
+    if (far_page)
+    {
+        get_memory_tier_resource(MemoryTier::Far)
+            ->deallocate(far_page, bytes,
+                         TieredMemoryResource::BLOCK_ALIGNMENT);
+        far_page = nullptr;
+    }
+    frame.reset_dirty();
+    frame.unlock_exclusive_and_set_evicted();
+
+    const auto lock = std::lock_guard<std::mutex>{_allocation_mutex};
+    region.free_indices.push_back(page_id.index());
+}
+
+std::byte *BufferManager::page_address(const PageID page_id) const
+{
+    DebugAssert(page_id.valid(), "Invalid pages have no address.");
+    return _region(page_id).data + page_id.index() * page_id.byte_count();
+}
+
+PageID BufferManager::find_page(const void *pointer) const
+{
+    const auto *address = static_cast<const std::byte *>(pointer);
+    for (auto size_type_index = size_t{0};
+         size_type_index < PAGE_SIZE_TYPES_COUNT; ++size_type_index)
+    {
+        const auto size_type =
+            magic_enum::enum_value<PageSizeType>(size_type_index);
+        const auto page_bytes = bytes_for_size_type(size_type);
+        const auto &region = _regions[size_type_index];
+        if (address >= region.data &&
+            address < region.data + region.page_count * page_bytes)
+        {
+            const auto offset = static_cast<size_t>(address - region.data);
+            return PageID{size_type, offset / page_bytes};
+        }
+    }
+    return INVALID_PAGE_ID;
+}
+
+void BufferManager::pin_shared(const PageID page_id)
+{
+    auto &frame = _frame(page_id);
+    while (true)
+    {
+        const auto state_and_version = frame.state_and_version();
+        const auto state = Frame::state(state_and_version);
+        if (state == Frame::EVICTED)
+        {
+            if (frame.try_lock_exclusive(state_and_version))
+            {
+                Assert(_load_page(page_id), "Cannot pin a deallocated page.");
+                frame.unlock_exclusive();
+            }
+            continue;
+        }
+
+        if ((state < Frame::MAX_LOCKED_SHARED || state == Frame::MARKED) &&
+            frame.try_lock_shared(state_and_version))
+        {
+            if (state == Frame::MARKED)
+            {
+                Assert(_restore_protection(page_id),
+                       std::string{"mprotect failed: "} +
+                           std::strerror(errno));
+            }
+            return;
+        }
+        std::this_thread::yield();
+    }
+}
+
+void BufferManager::unpin_shared(const PageID page_id)
+{
+    _frame(page_id).unlock_shared();
+}
+
+void BufferManager::pin_exclusive(const PageID page_id)
+{
+    auto &frame = _frame(page_id);
+    while (true)
+    {
+        const auto state_and_version = frame.state_and_version();
+        const auto state = Frame::state(state_and_version);
+        if ((state == Frame::UNLOCKED || state == Frame::MARKED ||
+             state == Frame::EVICTED) &&
+            frame.try_lock_exclusive(state_and_version))
+        {
+            if (state == Frame::EVICTED)
+            {
+                Assert(_load_page(page_id), "Cannot pin a deallocated page.");
+            }
+            break;
+        }
+        std::this_thread::yield();
+    }
+
+    frame.mark_dirty();
+    _protect(page_id, PROT_READ | PROT_WRITE);
+}
+
+void BufferManager::unpin_exclusive(const PageID page_id)
+{
+    _frame(page_id).unlock_exclusive();
+}
+
+MemoryTier BufferManager::page_tier(const PageID page_id) const
+{
+    const auto state = Frame::state(frame(page_id).state_and_version());
+    return state == Frame::EVICTED ? MemoryTier::Far : MemoryTier::Near;
+}
+
+const Frame &BufferManager::frame(const PageID page_id) const
+{
+    return _region(page_id).frames[page_id.index()];
+}
+
+size_t BufferManager::near_capacity() const
+{
+    return _near_capacity;
+}
+
+size_t BufferManager::resident_bytes() const
+{
+    return _resident_bytes.load();
+}
+
+const BufferManager::Metrics &BufferManager::metrics() const
+{
+    return _metrics;
+}
+
+boost::container::pmr::memory_resource *BufferManager::memory_resource()
+{
+    return &_memory_resource;
+}
+
+void BufferManager::evict_to_capacity()
+{
+    _enqueue_loaded_pages();
+    if (_resident_bytes.load() > _near_capacity)
+    {
+        _evict_pages(_near_capacity);
+    }
+}
+
+bool BufferManager::resolve_page_fault(const void *address)
+{
+    const auto page_id = find_page(address);
+    if (!page_id.valid())
+    {
+        return false;
+    }
+
+    auto &frame = _frame(page_id);
+    while (true)
+    {
+        const auto state_and_version = frame.state_and_version();
+        const auto state = Frame::state(state_and_version);
+        if (state == Frame::EVICTED)
+        {
+            if (frame.try_lock_exclusive(state_and_version))
+            {
+                if (!_map_far_page(page_id))
+                {
+                    // Access to a deallocated page.
+                    frame.unlock_exclusive_and_set_evicted();
+                    return false;
+                }
+
+                // The eviction thread queues the page and makes room for it.
+                _resident_bytes += page_id.byte_count();
+                _push_loaded_page(page_id);
+                frame.unlock_exclusive();
+                return true;
+            }
+        }
+        else if (state == Frame::UNLOCKED)
+        {
+            // A write to a clean page. Reads of pages that are marked
+            // concurrently also end up here, which only costs an unnecessary
+            // write-back.
+            if (frame.try_lock_exclusive(state_and_version))
+            {
+                frame.mark_dirty();
+                const auto protected_page =
+                    _try_protect(page_id, PROT_READ | PROT_WRITE);
+                frame.unlock_exclusive();
+                return protected_page;
+            }
+        }
+        else if (state == Frame::MARKED || state < Frame::MAX_LOCKED_SHARED)
+        {
+            // The page gets its second chance. If the access was a write to a
+            // clean page, the retried instruction faults again.
+            if (frame.try_lock_shared(state_and_version))
+            {
+                if (state == Frame::MARKED)
+                {
+                    ++_metrics.soft_faults;
+                }
+                const auto protected_page = _restore_protection(page_id);
+                frame.unlock_shared();
+                return protected_page;
+            }
+        }
+
+        // Another thread loads or evicts the page.
+        std::this_thread::yield();
+    }
+}
+
+BufferManager::Region &BufferManager::_region(const PageID page_id)
+{
+    return _regions[static_cast<size_t>(page_id.size_type())];
+}
+
+const BufferManager::Region &BufferManager::_region(const PageID page_id) const
+{
+    return _regions[static_cast<size_t>(page_id.size_type())];
+}
+
+Frame &BufferManager::_frame(const PageID page_id)
+{
+    return _region(page_id).frames[page_id.index()];
+}
+
+bool BufferManager::_restore_protection(const PageID page_id)
+{
+    return _try_protect(page_id, _frame(page_id).is_dirty()
+                                     ? PROT_READ | PROT_WRITE
+                                     : PROT_READ);
+}
+
+void BufferManager::_protect(const PageID page_id, const int protection)
+{
+    Assert(_try_protect(page_id, protection),
+           std::string{"mprotect failed: "} + std::strerror(errno));
+}
+
+bool BufferManager::_try_protect(const PageID page_id, const int protection)
+{
+    return mprotect(page_address(page_id), page_id.byte_count(), protection) ==
+           0;
+}
+
+bool BufferManager::_load_page(const PageID page_id)
+{
+    if (!_region(page_id).far_pages[page_id.index()])
+    {
+        return false;
+    }
+
+    _reserve_near_memory(page_id.byte_count());
+    Assert(_map_far_page(page_id),
+           std::string{"Could not load page: "} + std::strerror(errno));
+    _enqueue(page_id);
+    return true;
+}
+
+bool BufferManager::_map_far_page(const PageID page_id)
+{
+    const auto *far_page = _region(page_id).far_pages[page_id.index()];
+    if (!far_page)
+    {
+        return false;
+    }
+
+    const auto bytes = page_id.byte_count();
+#ifdef __linux__
+    // Threads that access the page without pinning it must not see it before
+    // it is complete. Thus, we fill a separate mapping and move it into place
+    // atomically.
+    auto *staging_page = mmap(nullptr, bytes, PROT_READ | PROT_WRITE,
+                              MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (staging_page == MAP_FAILED)
+    {
+        return false;
+    }
+    std::memcpy(staging_page, far_page, bytes);
+    if (mprotect(staging_page, bytes, PROT_READ) != 0 ||
+        mremap(staging_page, bytes, bytes, MREMAP_MAYMOVE | MREMAP_FIXED,
+               page_address(page_id)) == MAP_FAILED)
+    {
+        munmap(staging_page, bytes);
+        return false;
+    }
+#else
+    if (!_try_protect(page_id, PROT_READ | PROT_WRITE))
+    {
+        return false;
+    }
+    std::memcpy(page_address(page_id), far_page, bytes);
+    if (!_try_protect(page_id, PROT_READ))
+    {
+        return false;
+    }
+#endif
+
+    ++_metrics.page_loads;
+    _metrics.bytes_read_from_far += bytes;
+    return true;
+}
+
+void BufferManager::_evict_page(const PageID page_id)
+{
+    auto &frame = _frame(page_id);
+    auto &far_page = _region(page_id).far_pages[page_id.index()];
+    const auto bytes = page_id.byte_count();
+
+    // Clean pages already have an up-to-date copy in the far tier.
+    if (frame.is_dirty() || !far_page)
+    {
+        if (!far_page)
+        {
+            far_page = static_cast<std::byte *>(
+                get_memory_tier_resource(MemoryTier::Far)
+                    ->allocate(bytes, TieredMemoryResource::BLOCK_ALIGNMENT));
+        }
+
+        // Concurrent readers may continue, writers wait for the eviction.
+        _protect(page_id, PROT_READ);
+        std::memcpy(far_page, page_address(page_id), bytes);
+        frame.reset_dirty();
+        _metrics.bytes_written_to_far += bytes;
+    }
+
+    _protect(page_id, PROT_NONE);
+    madvise(page_address(page_id), bytes, MADV_DONTNEED);
+    _resident_bytes -= bytes;
+    ++_metrics.page_evictions;
+}
+
+void BufferManager::_reserve_near_memory(const size_t bytes)
+{
+    const auto resident_bytes = _resident_bytes.fetch_add(bytes) + bytes;
+    if (resident_bytes > _near_capacity)
+    {
+        // Pages loaded by page faults can be evicted as well.
+        _enqueue_loaded_pages();
+        _evict_pages(_near_capacity);
+    }
+}
+
+void BufferManager::_evict_pages(const size_t target_bytes)
+{
+    // Two sweeps over the queue mark and then evict every unpinned page.
+    auto remaining_steps = size_t{0};
+    {
+        const auto lock = std::lock_guard<std::mutex>{_queue_mutex};
+        remaining_steps = 2 * _eviction_queue.size();
+    }
+
+    while (_resident_bytes.load() > target_bytes && remaining_steps > 0)
+    {
+        --remaining_steps;
+        auto page_id = INVALID_PAGE_ID;
+        {
+            const auto lock = std::lock_guard<std::mutex>{_queue_mutex};
+            if (_eviction_queue.empty())
+            {
+                return;
+            }
+            page_id = _eviction_queue.front();
+            _eviction_queue.pop_front();
+        }
+
+        auto &frame = _frame(page_id);
+        const auto state_and_version = frame.state_and_version();
+        const auto state = Frame::state(state_and_version);
+        auto keep_queued = true;
+        if (state == Frame::EVICTED)
+        {
+            // The page has been deallocated.
+            keep_queued = false;
+        }
+        else if (state == Frame::UNLOCKED)
+        {
+            // First chance: protect the page so that the next access clears
+            // the mark. The page is locked while it is protected, so that no
+            // pinned page ends up protected.
+            if (frame.try_lock_exclusive(state_and_version))
+            {
+                _protect(page_id, PROT_NONE);
+                frame.unlock_exclusive();
+                const auto unlocked_state_and_version =
+                    frame.state_and_version();
+                if (Frame::state(unlocked_state_and_version) == Frame::UNLOCKED)
+                {
+                    frame.try_mark(unlocked_state_and_version);
+                }
+            }
+        }
+        else if (state == Frame::MARKED)
+        {
+            // The page has not been accessed since it was marked.
+            if (frame.try_lock_exclusive(state_and_version))
+            {
+                _evict_page(page_id);
+                {
+                    // Dequeue the page before it can be loaded and queued
+                    // again.
+                    const auto lock =
+                        std::lock_guard<std::mutex>{_queue_mutex};
+                    _region(page_id).queued[page_id.index()] = false;
+                }
+                frame.unlock_exclusive_and_set_evicted();
+                continue;
+            }
+        }
+
+        const auto lock = std::lock_guard<std::mutex>{_queue_mutex};
+        if (keep_queued)
+        {
+            _eviction_queue.push_back(page_id);
+        }
+        else
+        {
+            _region(page_id).queued[page_id.index()] = false;
+        }
+    }
+}
+
+void BufferManager::_enqueue(const PageID page_id)
+{
+    const auto lock = std::lock_guard<std::mutex>{_queue_mutex};
+    _enqueue_locked(page_id);
+}
+
+void BufferManager::_enqueue_locked(const PageID page_id)
+{
+    auto &queued = _region(page_id).queued;
+    if (!queued[page_id.index()])
+    {
+        queued[page_id.index()] = true;
+        _eviction_queue.push_back(page_id);
+    }
+}
+
+void BufferManager::_push_loaded_page(const PageID page_id)
+{
+    auto head = _loaded_pages_head.load();
+    do
+    {
+        if (head - _loaded_pages_tail.load() >= LOADED_PAGES_CAPACITY)
+        {
+            _loaded_pages_overflowed = true;
+            return;
+        }
+    } while (!_loaded_pages_head.compare_exchange_weak(head, head + 1));
+
+    // The slot has been cleared before the tail moved past it.
+    _loaded_pages[head % LOADED_PAGES_CAPACITY] =
+        std::bit_cast<uint64_t>(page_id);
+}
+
+void BufferManager::_enqueue_loaded_pages()
+{
+    const auto lock = std::lock_guard<std::mutex>{_queue_mutex};
+    auto tail = _loaded_pages_tail.load();
+    while (tail != _loaded_pages_head.load())
+    {
+        // A valid PageID is never zero.
+        const auto page_id_bits =
+            _loaded_pages[tail % LOADED_PAGES_CAPACITY].exchange(0);
+        if (page_id_bits == 0)
+        {
+            // The handler has claimed the slot, but not written it yet.
+            break;
+        }
+        _enqueue_locked(std::bit_cast<PageID>(page_id_bits));
+        _loaded_pages_tail = ++tail;
+    }
+
+    if (!_loaded_pages_overflowed.exchange(false))
+    {
+        return;
+    }
+
+    // Some loaded pages did not fit into the ring buffer. Queueing pages that
+    // are not resident is harmless, as the eviction loop skips them.
+    for (auto size_type_index = size_t{0};
+         size_type_index < PAGE_SIZE_TYPES_COUNT; ++size_type_index)
+    {
+        const auto size_type =
+            magic_enum::enum_value<PageSizeType>(size_type_index);
+        auto &region = _regions[size_type_index];
+        auto page_count = size_t{0};
+        {
+            const auto allocation_lock =
+                std::lock_guard<std::mutex>{_allocation_mutex};
+            page_count = region.next_index;
+        }
+        for (auto index = size_t{0}; index < page_count; ++index)
+        {
+            const auto state =
+                Frame::state(region.frames[index].state_and_version());
+            if (state != Frame::EVICTED)
+            {
+                _enqueue_locked(PageID{size_type, index});
+            }
+        }
+    }
+}
+
+} // namespace hyrise
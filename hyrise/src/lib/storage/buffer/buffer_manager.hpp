@@ -0,0 +1,258 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <boost/container/pmr/memory_resource.hpp>
+
+#include "memory/tiered_memory_resource.hpp"
+#include "storage/buffer/frame.hpp"
+#include "storage/buffer/page_id.hpp"
+#include "types.hpp"
+#include "utils/pausable_loop_thread.hpp"
+
+namespace hyrise
+{
+
+class BufferManager;
+
+/**
+ * Memory resource that serves each allocation with a page of the smallest
+ * fitting PageSizeType, so that data structures allocated from it (e.g., the
+ * vectors of a segment copied with copy_using_allocator()) are backed by
+ * buffer-managed pages. Allocations must not exceed the largest page size.
+ *
+ * Allocations are not packed into pages: each one occupies a whole page (and
+ * at least OS_PAGE_SIZE bytes), so the resource is meant for few large data
+ * structures, not for many small ones.
+ */
+class BufferPoolResource : public boost::container::pmr::memory_resource
+{
+  public:
+    explicit BufferPoolResource(BufferManager &buffer_manager);
+
+  protected:
+    void *do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void *pointer, std::size_t bytes,
+                       std::size_t alignment) override;
+    [[nodiscard]] bool do_is_equal(
+        const boost::container::pmr::memory_resource &other) const
+        noexcept override;
+
+  private:
+    BufferManager &_buffer_manager;
+};
+
+/**
+ * Buffer manager in the style of vmcache (Leis et al., "Virtual-Memory Assisted
+ * Buffer Management", SIGMOD'23) that keeps the hot pages in local DRAM (the
+ * near tier) and the others in the far memory tier (CXL memory or the emulated
+ * far tier, see get_memory_tier_resource()).
+ *
+ * For each PageSizeType, a contiguous virtual memory region is reserved
+ * upfront, and a page's address is derived from its PageID. Thus, the page
+ * table is implicit, and pointers into a page remain valid while the page
+ * moves between the tiers. Each page has a Frame that holds its state.
+ *
+ * Resident pages are physically backed by the region (at most near_capacity
+ * bytes of them). An evicted page is released to the OS with madvise and its
+ * content lives in a copy in the far tier. Evicted pages are protected with
+ * PROT_NONE. Accessing one raises a SIGSEGV that the buffer manager resolves
+ * by loading the page from the far tier, so that plain pointer accesses (e.g.,
+ * of segment iterators) work without explicit pinning. The far copy is kept
+ * while the page is resident, so clean pages are evicted without copying.
+ * Resident pages are mapped read-only until they are first written to (or
+ * pinned exclusively), which sets their dirty flag.
+ *
+ * Pages are evicted with the second-chance (CLOCK) policy: the eviction loop
+ * sweeps over the resident pages, marks unlocked pages, and evicts pages that
+ * are still marked on the next sweep. Marked pages are protected as well, so
+ * that the first access to a marked page clears the mark (a soft fault) and
+ * gives the page a second chance. Pinned pages are never evicted. If all
+ * resident pages are pinned, the near capacity is exceeded temporarily.
+ *
+ * The SIGSEGV handler only uses system calls and atomics on memory that is
+ * reserved upfront: it must neither lock a mutex nor allocate, as the faulting
+ * thread may hold the same lock or be inside the allocator. Thus, it does not
+ * evict pages itself. Pages it loads are passed to the eviction thread via a
+ * lock-free ring buffer. Every eviction interval, the eviction thread adds them
+ * to the eviction queue and evicts pages (which allocates their far copies)
+ * until the near capacity holds again. Until then, faults may exceed the near
+ * capacity. Allocating and pinning pages evicts synchronously.
+ *
+ * As pages are protected individually, each of them can become a separate
+ * mapping. Larger page sizes thus keep the number of mappings below the
+ * kernel's limit (vm.max_map_count).
+ *
+ * Only one buffer manager can be active at a time, as it owns the SIGSEGV
+ * handler while it exists. Faults outside of the buffer pool are forwarded to
+ * the previous handler. Pages must not be written while they are pinned in
+ * shared mode.
+ */
+class BufferManager : private Noncopyable
+{
+  public:
+    struct Metrics
+    {
+        // Pages copied from the far tier into the near tier and back.
+        std::atomic<size_t> page_loads{0};
+        std::atomic<size_t> page_evictions{0};
+        std::atomic<size_t> bytes_read_from_far{0};
+        std::atomic<size_t> bytes_written_to_far{0};
+
+        // Accesses that gave a marked page a second chance.
+        std::atomic<size_t> soft_faults{0};
+    };
+
+    // Reserves @param virtual_capacity bytes of address space for each
+    // PageSizeType. An @param eviction_interval of zero disables the eviction
+    // thread, so that pages loaded by page faults are only evicted by
+    // evict_to_capacity() or by the next allocation.
+    explicit BufferManager(
+        const size_t near_capacity,
+        const size_t virtual_capacity = DEFAULT_VIRTUAL_CAPACITY,
+        const std::chrono::milliseconds eviction_interval =
+            DEFAULT_EVICTION_INTERVAL);
+    ~BufferManager();
+
+    // Allocates a zero-initialized, resident page.
+    PageID allocate_page(const PageSizeType size_type);
+    void deallocate_page(const PageID page_id);
+
+    std::byte *page_address(const PageID page_id) const;
+
+    // Returns the page that contains @param pointer, INVALID_PAGE_ID if the
+    // pointer is not part of the buffer pool.
+    PageID find_page(const void *pointer) const;
+
+    // Pinned pages are resident and cannot be evicted until they are unpinned.
+    // Exclusively pinned pages are writable and marked as dirty.
+    void pin_shared(const PageID page_id);
+    void unpin_shared(const PageID page_id);
+    void pin_exclusive(const PageID page_id);
+    void unpin_exclusive(const PageID page_id);
+
+    // Near if the page is resident, Far if it has been evicted.
+    MemoryTier page_tier(const PageID page_id) const;
+
+    const Frame &frame(const PageID page_id) const;
+
+    size_t near_capacity() const;
+    size_t resident_bytes() const;
+    const Metrics &metrics() const;
+
+    // Resource to back data structures (e.g., segments) with pages.
+    boost::container::pmr::memory_resource *memory_resource();
+
+    // Adds the pages loaded by page faults to the eviction queue and evicts
+    // pages until the resident pages fit into the near capacity. Called by the
+    // eviction thread.
+    void evict_to_capacity();
+
+    // Makes the page containing @param address accessible again. Called by the
+    // SIGSEGV handler, thus async-signal-safe. Returns false if the address is
+    // not part of a page.
+    bool resolve_page_fault(const void *address);
+
+    static constexpr size_t DEFAULT_VIRTUAL_CAPACITY =
+        size_t{1} * 1024 * 1024 * 1024;
+    static constexpr auto DEFAULT_EVICTION_INTERVAL =
+        std::chrono::milliseconds{1};
+
+    // Number of pages that page faults can load between two runs of the
+    // eviction thread before it has to scan all frames for them.
+    static constexpr size_t LOADED_PAGES_CAPACITY = 4096;
+
+  private:
+    // Virtual memory region and frames of one PageSizeType.
+    struct Region
+    {
+        std::byte *data{nullptr};
+        size_t page_count{0};
+        std::unique_ptr<Frame[]> frames;
+
+        // Copy of each page in the far tier, nullptr if the page has never
+        // been evicted. Only accessed while the page is locked exclusively.
+        std::vector<std::byte *> far_pages;
+
+        // Guarded by _allocation_mutex.
+        size_t next_index{0};
+        std::vector<size_t> free_indices;
+
+        // Whether the page is in the eviction queue. Guarded by _queue_mutex.
+        std::vector<bool> queued;
+    };
+
+    Region &_region(const PageID page_id);
+    const Region &_region(const PageID page_id) const;
+    Frame &_frame(const PageID page_id);
+
+    // Sets the protection of a resident page by its dirty flag. Returns false
+    // if mprotect failed.
+    bool _restore_protection(const PageID page_id);
+    void _protect(const PageID page_id, const int protection);
+    bool _try_protect(const PageID page_id, const int protection);
+
+    // The following methods expect the page to be locked exclusively.
+    // Returns false if the page has been deallocated.
+    bool _load_page(const PageID page_id);
+    void _evict_page(const PageID page_id);
+
+    // Copies the far copy of a page into its address range without evicting
+    // other pages or queueing it, so that page faults can use it. Returns false
+    // if the page has been deallocated or could not be mapped.
+    bool _map_far_page(const PageID page_id);
+
+    // Adds @param bytes to the resident bytes and evicts pages until they fit
+    // into the near capacity.
+    void _reserve_near_memory(const size_t bytes);
+
+    // Runs the second-chance eviction loop until at most @param target_bytes
+    // are resident or no more pages can be evicted.
+    void _evict_pages(const size_t target_bytes);
+
+    void _enqueue(const PageID page_id);
+
+    // Expects _queue_mutex to be locked.
+    void _enqueue_locked(const PageID page_id);
+
+    // Passes a page loaded by a page fault to the eviction thread.
+    void _push_loaded_page(const PageID page_id);
+
+    // Moves the pages loaded by page faults into the eviction queue.
+    void _enqueue_loaded_pages();
+
+    const size_t _near_capacity;
+    std::array<Region, PAGE_SIZE_TYPES_COUNT> _regions;
+
+    std::mutex _allocation_mutex;
+
+    // Resident pages in CLOCK order.
+    std::deque<PageID> _eviction_queue;
+    std::mutex _queue_mutex;
+
+    // Ring buffer of the pages loaded by page faults, stored as the bits of
+    // their PageID (zero marks a slot that is not written yet). The SIGSEGV
+    // handler claims slots at the head, _enqueue_loaded_pages() drains them at
+    // the tail while it holds _queue_mutex. If the ring buffer is full, the
+    // handler sets _loaded_pages_overflowed instead.
+    std::array<std::atomic<uint64_t>, LOADED_PAGES_CAPACITY> _loaded_pages{};
+    std::atomic<size_t> _loaded_pages_head{0};
+    std::atomic<size_t> _loaded_pages_tail{0};
+    std::atomic_bool _loaded_pages_overflowed{false};
+
+    std::atomic<size_t> _resident_bytes{0};
+    Metrics _metrics;
+    BufferPoolResource _memory_resource;
+
+    // Stopped first on destruction, as it accesses all of the above.
+    std::unique_ptr<PausableLoopThread> _eviction_thread;
+};
+
+} // namespace hyrise
@@ -56,6 +56,15 @@ void Chunk::replace_segment(size_t column_id,
     std::atomic_store(&_segments.at(column_id), segment);
 }
 
+bool Chunk::try_replace_segment(
+    size_t column_id, const std::shared_ptr<AbstractSegment> &expected_segment,
+    const std::shared_ptr<AbstractSegment> &segment)
+{
+    auto expected = expected_segment;
+    return std::atomic_compare_exchange_strong(&_segments.at(column_id),
+                                               &expected, segment);
+}
+
 void Chunk::append(const std::vector<AllTypeVariant> &values)
 {
     DebugAssert(is_mutable(), "Can't append to immutable Chunk");
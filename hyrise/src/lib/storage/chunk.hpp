@@ -74,6 +74,14 @@ class Chunk : private Noncopyable
     void replace_segment(size_t column_id,
                          const std::shared_ptr<AbstractSegment> &segment);
 
+    // Atomically replaces the segment at column_id only if it still is
+    // expected_segment, i.e., if it has not been replaced concurrently (e.g.,
+    // by a compression or a migration). Returns whether it was replaced.
+    bool try_replace_segment(
+        size_t column_id,
+        const std::shared_ptr<AbstractSegment> &expected_segment,
+        const std::shared_ptr<AbstractSegment> &segment);
+
     // returns the number of columns, which is equal to the number of segments
     // (cannot exceed ColumnID (uint16_t))
     ColumnCount column_count() const;
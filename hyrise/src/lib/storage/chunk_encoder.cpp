@@ -1,9 +1,12 @@
 #include "chunk_encoder.hpp"
 
+#include <limits>
 #include <memory>
 #include <thread>
 #include <vector>
 
+#include <boost/container/pmr/global_resource.hpp>
+
 #include "base_value_segment.hpp"
 #include "chunk.hpp"
 #include "resolve_type.hpp"
@@ -30,11 +33,16 @@ namespace hyrise
 std::shared_ptr<AbstractSegment>
 ChunkEncoder::encode_segment(const std::shared_ptr<AbstractSegment> &segment,
                              const DataType data_type,
-                             const SegmentEncodingSpec &encoding_spec)
+                             const SegmentEncodingSpec &encoding_spec,
+                             const std::optional<MemoryTier> memory_tier)
 {
     Assert(!std::dynamic_pointer_cast<const ReferenceSegment>(segment),
            "Reference segments cannot be encoded.");
 
+    auto *const memory_resource =
+        memory_tier ? get_memory_tier_resource(*memory_tier)
+                    : boost::container::pmr::get_default_resource();
+
     std::shared_ptr<AbstractSegment> result;
     resolve_data_type(
         data_type,
@@ -49,7 +57,9 @@ ChunkEncoder::encode_segment(const std::shared_ptr<AbstractSegment> &segment,
             // Check if early exit is possible when passed segment is already
             // encoded with requested spec. In case no vector compression is
             // specified, only the correct encoding type is checked and the
-            // current vector compression type is ignored.
+            // current vector compression type is ignored. If a memory tier is
+            // requested, the segment is copied into that tier as we do not
+            // know where it has been allocated.
             const auto current_segment_encoding_spec =
                 get_segment_encoding_spec(segment);
             if (current_segment_encoding_spec == encoding_spec ||
@@ -57,7 +67,11 @@ ChunkEncoder::encode_segment(const std::shared_ptr<AbstractSegment> &segment,
                  current_segment_encoding_spec.encoding_type ==
                      encoding_spec.encoding_type))
             {
-                result = segment;
+                result =
+                    memory_tier
+                        ? segment->copy_using_allocator(
+                              PolymorphicAllocator<size_t>{memory_resource})
+                        : segment;
                 return;
             }
 
@@ -67,8 +81,10 @@ ChunkEncoder::encode_segment(const std::shared_ptr<AbstractSegment> &segment,
             // used (which create and call the according encoder).
             if (encoding_spec.encoding_type == EncodingType::Unencoded)
             {
-                pmr_vector<ColumnDataType> values;
-                pmr_vector<bool> null_values;
+                const auto allocator =
+                    PolymorphicAllocator<ColumnDataType>{memory_resource};
+                auto values = pmr_vector<ColumnDataType>{allocator};
+                auto null_values = pmr_vector<bool>{allocator};
                 auto contains_nulls = false;
 
                 auto iterable =
@@ -116,6 +132,7 @@ ChunkEncoder::encode_segment(const std::shared_ptr<AbstractSegment> &segment,
                     encoder->set_vector_compression(
                         *encoding_spec.vector_compression_type);
                 }
+                encoder->set_memory_resource(memory_resource);
 
                 result = encoder->encode(segment, data_type);
             }
@@ -123,9 +140,48 @@ ChunkEncoder::encode_segment(const std::shared_ptr<AbstractSegment> &segment,
     return result;
 }
 
+TieredEncodingResult ChunkEncoder::encode_segment_for_tier(
+    const std::shared_ptr<AbstractSegment> &segment, const DataType data_type,
+    const MemoryTier memory_tier, const TieredEncodingPolicy &policy)
+{
+    const auto row_count = segment->size();
+
+    auto result = TieredEncodingResult{};
+    result.original_bytes =
+        segment->memory_usage(MemoryUsageCalculationMode::Full);
+    auto min_scan_cost = std::numeric_limits<double>::max();
+
+    // Trial-encoding every candidate is more expensive than estimating the
+    // sizes from samples, but the encoded sizes (e.g., of LZ4 blocks) are hard
+    // to predict otherwise. The trials are allocated from the default resource
+    // and only the best segment is kept alive, so that the (possibly scarce or
+    // slow) target tier only sees the final copy.
+    for (const auto &encoding_spec : TieredEncodingPolicy::candidates(data_type))
+    {
+        auto encoded_segment =
+            encode_segment(segment, data_type, encoding_spec);
+        const auto encoded_bytes =
+            encoded_segment->memory_usage(MemoryUsageCalculationMode::Full);
+        const auto scan_cost = policy.estimate_scan_cost(
+            encoding_spec, encoded_bytes, row_count, memory_tier);
+        if (scan_cost < min_scan_cost)
+        {
+            min_scan_cost = scan_cost;
+            result.segment = std::move(encoded_segment);
+            result.encoding_spec = encoding_spec;
+            result.encoded_bytes = encoded_bytes;
+        }
+    }
+
+    result.segment = result.segment->copy_using_allocator(
+        PolymorphicAllocator<size_t>{get_memory_tier_resource(memory_tier)});
+    return result;
+}
+
 void ChunkEncoder::encode_chunk(const std::shared_ptr<Chunk> &chunk,
                                 const std::vector<DataType> &column_data_types,
-                                const ChunkEncodingSpec &chunk_encoding_spec)
+                                const ChunkEncodingSpec &chunk_encoding_spec,
+                                const ChunkPlacementSpec &chunk_placement_spec)
 {
     const auto column_count = chunk->column_count();
     Assert(column_data_types.size() == static_cast<size_t>(column_count),
@@ -133,6 +189,9 @@ void ChunkEncoder::encode_chunk(const std::shared_ptr<Chunk> &chunk,
     Assert(
         chunk_encoding_spec.size() == static_cast<size_t>(column_count),
         "Number of column encoding specs must match the chunk’s column count.");
+    Assert(chunk_placement_spec.empty() ||
+               chunk_placement_spec.size() == static_cast<size_t>(column_count),
+           "Number of memory tiers must match the chunk’s column count.");
     Assert(!chunk->is_mutable(), "Only immutable chunks can be encoded.");
 
     for (auto column_id = ColumnID{0}; column_id < column_count; ++column_id)
@@ -141,9 +200,13 @@ void ChunkEncoder::encode_chunk(const std::shared_ptr<Chunk> &chunk,
 
         const auto data_type = column_data_types[column_id];
         const auto abstract_segment = chunk->get_segment(column_id);
+        const auto memory_tier =
+            chunk_placement_spec.empty()
+                ? std::nullopt
+                : std::optional<MemoryTier>{chunk_placement_spec[column_id]};
 
         const auto encoded_segment =
-            encode_segment(abstract_segment, data_type, spec);
+            encode_segment(abstract_segment, data_type, spec, memory_tier);
         chunk->replace_segment(column_id, encoded_segment);
     }
 
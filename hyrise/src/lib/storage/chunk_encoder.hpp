@@ -7,9 +7,11 @@
 #include <vector>
 
 #include "all_type_variant.hpp"
+#include "memory/tiered_memory_resource.hpp"
 #include "types.hpp"
 
 #include "storage/encoding_type.hpp"
+#include "storage/tiered_encoding_policy.hpp"
 #include "storage/vector_compression/vector_compression.hpp"
 
 namespace hyrise
@@ -19,6 +21,10 @@ class Chunk;
 class Table;
 class AbstractSegment;
 
+// Memory tier of each column of a chunk. An empty spec leaves all segments
+// where the encoding allocates them by default.
+using ChunkPlacementSpec = std::vector<MemoryTier>;
+
 /**
  * @brief Interface for encoding chunks
  *
@@ -31,20 +37,44 @@ class AbstractSegment;
 class ChunkEncoder
 {
   public:
+    /**
+     * @brief Encodes a segment
+     *
+     * If a memory tier is passed, the encoded segment is allocated from that
+     * tier. This also moves segments that already have the requested encoding.
+     */
     static std::shared_ptr<AbstractSegment>
     encode_segment(const std::shared_ptr<AbstractSegment> &segment,
                    const DataType data_type,
-                   const SegmentEncodingSpec &encoding_spec);
+                   const SegmentEncodingSpec &encoding_spec,
+                   const std::optional<MemoryTier> memory_tier = std::nullopt);
+
+    /**
+     * @brief Encodes a segment with the encoding that is cheapest to scan from
+     * the given memory tier
+     *
+     * The segment is encoded with each of the policy's candidate encodings, and
+     * the one with the lowest estimated scan cost is copied into
+     * @param memory_tier and returned together with its compression ratio.
+     */
+    static TieredEncodingResult
+    encode_segment_for_tier(const std::shared_ptr<AbstractSegment> &segment,
+                            const DataType data_type,
+                            const MemoryTier memory_tier,
+                            const TieredEncodingPolicy &policy);
 
     /**
      * @brief Encodes a chunk
      *
      * Encodes a chunk using the passed encoding specifications. Reduces also
-     * the fragmentation of the chunk’s MVCC data.
+     * the fragmentation of the chunk’s MVCC data. If a placement spec is
+     * passed, each segment is allocated from the memory tier of its column.
      */
-    static void encode_chunk(const std::shared_ptr<Chunk> &chunk,
-                             const std::vector<DataType> &column_data_types,
-                             const ChunkEncodingSpec &chunk_encoding_spec);
+    static void
+    encode_chunk(const std::shared_ptr<Chunk> &chunk,
+                 const std::vector<DataType> &column_data_types,
+                 const ChunkEncodingSpec &chunk_encoding_spec,
+                 const ChunkPlacementSpec &chunk_placement_spec = {});
 
     /**
      * @brief Encodes a chunk using the same SegmentEncodingSpec
@@ -40,6 +40,9 @@ class AttributeVectorIterable
 
         _access_counter[SegmentAccessCounter::AccessType::Sequential] +=
             _attribute_vector.size();
+        _access_counter.record_range(
+            _attribute_vector.data_size(), _attribute_vector.size(),
+            ChunkOffset{0}, static_cast<ChunkOffset>(_attribute_vector.size()));
     }
 
     template <typename Functor, typename PosListType>
@@ -66,8 +69,13 @@ class AttributeVectorIterable
                 functor(begin, end);
             });
 
-        _access_counter[SegmentAccessCounter::access_type(*position_filter)] +=
-            position_filter->size();
+        const auto access_type =
+            SegmentAccessCounter::access_type(*position_filter);
+        _access_counter[access_type] += position_filter->size();
+        _access_counter.record_positions(access_type,
+                                         _attribute_vector.data_size(),
+                                         _attribute_vector.size(),
+                                         *position_filter);
     }
 
     size_t _on_size() const { return _attribute_vector.size(); }
@@ -2,6 +2,7 @@
 
 #include <type_traits>
 
+#include "memory/prefetching.hpp"
 #include "storage/abstract_segment.hpp"
 #include "storage/dictionary_segment.hpp"
 #include "storage/fixed_string_dictionary_segment.hpp"
@@ -36,6 +37,9 @@ class DictionarySegmentIterable : public PointAccessibleSegmentIterable<
             _segment.size();
         _segment.access_counter[SegmentAccessCounter::AccessType::Dictionary] +=
             _segment.size();
+        _segment.access_counter.record_range(
+            _segment.attribute_vector()->data_size(), _segment.size(),
+            ChunkOffset{0}, static_cast<ChunkOffset>(_segment.size()));
 
         resolve_compressed_vector_type(
             *_segment.attribute_vector(),
@@ -62,10 +66,14 @@ class DictionarySegmentIterable : public PointAccessibleSegmentIterable<
     void _on_with_iterators(const std::shared_ptr<PosListType> &position_filter,
                             const Functor &functor) const
     {
-        _segment.access_counter[SegmentAccessCounter::access_type(
-            *position_filter)] += position_filter->size();
+        const auto access_type =
+            SegmentAccessCounter::access_type(*position_filter);
+        _segment.access_counter[access_type] += position_filter->size();
         _segment.access_counter[SegmentAccessCounter::AccessType::Dictionary] +=
             position_filter->size();
+        _segment.access_counter.record_positions(
+            access_type, _segment.attribute_vector()->data_size(),
+            _segment.size(), *position_filter);
 
         resolve_compressed_vector_type(
             *_segment.attribute_vector(),
@@ -88,6 +96,16 @@ class DictionarySegmentIterable : public PointAccessibleSegmentIterable<
                         _dictionary->cbegin(), _segment.null_value_id(),
                         vector.create_decompressor(), position_filter->cbegin(),
                         position_filter->cend()};
+                if constexpr (HAS_PREFETCHABLE_DICTIONARY)
+                {
+                    const auto distance =
+                        prefetch_distance(_dictionary->data());
+                    if (distance > 0)
+                    {
+                        begin.enable_prefetching(position_filter->cend(),
+                                                 distance);
+                    }
+                }
                 functor(begin, end);
             });
     }
@@ -199,6 +217,21 @@ class DictionarySegmentIterable : public PointAccessibleSegmentIterable<
         {
         }
 
+        // Reads the value id ahead and prefetches the dictionary entry it
+        // points to. The value id itself is read from the attribute vector
+        // again in dereference(), which then is a cache hit.
+        void prefetch(const ChunkOffset chunk_offset) const
+        {
+            if constexpr (HAS_PREFETCHABLE_DICTIONARY)
+            {
+                const auto value_id = _attribute_decompressor.get(chunk_offset);
+                if (value_id != _null_value_id)
+                {
+                    prefetch_for_read(&*(_dictionary_begin_it + value_id));
+                }
+            }
+        }
+
       private:
         friend class boost::
             iterator_core_access; // grants the boost::iterator_facade access to
@@ -229,6 +262,10 @@ class DictionarySegmentIterable : public PointAccessibleSegmentIterable<
     };
 
   private:
+    // The values of FixedStringDictionarySegments are not addressable.
+    static constexpr auto HAS_PREFETCHABLE_DICTIONARY =
+        std::is_same_v<Dictionary, pmr_vector<T>>;
+
     const BaseDictionarySegment &_segment;
     std::shared_ptr<const Dictionary> _dictionary;
 };
@@ -1,10 +1,13 @@
 #include "segment_access_counter.hpp"
 
 #include <sstream>
+#include <utility>
 
 namespace hyrise
 {
 
+std::atomic_bool SegmentAccessCounter::_heatmaps_enabled{false};
+
 SegmentAccessCounter::SegmentAccessCounter()
 {
     DebugAssert(static_cast<size_t>(AccessType::Count) ==
@@ -29,46 +32,233 @@ SegmentAccessCounter::operator=(const SegmentAccessCounter &other)
     return *this;
 }
 
+SegmentAccessCounter::~SegmentAccessCounter()
+{
+    delete _shards.load();      // NOLINT(cppcoreguidelines-owning-memory)
+    delete _heatmap_ptr.load(); // NOLINT(cppcoreguidelines-owning-memory)
+}
+
 void SegmentAccessCounter::_set_counters(const SegmentAccessCounter &counter)
 {
-    const auto counter_count = _counters.size();
+    const auto counters = counter.get_counter();
+    const auto counter_count = counters.size();
     for (auto counter_index = size_t{0}; counter_index < counter_count;
          ++counter_index)
     {
-        _counters[counter_index] = counter._counters[counter_index].load();
+        (*this)[static_cast<AccessType>(counter_index)] =
+            counters[counter_index];
+    }
+
+    auto pages = counter.heatmap();
+    if (!pages.empty() || _heatmap_ptr.load())
+    {
+        auto &heatmap = _heatmap();
+        const auto lock = std::lock_guard<std::mutex>{heatmap.mutex};
+        heatmap.pages = std::move(pages);
+    }
+}
+
+SegmentAccessCounter::Counter::Counter(SegmentAccessCounter &counter,
+                                       const AccessType type)
+    : _counter{counter}, _type{type}
+{
+}
+
+SegmentAccessCounter::Counter &
+SegmentAccessCounter::Counter::operator+=(const CounterType value)
+{
+    auto &shard = _counter._shards_or_allocate()[_thread_shard()];
+    shard.counters[static_cast<size_t>(_type)].fetch_add(
+        value, std::memory_order_relaxed);
+    return *this;
+}
+
+SegmentAccessCounter::Counter &SegmentAccessCounter::Counter::operator++()
+{
+    return *this += 1;
+}
+
+SegmentAccessCounter::Counter &
+SegmentAccessCounter::Counter::operator=(const CounterType value)
+{
+    auto &shards = _counter._shards_or_allocate();
+    for (auto &shard : shards)
+    {
+        shard.counters[static_cast<size_t>(_type)] = 0;
     }
+    shards[0].counters[static_cast<size_t>(_type)] = value;
+    return *this;
+}
+
+SegmentAccessCounter::Counter::operator CounterType() const
+{
+    return std::as_const(_counter)[_type];
 }
 
-SegmentAccessCounter::CounterType &
+SegmentAccessCounter::Counter
 SegmentAccessCounter::operator[](const AccessType type)
 {
-    return _counters[static_cast<size_t>(type)];
+    return Counter{*this, type};
 }
 
-const SegmentAccessCounter::CounterType &
+SegmentAccessCounter::CounterType
 SegmentAccessCounter::operator[](const AccessType type) const
 {
-    return _counters[static_cast<size_t>(type)];
+    const auto *shards = _shards.load();
+    if (!shards)
+    {
+        return 0;
+    }
+
+    auto sum = CounterType{0};
+    for (const auto &shard : *shards)
+    {
+        sum += shard.counters[static_cast<size_t>(type)].load(
+            std::memory_order_relaxed);
+    }
+    return sum;
 }
 
-std::array<SegmentAccessCounter::CounterType, static_cast<size_t>(SegmentAccessCounter::AccessType::Count)> &SegmentAccessCounter::get_counter()
+std::array<SegmentAccessCounter::CounterType,
+           static_cast<size_t>(SegmentAccessCounter::AccessType::Count)>
+SegmentAccessCounter::get_counter() const
 {
-    return _counters;
+    auto counters =
+        std::array<CounterType, static_cast<size_t>(AccessType::Count)>{};
+    for (auto access_type = size_t{0}; access_type < counters.size();
+         ++access_type)
+    {
+        counters[access_type] = (*this)[static_cast<AccessType>(access_type)];
+    }
+    return counters;
 }
 
 std::string SegmentAccessCounter::to_string() const
 {
-    std::string result = std::to_string(_counters[0]);
+    const auto counters = get_counter();
+    std::string result = std::to_string(counters[0]);
     result.reserve(static_cast<size_t>(AccessType::Count) * 19);
     for (auto access_type = size_t{1};
          access_type < static_cast<size_t>(AccessType::Count); ++access_type)
     {
         result.append(",");
-        result.append(std::to_string(_counters[access_type]));
+        result.append(std::to_string(counters[access_type]));
     }
     return result;
 }
 
+void SegmentAccessCounter::enable_heatmaps(const bool enabled)
+{
+    _heatmaps_enabled = enabled;
+}
+
+bool SegmentAccessCounter::heatmaps_enabled()
+{
+    return _heatmaps_enabled.load(std::memory_order_relaxed);
+}
+
+void SegmentAccessCounter::record_range(const size_t buffer_bytes,
+                                        const size_t element_count,
+                                        const ChunkOffset begin,
+                                        const ChunkOffset end)
+{
+    if (!heatmaps_enabled() || buffer_bytes == 0 || element_count == 0 ||
+        begin >= end)
+    {
+        return;
+    }
+
+    const auto first_byte = begin * buffer_bytes / element_count;
+    const auto last_byte = end * buffer_bytes / element_count;
+    auto &heatmap = _heatmap();
+    const auto lock = std::lock_guard<std::mutex>{heatmap.mutex};
+    _add_bytes(heatmap.pages, AccessType::Sequential, first_byte,
+               std::max(last_byte - first_byte, size_t{1}));
+}
+
+SegmentAccessCounter::PageHeatmap SegmentAccessCounter::heatmap() const
+{
+    auto *heatmap = _heatmap_ptr.load();
+    if (!heatmap)
+    {
+        return {};
+    }
+    const auto lock = std::lock_guard<std::mutex>{heatmap->mutex};
+    return heatmap->pages;
+}
+
+std::array<SegmentAccessCounter::Shard, SegmentAccessCounter::SHARD_COUNT> &
+SegmentAccessCounter::_shards_or_allocate()
+{
+    auto *shards = _shards.load(std::memory_order_acquire);
+    if (shards)
+    {
+        return *shards;
+    }
+
+    // Another thread might allocate the shards at the same time. Only one of
+    // them wins the exchange, the others discard their allocation.
+    // NOLINTNEXTLINE(cppcoreguidelines-owning-memory)
+    auto *new_shards = new std::array<Shard, SHARD_COUNT>{};
+    if (!_shards.compare_exchange_strong(shards, new_shards,
+                                         std::memory_order_acq_rel))
+    {
+        delete new_shards; // NOLINT(cppcoreguidelines-owning-memory)
+        return *shards;
+    }
+    return *new_shards;
+}
+
+SegmentAccessCounter::Heatmap &SegmentAccessCounter::_heatmap()
+{
+    auto *heatmap = _heatmap_ptr.load(std::memory_order_acquire);
+    if (heatmap)
+    {
+        return *heatmap;
+    }
+
+    // NOLINTNEXTLINE(cppcoreguidelines-owning-memory)
+    auto *new_heatmap = new Heatmap{};
+    if (!_heatmap_ptr.compare_exchange_strong(heatmap, new_heatmap,
+                                              std::memory_order_acq_rel))
+    {
+        delete new_heatmap; // NOLINT(cppcoreguidelines-owning-memory)
+        return *heatmap;
+    }
+    return *new_heatmap;
+}
+
+// Threads are assigned to shards round-robin on their first access, so that
+// up to SHARD_COUNT workers never share a cache line.
+size_t SegmentAccessCounter::_thread_shard()
+{
+    static auto next_shard = std::atomic<size_t>{0};
+    thread_local const auto shard = next_shard++ % SHARD_COUNT;
+    return shard;
+}
+
+void SegmentAccessCounter::_add_bytes(PageHeatmap &pages, const AccessType type,
+                                      const size_t byte_offset,
+                                      const size_t bytes)
+{
+    const auto last_page = (byte_offset + bytes - 1) / HEATMAP_PAGE_SIZE;
+    if (pages.size() <= last_page)
+    {
+        pages.resize(last_page + 1);
+    }
+
+    // Split accesses that span multiple pages.
+    auto offset = byte_offset;
+    const auto end = byte_offset + bytes;
+    while (offset < end)
+    {
+        const auto page = offset / HEATMAP_PAGE_SIZE;
+        const auto page_end = std::min((page + 1) * HEATMAP_PAGE_SIZE, end);
+        pages[page][static_cast<size_t>(type)] += page_end - offset;
+        offset = page_end;
+    }
+}
+
 SegmentAccessCounter::AccessType
 SegmentAccessCounter::access_type(const AbstractPosList &positions)
 {
@@ -171,16 +361,7 @@ SegmentAccessCounter::_access_pattern(const AbstractPosList &positions)
 
 bool SegmentAccessCounter::operator==(const SegmentAccessCounter &other) const
 {
-    const auto counter_count = _counters.size();
-    for (auto counter_index = size_t{0}; counter_index < counter_count;
-         ++counter_index)
-    {
-        if (_counters[counter_index] != other._counters[counter_index])
-        {
-            return false;
-        }
-    }
-    return true;
+    return get_counter() == other.get_counter();
 }
 
 bool SegmentAccessCounter::operator!=(const SegmentAccessCounter &other) const
@@ -1,10 +1,14 @@
 #pragma once
 
+#include <algorithm>
 #include <array>
 #include <atomic>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <type_traits>
+#include <vector>
 
 #include "storage/pos_lists/row_id_pos_list.hpp"
 #include "types.hpp"
@@ -18,12 +22,17 @@ namespace hyrise
 // access. The individual counters can be accessed using the [] operator. The
 // counters are currently updated by the iterators, segment accessors or from
 // within the segment itself.
+//
+// As hot segments are accessed by all workers at the same time, the counters
+// are sharded: each thread adds to its own cache line and the shards are only
+// summed up when a counter is read. Optionally, the counter also records a
+// page-level heatmap of the segment's main buffer (see enable_heatmaps()).
 class SegmentAccessCounter
 {
     friend class SegmentAccessCounterTest;
 
   public:
-    using CounterType = std::atomic_uint64_t;
+    using CounterType = uint64_t;
 
     enum class AccessType
     {
@@ -45,15 +54,45 @@ class SegmentAccessCounter
                                       {AccessType::Random, "Random"},
                                       {AccessType::Dictionary, "Dictionary"}};
 
+    // Handle returned by the non-const operator[]. Additions go to the shard
+    // of the calling thread, reads sum up all shards.
+    class Counter
+    {
+      public:
+        Counter &operator+=(const CounterType value);
+        Counter &operator++();
+        // Not thread-safe with concurrent additions to the same counter.
+        Counter &operator=(const CounterType value);
+        operator CounterType() const; // NOLINT(google-explicit-constructor)
+
+      private:
+        friend class SegmentAccessCounter;
+        Counter(SegmentAccessCounter &counter, const AccessType type);
+
+        SegmentAccessCounter &_counter;
+        const AccessType _type;
+    };
+
+    // Bytes touched per 4 KB page of a segment's buffer, indexed by page and
+    // access type. Dictionary accesses are not part of the heatmap, as the
+    // heatmap only covers the buffer the rows are stored in (i.e., the values
+    // or the attribute vector).
+    using PageHeatmap = std::vector<
+        std::array<CounterType, static_cast<size_t>(AccessType::Count)>>;
+
+    static constexpr size_t SHARD_COUNT = 8;
+    static constexpr size_t HEATMAP_PAGE_SIZE = 4096;
+
     SegmentAccessCounter();
     SegmentAccessCounter(const SegmentAccessCounter &other);
     SegmentAccessCounter &operator=(const SegmentAccessCounter &other);
+    ~SegmentAccessCounter();
 
     bool operator==(const SegmentAccessCounter &other) const;
     bool operator!=(const SegmentAccessCounter &other) const;
 
-    CounterType &operator[](const AccessType type);
-    const CounterType &operator[](const AccessType type) const;
+    Counter operator[](const AccessType type);
+    CounterType operator[](const AccessType type) const;
 
     // For a given position list, this determines whether its entries are in
     // sequential, monotonic, or random order. It only looks at the first n
@@ -62,11 +101,82 @@ class SegmentAccessCounter
 
     std::string to_string() const;
 
-    std::array<CounterType, static_cast<size_t>(AccessType::Count)>& get_counter();
+    std::array<CounterType, static_cast<size_t>(AccessType::Count)>
+    get_counter() const;
+
+    // Recording heatmaps takes a lock per iterator or accessor and is
+    // therefore disabled by default.
+    static void enable_heatmaps(const bool enabled);
+    static bool heatmaps_enabled();
+
+    // Records a sequential access to the elements [begin, end) of a buffer of
+    // buffer_bytes bytes holding element_count elements.
+    void record_range(const size_t buffer_bytes, const size_t element_count,
+                      const ChunkOffset begin, const ChunkOffset end);
+
+    // Records point accesses to the given offsets (or RowIDs of a PosList)
+    // of a buffer of buffer_bytes bytes holding element_count elements.
+    template <typename Positions>
+    void record_positions(const AccessType type, const size_t buffer_bytes,
+                          const size_t element_count,
+                          const Positions &positions)
+    {
+        if (!heatmaps_enabled() || buffer_bytes == 0 || element_count == 0)
+        {
+            return;
+        }
+
+        const auto element_bytes =
+            std::max(buffer_bytes / element_count, size_t{1});
+        auto &heatmap = _heatmap();
+        const auto lock = std::lock_guard<std::mutex>{heatmap.mutex};
+        for (const auto &position : positions)
+        {
+            auto chunk_offset = ChunkOffset{};
+            if constexpr (std::is_same_v<std::decay_t<decltype(position)>,
+                                         RowID>)
+            {
+                chunk_offset = position.chunk_offset;
+            }
+            else
+            {
+                chunk_offset = position;
+            }
+            _add_bytes(heatmap.pages, type,
+                       chunk_offset * buffer_bytes / element_count,
+                       element_bytes);
+        }
+    }
+
+    // Returns an empty heatmap if no accesses were recorded.
+    PageHeatmap heatmap() const;
 
   private:
-    std::array<CounterType, static_cast<size_t>(AccessType::Count)> _counters =
-        {};
+    struct alignas(64) Shard
+    {
+        std::array<std::atomic<CounterType>,
+                   static_cast<size_t>(AccessType::Count)>
+            counters{};
+    };
+
+    struct Heatmap
+    {
+        std::mutex mutex;
+        PageHeatmap pages;
+    };
+
+    // Both are allocated on first use so that segments that are never
+    // accessed stay small.
+    std::atomic<std::array<Shard, SHARD_COUNT> *> _shards{nullptr};
+    std::atomic<Heatmap *> _heatmap_ptr{nullptr};
+
+    std::array<Shard, SHARD_COUNT> &_shards_or_allocate();
+    Heatmap &_heatmap();
+    static size_t _thread_shard();
+    static void _add_bytes(PageHeatmap &pages, const AccessType type,
+                           const size_t byte_offset, const size_t bytes);
+
+    static std::atomic_bool _heatmaps_enabled;
 
     // For access pattern analysis: The following enum is used used to determine
     // how an iterator iterates over its elements. This is done by analysing the
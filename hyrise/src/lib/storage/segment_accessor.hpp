@@ -6,6 +6,7 @@
 
 #include "storage/base_segment_accessor.hpp"
 #include "storage/dictionary_segment.hpp"
+#include "storage/value_segment.hpp"
 #include "types.hpp"
 #include "utils/performance_warning.hpp"
 
@@ -27,6 +28,25 @@ template <typename T> class CreateSegmentAccessor
 
 EXPLICITLY_DECLARE_DATA_TYPES(CreateSegmentAccessor);
 
+// Size of the buffer that the page heatmap of a segment refers to (see
+// SegmentAccessCounter). Segments of other types do not record a heatmap.
+template <typename T, typename SegmentType>
+size_t heatmap_buffer_bytes(const SegmentType &segment)
+{
+    if constexpr (std::is_same_v<SegmentType, ValueSegment<T>>)
+    {
+        return segment.values().size() * sizeof(T);
+    }
+    else if constexpr (std::is_same_v<SegmentType, DictionarySegment<T>>)
+    {
+        return segment.attribute_vector()->data_size();
+    }
+    else
+    {
+        return 0;
+    }
+}
+
 } // namespace detail
 
 /**
@@ -60,6 +80,10 @@ class SegmentAccessor final : public AbstractSegmentAccessor<T>
     const std::optional<T> access(ChunkOffset offset) const final
     {
         ++_accesses;
+        if (SegmentAccessCounter::heatmaps_enabled())
+        {
+            _heatmap_offsets.push_back(offset);
+        }
         return _segment.get_typed_value(offset);
     }
 
@@ -67,10 +91,15 @@ class SegmentAccessor final : public AbstractSegmentAccessor<T>
     {
         _segment.access_counter[SegmentAccessCounter::AccessType::Random] +=
             _accesses;
+        _segment.access_counter.record_positions(
+            SegmentAccessCounter::AccessType::Random,
+            detail::heatmap_buffer_bytes<T>(_segment), _segment.size(),
+            _heatmap_offsets);
     }
 
   protected:
     mutable uint64_t _accesses{0};
+    mutable std::vector<ChunkOffset> _heatmap_offsets;
     const SegmentType &_segment;
 };
 
@@ -148,6 +177,10 @@ class SingleChunkReferenceSegmentAccessor final
     {
         ++_accesses;
         const auto referenced_chunk_offset = _pos_list[offset].chunk_offset;
+        if (SegmentAccessCounter::heatmaps_enabled())
+        {
+            _heatmap_offsets.push_back(referenced_chunk_offset);
+        }
         return _segment.get_typed_value(referenced_chunk_offset);
     }
 
@@ -155,10 +188,15 @@ class SingleChunkReferenceSegmentAccessor final
     {
         _segment.access_counter[SegmentAccessCounter::AccessType::Random] +=
             _accesses;
+        _segment.access_counter.record_positions(
+            SegmentAccessCounter::AccessType::Random,
+            detail::heatmap_buffer_bytes<T>(_segment), _segment.size(),
+            _heatmap_offsets);
     }
 
   protected:
     mutable uint64_t _accesses{0};
+    mutable std::vector<ChunkOffset> _heatmap_offsets;
     const AbstractPosList &_pos_list;
     const ChunkID _chunk_id;
     const Segment &_segment;
@@ -3,10 +3,13 @@
 #include <map>
 #include <memory>
 
+#include "resolve_type.hpp"
 #include "storage/dictionary_segment/dictionary_encoder.hpp"
 #include "storage/frame_of_reference_segment/frame_of_reference_encoder.hpp"
 #include "storage/lz4_segment/lz4_encoder.hpp"
+#include "storage/reference_segment.hpp"
 #include "storage/run_length_segment/run_length_encoder.hpp"
+#include "storage/table.hpp"
 
 #include "utils/assert.hpp"
 #include "utils/enum_constant.hpp"
@@ -76,6 +79,80 @@ get_segment_encoding_spec(const std::shared_ptr<const AbstractSegment> &segment)
     Fail("Unexpected segment encoding found.");
 }
 
+MemoryTier get_segment_memory_tier(const AbstractSegment &segment)
+{
+    // ReferenceSegments do not own data, so we look at the segment they
+    // reference. Checking every referenced chunk would cost a pass over the
+    // positions, so the chunk of the first position stands for all of them.
+    // This is exact for the common case of positions from a single chunk.
+    if (const auto *const reference_segment =
+            dynamic_cast<const ReferenceSegment *>(&segment))
+    {
+        const auto &pos_list = *reference_segment->pos_list();
+        if (pos_list.empty())
+        {
+            return MemoryTier::Near;
+        }
+        const auto chunk_id = pos_list.references_single_chunk()
+                                  ? pos_list.common_chunk_id()
+                                  : pos_list[0].chunk_id;
+        const auto chunk =
+            chunk_id != INVALID_CHUNK_ID
+                ? reference_segment->referenced_table()->get_chunk(chunk_id)
+                : nullptr;
+        return chunk ? get_segment_memory_tier(*chunk->get_segment(
+                           reference_segment->referenced_column_id()))
+                     : MemoryTier::Near;
+    }
+
+    // All buffers of a segment are allocated from the same memory resource
+    // (see copy_using_allocator()). Thus, the primary data buffer of the
+    // segment tells its tier.
+    auto data = static_cast<const void *>(nullptr);
+    resolve_data_and_segment_type(
+        segment,
+        [&](const auto /*data_type_t*/, const auto &typed_segment)
+        {
+            if constexpr (requires { typed_segment.values().data(); })
+            {
+                // ValueSegment
+                data = typed_segment.values().data();
+            }
+            else if constexpr (requires { typed_segment.values()->data(); })
+            {
+                // RunLengthSegment
+                data = typed_segment.values()->data();
+            }
+            else if constexpr (requires {
+                                   typed_segment.dictionary()->data();
+                               })
+            {
+                // DictionarySegment
+                data = typed_segment.dictionary()->data();
+            }
+            else if constexpr (requires {
+                                   typed_segment.fixed_string_dictionary()
+                                       ->data();
+                               })
+            {
+                data = typed_segment.fixed_string_dictionary()->data();
+            }
+            else if constexpr (requires {
+                                   typed_segment.block_minima().data();
+                               })
+            {
+                // FrameOfReferenceSegment
+                data = typed_segment.block_minima().data();
+            }
+            else if constexpr (requires { typed_segment.lz4_blocks().data(); })
+            {
+                data = typed_segment.lz4_blocks().data();
+            }
+        });
+
+    return data ? memory_tier_of(data) : MemoryTier::Near;
+}
+
 VectorCompressionType parent_vector_compression_type(
     const CompressedVectorType compressed_vector_type)
 {
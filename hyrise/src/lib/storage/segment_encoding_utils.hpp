@@ -4,6 +4,7 @@
 #include <optional>
 
 #include "all_type_variant.hpp"
+#include "memory/tiered_memory_resource.hpp"
 #include "storage/abstract_segment.hpp"
 #include "storage/encoding_type.hpp"
 #include "storage/vector_compression/vector_compression.hpp"
@@ -26,6 +27,13 @@ std::unique_ptr<BaseSegmentEncoder> create_encoder(EncodingType encoding_type);
 SegmentEncodingSpec get_segment_encoding_spec(
     const std::shared_ptr<const AbstractSegment> &segment);
 
+/**
+ * @return the memory tier the segment's data has been allocated from.
+ * ReferenceSegments return the tier of the segment that their first position
+ * references, which is exact if all positions reference the same chunk.
+ */
+MemoryTier get_segment_memory_tier(const AbstractSegment &segment);
+
 /**
  * @brief Returns the vector compression type for a given compressed vector
  * type.
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <algorithm>
+
 #include <boost/iterator/iterator_facade.hpp>
 
 #include "storage/pos_lists/row_id_pos_list.hpp"
@@ -67,6 +69,11 @@ struct ChunkOffsetMapping
  * i.e., its underlying value or dictionary segment is iterated over.
  * The passed position_filter is used to select which of the iterable's values
  * are returned.
+ *
+ * As the positions are known upfront, the iterator can prefetch the values of
+ * upcoming positions (see memory/prefetching.hpp). Derived iterators that
+ * support this shadow prefetch(), and their iterables call
+ * enable_prefetching() on the begin iterator.
  */
 
 template <typename Derived, typename Value, typename PosListIteratorType>
@@ -82,6 +89,28 @@ class AbstractPointAccessSegmentIterator
     {
     }
 
+    /**
+     * From now on, each increment prefetches the position that is @param
+     * distance positions ahead. The positions up to that distance are
+     * prefetched right away. @param position_filter_end bounds the prefetched
+     * positions.
+     */
+    void enable_prefetching(const PosListIteratorType &position_filter_end,
+                            const size_t distance)
+    {
+        _prefetch_distance = static_cast<std::ptrdiff_t>(distance);
+        _position_filter_size = position_filter_end - _position_filter_begin;
+
+        const auto index = _position_filter_it - _position_filter_begin;
+        const auto warm_up_end =
+            std::min(index + _prefetch_distance, _position_filter_size);
+        for (auto prefetch_index = index; prefetch_index < warm_up_end;
+             ++prefetch_index)
+        {
+            _prefetch(prefetch_index);
+        }
+    }
+
   protected:
     const ChunkOffsetMapping chunk_offsets() const
     {
@@ -93,12 +122,29 @@ class AbstractPointAccessSegmentIterator
                 _position_filter_it->chunk_offset};
     }
 
+    // Issues the prefetches for the value at @param chunk_offset of the
+    // referenced segment. No-op unless shadowed by the derived iterator.
+    void prefetch(const ChunkOffset /*chunk_offset*/) const {}
+
   private:
     friend class boost::iterator_core_access; // grants the
                                               // boost::iterator_facade access
                                               // to the private interface
 
-    void increment() { ++_position_filter_it; }
+    void increment()
+    {
+        ++_position_filter_it;
+        if (_prefetch_distance > 0)
+        {
+            const auto prefetch_index =
+                (_position_filter_it - _position_filter_begin) +
+                _prefetch_distance - 1;
+            if (prefetch_index < _position_filter_size)
+            {
+                _prefetch(prefetch_index);
+            }
+        }
+    }
 
     void decrement() { --_position_filter_it; }
 
@@ -115,9 +161,22 @@ class AbstractPointAccessSegmentIterator
         return other._position_filter_it - _position_filter_it;
     }
 
+    void _prefetch(const std::ptrdiff_t index) const
+    {
+        // Positions of NULL values do not reference a value.
+        const auto chunk_offset = (_position_filter_begin + index)->chunk_offset;
+        if (chunk_offset != INVALID_CHUNK_OFFSET)
+        {
+            static_cast<const Derived &>(*this).prefetch(chunk_offset);
+        }
+    }
+
   private:
     PosListIteratorType _position_filter_begin;
     PosListIteratorType _position_filter_it;
+
+    std::ptrdiff_t _prefetch_distance{0};
+    std::ptrdiff_t _position_filter_size{0};
 };
 
 } // namespace hyrise
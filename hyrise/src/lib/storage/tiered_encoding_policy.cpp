@@ -0,0 +1,105 @@
+#include "tiered_encoding_policy.hpp"
+
+#include "storage/base_segment_encoder.hpp"
+#include "storage/segment_encoding_utils.hpp"
+#include "utils/assert.hpp"
+
+namespace hyrise
+{
+
+TieredEncodingPolicy::TieredEncodingPolicy()
+    : _scan_bandwidths{DEFAULT_NEAR_SCAN_BANDWIDTH, DEFAULT_FAR_SCAN_BANDWIDTH}
+{
+    // Unencoded values are read as they are. Dictionary and run-length
+    // encoding add an indirection per value, FrameOfReference an addition per
+    // value. LZ4 decompresses whole blocks, which is by far the most
+    // expensive.
+    _decode_costs[static_cast<size_t>(EncodingType::Unencoded)] = 0.0;
+    _decode_costs[static_cast<size_t>(EncodingType::Dictionary)] = 0.5;
+    _decode_costs[static_cast<size_t>(EncodingType::RunLength)] = 0.5;
+    _decode_costs[static_cast<size_t>(EncodingType::FixedStringDictionary)] =
+        1.0;
+    _decode_costs[static_cast<size_t>(EncodingType::FrameOfReference)] = 0.3;
+    _decode_costs[static_cast<size_t>(EncodingType::LZ4)] = 4.0;
+}
+
+void TieredEncodingPolicy::set_scan_bandwidth(const MemoryTier tier,
+                                              const size_t bandwidth)
+{
+    Assert(bandwidth > 0, "Scan bandwidth must be positive.");
+    _scan_bandwidths[static_cast<size_t>(tier)] = bandwidth;
+}
+
+size_t TieredEncodingPolicy::scan_bandwidth(const MemoryTier tier) const
+{
+    return _scan_bandwidths[static_cast<size_t>(tier)];
+}
+
+void TieredEncodingPolicy::set_decode_cost(const EncodingType encoding_type,
+                                           const double cost)
+{
+    Assert(cost >= 0.0, "Decode cost must not be negative.");
+    _decode_costs[static_cast<size_t>(encoding_type)] = cost;
+}
+
+double
+TieredEncodingPolicy::decode_cost(const SegmentEncodingSpec &encoding_spec) const
+{
+    auto cost = _decode_costs[static_cast<size_t>(encoding_spec.encoding_type)];
+    if (encoding_spec.vector_compression_type ==
+        VectorCompressionType::BitPacking)
+    {
+        cost += BIT_PACKING_DECODE_COST;
+    }
+    return cost;
+}
+
+double TieredEncodingPolicy::estimate_scan_cost(
+    const SegmentEncodingSpec &encoding_spec, const size_t bytes,
+    const size_t row_count, const MemoryTier tier) const
+{
+    const auto transfer_cost = static_cast<double>(bytes) * 1'000'000'000.0 /
+                               static_cast<double>(scan_bandwidth(tier));
+    return transfer_cost +
+           static_cast<double>(row_count) * decode_cost(encoding_spec);
+}
+
+std::vector<SegmentEncodingSpec>
+TieredEncodingPolicy::candidates(const DataType data_type)
+{
+    auto specs = std::vector<SegmentEncodingSpec>{};
+    for (const auto encoding_type : encoding_types)
+    {
+        if (!encoding_supports_data_type(encoding_type, data_type))
+        {
+            continue;
+        }
+
+        // LZ4 only compresses the offsets of string values with a vector
+        // compression, so we leave the choice to the encoder.
+        if (encoding_type == EncodingType::Unencoded ||
+            encoding_type == EncodingType::LZ4 ||
+            !create_encoder(encoding_type)->uses_vector_compression())
+        {
+            specs.emplace_back(encoding_type);
+            continue;
+        }
+
+        for (const auto vector_compression_type :
+             {VectorCompressionType::FixedWidthInteger,
+              VectorCompressionType::BitPacking})
+        {
+            specs.emplace_back(encoding_type, vector_compression_type);
+        }
+    }
+    return specs;
+}
+
+double TieredEncodingResult::compression_ratio() const
+{
+    DebugAssert(encoded_bytes > 0, "Encoded segment has no size.");
+    return static_cast<double>(original_bytes) /
+           static_cast<double>(encoded_bytes);
+}
+
+} // namespace hyrise
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "all_type_variant.hpp"
+#include "memory/tiered_memory_resource.hpp"
+#include "storage/encoding_type.hpp"
+
+namespace hyrise
+{
+
+class AbstractSegment;
+
+/**
+ * Chooses the encoding of a segment by the memory tier it is placed in.
+ *
+ * Scans over the far tier are bound by its bandwidth, which is a fraction of
+ * the local DRAM bandwidth. Heavier compression trades decoding work for fewer
+ * bytes to read, which does not pay off in near memory but does in far memory.
+ * The policy estimates the time to scan a segment as
+ *
+ *   encoded bytes / scan bandwidth of the tier + rows * decode cost per value
+ *
+ * and picks the cheapest of the encodings that support the column's data type.
+ * The bandwidths are those a single scanning thread achieves; the decode costs
+ * are rough per-value costs of the encodings' iterators.
+ */
+class TieredEncodingPolicy
+{
+  public:
+    TieredEncodingPolicy();
+
+    // Bytes per second a single thread reads when scanning the tier.
+    void set_scan_bandwidth(const MemoryTier tier, const size_t bandwidth);
+    size_t scan_bandwidth(const MemoryTier tier) const;
+
+    // Nanoseconds to decode a single value. Bit-packed vector compression adds
+    // BIT_PACKING_DECODE_COST to the cost of the encoding.
+    void set_decode_cost(const EncodingType encoding_type, const double cost);
+    double decode_cost(const SegmentEncodingSpec &encoding_spec) const;
+
+    // Estimated time (in ns) to scan a segment encoded with @param
+    // encoding_spec from @param tier.
+    double estimate_scan_cost(const SegmentEncodingSpec &encoding_spec,
+                              const size_t bytes, const size_t row_count,
+                              const MemoryTier tier) const;
+
+    // The encodings considered for a column of @param data_type.
+    static std::vector<SegmentEncodingSpec> candidates(const DataType data_type);
+
+    static constexpr size_t DEFAULT_NEAR_SCAN_BANDWIDTH = size_t{10'000'000'000};
+    static constexpr size_t DEFAULT_FAR_SCAN_BANDWIDTH = size_t{2'500'000'000};
+    static constexpr double BIT_PACKING_DECODE_COST = 0.5;
+
+  private:
+    std::array<size_t, 2> _scan_bandwidths;
+    std::array<double, magic_enum::enum_count<EncodingType>()> _decode_costs;
+};
+
+// A segment encoded for a memory tier.
+struct TieredEncodingResult
+{
+    std::shared_ptr<AbstractSegment> segment;
+    SegmentEncodingSpec encoding_spec;
+
+    size_t original_bytes{0};
+    size_t encoded_bytes{0};
+
+    double compression_ratio() const;
+};
+
+} // namespace hyrise
@@ -3,6 +3,7 @@
 #include <utility>
 #include <vector>
 
+#include "memory/prefetching.hpp"
 #include "storage/pos_lists/abstract_pos_list.hpp"
 #include "storage/segment_iterables.hpp"
 #include "storage/value_segment.hpp"
@@ -27,6 +28,9 @@ class ValueSegmentIterable
     {
         _segment.access_counter[SegmentAccessCounter::AccessType::Sequential] +=
             _segment.size();
+        _segment.access_counter.record_range(
+            _segment.values().size() * sizeof(T), _segment.size(),
+            ChunkOffset{0}, static_cast<ChunkOffset>(_segment.size()));
         if (_segment.is_nullable())
         {
             auto begin =
@@ -51,12 +55,18 @@ class ValueSegmentIterable
     void _on_with_iterators(const std::shared_ptr<PosListType> &position_filter,
                             const Functor &functor) const
     {
-        _segment.access_counter[SegmentAccessCounter::access_type(
-            *position_filter)] += position_filter->size();
+        const auto access_type =
+            SegmentAccessCounter::access_type(*position_filter);
+        _segment.access_counter[access_type] += position_filter->size();
+        _segment.access_counter.record_positions(
+            access_type, _segment.values().size() * sizeof(T), _segment.size(),
+            *position_filter);
 
         using PosListIteratorType =
             std::decay_t<decltype(position_filter->cbegin())>;
 
+        const auto distance = prefetch_distance(_segment.values().data());
+
         if (_segment.is_nullable())
         {
             auto begin = PointAccessIterator<PosListIteratorType>{
@@ -65,6 +75,10 @@ class ValueSegmentIterable
             auto end = PointAccessIterator<PosListIteratorType>{
                 _segment.values().cbegin(), _segment.null_values().cbegin(),
                 position_filter->cbegin(), position_filter->cend()};
+            if (distance > 0)
+            {
+                begin.enable_prefetching(position_filter->cend(), distance);
+            }
             functor(begin, end);
         }
         else
@@ -75,6 +89,10 @@ class ValueSegmentIterable
             auto end = NonNullPointAccessIterator<PosListIteratorType>{
                 _segment.values().cbegin(), position_filter->cbegin(),
                 position_filter->cend()};
+            if (distance > 0)
+            {
+                begin.enable_prefetching(position_filter->cend(), distance);
+            }
             functor(begin, end);
         }
     }
@@ -237,6 +255,11 @@ class ValueSegmentIterable
         {
         }
 
+        void prefetch(const ChunkOffset chunk_offset) const
+        {
+            prefetch_for_read(&*(_values_begin_it + chunk_offset));
+        }
+
       private:
         friend class boost::
             iterator_core_access; // grants the boost::iterator_facade access to
@@ -281,6 +304,13 @@ class ValueSegmentIterable
         {
         }
 
+        // The NULL flags are bit-packed and thus are likely to be cached
+        // already.
+        void prefetch(const ChunkOffset chunk_offset) const
+        {
+            prefetch_for_read(&*(_values_begin_it + chunk_offset));
+        }
+
       private:
         friend class boost::
             iterator_core_access; // grants the boost::iterator_facade access to
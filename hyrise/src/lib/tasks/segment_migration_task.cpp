@@ -0,0 +1,174 @@
+#include "segment_migration_task.hpp"
+
+#include <thread>
+
+#include "hyrise.hpp"
+#include "storage/chunk.hpp"
+#include "storage/chunk_encoder.hpp"
+#include "storage/segment_encoding_utils.hpp"
+#include "storage/table.hpp"
+#include "utils/assert.hpp"
+#include "utils/timer.hpp"
+
+namespace hyrise
+{
+
+MigrationRateLimiter::MigrationRateLimiter(const size_t init_bytes_per_second)
+    : bytes_per_second{init_bytes_per_second},
+      _next_slot{std::chrono::steady_clock::now()}
+{
+}
+
+std::chrono::nanoseconds MigrationRateLimiter::acquire(const size_t bytes)
+{
+    if (bytes_per_second == 0)
+    {
+        return std::chrono::nanoseconds{0};
+    }
+
+    const auto now = std::chrono::steady_clock::now();
+    auto slot = now;
+    {
+        const auto lock = std::lock_guard<std::mutex>{_mutex};
+        // Unused bandwidth of idle phases is not saved up, so that a migration
+        // that starts after a break does not burst.
+        slot = std::max(_next_slot, now);
+        _next_slot =
+            slot + std::chrono::nanoseconds{bytes * std::nano::den /
+                                            bytes_per_second};
+    }
+
+    std::this_thread::sleep_until(slot);
+    return slot - now;
+}
+
+SegmentMigrationTask::SegmentMigrationTask(
+    const std::string &table_name, const ChunkID chunk_id,
+    const std::vector<ColumnID> &column_ids, const MemoryTier target_tier,
+    const std::shared_ptr<MigrationRateLimiter> &rate_limiter,
+    const std::shared_ptr<SegmentMigrationStatistics> &statistics,
+    const std::shared_ptr<const TieredEncodingPolicy> &encoding_policy)
+    : _table_name{table_name}, _chunk_id{chunk_id}, _column_ids{column_ids},
+      _target_tier{target_tier}, _rate_limiter{rate_limiter},
+      _statistics{statistics}, _encoding_policy{encoding_policy}
+{
+}
+
+std::vector<std::shared_ptr<AbstractTask>> SegmentMigrationTask::make_for_table(
+    const std::string &table_name, const std::vector<ColumnID> &column_ids,
+    const MemoryTier target_tier,
+    const std::shared_ptr<MigrationRateLimiter> &rate_limiter,
+    const std::shared_ptr<SegmentMigrationStatistics> &statistics,
+    const size_t parallelism,
+    const std::shared_ptr<const TieredEncodingPolicy> &encoding_policy)
+{
+    Assert(parallelism > 0, "Migration needs at least one task at a time.");
+    const auto table = Hyrise::get().storage_manager.get_table(table_name);
+
+    auto tasks = std::vector<std::shared_ptr<AbstractTask>>{};
+    const auto chunk_count = table->chunk_count();
+    for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id)
+    {
+        const auto chunk = table->get_chunk(chunk_id);
+        if (!chunk || chunk->is_mutable())
+        {
+            continue;
+        }
+
+        auto task = std::make_shared<SegmentMigrationTask>(
+            table_name, chunk_id, column_ids, target_tier, rate_limiter,
+            statistics, encoding_policy);
+        if (tasks.size() >= parallelism)
+        {
+            tasks[tasks.size() - parallelism]->set_as_predecessor_of(task);
+        }
+        tasks.emplace_back(std::move(task));
+    }
+    return tasks;
+}
+
+const std::vector<std::shared_ptr<AbstractSegment>> &
+SegmentMigrationTask::migrated_segments() const
+{
+    DebugAssert(is_done(), "Migration has not finished yet.");
+    return _migrated_segments;
+}
+
+void SegmentMigrationTask::_on_execute()
+{
+    auto &storage_manager = Hyrise::get().storage_manager;
+    _migrated_segments.assign(_column_ids.size(), nullptr);
+    if (!storage_manager.has_table(_table_name))
+    {
+        // The table has been dropped in the meantime.
+        return;
+    }
+
+    const auto table = storage_manager.get_table(_table_name);
+    Assert(_chunk_id < table->chunk_count(),
+           "Chunk with given ID does not exist.");
+    const auto chunk = table->get_chunk(_chunk_id);
+    if (!chunk)
+    {
+        // The chunk has been deleted physically.
+        return;
+    }
+    Assert(!chunk->is_mutable(), "Only immutable chunks can be migrated.");
+
+    for (auto column_index = size_t{0}; column_index < _column_ids.size();
+         ++column_index)
+    {
+        const auto column_id = _column_ids[column_index];
+        const auto segment = chunk->get_segment(column_id);
+        const auto bytes =
+            segment->memory_usage(MemoryUsageCalculationMode::Sampled);
+
+        const auto stall_time =
+            _rate_limiter ? _rate_limiter->acquire(bytes)
+                          : std::chrono::nanoseconds{0};
+
+        auto copy_timer = Timer{};
+        const auto data_type = table->column_data_type(column_id);
+        auto migrated_segment = std::shared_ptr<AbstractSegment>{};
+        auto encoded_bytes = bytes;
+        if (_encoding_policy)
+        {
+            auto encoding_result = ChunkEncoder::encode_segment_for_tier(
+                segment, data_type, _target_tier, *_encoding_policy);
+            migrated_segment = std::move(encoding_result.segment);
+            encoded_bytes = encoding_result.encoded_bytes;
+        }
+        else
+        {
+            migrated_segment = ChunkEncoder::encode_segment(
+                segment, data_type, get_segment_encoding_spec(segment),
+                _target_tier);
+        }
+        const auto copy_time = copy_timer.lap();
+
+        const auto replaced =
+            chunk->try_replace_segment(column_id, segment, migrated_segment);
+        if (replaced)
+        {
+            _migrated_segments[column_index] = migrated_segment;
+        }
+
+        if (_statistics)
+        {
+            if (replaced)
+            {
+                ++_statistics->migrated_segment_count;
+                _statistics->migrated_bytes += bytes;
+                _statistics->encoded_bytes += encoded_bytes;
+            }
+            else
+            {
+                ++_statistics->skipped_segment_count;
+            }
+            _statistics->stall_time += stall_time.count();
+            _statistics->copy_time += copy_time.count();
+        }
+    }
+}
+
+} // namespace hyrise
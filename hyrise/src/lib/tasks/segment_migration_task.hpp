@@ -0,0 +1,126 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "memory/tiered_memory_resource.hpp"
+#include "scheduler/abstract_task.hpp"
+#include "storage/tiered_encoding_policy.hpp"
+
+namespace hyrise
+{
+
+class AbstractSegment;
+
+/**
+ * Paces migrations to a maximum bandwidth so that they leave enough memory
+ * bandwidth to the queries. Each copy reserves the next slot of the limiter;
+ * the caller then sleeps until its slot has started. Shared by all tasks of a
+ * migration. A bandwidth of zero disables the limit.
+ */
+class MigrationRateLimiter : public Noncopyable
+{
+  public:
+    explicit MigrationRateLimiter(const size_t init_bytes_per_second);
+
+    // Blocks until @param bytes may be copied. Returns the time spent waiting.
+    std::chrono::nanoseconds acquire(const size_t bytes);
+
+    const size_t bytes_per_second;
+
+  private:
+    std::mutex _mutex;
+    std::chrono::steady_clock::time_point _next_slot;
+};
+
+// Counters of a migration, updated by all of its tasks.
+struct SegmentMigrationStatistics
+{
+    std::atomic<size_t> migrated_segment_count{0};
+    std::atomic<size_t> migrated_bytes{0};
+
+    // Size of the migrated segments in the target tier. Differs from
+    // migrated_bytes if the segments have been re-encoded.
+    std::atomic<size_t> encoded_bytes{0};
+
+    // Segments that have been replaced concurrently (e.g., re-encoded) and
+    // are thus not migrated.
+    std::atomic<size_t> skipped_segment_count{0};
+
+    // Time (in ns) the tasks waited for the rate limiter and spent copying.
+    std::atomic<uint64_t> stall_time{0};
+    std::atomic<uint64_t> copy_time{0};
+};
+
+/**
+ * @brief Moves segments of a chunk to another memory tier
+ *
+ * Each segment is copied into a new allocation from the target tier's memory
+ * resource (keeping its encoding) and then swapped into the chunk atomically.
+ * Concurrent queries are not blocked: operators that already hold the old
+ * segment continue to read it through their shared_ptr, and the old memory is
+ * released once the last of them is done. New operators read the migrated
+ * segment. As the content of a segment does not change, MVCC data and position
+ * lists referencing the chunk remain valid.
+ *
+ * If an encoding policy is passed, the segments are re-encoded with the
+ * encoding that the policy deems cheapest to scan from the target tier (e.g.,
+ * heavier compression for the far tier) instead of keeping their encoding.
+ *
+ * If a segment has been replaced between copying and swapping (e.g., by a
+ * ChunkCompressionTask), the copy is dropped instead of overwriting the newer
+ * segment. Like compression, migration is restricted to immutable chunks.
+ */
+class SegmentMigrationTask : public AbstractTask
+{
+  public:
+    SegmentMigrationTask(
+        const std::string &table_name, const ChunkID chunk_id,
+        const std::vector<ColumnID> &column_ids, const MemoryTier target_tier,
+        const std::shared_ptr<MigrationRateLimiter> &rate_limiter = nullptr,
+        const std::shared_ptr<SegmentMigrationStatistics> &statistics =
+            nullptr,
+        const std::shared_ptr<const TieredEncodingPolicy> &encoding_policy =
+            nullptr);
+
+    /**
+     * Creates one task per immutable chunk of the table. The tasks are chained
+     * so that at most @param parallelism of them run at the same time, which
+     * bounds the number of workers the migration occupies.
+     */
+    static std::vector<std::shared_ptr<AbstractTask>> make_for_table(
+        const std::string &table_name, const std::vector<ColumnID> &column_ids,
+        const MemoryTier target_tier,
+        const std::shared_ptr<MigrationRateLimiter> &rate_limiter = nullptr,
+        const std::shared_ptr<SegmentMigrationStatistics> &statistics = nullptr,
+        const size_t parallelism = DEFAULT_PARALLELISM,
+        const std::shared_ptr<const TieredEncodingPolicy> &encoding_policy =
+            nullptr);
+
+    // The segments swapped in, one per column (nullptr if skipped). Only valid
+    // once the task is done.
+    const std::vector<std::shared_ptr<AbstractSegment>> &
+    migrated_segments() const;
+
+    static constexpr size_t DEFAULT_PARALLELISM = 2;
+
+  protected:
+    void _on_execute() override;
+
+  private:
+    const std::string _table_name;
+    const ChunkID _chunk_id;
+    const std::vector<ColumnID> _column_ids;
+    const MemoryTier _target_tier;
+    const std::shared_ptr<MigrationRateLimiter> _rate_limiter;
+    const std::shared_ptr<SegmentMigrationStatistics> _statistics;
+    const std::shared_ptr<const TieredEncodingPolicy> _encoding_policy;
+
+    std::vector<std::shared_ptr<AbstractSegment>> _migrated_segments;
+};
+
+} // namespace hyrise
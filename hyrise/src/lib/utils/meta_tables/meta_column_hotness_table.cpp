@@ -0,0 +1,67 @@
+#include "meta_column_hotness_table.hpp"
+
+#include "cost_estimation/column_hotness_estimator.hpp"
+#include "hyrise.hpp"
+#include "statistics/cardinality_estimator.hpp"
+
+namespace hyrise
+{
+
+MetaColumnHotnessTable::MetaColumnHotnessTable()
+    : AbstractMetaTable(
+          TableColumnDefinitions{{"sql_string", DataType::String, false},
+                                 {"frequency", DataType::Long, true},
+                                 {"table_name", DataType::String, false},
+                                 {"chunk_id", DataType::Int, false},
+                                 {"column_id", DataType::Int, false},
+                                 {"column_name", DataType::String, false},
+                                 {"estimated_rows", DataType::Float, false},
+                                 {"estimated_bytes", DataType::Float, false}})
+{
+}
+
+const std::string &MetaColumnHotnessTable::name() const
+{
+    static const auto name = std::string{"column_hotness"};
+    return name;
+}
+
+std::shared_ptr<Table> MetaColumnHotnessTable::_on_generate() const
+{
+    auto output_table = std::make_shared<Table>(
+        _column_definitions, TableType::Data, std::nullopt, UseMvcc::Yes);
+
+    const auto &lqp_cache = Hyrise::get().default_lqp_cache;
+    if (!lqp_cache)
+    {
+        return output_table;
+    }
+
+    const auto estimator =
+        ColumnHotnessEstimator{std::make_shared<CardinalityEstimator>()};
+    const auto &storage_manager = Hyrise::get().storage_manager;
+
+    for (const auto &[sql_string, entry] : lqp_cache->snapshot())
+    {
+        const auto frequency =
+            entry.frequency
+                ? AllTypeVariant{static_cast<int64_t>(*entry.frequency)}
+                : AllTypeVariant{NULL_VALUE};
+
+        for (const auto &hotness : estimator.estimate(entry.value))
+        {
+            const auto table = storage_manager.get_table(hotness.table_name);
+            output_table->append(
+                {pmr_string{sql_string}, frequency,
+                 pmr_string{hotness.table_name},
+                 static_cast<int32_t>(hotness.chunk_id),
+                 static_cast<int32_t>(hotness.column_id),
+                 pmr_string{table->column_name(hotness.column_id)},
+                 hotness.row_count, hotness.bytes});
+        }
+    }
+
+    return output_table;
+}
+
+} // namespace hyrise
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "utils/meta_tables/abstract_meta_table.hpp"
+
+namespace hyrise
+{
+
+/**
+ * This is a class for showing the estimated accesses of the cached queries to
+ * the stored segments (see ColumnHotnessEstimator). There is one row per query
+ * in the default LQP cache and segment it reads, together with the query's
+ * frequency in the cache. Thus, the workload's expected traffic per segment is
+ * the sum of estimated_bytes * frequency.
+ */
+class MetaColumnHotnessTable : public AbstractMetaTable
+{
+  public:
+    MetaColumnHotnessTable();
+
+    const std::string &name() const final;
+
+  protected:
+    std::shared_ptr<Table> _on_generate() const final;
+};
+
+} // namespace hyrise
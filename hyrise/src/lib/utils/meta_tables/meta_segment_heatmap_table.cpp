@@ -0,0 +1,80 @@
+#include "meta_segment_heatmap_table.hpp"
+
+#include "hyrise.hpp"
+
+namespace hyrise
+{
+
+MetaSegmentHeatmapTable::MetaSegmentHeatmapTable()
+    : AbstractMetaTable(
+          TableColumnDefinitions{{"table_name", DataType::String, false},
+                                 {"chunk_id", DataType::Int, false},
+                                 {"column_id", DataType::Int, false},
+                                 {"column_name", DataType::String, false},
+                                 {"access_type", DataType::String, false},
+                                 {"page_id", DataType::Long, false},
+                                 {"bytes", DataType::Long, false}})
+{
+}
+
+const std::string &MetaSegmentHeatmapTable::name() const
+{
+    static const auto name = std::string{"segment_heatmap"};
+    return name;
+}
+
+std::shared_ptr<Table> MetaSegmentHeatmapTable::_on_generate() const
+{
+    auto output_table = std::make_shared<Table>(
+        _column_definitions, TableType::Data, std::nullopt, UseMvcc::Yes);
+
+    for (const auto &[table_name, table] :
+         Hyrise::get().storage_manager.tables())
+    {
+        const auto chunk_count = table->chunk_count();
+        for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id)
+        {
+            const auto &chunk = table->get_chunk(chunk_id);
+            // Skip physically deleted chunks
+            if (!chunk)
+            {
+                continue;
+            }
+
+            const auto column_count = table->column_count();
+            for (auto column_id = ColumnID{0}; column_id < column_count;
+                 ++column_id)
+            {
+                const auto heatmap =
+                    chunk->get_segment(column_id)->access_counter.heatmap();
+                const auto page_count = heatmap.size();
+                for (auto page_id = size_t{0}; page_id < page_count; ++page_id)
+                {
+                    for (const auto &[access_type, access_type_name] :
+                         SegmentAccessCounter::access_type_string_mapping)
+                    {
+                        const auto bytes =
+                            heatmap[page_id][static_cast<size_t>(access_type)];
+                        if (bytes == 0)
+                        {
+                            continue;
+                        }
+
+                        output_table->append(
+                            {pmr_string{table_name},
+                             static_cast<int32_t>(chunk_id),
+                             static_cast<int32_t>(column_id),
+                             pmr_string{table->column_name(column_id)},
+                             pmr_string{access_type_name},
+                             static_cast<int64_t>(page_id),
+                             static_cast<int64_t>(bytes)});
+                    }
+                }
+            }
+        }
+    }
+
+    return output_table;
+}
+
+} // namespace hyrise
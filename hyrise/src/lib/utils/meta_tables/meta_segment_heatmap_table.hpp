@@ -0,0 +1,25 @@
+#pragma once
+
+#include "utils/meta_tables/abstract_meta_table.hpp"
+
+namespace hyrise
+{
+
+/**
+ * This is a class for showing the page-level access heatmaps of all stored
+ * segments via a meta table. There is one row per segment, 4 KB page, and
+ * access type with the number of bytes touched. Heatmaps are only recorded if
+ * enabled via SegmentAccessCounter::enable_heatmaps().
+ */
+class MetaSegmentHeatmapTable : public AbstractMetaTable
+{
+  public:
+    MetaSegmentHeatmapTable();
+
+    const std::string &name() const final;
+
+  protected:
+    std::shared_ptr<Table> _on_generate() const final;
+};
+
+} // namespace hyrise
@@ -0,0 +1,356 @@
+#include "system_sampler.hpp"
+
+#include <algorithm>
+#include <array>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#endif
+
+#include <unistd.h>
+
+#include "utils/assert.hpp"
+#include "utils/pausable_loop_thread.hpp"
+
+namespace
+{
+
+using namespace hyrise; // NOLINT
+
+uint64_t ticks_to_ns(const uint64_t ticks)
+{
+    return ticks * std::nano::den / sysconf(_SC_CLK_TCK);
+}
+
+// The files in /proc might not be readable (e.g., in containers). In this
+// case, the values are left at zero instead of failing the query.
+void read_process_io(SystemSample &sample)
+{
+    auto io_file = std::ifstream{"/proc/self/io"};
+    auto key = std::string{};
+    auto value = uint64_t{0};
+    while (io_file >> key >> value)
+    {
+        if (key == "rchar:")
+        {
+            sample.io_read_chars = value;
+        }
+        else if (key == "wchar:")
+        {
+            sample.io_write_chars = value;
+        }
+        else if (key == "read_bytes:")
+        {
+            sample.io_read_bytes = value;
+        }
+        else if (key == "write_bytes:")
+        {
+            sample.io_write_bytes = value;
+        }
+    }
+}
+
+void read_system_cpu_times(SystemSample &sample)
+{
+    auto stat_file = std::ifstream{"/proc/stat"};
+    auto cpu_line = std::string{};
+    if (!std::getline(stat_file, cpu_line))
+    {
+        return;
+    }
+
+    // cpu  user nice system idle iowait irq softirq steal ...
+    auto cpu_stream = std::istringstream{cpu_line};
+    auto label = std::string{};
+    auto ticks = std::vector<uint64_t>{};
+    cpu_stream >> label;
+    for (auto value = uint64_t{0}; cpu_stream >> value;)
+    {
+        ticks.push_back(value);
+    }
+    if (ticks.size() < 8)
+    {
+        return;
+    }
+
+    sample.system_busy_time =
+        ticks_to_ns(ticks[0] + ticks[1] + ticks[2] + ticks[5] + ticks[6] +
+                    ticks[7]);
+    sample.system_idle_time = ticks_to_ns(ticks[3]);
+    sample.system_iowait_time = ticks_to_ns(ticks[4]);
+}
+
+void read_process_status(SystemSample &sample)
+{
+    auto status_file = std::ifstream{"/proc/self/status"};
+    auto line = std::string{};
+    while (std::getline(status_file, line))
+    {
+        auto line_stream = std::istringstream{line};
+        auto key = std::string{};
+        auto value = uint64_t{0};
+        line_stream >> key >> value;
+        if (key == "VmRSS:")
+        {
+            sample.process_rss = value * 1024;
+        }
+        else if (key == "Threads:")
+        {
+            sample.process_threads = value;
+        }
+    }
+}
+
+uint64_t process_cpu_time()
+{
+    auto time_spec = timespec{};
+    const auto ret = clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &time_spec);
+    Assert(ret == 0, "Failed in clock_gettime");
+    return time_spec.tv_sec * std::nano::den + time_spec.tv_nsec;
+}
+
+#ifdef __linux__
+int open_perf_event(const uint64_t config, const pid_t thread_id,
+                    const int group_fd)
+{
+    auto attributes = perf_event_attr{};
+    attributes.type = PERF_TYPE_HARDWARE;
+    attributes.size = sizeof(attributes);
+    attributes.config = config;
+    attributes.read_format = PERF_FORMAT_GROUP;
+    // Only count user space, which is allowed up to perf_event_paranoid=2.
+    attributes.exclude_kernel = 1;
+    attributes.exclude_hv = 1;
+    // Threads created while the sampler is running are counted as well.
+    attributes.inherit = 1;
+    return static_cast<int>(
+        syscall(SYS_perf_event_open, &attributes, thread_id, -1, group_fd, 0));
+}
+#endif
+
+} // namespace
+
+namespace hyrise
+{
+
+SystemSampler::SystemSampler(const std::chrono::milliseconds interval,
+                             const size_t capacity)
+    : _interval{interval}, _capacity{capacity}
+{
+    Assert(_interval > std::chrono::milliseconds{0},
+           "Sampling interval must be positive.");
+    Assert(_capacity > 0, "Sampler needs room for at least one sample.");
+    _ring.resize(_capacity);
+}
+
+SystemSampler::~SystemSampler()
+{
+    _loop_thread.reset();
+    _close_hardware_counters();
+}
+
+void SystemSampler::start()
+{
+    Assert(!_loop_thread, "Sampler is already running.");
+
+    _open_hardware_counters();
+    _thread_cpu_times_at_start = read_thread_cpu_times();
+    _begin = std::chrono::steady_clock::now();
+    _sample_count = 0;
+    _first_sample = sample();
+
+    _loop_thread = std::make_unique<PausableLoopThread>(
+        _interval,
+        [&](size_t)
+        {
+            auto next_sample = sample();
+            const auto lock = std::lock_guard<std::mutex>{_mutex};
+            _ring[_sample_count % _capacity] = std::move(next_sample);
+            ++_sample_count;
+        });
+}
+
+SystemUtilization SystemSampler::stop()
+{
+    Assert(_loop_thread, "Sampler is not running.");
+
+    // Destroying the loop thread wakes it up, so stopping does not wait for the
+    // rest of the interval.
+    _loop_thread.reset();
+
+    auto utilization = SystemUtilization{};
+    utilization.interval = _interval;
+    utilization.samples.reserve(std::min(_sample_count, _capacity) + 2);
+    utilization.samples.emplace_back(std::move(*_first_sample));
+    const auto dropped_count =
+        _sample_count > _capacity ? _sample_count - _capacity : size_t{0};
+    for (auto sample_id = dropped_count; sample_id < _sample_count; ++sample_id)
+    {
+        utilization.samples.emplace_back(_ring[sample_id % _capacity]);
+    }
+    utilization.samples.emplace_back(sample());
+    _first_sample.reset();
+
+    // Report the CPU time each thread spent while the sampler was running.
+    // Threads that were spawned in the meantime start at zero.
+    for (const auto &thread_time : read_thread_cpu_times())
+    {
+        auto delta = thread_time;
+        for (const auto &start_time : _thread_cpu_times_at_start)
+        {
+            if (start_time.thread_id == thread_time.thread_id)
+            {
+                delta.user_time -= start_time.user_time;
+                delta.system_time -= start_time.system_time;
+                break;
+            }
+        }
+
+        if (delta.user_time.count() > 0 || delta.system_time.count() > 0)
+        {
+            utilization.thread_cpu_times.emplace_back(delta);
+        }
+    }
+
+    _close_hardware_counters();
+    return utilization;
+}
+
+SystemSample SystemSampler::sample() const
+{
+    auto sample = SystemSample{};
+    sample.timestamp = std::chrono::steady_clock::now() - _begin;
+    read_process_io(sample);
+    read_system_cpu_times(sample);
+    read_process_status(sample);
+    sample.process_cpu_time = process_cpu_time();
+    sample.hardware_counters = _read_hardware_counters();
+    return sample;
+}
+
+void SystemSampler::_open_hardware_counters()
+{
+#ifdef __linux__
+    // Counters opened with inherit only follow threads created after them.
+    // Hence, we open one group per existing thread of the process.
+    for (const auto &thread_time : read_thread_cpu_times())
+    {
+        const auto thread_id = static_cast<pid_t>(thread_time.thread_id);
+        auto group = std::vector<int>{};
+        for (const auto config :
+             {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+              PERF_COUNT_HW_CACHE_MISSES})
+        {
+            const auto fd = open_perf_event(
+                config, thread_id, group.empty() ? -1 : group.front());
+            if (fd == -1)
+            {
+                break;
+            }
+            group.push_back(fd);
+        }
+
+        if (group.size() < 3)
+        {
+            // Perf events are not available or the thread has exited in the
+            // meantime. In the first case, none of the other threads will
+            // succeed either.
+            for (const auto fd : group)
+            {
+                close(fd);
+            }
+            if (_perf_event_groups.empty())
+            {
+                return;
+            }
+            continue;
+        }
+        _perf_event_groups.emplace_back(std::move(group));
+    }
+#endif
+}
+
+void SystemSampler::_close_hardware_counters()
+{
+    for (const auto &group : _perf_event_groups)
+    {
+        for (const auto fd : group)
+        {
+            close(fd);
+        }
+    }
+    _perf_event_groups.clear();
+}
+
+std::optional<HardwareCounters> SystemSampler::_read_hardware_counters() const
+{
+    if (_perf_event_groups.empty())
+    {
+        return std::nullopt;
+    }
+
+    auto counters = HardwareCounters{};
+    for (const auto &group : _perf_event_groups)
+    {
+        // With PERF_FORMAT_GROUP, the leader returns the number of events
+        // followed by their values.
+        auto values = std::array<uint64_t, 4>{};
+        if (read(group.front(), values.data(), sizeof(values)) !=
+            sizeof(values))
+        {
+            continue;
+        }
+        counters.cycles += values[1];
+        counters.instructions += values[2];
+        counters.cache_misses += values[3];
+    }
+    return counters;
+}
+
+std::vector<ThreadCpuTime> read_thread_cpu_times()
+{
+    auto thread_cpu_times = std::vector<ThreadCpuTime>{};
+    auto error_code = std::error_code{};
+    for (const auto &entry : std::filesystem::directory_iterator{
+             "/proc/self/task", error_code})
+    {
+        auto stat_file = std::ifstream{entry.path() / "stat"};
+        auto stat_line = std::string{};
+        if (!std::getline(stat_file, stat_line))
+        {
+            continue;
+        }
+
+        // The thread name (second field) may contain spaces and is wrapped in
+        // parentheses. utime and stime are the 14th and 15th field, i.e., the
+        // 12th and 13th field after the name.
+        const auto name_end = stat_line.rfind(')');
+        if (name_end == std::string::npos)
+        {
+            continue;
+        }
+        auto fields = std::istringstream{stat_line.substr(name_end + 1)};
+        auto field = std::string{};
+        for (auto field_id = 0; field_id < 11; ++field_id)
+        {
+            fields >> field;
+        }
+        auto user_ticks = uint64_t{0};
+        auto system_ticks = uint64_t{0};
+        fields >> user_ticks >> system_ticks;
+
+        thread_cpu_times.push_back(
+            {std::stoll(entry.path().filename().string()),
+             std::chrono::nanoseconds{ticks_to_ns(user_ticks)},
+             std::chrono::nanoseconds{ticks_to_ns(system_ticks)}});
+    }
+    return thread_cpu_times;
+}
+
+} // namespace hyrise
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+#include "types.hpp"
+
+namespace hyrise
+{
+
+struct PausableLoopThread;
+
+// Hardware counters of all threads of the process (perf_event_open, user
+// space only).
+struct HardwareCounters
+{
+    uint64_t cycles{0};
+    uint64_t instructions{0};
+    uint64_t cache_misses{0};
+};
+
+// A snapshot of the process' and the system's resource usage. All values are
+// cumulative, so the utilization between two samples is their difference.
+struct SystemSample
+{
+    // Time since the sampler was started.
+    std::chrono::nanoseconds timestamp{};
+
+    // From /proc/self/io: bytes read from and written to storage (read_bytes,
+    // write_bytes) and bytes passed to read/write syscalls (rchar, wchar).
+    uint64_t io_read_bytes{0};
+    uint64_t io_write_bytes{0};
+    uint64_t io_read_chars{0};
+    uint64_t io_write_chars{0};
+
+    // From /proc/stat: time (in ns) all CPUs of the system spent busy, idle,
+    // and waiting for I/O.
+    uint64_t system_busy_time{0};
+    uint64_t system_idle_time{0};
+    uint64_t system_iowait_time{0};
+
+    // CPU time (in ns) of all threads of this process.
+    uint64_t process_cpu_time{0};
+
+    // From /proc/self/status.
+    uint64_t process_rss{0};
+    uint64_t process_threads{0};
+
+    // std::nullopt if perf events are not available (e.g., because of
+    // kernel.perf_event_paranoid).
+    std::optional<HardwareCounters> hardware_counters;
+};
+
+// CPU time a thread of the process spent while the sampler was running.
+struct ThreadCpuTime
+{
+    int64_t thread_id{0};
+    std::chrono::nanoseconds user_time{};
+    std::chrono::nanoseconds system_time{};
+};
+
+struct SystemUtilization
+{
+    std::chrono::milliseconds interval{};
+
+    // The first and the last sample are taken when the sampler is started and
+    // stopped, the others in the given interval.
+    std::vector<SystemSample> samples;
+    std::vector<ThreadCpuTime> thread_cpu_times;
+};
+
+/**
+ * Samples the resource usage of the process and the system in-process, i.e.,
+ * without forking tools like iostat or top. start() and stop() take a sample
+ * synchronously, and a background thread takes one every interval in between.
+ * Thus, the sampler neither needs to sleep before nor after the measured work,
+ * and even short queries get a begin and an end sample.
+ *
+ * Samples are kept in a fixed-size ring; if it overflows, the oldest
+ * intermediate samples are dropped (the first sample is always kept).
+ */
+class SystemSampler : public Noncopyable
+{
+  public:
+    explicit SystemSampler(
+        std::chrono::milliseconds interval = DEFAULT_INTERVAL,
+        size_t capacity = DEFAULT_CAPACITY);
+    ~SystemSampler();
+
+    void start();
+    SystemUtilization stop();
+
+    // Reads all sources once. Hardware counters are only read if the sampler is
+    // running.
+    SystemSample sample() const;
+
+    static constexpr auto DEFAULT_INTERVAL = std::chrono::milliseconds{100};
+    static constexpr size_t DEFAULT_CAPACITY = 1024;
+
+  private:
+    void _open_hardware_counters();
+    void _close_hardware_counters();
+    std::optional<HardwareCounters> _read_hardware_counters() const;
+
+    const std::chrono::milliseconds _interval;
+    const size_t _capacity;
+
+    std::chrono::steady_clock::time_point _begin;
+    std::optional<SystemSample> _first_sample;
+    std::vector<SystemSample> _ring;
+    size_t _sample_count{0};
+    std::vector<ThreadCpuTime> _thread_cpu_times_at_start;
+    mutable std::mutex _mutex;
+
+    // One perf event group (leader first) per thread.
+    std::vector<std::vector<int>> _perf_event_groups;
+
+    std::unique_ptr<PausableLoopThread> _loop_thread;
+};
+
+// Cumulative CPU times of all threads of this process (/proc/self/task).
+std::vector<ThreadCpuTime> read_thread_cpu_times();
+
+} // namespace hyrise
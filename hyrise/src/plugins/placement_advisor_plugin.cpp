@@ -0,0 +1,526 @@
+#include "placement_advisor_plugin.hpp"
+
+#include <algorithm>
+#include <numeric>
+#include <set>
+#include <sstream>
+
+#include "../benchmarklib/abstract_benchmark_item_runner.hpp"
+#include "cost_estimation/column_hotness_estimator.hpp"
+#include "hyrise.hpp"
+#include "magic_enum.hpp"
+#include "statistics/cardinality_estimator.hpp"
+#include "storage/segment_encoding_utils.hpp"
+#include "storage/table.hpp"
+#include "tasks/segment_migration_task.hpp"
+#include "utils/assert.hpp"
+#include "utils/format_bytes.hpp"
+#include "utils/format_duration.hpp"
+#include "utils/timer.hpp"
+
+namespace
+{
+
+using namespace hyrise; // NOLINT
+
+const auto LOG_REPORTER = std::string{"PlacementAdvisorPlugin"};
+
+struct PlacementCandidate
+{
+    std::string table_name;
+    ChunkID chunk_id;
+    ColumnID column_id;
+    size_t bytes;
+    MemoryTier tier;
+
+    // Heat per byte, including the bonus for segments in the near tier.
+    float priority;
+};
+
+// Calls @param functor for each segment of an immutable chunk.
+template <typename Functor> void for_each_immutable_segment(Functor functor)
+{
+    for (const auto &[table_name, table] :
+         Hyrise::get().storage_manager.tables())
+    {
+        const auto chunk_count = table->chunk_count();
+        const auto column_count = table->column_count();
+        for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id)
+        {
+            const auto chunk = table->get_chunk(chunk_id);
+            if (!chunk || chunk->is_mutable())
+            {
+                continue;
+            }
+
+            for (auto column_id = ColumnID{0}; column_id < column_count;
+                 ++column_id)
+            {
+                functor(table_name, chunk_id, column_id,
+                        chunk->get_segment(column_id));
+            }
+        }
+    }
+}
+
+} // namespace
+
+namespace hyrise
+{
+
+PlacementAdvisorPlugin::PlacementAdvisorSetting::PlacementAdvisorSetting(
+    const std::string &init_name, const std::string &init_description,
+    const std::string &init_value,
+    const std::function<void(const std::string &)> &init_on_set)
+    : AbstractSetting(init_name), _description(init_description),
+      _value(init_value), _on_set(init_on_set)
+{
+}
+
+const std::string &
+PlacementAdvisorPlugin::PlacementAdvisorSetting::description() const
+{
+    return _description;
+}
+
+const std::string &PlacementAdvisorPlugin::PlacementAdvisorSetting::get()
+{
+    return _value;
+}
+
+void PlacementAdvisorPlugin::PlacementAdvisorSetting::set(
+    const std::string &value)
+{
+    _on_set(value);
+    _value = value;
+}
+
+std::string PlacementAdvisorPlugin::description() const
+{
+    return "Online Segment Placement Advisor Plugin";
+}
+
+void PlacementAdvisorPlugin::start()
+{
+    _settings.emplace_back(std::make_shared<PlacementAdvisorSetting>(
+        "PlacementAdvisor.heat_source",
+        "Source of the segment heat (AccessCounters or PlanEstimates)",
+        std::string{magic_enum::enum_name(_heat_source)},
+        [&](const auto &value)
+        {
+            const auto heat_source = magic_enum::enum_cast<HeatSource>(value);
+            Assert(heat_source, "Unknown heat source: " + value);
+            const auto lock = std::lock_guard<std::mutex>{_mutex};
+            _heat_source = *heat_source;
+        }));
+    _settings.emplace_back(std::make_shared<PlacementAdvisorSetting>(
+        "PlacementAdvisor.near_tier_capacity",
+        "Bytes of segments that are placed in the near memory tier",
+        std::to_string(_near_tier_capacity),
+        [&](const auto &value)
+        {
+            const auto lock = std::lock_guard<std::mutex>{_mutex};
+            _near_tier_capacity = std::stoull(value);
+        }));
+    _settings.emplace_back(std::make_shared<PlacementAdvisorSetting>(
+        "PlacementAdvisor.apply_migrations",
+        "Whether migrations are applied or only logged (true or false)",
+        _apply_migrations ? "true" : "false",
+        [&](const auto &value)
+        {
+            Assert(value == "true" || value == "false",
+                   "Expected true or false, got " + value);
+            _apply_migrations = value == "true";
+        }));
+    _settings.emplace_back(std::make_shared<PlacementAdvisorSetting>(
+        "PlacementAdvisor.reencode_segments",
+        "Whether migrated segments are re-encoded for their target tier (true "
+        "or false)",
+        _reencode_segments ? "true" : "false",
+        [&](const auto &value)
+        {
+            Assert(value == "true" || value == "false",
+                   "Expected true or false, got " + value);
+            _reencode_segments = value == "true";
+        }));
+    for (const auto &setting : _settings)
+    {
+        setting->register_at_settings_manager();
+    }
+
+    _loop_thread = std::make_unique<PausableLoopThread>(
+        ADVISE_INTERVAL,
+        [&](size_t /*unused*/)
+        {
+            const auto migrations = _advise();
+            if (_apply_migrations)
+            {
+                _apply(migrations);
+            }
+        });
+}
+
+void PlacementAdvisorPlugin::stop()
+{
+    // Call destructor of PausableLoopThread to terminate its thread
+    _loop_thread.reset();
+
+    for (const auto &setting : _settings)
+    {
+        setting->unregister_at_settings_manager();
+    }
+    _settings.clear();
+}
+
+std::vector<std::pair<PluginFunctionName, PluginFunctionPointer>>
+PlacementAdvisorPlugin::provided_user_executable_functions()
+{
+    return {{"AdvisePlacement", [&]() { _advise(); }},
+            {"ApplyPlacement", [&]() { _apply(_advise()); }}};
+}
+
+std::optional<PreBenchmarkHook> PlacementAdvisorPlugin::pre_benchmark_hook()
+{
+    return [&](auto &benchmark_item_runner)
+    {
+        for (const auto item_id : benchmark_item_runner.items())
+        {
+            benchmark_item_runner.execute_item(item_id);
+        }
+
+        // Place the segments before the measurements start. As each round
+        // moves a limited number of bytes, we run rounds until the placement
+        // is reached. Migrations that cannot be applied (e.g., because the
+        // chunk has been dropped) are advised again, so we also stop once a
+        // round makes no progress.
+        for (auto round = size_t{0}; round < MAX_PREPARATION_ROUNDS; ++round)
+        {
+            const auto migrations = _advise();
+            if (migrations.empty())
+            {
+                return;
+            }
+            if (_apply(migrations) == 0)
+            {
+                Hyrise::get().log_manager.add_message(
+                    LOG_REPORTER,
+                    "Stopped placing segments as none of " +
+                        std::to_string(migrations.size()) +
+                        " advised migrations could be applied",
+                    LogLevel::Warning);
+                return;
+            }
+        }
+        Hyrise::get().log_manager.add_message(
+            LOG_REPORTER,
+            "Placement not reached after " +
+                std::to_string(MAX_PREPARATION_ROUNDS) + " rounds",
+            LogLevel::Warning);
+    };
+}
+
+std::vector<SegmentMigration> PlacementAdvisorPlugin::_advise()
+{
+    const auto lock = std::lock_guard<std::mutex>{_mutex};
+
+    switch (_heat_source)
+    {
+    case HeatSource::AccessCounters:
+        _update_heat_from_access_counters();
+        break;
+    case HeatSource::PlanEstimates:
+        _update_heat_from_plan_estimates();
+        break;
+    }
+
+    // Fold the bytes read in this round into the heat and collect the segments
+    // that can be placed. States of segments that no longer exist are dropped.
+    auto candidates = std::vector<PlacementCandidate>{};
+    auto near_tier_bytes = size_t{0};
+    auto existing_segments = std::set<SegmentKey>{};
+    for_each_immutable_segment(
+        [&](const auto &table_name, const auto chunk_id, const auto column_id,
+            const auto &segment)
+        {
+            const auto key = SegmentKey{table_name, chunk_id, column_id};
+            auto &state = _segment_states[key];
+            existing_segments.emplace(key);
+
+            state.heat = HEAT_DECAY * state.heat +
+                         (1.0f - HEAT_DECAY) * state.round_bytes;
+            state.round_bytes = 0.0f;
+
+            // Segments can also be placed by others (e.g., re-encoded or
+            // loaded into the far tier), so we check where their data is.
+            const auto tier = get_segment_memory_tier(*segment);
+            const auto bytes =
+                segment->memory_usage(MemoryUsageCalculationMode::Sampled);
+            auto priority =
+                state.heat / static_cast<float>(std::max(bytes, size_t{1}));
+            if (tier == MemoryTier::Near)
+            {
+                priority *= HYSTERESIS;
+                near_tier_bytes += bytes;
+            }
+
+            candidates.push_back(
+                {table_name, chunk_id, column_id, bytes, tier, priority});
+        });
+    std::erase_if(_segment_states, [&](const auto &entry)
+                  { return !existing_segments.contains(entry.first); });
+
+    // Greedily fill the near tier with the hottest segments per byte. Segments
+    // that do not fit anymore are placed in the far tier.
+    std::stable_sort(candidates.begin(), candidates.end(),
+                     [](const auto &lhs, const auto &rhs)
+                     { return lhs.priority > rhs.priority; });
+    auto promotions = std::vector<const PlacementCandidate *>{};
+    auto demotions = std::vector<const PlacementCandidate *>{};
+    auto planned_near_tier_bytes = size_t{0};
+    for (const auto &candidate : candidates)
+    {
+        if (planned_near_tier_bytes + candidate.bytes <= _near_tier_capacity)
+        {
+            planned_near_tier_bytes += candidate.bytes;
+            if (candidate.tier == MemoryTier::Far)
+            {
+                promotions.push_back(&candidate);
+            }
+        }
+        else if (candidate.tier == MemoryTier::Near)
+        {
+            demotions.push_back(&candidate);
+        }
+    }
+
+    // Emit the coldest demotions first, as they free the near tier for the
+    // promotions, which are emitted hottest first.
+    auto migrations = std::vector<SegmentMigration>{};
+    auto migrated_bytes = size_t{0};
+    const auto emit = [&](const auto &candidate, const auto target_tier)
+    {
+        // A segment larger than the limit is migrated in a round of its own, as
+        // it would never be migrated otherwise.
+        if (!migrations.empty() &&
+            migrated_bytes + candidate.bytes > MAX_MIGRATION_BYTES_PER_ROUND)
+        {
+            return false;
+        }
+        migrated_bytes += candidate.bytes;
+        migrations.push_back({candidate.table_name, candidate.chunk_id,
+                              candidate.column_id, candidate.tier, target_tier,
+                              candidate.bytes});
+        return true;
+    };
+
+    for (auto demotion_it = demotions.rbegin(); demotion_it != demotions.rend();
+         ++demotion_it)
+    {
+        if (!emit(**demotion_it, MemoryTier::Far))
+        {
+            break;
+        }
+        near_tier_bytes -= (*demotion_it)->bytes;
+    }
+    for (const auto *promotion : promotions)
+    {
+        if (near_tier_bytes + promotion->bytes > _near_tier_capacity)
+        {
+            continue;
+        }
+        if (!emit(*promotion, MemoryTier::Near))
+        {
+            break;
+        }
+        near_tier_bytes += promotion->bytes;
+    }
+
+    if (!migrations.empty())
+    {
+        auto message = std::stringstream{};
+        message << "Advised " << migrations.size() << " migrations ("
+                << format_bytes(migrated_bytes) << ") for "
+                << magic_enum::enum_name(_heat_source) << ", near tier "
+                << format_bytes(near_tier_bytes) << " of "
+                << format_bytes(_near_tier_capacity);
+        Hyrise::get().log_manager.add_message(LOG_REPORTER, message.str(),
+                                              LogLevel::Info);
+    }
+
+    return migrations;
+}
+
+size_t PlacementAdvisorPlugin::_apply(
+    const std::vector<SegmentMigration> &migrations)
+{
+    // Only one migration at a time, but _advise() is not blocked meanwhile.
+    const auto lock = std::lock_guard<std::mutex>{_migration_mutex};
+    auto &storage_manager = Hyrise::get().storage_manager;
+
+    // Group the migrations that are still valid by chunk and target tier, so
+    // that each chunk is migrated by a single task.
+    auto columns_by_chunk =
+        std::map<std::tuple<std::string, ChunkID, MemoryTier>,
+                 std::vector<ColumnID>>{};
+    for (const auto &migration : migrations)
+    {
+        if (!storage_manager.has_table(migration.table_name))
+        {
+            continue;
+        }
+        const auto chunk = storage_manager.get_table(migration.table_name)
+                               ->get_chunk(migration.chunk_id);
+        if (!chunk)
+        {
+            continue;
+        }
+
+        if (get_segment_memory_tier(*chunk->get_segment(migration.column_id)) ==
+            migration.source_tier)
+        {
+            columns_by_chunk[{migration.table_name, migration.chunk_id,
+                              migration.target_tier}]
+                .push_back(migration.column_id);
+        }
+    }
+
+    if (columns_by_chunk.empty())
+    {
+        return 0;
+    }
+
+    // The migration runs in the scheduler's workers, while queries keep on
+    // reading the old segments. As the tasks wait for the rate limiter, they
+    // are chained so that they occupy few workers (see make_for_table()).
+    const auto rate_limiter =
+        std::make_shared<MigrationRateLimiter>(MIGRATION_BANDWIDTH);
+    const auto statistics = std::make_shared<SegmentMigrationStatistics>();
+    const auto encoding_policy =
+        _reencode_segments ? std::make_shared<const TieredEncodingPolicy>()
+                           : nullptr;
+    constexpr auto PARALLELISM = SegmentMigrationTask::DEFAULT_PARALLELISM;
+    auto migration_tasks = std::vector<std::shared_ptr<AbstractTask>>{};
+    for (const auto &[chunk_key, column_ids] : columns_by_chunk)
+    {
+        const auto &[table_name, chunk_id, target_tier] = chunk_key;
+        auto task = std::make_shared<SegmentMigrationTask>(
+            table_name, chunk_id, column_ids, target_tier, rate_limiter,
+            statistics, encoding_policy);
+        if (migration_tasks.size() >= PARALLELISM)
+        {
+            migration_tasks[migration_tasks.size() - PARALLELISM]
+                ->set_as_predecessor_of(task);
+        }
+        migration_tasks.emplace_back(std::move(task));
+    }
+
+    auto timer = Timer{};
+    Hyrise::get().scheduler()->schedule_and_wait_for_tasks(migration_tasks);
+
+    auto message = std::stringstream{};
+    message << "Migrated " << statistics->migrated_segment_count.load()
+            << " segments (" << format_bytes(statistics->migrated_bytes)
+            << ") in " << timer.lap_formatted() << ", stalled for "
+            << format_duration(
+                   std::chrono::nanoseconds{statistics->stall_time.load()});
+    if (encoding_policy && statistics->encoded_bytes > 0)
+    {
+        message << ", compression ratio "
+                << static_cast<double>(statistics->migrated_bytes) /
+                       static_cast<double>(statistics->encoded_bytes);
+    }
+    if (statistics->skipped_segment_count > 0)
+    {
+        message << ", skipped " << statistics->skipped_segment_count.load()
+                << " concurrently replaced segments";
+    }
+    Hyrise::get().log_manager.add_message(LOG_REPORTER, message.str(),
+                                          LogLevel::Info);
+    return statistics->migrated_segment_count;
+}
+
+void PlacementAdvisorPlugin::_update_heat_from_access_counters()
+{
+    for_each_immutable_segment(
+        [&](const auto &table_name, const auto chunk_id, const auto column_id,
+            const auto &segment)
+        {
+            // Dictionary accesses are lookups of single values and already
+            // reflected by the accesses to the attribute vector.
+            const auto counter = segment->access_counter.get_counter();
+            const auto access_count =
+                std::accumulate(counter.cbegin(), counter.cend(),
+                                SegmentAccessCounter::CounterType{0}) -
+                counter[static_cast<size_t>(
+                    SegmentAccessCounter::AccessType::Dictionary)];
+
+            auto &state = _segment_states[{table_name, chunk_id, column_id}];
+            // Replaced segments may start with fresh counters.
+            const auto new_accesses = access_count >= state.access_count
+                                          ? access_count - state.access_count
+                                          : access_count;
+            state.access_count = access_count;
+
+            const auto segment_size = segment->size();
+            if (new_accesses == 0 || segment_size == 0)
+            {
+                return;
+            }
+            const auto bytes_per_value =
+                static_cast<float>(segment->memory_usage(
+                    MemoryUsageCalculationMode::Sampled)) /
+                static_cast<float>(segment_size);
+            state.round_bytes +=
+                static_cast<float>(new_accesses) * bytes_per_value;
+        });
+}
+
+void PlacementAdvisorPlugin::_update_heat_from_plan_estimates()
+{
+    const auto &lqp_cache = Hyrise::get().default_lqp_cache;
+    if (!lqp_cache)
+    {
+        return;
+    }
+
+    const auto estimator =
+        ColumnHotnessEstimator{std::make_shared<CardinalityEstimator>()};
+    auto plan_frequencies = std::unordered_map<std::string, size_t>{};
+
+    for (const auto &[sql_string, entry] : lqp_cache->snapshot())
+    {
+        // Count the executions since the last round. Caches that do not track
+        // frequencies count every cached query once per round.
+        auto execution_count = size_t{1};
+        if (entry.frequency)
+        {
+            const auto previous_it = _plan_frequencies.find(sql_string);
+            const auto previous_frequency =
+                previous_it != _plan_frequencies.end() ? previous_it->second
+                                                       : size_t{0};
+            // The entry may have been evicted and re-inserted in between.
+            execution_count = *entry.frequency >= previous_frequency
+                                  ? *entry.frequency - previous_frequency
+                                  : *entry.frequency;
+            plan_frequencies[sql_string] = *entry.frequency;
+        }
+        if (execution_count == 0)
+        {
+            continue;
+        }
+
+        for (const auto &hotness : estimator.estimate(entry.value))
+        {
+            _segment_states[{hotness.table_name, hotness.chunk_id,
+                             hotness.column_id}]
+                .round_bytes +=
+                hotness.bytes * static_cast<float>(execution_count);
+        }
+    }
+
+    _plan_frequencies = std::move(plan_frequencies);
+}
+
+EXPORT_PLUGIN(PlacementAdvisorPlugin);
+
+} // namespace hyrise
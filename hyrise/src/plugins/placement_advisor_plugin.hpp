@@ -0,0 +1,176 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+#include "memory/tiered_memory_resource.hpp"
+#include "types.hpp"
+#include "utils/abstract_plugin.hpp"
+#include "utils/pausable_loop_thread.hpp"
+#include "utils/settings/abstract_setting.hpp"
+
+namespace hyrise
+{
+
+// Move of a segment from one memory tier to the other.
+struct SegmentMigration
+{
+    std::string table_name;
+    ChunkID chunk_id;
+    ColumnID column_id;
+    MemoryTier source_tier;
+    MemoryTier target_tier;
+    size_t bytes;
+};
+
+/**
+ * This plugin decides which segments are placed in the near memory tier (local
+ * DRAM) and which in the far tier (e.g., CXL memory). Instead of solving the
+ * placement once for a fixed workload, it periodically re-evaluates it:
+ *
+ *  1. The heat of each segment (bytes read per round) is measured either from
+ *     the SegmentAccessCounters or estimated from the plans in the LQP cache
+ *     (see ColumnHotnessEstimator). It is smoothed with an exponential moving
+ *     average, so that the placement follows workload shifts without reacting
+ *     to every single query.
+ *  2. The capacity-constrained placement is solved greedily by heat per byte,
+ *     i.e., as a fractional knapsack. Segments that already are in the near
+ *     tier get a bonus (HYSTERESIS) so that segments of similar heat do not
+ *     bounce between the tiers.
+ *  3. The differences to the current placement are emitted as migrations. At
+ *     most MAX_MIGRATION_BYTES_PER_ROUND are moved per round, and promotions
+ *     are only issued if the near tier has room for them.
+ *
+ * If enabled, migrations are applied by SegmentMigrationTasks, which copy the
+ * segments into the target tier's memory resource and atomically replace them
+ * in their chunks. Running operators keep the old segments alive through their
+ * shared_ptrs. Only immutable chunks are considered, as mutable chunks are
+ * still appended to. Optionally, the segments are re-encoded for their target
+ * tier (see TieredEncodingPolicy).
+ *
+ * The plugin is configured through the settings manager (see meta_settings).
+ */
+class PlacementAdvisorPlugin : public AbstractPlugin
+{
+    friend class PlacementAdvisorPluginTest;
+
+  public:
+    enum class HeatSource
+    {
+        AccessCounters,
+        PlanEstimates
+    };
+
+    std::string description() const final;
+
+    void start() final;
+
+    void stop() final;
+
+    std::vector<std::pair<PluginFunctionName, PluginFunctionPointer>>
+    provided_user_executable_functions() final;
+
+    std::optional<PreBenchmarkHook> pre_benchmark_hook() final;
+
+    /**
+     * ADVISE_INTERVAL: sleep between two placement rounds
+     * HEAT_DECAY: weight of the previous heat in the moving average
+     * HYSTERESIS: factor by which the heat of segments in the near tier is
+     * increased when solving the placement
+     * MAX_MIGRATION_BYTES_PER_ROUND: limit of the bytes migrated in one round,
+     * a single larger segment is migrated on its own
+     * MAX_PREPARATION_ROUNDS: limit of the rounds the pre-benchmark hook runs
+     * to reach the placement
+     * MIGRATION_BANDWIDTH: bytes per second the migrations may copy
+     * DEFAULT_NEAR_TIER_CAPACITY: near tier budget if none is configured
+     */
+    constexpr static std::chrono::milliseconds ADVISE_INTERVAL =
+        std::chrono::milliseconds(1000);
+    constexpr static float HEAT_DECAY = 0.5f;
+    constexpr static float HYSTERESIS = 1.25f;
+    constexpr static size_t MAX_MIGRATION_BYTES_PER_ROUND =
+        size_t{256} * 1024 * 1024;
+    constexpr static size_t MAX_PREPARATION_ROUNDS = 100;
+    constexpr static size_t MIGRATION_BANDWIDTH = size_t{1024} * 1024 * 1024;
+    constexpr static size_t DEFAULT_NEAR_TIER_CAPACITY =
+        size_t{16} * 1024 * 1024 * 1024;
+
+  protected:
+    // Setting whose value is stored as string. On set(), the new value is
+    // validated and applied by the plugin.
+    class PlacementAdvisorSetting : public AbstractSetting
+    {
+      public:
+        PlacementAdvisorSetting(
+            const std::string &init_name, const std::string &init_description,
+            const std::string &init_value,
+            const std::function<void(const std::string &)> &init_on_set);
+
+        const std::string &description() const final;
+
+        const std::string &get() final;
+
+        void set(const std::string &value) final;
+
+      private:
+        const std::string _description;
+        std::string _value;
+        const std::function<void(const std::string &)> _on_set;
+    };
+
+    // Runs one round: updates the heat, solves the placement, and returns the
+    // migrations towards it.
+    std::vector<SegmentMigration> _advise();
+
+    // Migrates the segments with one SegmentMigrationTask per chunk, chained so
+    // that only a few of them run at a time. Migrations whose segment is no
+    // longer in the source tier are skipped. Returns the number of migrated
+    // segments.
+    size_t _apply(const std::vector<SegmentMigration> &migrations);
+
+    // Add the bytes read since the last round to round_bytes. Must be called
+    // with _mutex locked.
+    void _update_heat_from_access_counters();
+    void _update_heat_from_plan_estimates();
+
+    HeatSource _heat_source{HeatSource::AccessCounters};
+    size_t _near_tier_capacity{DEFAULT_NEAR_TIER_CAPACITY};
+    std::atomic_bool _apply_migrations{false};
+    std::atomic_bool _reencode_segments{false};
+
+  private:
+    using SegmentKey = std::tuple<std::string, ChunkID, ColumnID>;
+
+    struct SegmentState
+    {
+        // Smoothed bytes read per round.
+        float heat{0.0f};
+
+        // Bytes read since the last round, not yet folded into heat.
+        float round_bytes{0.0f};
+
+        // Access count at the last round (AccessCounters only).
+        uint64_t access_count{0};
+    };
+
+    std::map<SegmentKey, SegmentState> _segment_states;
+
+    // Frequency of each cached query at the last round (PlanEstimates only).
+    std::unordered_map<std::string, size_t> _plan_frequencies;
+
+    // _mutex guards the plugin's state, _migration_mutex serializes _apply().
+    std::mutex _mutex;
+    std::mutex _migration_mutex;
+    std::vector<std::shared_ptr<PlacementAdvisorSetting>> _settings;
+    std::unique_ptr<PausableLoopThread> _loop_thread;
+};
+
+} // namespace hyrise
@@ -0,0 +1,106 @@
+#include "base_test.hpp"
+
+#include "cost_estimation/column_hotness_estimator.hpp"
+#include "expression/expression_functional.hpp"
+#include "hyrise.hpp"
+#include "logical_query_plan/predicate_node.hpp"
+#include "logical_query_plan/projection_node.hpp"
+#include "logical_query_plan/stored_table_node.hpp"
+#include "sql/sql_pipeline_builder.hpp"
+#include "statistics/cardinality_estimator.hpp"
+#include "utils/load_table.hpp"
+
+namespace hyrise
+{
+
+using namespace expression_functional; // NOLINT(build/namespaces)
+
+class ColumnHotnessEstimatorTest : public BaseTest
+{
+  public:
+    void SetUp() override
+    {
+        table = load_table("resources/test_data/tbl/int_int.tbl", ChunkOffset{2});
+        Hyrise::get().storage_manager.add_table("int_int", table);
+
+        stored_table_node = StoredTableNode::make("int_int");
+        a = stored_table_node->get_column("a");
+        b = stored_table_node->get_column("b");
+    }
+
+    float segment_bytes(const ChunkID chunk_id, const ColumnID column_id)
+    {
+        return static_cast<float>(
+            table->get_chunk(chunk_id)->get_segment(column_id)->memory_usage(
+                MemoryUsageCalculationMode::Sampled));
+    }
+
+    std::shared_ptr<Table> table;
+    std::shared_ptr<StoredTableNode> stored_table_node;
+    std::shared_ptr<LQPColumnExpression> a, b;
+    ColumnHotnessEstimator estimator{std::make_shared<CardinalityEstimator>()};
+};
+
+TEST_F(ColumnHotnessEstimatorTest, ScanAndFilteredAccess)
+{
+    // clang-format off
+    const auto lqp =
+    ProjectionNode::make(expression_vector(add_(b, 1)),
+      PredicateNode::make(equals_(a, 123),
+        stored_table_node));
+    // clang-format on
+
+    const auto hotness = estimator.estimate(lqp);
+    ASSERT_EQ(hotness.size(), 4);
+
+    // Column a is scanned completely.
+    EXPECT_EQ(hotness[0].table_name, "int_int");
+    EXPECT_EQ(hotness[0].column_id, ColumnID{0});
+    EXPECT_EQ(hotness[0].chunk_id, ChunkID{0});
+    EXPECT_FLOAT_EQ(hotness[0].row_count, 2.0f);
+    EXPECT_FLOAT_EQ(hotness[0].bytes, segment_bytes(ChunkID{0}, ColumnID{0}));
+    EXPECT_EQ(hotness[1].chunk_id, ChunkID{1});
+    EXPECT_FLOAT_EQ(hotness[1].row_count, 1.0f);
+    EXPECT_FLOAT_EQ(hotness[1].bytes, segment_bytes(ChunkID{1}, ColumnID{0}));
+
+    // Column b is only read for the qualifying rows.
+    EXPECT_EQ(hotness[2].column_id, ColumnID{1});
+    EXPECT_EQ(hotness[3].column_id, ColumnID{1});
+    EXPECT_GT(hotness[2].row_count, 0.0f);
+    EXPECT_LT(hotness[2].row_count + hotness[3].row_count, 3.0f);
+    EXPECT_LT(hotness[2].bytes, segment_bytes(ChunkID{0}, ColumnID{1}));
+}
+
+TEST_F(ColumnHotnessEstimatorTest, PrunedChunksAreNotRead)
+{
+    stored_table_node->set_pruned_chunk_ids({ChunkID{1}});
+    const auto lqp = PredicateNode::make(equals_(a, 123), stored_table_node);
+
+    const auto hotness = estimator.estimate(lqp);
+    for (const auto &segment_hotness : hotness)
+    {
+        EXPECT_EQ(segment_hotness.chunk_id, ChunkID{0});
+    }
+
+    // The predicate scans a, the output reads a and b.
+    ASSERT_EQ(hotness.size(), 2);
+    EXPECT_GT(hotness[0].bytes, segment_bytes(ChunkID{0}, ColumnID{0}));
+}
+
+TEST_F(ColumnHotnessEstimatorTest, MetaTable)
+{
+    Hyrise::get().default_lqp_cache = std::make_shared<SQLLogicalPlanCache>();
+    SQLPipelineBuilder{"SELECT b FROM int_int WHERE a = 123"}
+        .create_pipeline()
+        .get_result_table();
+
+    const auto [status, hotness_table] =
+        SQLPipelineBuilder{"SELECT column_name FROM meta_column_hotness WHERE "
+                           "table_name = 'int_int' AND chunk_id = 0"}
+            .create_pipeline()
+            .get_result_table();
+    ASSERT_EQ(status, SQLPipelineStatus::Success);
+    EXPECT_EQ(hotness_table->row_count(), 2);
+}
+
+} // namespace hyrise
@@ -0,0 +1,160 @@
+#include <memory>
+
+#include "base_test.hpp"
+
+#include "expression/expression_functional.hpp"
+#include "expression/pqp_column_expression.hpp"
+#include "memory/operator_memory_arena.hpp"
+#include "operators/projection.hpp"
+#include "operators/sort.hpp"
+#include "operators/table_wrapper.hpp"
+#include "utils/performance_warning.hpp"
+
+namespace hyrise
+{
+
+using namespace expression_functional; // NOLINT(build/namespaces)
+
+class OperatorMemoryArenaTest : public BaseTest
+{
+};
+
+TEST_F(OperatorMemoryArenaTest, AllocatesFromBlocks)
+{
+    const auto pool = std::make_shared<QueryMemoryPool>();
+    auto arena = OperatorMemoryArena{pool};
+
+    auto *first = arena.allocate(100);
+    auto *second = arena.allocate(1000, 64);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(second) % 64, 0);
+    EXPECT_EQ(arena.allocated_bytes(), 1100);
+    EXPECT_EQ(arena.reserved_bytes(), QueryMemoryPool::BLOCK_SIZE);
+
+    // Undoing the most recent allocation makes its memory available again.
+    arena.deallocate(second, 1000, 64);
+    EXPECT_EQ(arena.allocate(1000, 64), second);
+
+    // Large allocations get a block of their own, which is released right away.
+    auto *large = arena.allocate(QueryMemoryPool::BLOCK_SIZE);
+    EXPECT_EQ(arena.reserved_bytes(), 2 * QueryMemoryPool::BLOCK_SIZE);
+    arena.deallocate(large, QueryMemoryPool::BLOCK_SIZE);
+    EXPECT_EQ(arena.reserved_bytes(), QueryMemoryPool::BLOCK_SIZE);
+
+    arena.deallocate(first, 100);
+    EXPECT_EQ(arena.allocated_bytes(), 1000);
+    EXPECT_EQ(arena.peak_allocated_bytes(),
+              1100 + QueryMemoryPool::BLOCK_SIZE);
+}
+
+TEST_F(OperatorMemoryArenaTest, ReusesBlocksAcrossArenas)
+{
+    const auto pool = std::make_shared<QueryMemoryPool>();
+    auto *block = static_cast<void *>(nullptr);
+    {
+        auto arena = OperatorMemoryArena{pool};
+        block = arena.allocate(100);
+    }
+
+    // The next operator of the query gets the block of the previous one.
+    {
+        auto arena = OperatorMemoryArena{pool};
+        EXPECT_EQ(arena.allocate(100), block);
+    }
+
+    const auto statistics = pool->statistics();
+    EXPECT_EQ(statistics.reserved_bytes, QueryMemoryPool::BLOCK_SIZE);
+    EXPECT_EQ(statistics.peak_reserved_bytes, QueryMemoryPool::BLOCK_SIZE);
+    EXPECT_EQ(statistics.peak_allocated_bytes, 100);
+    EXPECT_EQ(statistics.reused_bytes, QueryMemoryPool::BLOCK_SIZE);
+
+    pool->release_free_blocks();
+    EXPECT_EQ(pool->statistics().reserved_bytes, 0);
+}
+
+TEST_F(OperatorMemoryArenaTest, CountsMemoryBeyondBudget)
+{
+    auto performance_warning_disabler = PerformanceWarningDisabler{};
+    const auto pool =
+        std::make_shared<QueryMemoryPool>(2 * QueryMemoryPool::BLOCK_SIZE);
+    {
+        auto arena = OperatorMemoryArena{pool};
+        arena.allocate(QueryMemoryPool::BLOCK_SIZE);
+    }
+
+    // The free block is returned to make room for the larger one, which still
+    // exceeds the budget.
+    auto arena = OperatorMemoryArena{pool};
+    arena.allocate(3 * QueryMemoryPool::BLOCK_SIZE);
+
+    const auto statistics = pool->statistics();
+    EXPECT_EQ(statistics.budget, 2 * QueryMemoryPool::BLOCK_SIZE);
+    EXPECT_EQ(statistics.reserved_bytes, 3 * QueryMemoryPool::BLOCK_SIZE);
+    EXPECT_EQ(statistics.over_budget_bytes, 3 * QueryMemoryPool::BLOCK_SIZE);
+    EXPECT_EQ(statistics.reused_bytes, 0);
+}
+
+TEST_F(OperatorMemoryArenaTest, OperatorsShareQueryPool)
+{
+    const auto table = load_table("resources/test_data/tbl/int_float.tbl",
+                                  ChunkOffset{2});
+    const auto table_wrapper = std::make_shared<TableWrapper>(table);
+    const auto sort = std::make_shared<Sort>(
+        table_wrapper,
+        std::vector<SortColumnDefinition>{SortColumnDefinition{ColumnID{0}}});
+
+    const auto pool = std::make_shared<QueryMemoryPool>();
+    sort->set_memory_pool_recursively(pool);
+    table_wrapper->execute();
+    sort->execute();
+
+    EXPECT_GT(sort->performance_data->peak_arena_bytes, 0);
+    EXPECT_EQ(pool->statistics().peak_allocated_bytes,
+              sort->performance_data->peak_arena_bytes);
+
+    // The sort column is materialized in the arena, the output is not.
+    pool->release_free_blocks();
+    EXPECT_EQ(pool->statistics().reserved_bytes, 0);
+    EXPECT_TABLE_EQ_ORDERED(
+        sort->get_output(),
+        load_table("resources/test_data/tbl/int_float_sorted.tbl"));
+}
+
+TEST_F(OperatorMemoryArenaTest, CorrelatedSubqueriesShareQueryPool)
+{
+    /**
+     * SELECT EXISTS (SELECT a + x FROM table ORDER BY 1) FROM table, where x is
+     * the outer a. The subquery's Sort runs once per row on a copy of its PQP.
+     */
+    const auto table = load_table("resources/test_data/tbl/int_float.tbl",
+                                  ChunkOffset{2});
+    const auto a = PQPColumnExpression::from_table(*table, "a");
+    const auto subquery_projection = std::make_shared<Projection>(
+        std::make_shared<TableWrapper>(table),
+        expression_vector(add_(correlated_parameter_(ParameterID{0}, a), a)));
+    const auto subquery_sort = std::make_shared<Sort>(
+        subquery_projection,
+        std::vector<SortColumnDefinition>{SortColumnDefinition{ColumnID{0}}});
+    const auto subquery =
+        pqp_subquery_(subquery_sort, DataType::Int, false,
+                      std::make_pair(ParameterID{0}, ColumnID{0}));
+    const auto table_wrapper = std::make_shared<TableWrapper>(table);
+    const auto projection = std::make_shared<Projection>(
+        table_wrapper, expression_vector(exists_(subquery)));
+
+    const auto pool =
+        std::make_shared<QueryMemoryPool>(2 * QueryMemoryPool::BLOCK_SIZE);
+    projection->set_memory_pool_recursively(pool);
+    table_wrapper->execute();
+    projection->execute();
+
+    // The Sorts of the second and third row reuse the block of the first one.
+    const auto statistics = pool->statistics();
+    EXPECT_EQ(statistics.budget, 2 * QueryMemoryPool::BLOCK_SIZE);
+    EXPECT_GT(statistics.peak_allocated_bytes, 0);
+    EXPECT_EQ(statistics.peak_reserved_bytes, QueryMemoryPool::BLOCK_SIZE);
+    EXPECT_EQ(statistics.reused_bytes, 2 * QueryMemoryPool::BLOCK_SIZE);
+    EXPECT_EQ(statistics.over_budget_bytes, 0);
+    EXPECT_FALSE(subquery_sort->executed());
+}
+
+} // namespace hyrise
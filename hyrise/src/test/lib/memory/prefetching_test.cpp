@@ -0,0 +1,84 @@
+#include <numeric>
+
+#include "base_test.hpp"
+
+#include "memory/prefetching.hpp"
+#include "storage/chunk_encoder.hpp"
+#include "storage/segment_iterate.hpp"
+#include "storage/value_segment.hpp"
+
+namespace hyrise
+{
+
+class PrefetchingTest : public BaseTest
+{
+  public:
+    void TearDown() override
+    {
+        set_prefetch_distance(MemoryTier::Near,
+                              DEFAULT_NEAR_TIER_PREFETCH_DISTANCE);
+        set_prefetch_distance(MemoryTier::Far,
+                              DEFAULT_FAR_TIER_PREFETCH_DISTANCE);
+    }
+};
+
+TEST_F(PrefetchingTest, DistancePerTier)
+{
+    set_prefetch_distance(MemoryTier::Near, 4);
+    set_prefetch_distance(MemoryTier::Far, 16);
+    EXPECT_EQ(prefetch_distance(MemoryTier::Near), 4);
+    EXPECT_EQ(prefetch_distance(MemoryTier::Far), 16);
+
+    auto near_values = pmr_vector<int32_t>(100);
+    auto far_values = pmr_vector<int32_t>(
+        100, PolymorphicAllocator<int32_t>{
+                 get_memory_tier_resource(MemoryTier::Far)});
+    EXPECT_EQ(prefetch_distance(near_values.data()), 4);
+    EXPECT_EQ(prefetch_distance(far_values.data()), 16);
+}
+
+TEST_F(PrefetchingTest, PointAccessWithPrefetching)
+{
+    auto values = pmr_vector<int32_t>(1'000);
+    std::iota(values.begin(), values.end(), 0);
+    const auto value_segment =
+        std::make_shared<ValueSegment<int32_t>>(std::move(values));
+    const auto far_segment = ChunkEncoder::encode_segment(
+        value_segment, DataType::Int,
+        SegmentEncodingSpec{EncodingType::Dictionary}, MemoryTier::Far);
+
+    // Random positions, including some within the last prefetch distance.
+    auto position_filter = std::make_shared<RowIDPosList>();
+    for (auto offset = ChunkOffset{0}; offset < 1'000; offset += 7)
+    {
+        position_filter->emplace_back(ChunkID{0},
+                                      ChunkOffset{(offset * 13) % 1'000});
+    }
+    position_filter->guarantee_single_chunk();
+
+    for (const auto distance : {size_t{0}, size_t{1}, size_t{64}, size_t{500}})
+    {
+        set_prefetch_distance(MemoryTier::Near, distance);
+        set_prefetch_distance(MemoryTier::Far, distance);
+
+        for (const auto &segment :
+             {std::static_pointer_cast<AbstractSegment>(value_segment),
+              far_segment})
+        {
+            auto position_index = size_t{0};
+            segment_iterate_filtered<int32_t>(
+                *segment, position_filter,
+                [&](const auto &position)
+                {
+                    EXPECT_EQ(position.value(),
+                              static_cast<int32_t>((*position_filter)
+                                                       [position_index]
+                                                           .chunk_offset));
+                    ++position_index;
+                });
+            EXPECT_EQ(position_index, position_filter->size());
+        }
+    }
+}
+
+} // namespace hyrise
@@ -0,0 +1,81 @@
+#include <boost/container/pmr/global_resource.hpp>
+
+#include "base_test.hpp"
+
+#include "memory/tiered_memory_resource.hpp"
+
+namespace hyrise
+{
+
+class TieredMemoryResourceTest : public BaseTest
+{
+};
+
+TEST_F(TieredMemoryResourceTest, AllocatesFromRegion)
+{
+    auto resource = TieredMemoryResource{MemoryTier::Far, 4096};
+    EXPECT_EQ(resource.tier(), MemoryTier::Far);
+    EXPECT_EQ(resource.numa_node(), std::nullopt);
+    EXPECT_EQ(resource.capacity(), 4096);
+
+    auto *first = resource.allocate(100);
+    auto *second = resource.allocate(1000);
+    EXPECT_TRUE(resource.contains(first));
+    EXPECT_TRUE(resource.contains(second));
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(first) %
+                  TieredMemoryResource::BLOCK_ALIGNMENT,
+              0);
+    EXPECT_EQ(resource.allocated_bytes(), 128 + 1024);
+
+    resource.deallocate(first, 100);
+    resource.deallocate(second, 1000);
+    EXPECT_EQ(resource.allocated_bytes(), 0);
+}
+
+TEST_F(TieredMemoryResourceTest, CoalescesFreeBlocks)
+{
+    auto resource = TieredMemoryResource{MemoryTier::Far, 4096};
+
+    auto *first = resource.allocate(1024);
+    auto *second = resource.allocate(1024);
+    auto *third = resource.allocate(1024);
+    resource.deallocate(first, 1024);
+    resource.deallocate(second, 1024);
+
+    // The two freed neighbors form a block large enough for this allocation.
+    EXPECT_EQ(resource.allocate(2048), first);
+
+    resource.deallocate(first, 2048);
+    resource.deallocate(third, 1024);
+    EXPECT_EQ(resource.allocate(4096), first);
+}
+
+TEST_F(TieredMemoryResourceTest, FallsBackWhenFull)
+{
+    auto resource = TieredMemoryResource{MemoryTier::Far, 4096};
+
+    auto *in_tier = resource.allocate(4096);
+    auto *fallback = resource.allocate(100);
+    EXPECT_TRUE(resource.contains(in_tier));
+    EXPECT_FALSE(resource.contains(fallback));
+    EXPECT_EQ(resource.fallback_bytes(), 100);
+
+    resource.deallocate(fallback, 100);
+    EXPECT_EQ(resource.fallback_bytes(), 0);
+    resource.deallocate(in_tier, 4096);
+}
+
+TEST_F(TieredMemoryResourceTest, TierResources)
+{
+    EXPECT_EQ(get_memory_tier_resource(MemoryTier::Near),
+              boost::container::pmr::get_default_resource());
+
+    auto values = pmr_vector<int32_t>{
+        100, PolymorphicAllocator<int32_t>{
+                 get_memory_tier_resource(MemoryTier::Far)}};
+    ASSERT_TRUE(get_far_memory_tier());
+    EXPECT_TRUE(get_far_memory_tier()->contains(values.data()));
+    EXPECT_EQ(get_memory_tier_resource(MemoryTier::Far), get_far_memory_tier());
+}
+
+} // namespace hyrise
@@ -95,6 +95,28 @@ TEST_F(JoinHashStepsTest, SmallHashTableAllPositions)
     }
 }
 
+TEST_F(JoinHashStepsTest, HashTableRanges)
+{
+    auto table = PosHashTable<int64_t>{JoinHashBuildMode::AllPositions, 50};
+    for (auto index = uint32_t{0}; index < 10; ++index)
+    {
+        table.emplace(int64_t{index},
+                      RowID{ChunkID{100u + index}, ChunkOffset{200u + index}});
+    }
+    table.finalize();
+
+    // The stages of the batched probe yield the same ranges as find().
+    const auto range_index = table.find_range(5);
+    ASSERT_TRUE(range_index);
+    table.prefetch_range(*range_index);
+    table.prefetch_positions(*range_index);
+    EXPECT_EQ(table.range(range_index), table.find(5));
+
+    EXPECT_FALSE(table.find_range(1000));
+    const auto [iter, end] = table.range(std::nullopt);
+    EXPECT_EQ(iter, end);
+}
+
 TEST_F(JoinHashStepsTest, LargeHashTableExistenceOnly)
 {
     auto table = PosHashTable<int64_t>{JoinHashBuildMode::ExistenceOnly, 100};
@@ -393,6 +415,76 @@ TEST_F(JoinHashStepsTest, BuildRespectsBloomFilter)
     EXPECT_FALSE(hash_table->contains(18));
 }
 
+TEST_F(JoinHashStepsTest, BatchedProbe)
+{
+    std::vector<std::vector<size_t>> histograms; // Ignored in this test
+    BloomFilter bloom_filter;                    // Ignored in this test
+
+    const auto build_container = materialize_input<int, int, false>(
+        _table_with_nulls_and_zeros->get_output(), ColumnID{0}, histograms, 0,
+        bloom_filter);
+    const auto hash_tables = build<int, int>(
+        build_container, JoinHashBuildMode::AllPositions, 0,
+        ALL_TRUE_BLOOM_FILTER);
+
+    // Merge the partitions of the probe side (one per chunk) so that the
+    // partition spans several batches, the last one being incomplete.
+    const auto materialized_probe_column = materialize_input<int, int, true>(
+        _table_zero_one, ColumnID{0}, histograms, 0, bloom_filter);
+    auto probe_container = RadixContainer<int>(1);
+    for (const auto &partition : materialized_probe_column)
+    {
+        for (auto offset = size_t{0}; offset < partition.elements.size();
+             ++offset)
+        {
+            probe_container[0].elements.push_back(partition.elements[offset]);
+            probe_container[0].null_values.push_back(
+                partition.null_values[offset]);
+        }
+    }
+    ASSERT_EQ(probe_container[0].elements.size() % JoinHash::PROBE_BATCH_SIZE,
+              8);
+
+    for (const auto mode : {JoinMode::Inner, JoinMode::Left})
+    {
+        auto expected_pos_lists_build_side =
+            std::vector<RowIDPosList>(probe_container.size());
+        auto expected_pos_lists_probe_side =
+            std::vector<RowIDPosList>(probe_container.size());
+        auto pos_lists_build_side =
+            std::vector<RowIDPosList>(probe_container.size());
+        auto pos_lists_probe_side =
+            std::vector<RowIDPosList>(probe_container.size());
+
+        const auto &build_table = *_table_with_nulls_and_zeros->get_output();
+        if (mode == JoinMode::Inner)
+        {
+            probe<int, int, false>(
+                probe_container, hash_tables, expected_pos_lists_build_side,
+                expected_pos_lists_probe_side, mode, build_table,
+                *_table_zero_one, {});
+            probe<int, int, false>(probe_container, hash_tables,
+                                   pos_lists_build_side, pos_lists_probe_side,
+                                   mode, build_table, *_table_zero_one, {},
+                                   true);
+        }
+        else
+        {
+            probe<int, int, true>(
+                probe_container, hash_tables, expected_pos_lists_build_side,
+                expected_pos_lists_probe_side, mode, build_table,
+                *_table_zero_one, {});
+            probe<int, int, true>(probe_container, hash_tables,
+                                  pos_lists_build_side, pos_lists_probe_side,
+                                  mode, build_table, *_table_zero_one, {},
+                                  true);
+        }
+
+        EXPECT_EQ(pos_lists_build_side, expected_pos_lists_build_side);
+        EXPECT_EQ(pos_lists_probe_side, expected_pos_lists_probe_side);
+    }
+}
+
 TEST_F(JoinHashStepsTest, ThrowWhenNoNullValuesArePassed)
 {
     if constexpr (!HYRISE_DEBUG)
@@ -153,4 +153,19 @@ TEST_F(OperatorsJoinHashTest, RadixBitCalculation)
         0);
 }
 
+TEST_F(OperatorsJoinHashTest, BatchedProbeSelection)
+{
+    // Hash tables that fit into the cache are probed value by value.
+    EXPECT_FALSE(JoinHash::use_batched_probe(0, 0));
+    EXPECT_FALSE(JoinHash::use_batched_probe(1'000, 0));
+    EXPECT_FALSE(JoinHash::use_batched_probe(
+        1'000'000, JoinHash::calculate_radix_bits(1'000'000, 1'000'000)));
+
+    // Once the fan out is capped, the partitions' hash tables exceed the cache.
+    const auto build_side_size = size_t{1'000'000'000};
+    const auto radix_bits =
+        JoinHash::calculate_radix_bits(build_side_size, build_side_size);
+    EXPECT_TRUE(JoinHash::use_batched_probe(build_side_size, radix_bits));
+}
+
 } // namespace hyrise
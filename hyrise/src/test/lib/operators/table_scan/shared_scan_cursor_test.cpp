@@ -0,0 +1,147 @@
+#include <memory>
+#include <vector>
+
+#include "base_test.hpp"
+
+#include "expression/expression_functional.hpp"
+#include "hyrise.hpp"
+#include "operators/table_scan.hpp"
+#include "operators/table_scan/shared_scan_cursor.hpp"
+#include "operators/table_wrapper.hpp"
+
+namespace hyrise
+{
+
+using namespace expression_functional; // NOLINT(build/namespaces)
+
+class SharedScanCursorTest : public BaseTest
+{
+};
+
+TEST_F(SharedScanCursorTest, SingleScanVisitsAllChunks)
+{
+    auto cursor = SharedScanCursor{};
+    auto visited_chunk_ids = std::vector<ChunkID>{};
+    const auto scan_id =
+        cursor.attach({ChunkID{0}, ChunkID{1}, ChunkID{2}},
+                      [&](const ChunkID chunk_id)
+                      { visited_chunk_ids.push_back(chunk_id); });
+    EXPECT_EQ(cursor.attached_scan_count(), 1);
+
+    while (cursor.process_next_chunk(scan_id))
+    {
+    }
+    const auto statistics = cursor.detach(scan_id);
+
+    EXPECT_EQ(visited_chunk_ids,
+              std::vector<ChunkID>({ChunkID{0}, ChunkID{1}, ChunkID{2}}));
+    EXPECT_EQ(statistics.visited_chunk_count, 3);
+    EXPECT_EQ(statistics.shared_chunk_count, 0);
+    EXPECT_EQ(cursor.attached_scan_count(), 0);
+}
+
+TEST_F(SharedScanCursorTest, SkipsExcludedChunks)
+{
+    auto cursor = SharedScanCursor{};
+    auto visited_chunk_ids = std::vector<ChunkID>{};
+    const auto scan_id =
+        cursor.attach({ChunkID{1}, ChunkID{3}},
+                      [&](const ChunkID chunk_id)
+                      { visited_chunk_ids.push_back(chunk_id); });
+
+    while (cursor.process_next_chunk(scan_id))
+    {
+    }
+    cursor.detach(scan_id);
+
+    EXPECT_EQ(visited_chunk_ids,
+              std::vector<ChunkID>({ChunkID{1}, ChunkID{3}}));
+    EXPECT_EQ(cursor.read_chunk_count(), 2);
+}
+
+TEST_F(SharedScanCursorTest, ScanAttachedMidPassWrapsAround)
+{
+    auto cursor = SharedScanCursor{};
+    const auto all_chunk_ids = std::vector<ChunkID>{ChunkID{0}, ChunkID{1},
+                                                    ChunkID{2}, ChunkID{3}};
+    auto first_chunk_ids = std::vector<ChunkID>{};
+    auto second_chunk_ids = std::vector<ChunkID>{};
+    const auto first_scan_id = cursor.attach(
+        all_chunk_ids, [&](const ChunkID chunk_id)
+        { first_chunk_ids.push_back(chunk_id); });
+
+    EXPECT_TRUE(cursor.process_next_chunk(first_scan_id));
+    EXPECT_TRUE(cursor.process_next_chunk(first_scan_id));
+    EXPECT_EQ(cursor.position(), ChunkID{2});
+
+    // The second scan joins at chunk 2 and is served by the jobs of the first
+    // one until that has all of its chunks.
+    const auto second_scan_id = cursor.attach(
+        all_chunk_ids, [&](const ChunkID chunk_id)
+        { second_chunk_ids.push_back(chunk_id); });
+    while (cursor.process_next_chunk(first_scan_id))
+    {
+    }
+    const auto first_statistics = cursor.detach(first_scan_id);
+
+    while (cursor.process_next_chunk(second_scan_id))
+    {
+    }
+    const auto second_statistics = cursor.detach(second_scan_id);
+
+    EXPECT_EQ(first_chunk_ids, all_chunk_ids);
+    EXPECT_EQ(second_chunk_ids,
+              std::vector<ChunkID>(
+                  {ChunkID{2}, ChunkID{3}, ChunkID{0}, ChunkID{1}}));
+    EXPECT_EQ(first_statistics.shared_chunk_count, 2);
+    EXPECT_EQ(second_statistics.shared_chunk_count, 2);
+
+    // Six chunk reads instead of eight.
+    EXPECT_EQ(cursor.read_chunk_count(), 6);
+    EXPECT_EQ(cursor.visited_chunk_count(), 8);
+}
+
+TEST_F(SharedScanCursorTest, RegistryReusesCursorWhileInUse)
+{
+    auto &registry = Hyrise::get().shared_scans;
+    EXPECT_FALSE(registry.is_enabled());
+
+    const auto table = load_table("resources/test_data/tbl/int_float.tbl",
+                                  ChunkOffset{2});
+    auto cursor = registry.get_cursor(table);
+    EXPECT_EQ(registry.get_cursor(table), cursor);
+
+    const auto scan_id = cursor->attach({ChunkID{0}}, [](const ChunkID) {});
+    EXPECT_TRUE(cursor->process_next_chunk(scan_id));
+    cursor->detach(scan_id);
+    EXPECT_EQ(cursor->read_chunk_count(), 1);
+
+    // Once no scan holds the cursor, the next scan of the table starts anew.
+    cursor.reset();
+    EXPECT_EQ(registry.get_cursor(table)->read_chunk_count(), 0);
+}
+
+TEST_F(SharedScanCursorTest, TableScanResultIsUnchanged)
+{
+    const auto table = load_table("resources/test_data/tbl/int_float.tbl",
+                                  ChunkOffset{1});
+    const auto table_wrapper = std::make_shared<TableWrapper>(table);
+    table_wrapper->never_clear_output();
+    table_wrapper->execute();
+
+    const auto predicate =
+        greater_than_equals_(pqp_column_(ColumnID{0}, DataType::Int, false,
+                                         "a"),
+                             1234);
+    const auto scan = std::make_shared<TableScan>(table_wrapper, predicate);
+    scan->execute();
+
+    Hyrise::get().shared_scans.set_enabled(true);
+    const auto shared_scan =
+        std::make_shared<TableScan>(table_wrapper, predicate);
+    shared_scan->execute();
+
+    EXPECT_TABLE_EQ_UNORDERED(shared_scan->get_output(), scan->get_output());
+}
+
+} // namespace hyrise
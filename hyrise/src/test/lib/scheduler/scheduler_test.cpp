@@ -1,5 +1,7 @@
+#include <atomic>
 #include <chrono>
 #include <memory>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -10,6 +12,7 @@
 #include "hyrise.hpp"
 #include "operators/get_table.hpp"
 #include "operators/table_scan.hpp"
+#include "scheduler/far_memory_bandwidth_budget.hpp"
 #include "scheduler/immediate_execution_scheduler.hpp"
 #include "scheduler/job_task.hpp"
 #include "scheduler/node_queue_scheduler.hpp"
@@ -387,6 +390,55 @@ TEST_F(SchedulerTest, SingleWorkerGuaranteeProgress)
     Hyrise::get().scheduler()->finish();
 }
 
+TEST_F(SchedulerTest, FarMemoryBudgetLimitsConcurrency)
+{
+    Hyrise::get().topology.use_fake_numa_topology(8, 4);
+    const auto node_queue_scheduler = std::make_shared<NodeQueueScheduler>();
+    Hyrise::get().set_scheduler(node_queue_scheduler);
+    node_queue_scheduler->far_memory_budget().configure(2'000, 1'000);
+
+    auto running_far_tasks = std::atomic_uint32_t{0};
+    auto max_running_far_tasks = std::atomic_uint32_t{0};
+    auto finished_tasks = std::atomic_uint32_t{0};
+
+    auto tasks = std::vector<std::shared_ptr<AbstractTask>>{};
+    for (auto task_id = 0; task_id < 32; ++task_id)
+    {
+        const auto memory_tier =
+            task_id % 2 == 0 ? MemoryTier::Far : MemoryTier::Near;
+        auto task = std::make_shared<JobTask>(
+            [&, memory_tier]()
+            {
+                if (memory_tier == MemoryTier::Far)
+                {
+                    const auto running = ++running_far_tasks;
+                    auto max_running = max_running_far_tasks.load();
+                    while (running > max_running &&
+                           !max_running_far_tasks.compare_exchange_weak(
+                               max_running, running))
+                    {
+                    }
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                    --running_far_tasks;
+                }
+                ++finished_tasks;
+            });
+        task->set_memory_tier(memory_tier);
+        tasks.emplace_back(std::move(task));
+    }
+
+    node_queue_scheduler->schedule_and_wait_for_tasks(tasks);
+    EXPECT_EQ(finished_tasks, 32u);
+    EXPECT_GE(max_running_far_tasks, 1u);
+    EXPECT_LE(max_running_far_tasks, 2u);
+
+    // Workers release their slot after the task is done, so we check the
+    // budget once they have stopped.
+    Hyrise::get().scheduler()->finish();
+    EXPECT_EQ(node_queue_scheduler->far_memory_budget().active_task_count(),
+              size_t{0});
+}
+
 TEST_F(SchedulerTest, DetermineQueueIDForTask)
 {
     if (std::thread::hardware_concurrency() < 2)
@@ -1,5 +1,6 @@
 #include "base_test.hpp"
 
+#include "scheduler/far_memory_bandwidth_budget.hpp"
 #include "scheduler/job_task.hpp"
 #include "scheduler/task_queue.hpp"
 
@@ -42,4 +43,63 @@ TEST_F(TaskQueueTest, EstimateLoad)
     EXPECT_EQ(task_queue.estimate_load(), size_t{3});
 }
 
+TEST_F(TaskQueueTest, FarMemoryTasksWaitForBudget)
+{
+    const auto budget = std::make_shared<FarMemoryBandwidthBudget>();
+    budget->configure(10'000, 10'000);
+    auto task_queue = TaskQueue{NodeID{0}, budget};
+
+    const auto make_task = [](const MemoryTier memory_tier)
+    {
+        auto task = std::make_shared<JobTask>([]() { return; });
+        task->set_memory_tier(memory_tier);
+        return task;
+    };
+
+    const auto far_task_1 = make_task(MemoryTier::Far);
+    const auto far_task_2 = make_task(MemoryTier::Far);
+    const auto near_task = make_task(MemoryTier::Near);
+    task_queue.push(far_task_1, SchedulePriority::Default);
+    task_queue.push(far_task_2, SchedulePriority::Default);
+    task_queue.push(near_task, SchedulePriority::Default);
+    EXPECT_EQ(task_queue.estimate_load(), size_t{3});
+
+    // Near-memory tasks are pulled first.
+    EXPECT_EQ(task_queue.pull(), near_task);
+    EXPECT_EQ(task_queue.pull(), far_task_1);
+    EXPECT_EQ(budget->active_task_count(), size_t{1});
+
+    // The budget allows a single far-memory task at a time.
+    EXPECT_FALSE(task_queue.pull());
+    EXPECT_FALSE(task_queue.steal());
+    EXPECT_TRUE(task_queue.has_far_memory_tasks());
+    EXPECT_FALSE(task_queue.empty());
+
+    task_queue.release_far_memory_slot(*far_task_1);
+    EXPECT_EQ(task_queue.pull(), far_task_2);
+    EXPECT_TRUE(task_queue.empty());
+}
+
+TEST_F(TaskQueueTest, FarMemoryBandwidthBudget)
+{
+    auto budget = FarMemoryBandwidthBudget{};
+    EXPECT_EQ(budget.max_task_count(), size_t{0});
+
+    // A budget without limit still counts the running far-memory tasks.
+    EXPECT_TRUE(budget.try_acquire());
+    EXPECT_EQ(budget.active_task_count(), size_t{1});
+    budget.release();
+
+    // Three tasks of 4 GB/s each saturate a 10 GB/s link.
+    budget.configure(10'000'000'000, 4'000'000'000);
+    EXPECT_EQ(budget.max_task_count(), size_t{3});
+
+    budget.configure(1'000, 4'000);
+    EXPECT_EQ(budget.max_task_count(), size_t{1});
+    EXPECT_TRUE(budget.try_acquire());
+    EXPECT_FALSE(budget.try_acquire());
+    budget.release();
+    EXPECT_EQ(budget.active_task_count(), size_t{0});
+}
+
 } // namespace hyrise
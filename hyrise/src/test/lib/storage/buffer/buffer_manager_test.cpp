@@ -0,0 +1,306 @@
+#include <chrono>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+#include "base_test.hpp"
+
+#include "storage/buffer/buffer_manager.hpp"
+#include "storage/value_segment.hpp"
+
+namespace hyrise
+{
+
+class BufferManagerTest : public BaseTest
+{
+  public:
+    static constexpr auto PAGE_SIZE_TYPE = PageSizeType::KiB16;
+    static constexpr auto PAGE_BYTES = bytes_for_size_type(PAGE_SIZE_TYPE);
+    static constexpr auto VIRTUAL_CAPACITY = size_t{64} * 1024 * 1024;
+
+    // Without the eviction thread, pages loaded by page faults are evicted
+    // only by evict_to_capacity(), which keeps the tests deterministic.
+    static constexpr auto NO_EVICTION_THREAD = std::chrono::milliseconds{0};
+
+  protected:
+    // Reads through a volatile pointer, so that every access reaches the page.
+    static int32_t _read(const BufferManager &buffer_manager,
+                         const PageID page_id, const size_t offset = 0)
+    {
+        return reinterpret_cast<volatile int32_t *>(
+            buffer_manager.page_address(page_id))[offset];
+    }
+
+    static void _write(const BufferManager &buffer_manager,
+                       const PageID page_id, const int32_t value,
+                       const size_t offset = 0)
+    {
+        reinterpret_cast<volatile int32_t *>(
+            buffer_manager.page_address(page_id))[offset] = value;
+    }
+};
+
+TEST_F(BufferManagerTest, AllocateAndFindPages)
+{
+    auto buffer_manager = BufferManager{4 * PAGE_BYTES, VIRTUAL_CAPACITY,
+                                        NO_EVICTION_THREAD};
+    const auto page_id = buffer_manager.allocate_page(PAGE_SIZE_TYPE);
+    EXPECT_EQ(page_id.size_type(), PAGE_SIZE_TYPE);
+    EXPECT_EQ(buffer_manager.resident_bytes(), PAGE_BYTES);
+    EXPECT_EQ(buffer_manager.page_tier(page_id), MemoryTier::Near);
+
+    // New pages are zeroed.
+    EXPECT_EQ(_read(buffer_manager, page_id, 100), 0);
+
+    const auto *address = buffer_manager.page_address(page_id);
+    EXPECT_EQ(buffer_manager.find_page(address), page_id);
+    EXPECT_EQ(buffer_manager.find_page(address + PAGE_BYTES - 1), page_id);
+    EXPECT_NE(buffer_manager.find_page(address + PAGE_BYTES), page_id);
+    const auto value = 17;
+    EXPECT_EQ(buffer_manager.find_page(&value), INVALID_PAGE_ID);
+
+    buffer_manager.deallocate_page(page_id);
+    EXPECT_EQ(buffer_manager.resident_bytes(), size_t{0});
+
+    // Freed pages are reused.
+    EXPECT_EQ(buffer_manager.allocate_page(PAGE_SIZE_TYPE), page_id);
+}
+
+TEST_F(BufferManagerTest, OnlyOneActiveBufferManager)
+{
+    auto buffer_manager = BufferManager{PAGE_BYTES, VIRTUAL_CAPACITY};
+    EXPECT_THROW(BufferManager(PAGE_BYTES, VIRTUAL_CAPACITY),
+                 std::logic_error);
+}
+
+TEST_F(BufferManagerTest, EvictToFarTierAndLoadOnAccess)
+{
+    auto buffer_manager = BufferManager{4 * PAGE_BYTES, VIRTUAL_CAPACITY,
+                                        NO_EVICTION_THREAD};
+    auto page_ids = std::vector<PageID>{};
+    for (auto page_index = 0; page_index < 16; ++page_index)
+    {
+        const auto page_id = buffer_manager.allocate_page(PAGE_SIZE_TYPE);
+        _write(buffer_manager, page_id, page_index);
+        _write(buffer_manager, page_id, -page_index, PAGE_BYTES / 4 - 1);
+        page_ids.push_back(page_id);
+    }
+
+    EXPECT_LE(buffer_manager.resident_bytes(), 4 * PAGE_BYTES);
+    EXPECT_EQ(buffer_manager.page_tier(page_ids.front()), MemoryTier::Far);
+    EXPECT_EQ(buffer_manager.page_tier(page_ids.back()), MemoryTier::Near);
+    const auto &metrics = buffer_manager.metrics();
+    EXPECT_GE(metrics.page_evictions.load(), size_t{12});
+
+    // Evicted pages are loaded transparently when they are accessed.
+    for (auto page_index = 0; page_index < 16; ++page_index)
+    {
+        EXPECT_EQ(_read(buffer_manager, page_ids[page_index]), page_index);
+        EXPECT_EQ(_read(buffer_manager, page_ids[page_index],
+                        PAGE_BYTES / 4 - 1),
+                  -page_index);
+    }
+    EXPECT_GE(metrics.page_loads.load(), size_t{12});
+    EXPECT_EQ(metrics.bytes_read_from_far.load(),
+              metrics.page_loads.load() * PAGE_BYTES);
+
+    // Page faults do not evict, the eviction thread (or here, the test) does.
+    EXPECT_GT(buffer_manager.resident_bytes(), 4 * PAGE_BYTES);
+    buffer_manager.evict_to_capacity();
+    EXPECT_LE(buffer_manager.resident_bytes(), 4 * PAGE_BYTES);
+
+    // Writes to loaded pages are not lost on the next eviction.
+    _write(buffer_manager, page_ids[0], 42);
+    for (const auto page_id : page_ids)
+    {
+        _read(buffer_manager, page_id);
+    }
+    buffer_manager.evict_to_capacity();
+    EXPECT_EQ(buffer_manager.page_tier(page_ids[0]), MemoryTier::Far);
+    EXPECT_EQ(_read(buffer_manager, page_ids[0]), 42);
+
+    for (const auto page_id : page_ids)
+    {
+        buffer_manager.deallocate_page(page_id);
+    }
+    EXPECT_EQ(buffer_manager.resident_bytes(), size_t{0});
+}
+
+TEST_F(BufferManagerTest, CleanPagesAreNotWrittenBack)
+{
+    auto buffer_manager = BufferManager{2 * PAGE_BYTES, VIRTUAL_CAPACITY,
+                                        NO_EVICTION_THREAD};
+    auto page_ids = std::vector<PageID>{};
+    for (auto page_index = 0; page_index < 4; ++page_index)
+    {
+        page_ids.push_back(buffer_manager.allocate_page(PAGE_SIZE_TYPE));
+    }
+    for (const auto page_id : page_ids)
+    {
+        _read(buffer_manager, page_id);
+        buffer_manager.evict_to_capacity();
+    }
+
+    // From now on, all pages have an up-to-date copy in the far tier.
+    const auto &metrics = buffer_manager.metrics();
+    const auto bytes_written_to_far = metrics.bytes_written_to_far.load();
+    const auto page_evictions = metrics.page_evictions.load();
+    for (auto round = 0; round < 3; ++round)
+    {
+        for (const auto page_id : page_ids)
+        {
+            _read(buffer_manager, page_id);
+            buffer_manager.evict_to_capacity();
+        }
+    }
+    EXPECT_GT(metrics.page_evictions.load(), page_evictions);
+    EXPECT_EQ(metrics.bytes_written_to_far.load(), bytes_written_to_far);
+}
+
+TEST_F(BufferManagerTest, SecondChanceKeepsHotPages)
+{
+    auto buffer_manager = BufferManager{4 * PAGE_BYTES, VIRTUAL_CAPACITY,
+                                        NO_EVICTION_THREAD};
+    auto page_ids = std::vector<PageID>{};
+    for (auto page_index = 0; page_index < 8; ++page_index)
+    {
+        page_ids.push_back(buffer_manager.allocate_page(PAGE_SIZE_TYPE));
+    }
+
+    // The first page is accessed between all other accesses. It is marked by
+    // the eviction loop, but the next access gives it a second chance.
+    for (auto round = 0; round < 10; ++round)
+    {
+        for (auto page_index = size_t{1}; page_index < 8; ++page_index)
+        {
+            _read(buffer_manager, page_ids[0]);
+            _read(buffer_manager, page_ids[page_index]);
+            buffer_manager.evict_to_capacity();
+        }
+    }
+    const auto &metrics = buffer_manager.metrics();
+    EXPECT_GT(metrics.soft_faults.load(), size_t{0});
+    EXPECT_EQ(buffer_manager.page_tier(page_ids[0]), MemoryTier::Near);
+    EXPECT_LT(metrics.page_loads.load(), size_t{10 * 8});
+}
+
+TEST_F(BufferManagerTest, PinnedPagesAreNotEvicted)
+{
+    auto buffer_manager = BufferManager{2 * PAGE_BYTES, VIRTUAL_CAPACITY,
+                                        NO_EVICTION_THREAD};
+    const auto shared_page_id = buffer_manager.allocate_page(PAGE_SIZE_TYPE);
+    const auto exclusive_page_id =
+        buffer_manager.allocate_page(PAGE_SIZE_TYPE);
+    buffer_manager.pin_shared(shared_page_id);
+    buffer_manager.pin_exclusive(exclusive_page_id);
+    _write(buffer_manager, exclusive_page_id, 7);
+
+    // The near capacity is exceeded, as no page can be evicted.
+    const auto page_id = buffer_manager.allocate_page(PAGE_SIZE_TYPE);
+    EXPECT_EQ(buffer_manager.resident_bytes(), 3 * PAGE_BYTES);
+    EXPECT_EQ(buffer_manager.page_tier(shared_page_id), MemoryTier::Near);
+    EXPECT_EQ(buffer_manager.page_tier(exclusive_page_id), MemoryTier::Near);
+    EXPECT_TRUE(buffer_manager.frame(exclusive_page_id).is_dirty());
+
+    buffer_manager.unpin_shared(shared_page_id);
+    buffer_manager.unpin_exclusive(exclusive_page_id);
+    buffer_manager.deallocate_page(page_id);
+    for (auto page_index = 0; page_index < 2; ++page_index)
+    {
+        _read(buffer_manager, buffer_manager.allocate_page(PAGE_SIZE_TYPE));
+    }
+    EXPECT_LE(buffer_manager.resident_bytes(), 2 * PAGE_BYTES);
+    EXPECT_EQ(buffer_manager.page_tier(exclusive_page_id), MemoryTier::Far);
+
+    // Pinning loads evicted pages.
+    buffer_manager.pin_shared(exclusive_page_id);
+    EXPECT_EQ(buffer_manager.page_tier(exclusive_page_id), MemoryTier::Near);
+    EXPECT_EQ(_read(buffer_manager, exclusive_page_id), 7);
+    buffer_manager.unpin_shared(exclusive_page_id);
+}
+
+TEST_F(BufferManagerTest, EvictionThreadEnforcesNearCapacity)
+{
+    // More pages than the ring buffer of loaded pages holds, so that the
+    // eviction thread also has to scan the frames for them.
+    const auto page_count = BufferManager::LOADED_PAGES_CAPACITY + 1000;
+    auto buffer_manager = BufferManager{16 * OS_PAGE_SIZE, VIRTUAL_CAPACITY};
+    auto page_ids = std::vector<PageID>{};
+    for (auto page_index = size_t{0}; page_index < page_count; ++page_index)
+    {
+        const auto page_id = buffer_manager.allocate_page(MIN_PAGE_SIZE_TYPE);
+        _write(buffer_manager, page_id, static_cast<int32_t>(page_index));
+        page_ids.push_back(page_id);
+    }
+
+    auto threads = std::vector<std::thread>{};
+    auto wrong_values = std::atomic<size_t>{0};
+    for (auto thread_index = size_t{0}; thread_index < 4; ++thread_index)
+    {
+        threads.emplace_back(
+            [&, thread_index]
+            {
+                for (auto page_index = thread_index; page_index < page_count;
+                     page_index += 2)
+                {
+                    if (_read(buffer_manager, page_ids[page_index]) !=
+                        static_cast<int32_t>(page_index))
+                    {
+                        ++wrong_values;
+                    }
+                }
+            });
+    }
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+    EXPECT_EQ(wrong_values.load(), size_t{0});
+
+    for (auto attempt = 0; attempt < 1000 && buffer_manager.resident_bytes() >
+                                                 16 * OS_PAGE_SIZE;
+         ++attempt)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    }
+    EXPECT_LE(buffer_manager.resident_bytes(), 16 * OS_PAGE_SIZE);
+}
+
+TEST_F(BufferManagerTest, SegmentsBackedByPages)
+{
+    // Each segment fills a 512 KiB page, but only one of them fits into the
+    // near tier.
+    const auto row_count = size_t{100'000};
+    auto buffer_manager =
+        BufferManager{bytes_for_size_type(PageSizeType::KiB512) + PAGE_BYTES,
+                      VIRTUAL_CAPACITY};
+    auto values = pmr_vector<int32_t>(row_count);
+    std::iota(values.begin(), values.end(), 0);
+    const auto value_segment =
+        std::make_shared<ValueSegment<int32_t>>(std::move(values));
+
+    const auto allocator =
+        PolymorphicAllocator<size_t>{buffer_manager.memory_resource()};
+    const auto first_segment = std::static_pointer_cast<ValueSegment<int32_t>>(
+        value_segment->copy_using_allocator(allocator));
+    const auto second_segment = std::static_pointer_cast<ValueSegment<int32_t>>(
+        value_segment->copy_using_allocator(allocator));
+    EXPECT_TRUE(
+        buffer_manager.find_page(first_segment->values().data()).valid());
+
+    const auto expected_sum = static_cast<int64_t>(row_count) *
+                              static_cast<int64_t>(row_count - 1) / 2;
+    for (auto round = 0; round < 2; ++round)
+    {
+        for (const auto &segment : {first_segment, second_segment})
+        {
+            const auto &segment_values = segment->values();
+            EXPECT_EQ(std::accumulate(segment_values.cbegin(),
+                                      segment_values.cend(), int64_t{0}),
+                      expected_sum);
+        }
+    }
+    EXPECT_GT(buffer_manager.metrics().page_loads.load(), size_t{0});
+}
+
+} // namespace hyrise
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <cstdint>
 #include <map>
 #include <memory>
@@ -6,14 +7,17 @@
 #include "base_test.hpp"
 
 #include "all_type_variant.hpp"
+#include "memory/tiered_memory_resource.hpp"
 #include "operators/table_scan.hpp"
 #include "operators/table_wrapper.hpp"
 #include "storage/abstract_encoded_segment.hpp"
 #include "storage/base_value_segment.hpp"
 #include "storage/chunk.hpp"
 #include "storage/chunk_encoder.hpp"
+#include "storage/dictionary_segment.hpp"
 #include "storage/segment_encoding_utils.hpp"
 #include "storage/table.hpp"
+#include "storage/value_segment.hpp"
 
 namespace hyrise
 {
@@ -119,6 +123,121 @@ TEST_F(ChunkEncoderTest, UnencodeEncodedSegments)
     assert_chunk_encoding(chunk, chunk_unencoding_spec);
 }
 
+TEST_F(ChunkEncoderTest, PlaceSegmentsInMemoryTiers)
+{
+    const auto column_data_types = _table->column_data_types();
+    const auto chunk = _table->get_chunk(ChunkID{0});
+
+    const auto chunk_encoding_spec =
+        ChunkEncodingSpec{SegmentEncodingSpec{EncodingType::Dictionary},
+                          SegmentEncodingSpec{EncodingType::Unencoded},
+                          SegmentEncodingSpec{EncodingType::Dictionary}};
+    const auto in_far_tier = [&](const ColumnID column_id)
+    {
+        const auto segment = chunk->get_segment(column_id);
+        if (const auto dictionary_segment =
+                std::dynamic_pointer_cast<DictionarySegment<int32_t>>(segment))
+        {
+            return get_far_memory_tier()->contains(
+                dictionary_segment->dictionary()->data());
+        }
+        const auto value_segment =
+            std::dynamic_pointer_cast<ValueSegment<int32_t>>(segment);
+        return get_far_memory_tier()->contains(value_segment->values().data());
+    };
+
+    ChunkEncoder::encode_chunk(
+        chunk, column_data_types, chunk_encoding_spec,
+        ChunkPlacementSpec{MemoryTier::Far, MemoryTier::Far, MemoryTier::Near});
+    assert_chunk_encoding(chunk, chunk_encoding_spec);
+    EXPECT_TRUE(in_far_tier(ColumnID{0}));
+    EXPECT_TRUE(in_far_tier(ColumnID{1}));
+    EXPECT_FALSE(in_far_tier(ColumnID{2}));
+
+    // Changing only the placement moves the segments
+    ChunkEncoder::encode_chunk(
+        chunk, column_data_types, chunk_encoding_spec,
+        ChunkPlacementSpec{MemoryTier::Near, MemoryTier::Far, MemoryTier::Far});
+    assert_chunk_encoding(chunk, chunk_encoding_spec);
+    EXPECT_FALSE(in_far_tier(ColumnID{0}));
+    EXPECT_TRUE(in_far_tier(ColumnID{1}));
+    EXPECT_TRUE(in_far_tier(ColumnID{2}));
+    EXPECT_EQ(chunk->get_segment(ColumnID{1})->size(), 5);
+
+    EXPECT_THROW(ChunkEncoder::encode_chunk(chunk, column_data_types,
+                                            chunk_encoding_spec,
+                                            ChunkPlacementSpec{MemoryTier::Far}),
+                 std::logic_error);
+}
+
+TEST_F(ChunkEncoderTest, EncodeSegmentForMemoryTier)
+{
+    auto values = pmr_vector<int32_t>(10'000);
+    for (auto index = size_t{0}; index < values.size(); ++index)
+    {
+        values[index] = static_cast<int32_t>(index % 16);
+    }
+    const auto segment =
+        std::make_shared<ValueSegment<int32_t>>(std::move(values));
+
+    auto policy = TieredEncodingPolicy{};
+    policy.set_scan_bandwidth(MemoryTier::Near, size_t{1} << 60);
+    policy.set_scan_bandwidth(MemoryTier::Far, 1'000);
+
+    // If reading is (almost) free, decoding dominates and values are best
+    // left unencoded.
+    const auto near_result = ChunkEncoder::encode_segment_for_tier(
+        segment, DataType::Int, MemoryTier::Near, policy);
+    EXPECT_EQ(near_result.encoding_spec.encoding_type, EncodingType::Unencoded);
+    EXPECT_EQ(near_result.encoded_bytes, near_result.original_bytes);
+    EXPECT_NE(near_result.segment, segment);
+
+    // If reading is expensive, the smallest encoding wins.
+    const auto far_result = ChunkEncoder::encode_segment_for_tier(
+        segment, DataType::Int, MemoryTier::Far, policy);
+    EXPECT_NE(far_result.encoding_spec.encoding_type, EncodingType::Unencoded);
+    EXPECT_EQ(get_segment_encoding_spec(far_result.segment),
+              far_result.encoding_spec);
+    EXPECT_EQ(get_segment_memory_tier(*far_result.segment), MemoryTier::Far);
+    EXPECT_GT(far_result.compression_ratio(), 4.0);
+    EXPECT_EQ(far_result.segment->size(), segment->size());
+    EXPECT_EQ((*far_result.segment)[ChunkOffset{9'999}], AllTypeVariant{15});
+}
+
+TEST_F(ChunkEncoderTest, TieredEncodingPolicy)
+{
+    auto policy = TieredEncodingPolicy{};
+    policy.set_scan_bandwidth(MemoryTier::Far, 1'000'000'000);
+    policy.set_decode_cost(EncodingType::Dictionary, 2.0);
+
+    // 1000 bytes take 1000 ns at 1 GB/s, decoding 100 values 200 ns.
+    const auto dictionary_spec = SegmentEncodingSpec{
+        EncodingType::Dictionary, VectorCompressionType::FixedWidthInteger};
+    EXPECT_DOUBLE_EQ(policy.estimate_scan_cost(dictionary_spec, 1'000, 100,
+                                               MemoryTier::Far),
+                     1'200.0);
+    EXPECT_DOUBLE_EQ(
+        policy.decode_cost(SegmentEncodingSpec{
+            EncodingType::Dictionary, VectorCompressionType::BitPacking}),
+        2.0 + TieredEncodingPolicy::BIT_PACKING_DECODE_COST);
+
+    const auto contains = [](const auto &specs,
+                             const EncodingType encoding_type)
+    {
+        return std::any_of(specs.cbegin(), specs.cend(),
+                           [&](const auto &spec)
+                           { return spec.encoding_type == encoding_type; });
+    };
+    const auto int_candidates = TieredEncodingPolicy::candidates(DataType::Int);
+    EXPECT_TRUE(contains(int_candidates, EncodingType::FrameOfReference));
+    EXPECT_FALSE(contains(int_candidates, EncodingType::FixedStringDictionary));
+    const auto string_candidates =
+        TieredEncodingPolicy::candidates(DataType::String);
+    EXPECT_TRUE(
+        contains(string_candidates, EncodingType::FixedStringDictionary));
+    EXPECT_TRUE(contains(string_candidates, EncodingType::LZ4));
+}
+
 TEST_F(ChunkEncoderTest, ThrowOnEncodingAMutableChunk)
 {
     const auto chunk_encoding_spec =
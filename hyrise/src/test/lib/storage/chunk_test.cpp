@@ -79,6 +79,18 @@ TEST_F(StorageChunkTest, RetrieveSegment)
     EXPECT_EQ(abstract_segment->size(), 4u);
 }
 
+TEST_F(StorageChunkTest, TryReplaceSegment)
+{
+    chunk = std::make_shared<Chunk>(Segments({vs_int, vs_str}));
+
+    EXPECT_TRUE(chunk->try_replace_segment(ColumnID{0}, vs_int, ds_int));
+    EXPECT_EQ(chunk->get_segment(ColumnID{0}), ds_int);
+
+    // The segment has been replaced already.
+    EXPECT_FALSE(chunk->try_replace_segment(ColumnID{0}, vs_int, vs_int));
+    EXPECT_EQ(chunk->get_segment(ColumnID{0}), ds_int);
+}
+
 TEST_F(StorageChunkTest, FinalizingAFinalizedChunkThrows)
 {
     chunk = std::make_shared<Chunk>(Segments({vs_int, vs_str}));
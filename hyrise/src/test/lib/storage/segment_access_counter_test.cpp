@@ -2,6 +2,8 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "base_test.hpp"
 #include "storage/create_iterable_from_segment.hpp"
@@ -239,4 +241,75 @@ TEST_F(SegmentAccessCounterTest, AccessPattern8)
     EXPECT_EQ(_access_pattern(positions), AccessPattern::Random);
 }
 
+TEST_F(SegmentAccessCounterTest, ConcurrentAdditionsAreMerged)
+{
+    SegmentAccessCounter counter;
+    auto threads = std::vector<std::thread>{};
+    for (auto thread_id = size_t{0};
+         thread_id < 2 * SegmentAccessCounter::SHARD_COUNT; ++thread_id)
+    {
+        threads.emplace_back(
+            [&]()
+            {
+                for (auto access = 0; access < 1'000; ++access)
+                {
+                    counter[AccessType::Random] += 2;
+                }
+            });
+    }
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+
+    EXPECT_EQ(counter[AccessType::Random],
+              2 * SegmentAccessCounter::SHARD_COUNT * 2'000);
+
+    // Assigning a value overwrites the sum of all shards.
+    counter[AccessType::Random] = 7;
+    EXPECT_EQ(counter[AccessType::Random], 7);
+}
+
+TEST_F(SegmentAccessCounterTest, HeatmapDisabledByDefault)
+{
+    SegmentAccessCounter counter;
+    counter.record_range(8'192, 2'048, ChunkOffset{0}, ChunkOffset{2'048});
+    EXPECT_TRUE(counter.heatmap().empty());
+}
+
+TEST_F(SegmentAccessCounterTest, Heatmap)
+{
+    SegmentAccessCounter::enable_heatmaps(true);
+
+    // 3'000 int values span three pages, the last one partially
+    auto values = pmr_vector<int32_t>(3'000);
+    const auto segment =
+        std::make_shared<ValueSegment<int32_t>>(std::move(values));
+    auto iterable = ValueSegmentIterable<int32_t>{*segment};
+    iterable.with_iterators([](auto, auto) {});
+
+    auto positions = std::make_shared<RowIDPosList>();
+    positions->push_back({ChunkID{0}, ChunkOffset{2'999}});
+    positions->push_back({ChunkID{0}, ChunkOffset{10}});
+    positions->guarantee_single_chunk();
+    iterable.with_iterators(positions, [](auto, auto) {});
+
+    SegmentAccessCounter::enable_heatmaps(false);
+
+    const auto heatmap = segment->access_counter.heatmap();
+    ASSERT_EQ(heatmap.size(), 3);
+    const auto sequential = static_cast<size_t>(AccessType::Sequential);
+    const auto monotonic = static_cast<size_t>(AccessType::Monotonic);
+    EXPECT_EQ(heatmap[0][sequential], 4'096);
+    EXPECT_EQ(heatmap[1][sequential], 4'096);
+    EXPECT_EQ(heatmap[2][sequential], 3'000 * 4 - 2 * 4'096);
+    EXPECT_EQ(heatmap[0][monotonic], 4);
+    EXPECT_EQ(heatmap[1][monotonic], 0);
+    EXPECT_EQ(heatmap[2][monotonic], 4);
+
+    // Copies keep the heatmap
+    const auto copied_counter = segment->access_counter;
+    EXPECT_EQ(copied_counter.heatmap(), heatmap);
+}
+
 } // namespace hyrise
@@ -0,0 +1,142 @@
+#include <memory>
+#include <vector>
+
+#include "base_test.hpp"
+
+#include "hyrise.hpp"
+#include "storage/reference_segment.hpp"
+#include "storage/segment_encoding_utils.hpp"
+#include "storage/value_segment.hpp"
+#include "tasks/segment_migration_task.hpp"
+#include "utils/load_table.hpp"
+
+namespace hyrise
+{
+
+class SegmentMigrationTaskTest : public BaseTest
+{
+  public:
+    void SetUp() override
+    {
+        table =
+            load_table("resources/test_data/tbl/int_int.tbl", ChunkOffset{1});
+        Hyrise::get().storage_manager.add_table("int_int", table);
+    }
+
+    bool is_in_far_tier(const std::shared_ptr<AbstractSegment> &segment)
+    {
+        const auto value_segment =
+            std::dynamic_pointer_cast<const ValueSegment<int32_t>>(segment);
+        const auto *far_tier = get_far_memory_tier();
+        return far_tier && far_tier->contains(value_segment->values().data());
+    }
+
+    std::shared_ptr<Table> table;
+};
+
+TEST_F(SegmentMigrationTaskTest, MigratesColumns)
+{
+    const auto statistics = std::make_shared<SegmentMigrationStatistics>();
+    const auto tasks = SegmentMigrationTask::make_for_table(
+        "int_int", {ColumnID{1}}, MemoryTier::Far, nullptr, statistics);
+    ASSERT_EQ(tasks.size(), 3);
+    Hyrise::get().scheduler()->schedule_and_wait_for_tasks(tasks);
+
+    EXPECT_EQ(statistics->migrated_segment_count, 3);
+    EXPECT_EQ(statistics->skipped_segment_count, 0);
+    EXPECT_GT(statistics->migrated_bytes, 0);
+    for (auto chunk_id = ChunkID{0}; chunk_id < table->chunk_count();
+         ++chunk_id)
+    {
+        const auto chunk = table->get_chunk(chunk_id);
+        EXPECT_FALSE(is_in_far_tier(chunk->get_segment(ColumnID{0})));
+        EXPECT_TRUE(is_in_far_tier(chunk->get_segment(ColumnID{1})));
+    }
+
+    // ReferenceSegments are in the tier of the segments they reference.
+    const auto pos_list = std::make_shared<RowIDPosList>(
+        RowIDPosList{RowID{ChunkID{2}, ChunkOffset{0}}});
+    pos_list->guarantee_single_chunk();
+    EXPECT_EQ(get_segment_memory_tier(
+                  ReferenceSegment{table, ColumnID{0}, pos_list}),
+              MemoryTier::Near);
+    EXPECT_EQ(get_segment_memory_tier(
+                  ReferenceSegment{table, ColumnID{1}, pos_list}),
+              MemoryTier::Far);
+
+    EXPECT_TABLE_EQ_ORDERED(
+        table, load_table("resources/test_data/tbl/int_int.tbl"));
+}
+
+TEST_F(SegmentMigrationTaskTest, RunningOperatorsKeepOldSegment)
+{
+    const auto chunk = table->get_chunk(ChunkID{0});
+    const auto old_segment = chunk->get_segment(ColumnID{0});
+
+    const auto task = std::make_shared<SegmentMigrationTask>(
+        "int_int", ChunkID{0}, std::vector<ColumnID>{ColumnID{0}},
+        MemoryTier::Far);
+    Hyrise::get().scheduler()->schedule_and_wait_for_tasks({task});
+
+    const auto &migrated_segments = task->migrated_segments();
+    ASSERT_EQ(migrated_segments.size(), 1);
+    EXPECT_EQ(chunk->get_segment(ColumnID{0}), migrated_segments[0]);
+    EXPECT_NE(old_segment, migrated_segments[0]);
+
+    // The old segment stays valid as long as it is referenced.
+    EXPECT_FALSE(is_in_far_tier(old_segment));
+    EXPECT_EQ((*old_segment)[ChunkOffset{0}],
+              (*migrated_segments[0])[ChunkOffset{0}]);
+}
+
+TEST_F(SegmentMigrationTaskTest, BoundedParallelism)
+{
+    const auto tasks = SegmentMigrationTask::make_for_table(
+        "int_int", {ColumnID{0}}, MemoryTier::Far, nullptr, nullptr, 2);
+    ASSERT_EQ(tasks.size(), 3);
+    EXPECT_TRUE(tasks[0]->predecessors().empty());
+    EXPECT_TRUE(tasks[1]->predecessors().empty());
+    ASSERT_EQ(tasks[2]->predecessors().size(), 1);
+    EXPECT_EQ(tasks[2]->predecessors().front().lock(), tasks[0]);
+    Hyrise::get().scheduler()->schedule_and_wait_for_tasks(tasks);
+}
+
+TEST_F(SegmentMigrationTaskTest, ReencodesForTargetTier)
+{
+    auto encoding_policy = std::make_shared<TieredEncodingPolicy>();
+    encoding_policy->set_scan_bandwidth(MemoryTier::Far, 1'000);
+    const auto statistics = std::make_shared<SegmentMigrationStatistics>();
+    const auto tasks = SegmentMigrationTask::make_for_table(
+        "int_int", {ColumnID{0}}, MemoryTier::Far, nullptr, statistics,
+        SegmentMigrationTask::DEFAULT_PARALLELISM, encoding_policy);
+    Hyrise::get().scheduler()->schedule_and_wait_for_tasks(tasks);
+
+    EXPECT_EQ(statistics->migrated_segment_count, 3);
+    EXPECT_GT(statistics->encoded_bytes, 0);
+    for (auto chunk_id = ChunkID{0}; chunk_id < table->chunk_count();
+         ++chunk_id)
+    {
+        // With a single row per chunk, the smallest encoding may well be the
+        // unencoded one, so we only check the placement.
+        const auto segment =
+            table->get_chunk(chunk_id)->get_segment(ColumnID{0});
+        EXPECT_EQ(get_segment_memory_tier(*segment), MemoryTier::Far);
+    }
+
+    EXPECT_TABLE_EQ_ORDERED(
+        table, load_table("resources/test_data/tbl/int_int.tbl"));
+}
+
+TEST_F(SegmentMigrationTaskTest, RateLimiter)
+{
+    auto rate_limiter = MigrationRateLimiter{10'000};
+    EXPECT_EQ(rate_limiter.acquire(500), std::chrono::nanoseconds{0});
+
+    // The first 500 bytes take 50 ms at 10 KB/s.
+    EXPECT_GT(rate_limiter.acquire(500), std::chrono::milliseconds{25});
+
+    auto unlimited = MigrationRateLimiter{0};
+    EXPECT_EQ(unlimited.acquire(size_t{1} << 40), std::chrono::nanoseconds{0});
+}
+
+} // namespace hyrise
@@ -7,10 +7,12 @@
 #include "utils/meta_table_manager.hpp"
 #include "utils/meta_tables/meta_chunk_sort_orders_table.hpp"
 #include "utils/meta_tables/meta_chunks_table.hpp"
+#include "utils/meta_tables/meta_column_hotness_table.hpp"
 #include "utils/meta_tables/meta_columns_table.hpp"
 #include "utils/meta_tables/meta_exec_table.hpp"
 #include "utils/meta_tables/meta_log_table.hpp"
 #include "utils/meta_tables/meta_plugins_table.hpp"
+#include "utils/meta_tables/meta_segment_heatmap_table.hpp"
 #include "utils/meta_tables/meta_segments_accurate_table.hpp"
 #include "utils/meta_tables/meta_segments_table.hpp"
 #include "utils/meta_tables/meta_settings_table.hpp"
@@ -32,10 +34,12 @@ class MetaTableManagerTest : public BaseTest
     {
         return {std::make_shared<MetaChunksTable>(),
                 std::make_shared<MetaChunkSortOrdersTable>(),
+                std::make_shared<MetaColumnHotnessTable>(),
                 std::make_shared<MetaColumnsTable>(),
                 std::make_shared<MetaExecTable>(),
                 std::make_shared<MetaLogTable>(),
                 std::make_shared<MetaPluginsTable>(),
+                std::make_shared<MetaSegmentHeatmapTable>(),
                 std::make_shared<MetaSegmentsTable>(),
                 std::make_shared<MetaSegmentsAccurateTable>(),
                 std::make_shared<MetaSettingsTable>(),
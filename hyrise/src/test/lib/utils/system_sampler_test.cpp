@@ -0,0 +1,83 @@
+#include <thread>
+
+#include "base_test.hpp"
+
+#include "hyrise.hpp"
+#include "sql/sql_pipeline_builder.hpp"
+#include "utils/system_sampler.hpp"
+
+namespace hyrise
+{
+
+class SystemSamplerTest : public BaseTest
+{
+};
+
+TEST_F(SystemSamplerTest, SamplesUntilStopped)
+{
+    auto sampler = SystemSampler{std::chrono::milliseconds{1}};
+    sampler.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds{20});
+    const auto utilization = sampler.stop();
+
+    EXPECT_EQ(utilization.interval, std::chrono::milliseconds{1});
+    ASSERT_GT(utilization.samples.size(), 2);
+    for (auto sample_id = size_t{1}; sample_id < utilization.samples.size();
+         ++sample_id)
+    {
+        const auto &previous = utilization.samples[sample_id - 1];
+        const auto &sample = utilization.samples[sample_id];
+        EXPECT_GE(sample.timestamp, previous.timestamp);
+        EXPECT_GE(sample.process_cpu_time, previous.process_cpu_time);
+    }
+    EXPECT_GT(utilization.samples.back().process_rss, 0);
+    EXPECT_GT(utilization.samples.back().process_threads, 0);
+
+    // The sampler can be restarted.
+    sampler.start();
+    EXPECT_GE(sampler.stop().samples.size(), 2);
+}
+
+TEST_F(SystemSamplerTest, KeepsFirstSampleWhenRingOverflows)
+{
+    auto sampler = SystemSampler{std::chrono::milliseconds{1}, 2};
+    sampler.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds{20});
+    const auto utilization = sampler.stop();
+
+    // The first and the last sample plus the ring's capacity.
+    ASSERT_EQ(utilization.samples.size(), 4);
+    EXPECT_LT(utilization.samples[0].timestamp,
+              std::chrono::milliseconds{1});
+    EXPECT_GT(utilization.samples[1].timestamp,
+              std::chrono::milliseconds{1});
+}
+
+TEST_F(SystemSamplerTest, ThreadCpuTimes)
+{
+    const auto thread_cpu_times = read_thread_cpu_times();
+    ASSERT_FALSE(thread_cpu_times.empty());
+    for (const auto &thread_time : thread_cpu_times)
+    {
+        EXPECT_GT(thread_time.thread_id, 0);
+    }
+}
+
+TEST_F(SystemSamplerTest, AttachedToPipelineMetrics)
+{
+    auto pipeline = SQLPipelineBuilder{"SELECT 1"}.create_pipeline();
+    pipeline.get_result_table();
+    EXPECT_FALSE(pipeline.metrics().statement_metrics.at(0)->system_utilization);
+
+    Hyrise::get().set_system_sampling(true);
+    auto sampled_pipeline = SQLPipelineBuilder{"SELECT 1"}.create_pipeline();
+    sampled_pipeline.get_result_table();
+    Hyrise::get().set_system_sampling(false);
+
+    const auto &utilization =
+        sampled_pipeline.metrics().statement_metrics.at(0)->system_utilization;
+    ASSERT_TRUE(utilization);
+    EXPECT_GE(utilization->samples.size(), 2);
+}
+
+} // namespace hyrise
@@ -0,0 +1,191 @@
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base_test.hpp"
+#include "lib/utils/plugin_test_utils.hpp"
+
+#include "../../plugins/placement_advisor_plugin.hpp"
+#include "sql/sql_pipeline_builder.hpp"
+#include "storage/table.hpp"
+#include "storage/value_segment.hpp"
+#include "utils/load_table.hpp"
+#include "utils/plugin_manager.hpp"
+
+namespace hyrise
+{
+
+class PlacementAdvisorPluginTest : public BaseTest
+{
+  public:
+    void SetUp() override
+    {
+        // Each chunk holds a single row, so that all segments have the same
+        // size.
+        _table =
+            load_table("resources/test_data/tbl/int_int.tbl", ChunkOffset{1});
+        Hyrise::get().storage_manager.add_table(_table_name, _table);
+
+        _set_near_tier_capacity(_segment_bytes(ChunkID{0}, ColumnID{0}));
+    }
+
+  protected:
+    void _set_near_tier_capacity(const size_t capacity)
+    {
+        _plugin._near_tier_capacity = capacity;
+    }
+
+    void _set_heat_source(const PlacementAdvisorPlugin::HeatSource heat_source)
+    {
+        _plugin._heat_source = heat_source;
+    }
+
+    std::vector<SegmentMigration> _advise()
+    {
+        return _plugin._advise();
+    }
+
+    size_t _apply(const std::vector<SegmentMigration> &migrations)
+    {
+        return _plugin._apply(migrations);
+    }
+
+    void _access(const ChunkID chunk_id, const ColumnID column_id)
+    {
+        _table->get_chunk(chunk_id)->get_segment(column_id)->access_counter
+            [SegmentAccessCounter::AccessType::Sequential] += 100;
+    }
+
+    size_t _segment_bytes(const ChunkID chunk_id, const ColumnID column_id)
+    {
+        return _table->get_chunk(chunk_id)
+            ->get_segment(column_id)
+            ->memory_usage(MemoryUsageCalculationMode::Sampled);
+    }
+
+    bool _is_in_far_tier(const ChunkID chunk_id, const ColumnID column_id)
+    {
+        const auto value_segment =
+            std::dynamic_pointer_cast<const ValueSegment<int32_t>>(
+                _table->get_chunk(chunk_id)->get_segment(column_id));
+        const auto *far_tier = get_far_memory_tier();
+        return far_tier && far_tier->contains(value_segment->values().data());
+    }
+
+    const std::string _table_name{"int_int"};
+    std::shared_ptr<Table> _table;
+    PlacementAdvisorPlugin _plugin;
+};
+
+TEST_F(PlacementAdvisorPluginTest, LoadUnloadPlugin)
+{
+    auto &plugin_manager = Hyrise::get().plugin_manager;
+    EXPECT_NO_THROW(plugin_manager.load_plugin(
+        build_dylib_path("libhyrisePlacementAdvisorPlugin")));
+    EXPECT_TRUE(Hyrise::get().settings_manager.has_setting(
+        "PlacementAdvisor.near_tier_capacity"));
+    EXPECT_NO_THROW(
+        plugin_manager.unload_plugin("hyrisePlacementAdvisorPlugin"));
+    EXPECT_FALSE(Hyrise::get().settings_manager.has_setting(
+        "PlacementAdvisor.near_tier_capacity"));
+}
+
+TEST_F(PlacementAdvisorPluginTest, DescriptionAndProvidedFunctions)
+{
+    EXPECT_EQ(_plugin.description(), "Online Segment Placement Advisor Plugin");
+    const auto &provided_functions =
+        _plugin.provided_user_executable_functions();
+    ASSERT_EQ(provided_functions.size(), 2);
+    EXPECT_EQ(provided_functions[0].first, "AdvisePlacement");
+    EXPECT_EQ(provided_functions[1].first, "ApplyPlacement");
+    EXPECT_TRUE(_plugin.pre_benchmark_hook());
+}
+
+TEST_F(PlacementAdvisorPluginTest, DemotesColdSegments)
+{
+    _access(ChunkID{1}, ColumnID{0});
+
+    const auto migrations = _advise();
+    ASSERT_EQ(migrations.size(), 5);
+    for (const auto &migration : migrations)
+    {
+        EXPECT_EQ(migration.table_name, _table_name);
+        EXPECT_EQ(migration.source_tier, MemoryTier::Near);
+        EXPECT_EQ(migration.target_tier, MemoryTier::Far);
+        EXPECT_FALSE(migration.chunk_id == ChunkID{1} &&
+                     migration.column_id == ColumnID{0});
+    }
+
+    EXPECT_EQ(_apply(migrations), 5);
+    EXPECT_FALSE(_is_in_far_tier(ChunkID{1}, ColumnID{0}));
+    EXPECT_TRUE(_is_in_far_tier(ChunkID{0}, ColumnID{0}));
+    EXPECT_TRUE(_is_in_far_tier(ChunkID{2}, ColumnID{1}));
+
+    // The placement is stable as long as the workload does not change.
+    _access(ChunkID{1}, ColumnID{0});
+    EXPECT_TRUE(_advise().empty());
+}
+
+TEST_F(PlacementAdvisorPluginTest, FollowsWorkloadShift)
+{
+    _access(ChunkID{1}, ColumnID{0});
+    _apply(_advise());
+    ASSERT_TRUE(_is_in_far_tier(ChunkID{2}, ColumnID{0}));
+
+    // The hysteresis delays the swap, but the new hot segment is promoted
+    // within a few rounds.
+    for (auto round = 0; round < 5; ++round)
+    {
+        _access(ChunkID{2}, ColumnID{0});
+        _apply(_advise());
+    }
+    EXPECT_FALSE(_is_in_far_tier(ChunkID{2}, ColumnID{0}));
+    EXPECT_TRUE(_is_in_far_tier(ChunkID{1}, ColumnID{0}));
+}
+
+TEST_F(PlacementAdvisorPluginTest, PromotesSegmentsPlacedByOthers)
+{
+    // The segment has not been migrated by the plugin, but it is in the far
+    // tier nevertheless.
+    const auto chunk = _table->get_chunk(ChunkID{0});
+    chunk->replace_segment(
+        ColumnID{0},
+        chunk->get_segment(ColumnID{0})
+            ->copy_using_allocator(PolymorphicAllocator<size_t>{
+                get_memory_tier_resource(MemoryTier::Far)}));
+    ASSERT_TRUE(_is_in_far_tier(ChunkID{0}, ColumnID{0}));
+    _access(ChunkID{0}, ColumnID{0});
+
+    const auto migrations = _advise();
+    ASSERT_EQ(migrations.size(), 6);
+    const auto &promotion = migrations.back();
+    EXPECT_EQ(promotion.chunk_id, ChunkID{0});
+    EXPECT_EQ(promotion.column_id, ColumnID{0});
+    EXPECT_EQ(promotion.source_tier, MemoryTier::Far);
+    EXPECT_EQ(promotion.target_tier, MemoryTier::Near);
+
+    EXPECT_EQ(_apply(migrations), 6);
+    EXPECT_FALSE(_is_in_far_tier(ChunkID{0}, ColumnID{0}));
+}
+
+TEST_F(PlacementAdvisorPluginTest, PlanEstimates)
+{
+    _set_heat_source(PlacementAdvisorPlugin::HeatSource::PlanEstimates);
+    _set_near_tier_capacity(3 * _segment_bytes(ChunkID{0}, ColumnID{0}));
+
+    Hyrise::get().default_lqp_cache = std::make_shared<SQLLogicalPlanCache>();
+    SQLPipelineBuilder{"SELECT a FROM int_int WHERE a > 100"}
+        .create_pipeline()
+        .get_result_table();
+
+    // Column b is not read by the cached query.
+    const auto migrations = _advise();
+    ASSERT_EQ(migrations.size(), 3);
+    for (const auto &migration : migrations)
+    {
+        EXPECT_EQ(migration.column_id, ColumnID{1});
+        EXPECT_EQ(migration.target_tier, MemoryTier::Far);
+    }
+}
+
+} // namespace hyrise
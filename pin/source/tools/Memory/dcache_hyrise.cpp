@@ -14,10 +14,15 @@
 #include <fstream>
 #include <cassert>
 #include <cstdio>
+#include <cstdlib>
+#include <map>
 #include <mutex>
+#include <sstream>
+#include <vector>
 
 #include "cache.H"
 #include "pin_profile.H"
+#include "../../../../cxlsim/include/TraceRing.h"
 using std::cerr;
 using std::endl;
 
@@ -34,6 +39,15 @@ KNOB<UINT32> KnobThresholdMiss(KNOB_MODE_WRITEONCE, "pintool", "rm", "100",
 KNOB<UINT32> KnobCacheSize(KNOB_MODE_WRITEONCE, "pintool", "c", "32", "cache size in kilobytes");
 KNOB<UINT32> KnobLineSize(KNOB_MODE_WRITEONCE, "pintool", "b", "32", "cache block size in bytes");
 KNOB<UINT32> KnobAssociativity(KNOB_MODE_WRITEONCE, "pintool", "a", "4", "cache associativity (1 for direct mapped)");
+KNOB<string> KnobRing(KNOB_MODE_WRITEONCE, "pintool", "ring", "",
+                      "stream misses to cxlsim through the trace ring at this path (e.g. /dev/shm/q6) instead of writing roitrace_<pid>.csv");
+KNOB<UINT32> KnobRingShards(KNOB_MODE_WRITEONCE, "pintool", "shards", "1", "number of cxlsim shards, reading <ring>.0 to <ring>.<n-1>");
+KNOB<UINT64> KnobShardChunk(KNOB_MODE_WRITEONCE, "pintool", "shard_chunk", "1048576",
+                            "number of consecutive misses sent to one shard before moving on to the next");
+KNOB<UINT32> KnobRingTimeout(KNOB_MODE_WRITEONCE, "pintool", "ring_timeout", "60000", "milliseconds to wait for the cxlsim shards to create their rings");
+KNOB<string> KnobTee(KNOB_MODE_WRITEONCE, "pintool", "tee", "", "also write the streamed misses to this file in the cxlsim trace format");
+KNOB<string> KnobDetails(KNOB_MODE_WRITEONCE, "pintool", "details", "",
+                         "details.dat to tag streamed segment accesses with their table and column from mem_blk_<pid>.txt, like isolate_hash");
 
 /* ===================================================================== */
 
@@ -100,6 +114,21 @@ std::mutex fileMutex;
 
 UINT32 num_ins_between_misses=0;
 
+// Live streaming to cxlsim, used instead of the roitrace file when -ring is given
+std::vector<CXL::TraceRing *> rings;
+UINT64 streamed_misses = 0;
+FILE *tee = NULL;
+
+// Address range of a segment from the mem_blk file, keyed by start address
+struct SegmentRange
+{
+    ADDRINT end;
+    UINT8 table_id;
+    UINT8 column_id;
+};
+std::map<ADDRINT, SegmentRange> segment_ranges;
+bool segment_ranges_loaded = false;
+
 INS global_ins;
 UINT32 global_memOp;
 // const CHAR * name;
@@ -107,18 +136,96 @@ UINT32 global_memOp;
 int total_evict_requests = 0;
 int total_evictions = 0;
 
+static string Trim(const string &str)
+{
+    size_t first = str.find_first_not_of(" \t\n\r");
+    size_t last = str.find_last_not_of(" \t\n\r");
+    return first == string::npos ? "" : str.substr(first, last - first + 1);
+}
+
+// Read the segment ranges hyrise wrote to mem_blk_<pid>.txt before the ROI, in the format isolate_hash parses
+VOID LoadSegmentRanges()
+{
+    segment_ranges_loaded = true;
+    std::map<string, std::pair<UINT8, UINT8>> columns;
+    std::ifstream details(KnobDetails.Value().c_str());
+    string line;
+    while (std::getline(details, line))
+    {
+        std::istringstream ss(line);
+        string name, table_id, column_id;
+        std::getline(ss, name, ',');
+        std::getline(ss, table_id, ',');
+        std::getline(ss, column_id, ',');
+        columns[name] = std::make_pair((UINT8)atoi(table_id.c_str()), (UINT8)atoi(column_id.c_str()));
+    }
+
+    char filename[100];
+    sprintf(filename, "mem_blk_%d.txt", PIN_GetPid());
+    std::ifstream mem_blk(filename);
+    std::pair<UINT8, UINT8> column(0, 0);
+    while (std::getline(mem_blk, line))
+    {
+        if (line.find("Table") != string::npos)
+        {
+            column = columns[Trim(line.substr(line.rfind(':') + 1))];
+            continue;
+        }
+        if (line.find("-----") != string::npos || line.find("VEC") != string::npos)
+            continue;
+        size_t open = line.find('('), close = line.find(')'), colon = line.find(':');
+        if (open == string::npos || close == string::npos || colon == string::npos)
+            continue;
+        ADDRINT start = strtoull(Trim(line.substr(colon + 1)).c_str(), NULL, 16);
+        ADDRINT size = strtoull(line.substr(open + 1, close - open - 1).c_str(), NULL, 10);
+        SegmentRange range = {start + size, column.first, column.second};
+        segment_ranges[start] = range;
+    }
+    cerr << "Loaded " << segment_ranges.size() << " segment ranges from " << filename << endl;
+}
+
+// Tag accesses to segments with their table and column id, as isolate_hash does for the roitrace file
+ADDRINT TagSegment(ADDRINT addr)
+{
+    std::map<ADDRINT, SegmentRange>::iterator it = segment_ranges.upper_bound(addr);
+    if (it == segment_ranges.begin())
+        return addr;
+    --it;
+    if (addr >= it->second.end)
+        return addr;
+    return addr | 0xa00000000000000 | (ADDRINT)it->second.table_id << 52 | (ADDRINT)it->second.column_id << 48;
+}
+
+// Send a miss to the cxlsim shard that owns the current chunk of the stream. Blocks while the ring of that shard is
+// full, so tracing slows down to the speed of the simulation instead of buffering the trace
+VOID StreamMiss(ADDRINT addr, BOOL isWrite)
+{
+    PIN_GetLock(&pinLock, 1);
+    CXL::TraceRecord record = {TagSegment(addr), num_ins_between_misses, (UINT8)isWrite, 0, 0};
+    num_ins_between_misses = 0;
+    rings[(streamed_misses / KnobShardChunk.Value()) % rings.size()]->push(record);
+    streamed_misses++;
+    if (tee != NULL)
+        fprintf(tee, "0x%lx %c %u\n", record.address, isWrite ? 'W' : 'R', record.gap);
+    PIN_ReleaseLock(&pinLock);
+}
+
 // Set ROI flag
 VOID StartROI()
 {
     isROI = true;
-    fprintf(trace, "startROI\n");
+    if (!rings.empty() && !segment_ranges_loaded && !KnobDetails.Value().empty())
+        LoadSegmentRanges();
+    if (trace != NULL)
+        fprintf(trace, "startROI\n");
 }
 
 // Set ROI flag
 VOID StopROI()
 {
     isROI = false;
-    fprintf(trace, "endROI\n");
+    if (trace != NULL)
+        fprintf(trace, "endROI\n");
 }
 
 // Function that will be called before each "RTN", or "function/routine"
@@ -203,6 +310,11 @@ VOID LoadMulti(ADDRINT addr, UINT32 size, UINT32 instId, const CHAR *name, UINT3
         {
             return;
         }
+        if (!rings.empty())
+        {
+            StreamMiss(addr, FALSE);
+            return;
+        }
 
         // Log memory access in CSV
         // fprintf(trace,"%p,R,%p,%s\n", ins, addr, name);
@@ -239,6 +351,11 @@ VOID StoreMulti(ADDRINT addr, UINT32 size, UINT32 instId, const CHAR *name, UINT
         {
             return;
         }
+        if (!rings.empty())
+        {
+            StreamMiss(addr, TRUE);
+            return;
+        }
 
         // Log memory access in CSV
         // fprintf(trace,"%p,R,%p,%s\n", ins, addr, name);
@@ -275,6 +392,11 @@ VOID LoadSingle(ADDRINT addr, UINT32 instId, const CHAR *name, UINT32 asize)
         {
             return;
         }
+        if (!rings.empty())
+        {
+            StreamMiss(addr, FALSE);
+            return;
+        }
 
         // Log memory access in CSV
         // fprintf(trace,"%p,R,%p,%s\n", ins, addr, name);
@@ -310,6 +432,11 @@ VOID StoreSingle(ADDRINT addr, UINT32 instId, const CHAR *name, UINT32 asize)
         {
             return;
         }
+        if (!rings.empty())
+        {
+            StreamMiss(addr, TRUE);
+            return;
+        }
 
         // Log memory access in CSV
         // fprintf(trace,"%p,R,%p,%s\n", ins, addr, name);
@@ -473,7 +600,16 @@ VOID Fini(int code, VOID *v)
         out << profile.StringLong();
     }
     out.close();
-    fprintf(trace, "Total Req: %d, Actual Evict: %d\n", total_evict_requests, total_evictions);
+    if (trace != NULL)
+        fprintf(trace, "Total Req: %d, Actual Evict: %d\n", total_evict_requests, total_evictions);
+
+    // Detaching the last producer closes the rings, the shards finish once they drained them
+    for (size_t i = 0; i < rings.size(); i++)
+        delete rings[i];
+    rings.clear();
+    if (tee != NULL)
+        fclose(tee);
+    cerr << "Streamed " << streamed_misses << " misses" << endl;
 }
 
 /* ===================================================================== */
@@ -506,11 +642,31 @@ int main(int argc, char *argv[])
     INS_AddInstrumentFunction(Instruction, 0);
     PIN_AddFiniFunction(Fini, 0);
 
-    // Open trace file and write header
-    char filename[100];
-    sprintf(filename, "roitrace_%d.csv", PIN_GetPid());
-    trace = fopen(filename, "w");
-    fprintf(trace, "pc,rw,addr,rtn\n");
+    if (!KnobRing.Value().empty())
+    {
+        // Attach to the rings of all cxlsim shards, which have to be started first
+        for (UINT32 shard = 0; shard < KnobRingShards.Value(); shard++)
+        {
+            CXL::TraceRing *ring = new CXL::TraceRing();
+            string path = CXL::TraceRing::shard_path(KnobRing.Value(), shard, KnobRingShards.Value());
+            if (!ring->attach(path, KnobRingTimeout.Value()))
+            {
+                cerr << "No cxlsim ring at " << path << endl;
+                return 1;
+            }
+            rings.push_back(ring);
+        }
+        if (!KnobTee.Value().empty())
+            tee = fopen(KnobTee.Value().c_str(), "w");
+    }
+    else
+    {
+        // Open trace file and write header
+        char filename[100];
+        sprintf(filename, "roitrace_%d.csv", PIN_GetPid());
+        trace = fopen(filename, "w");
+        fprintf(trace, "pc,rw,addr,rtn\n");
+    }
 
     // Never returns
 